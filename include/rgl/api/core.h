@@ -176,6 +176,89 @@ static_assert(std::is_trivial<rgl_bone_weights_t>::value);
 static_assert(std::is_standard_layout<rgl_bone_weights_t>::value);
 #endif
 
+/**
+ * Latency counters of a graph, see rgl_graph_get_latency.
+ * Times are given in microseconds. Maximums are zero if nothing has been measured yet.
+ */
+typedef struct
+{
+	/**
+	 * Number of completed runs.
+	 */
+	int32_t run_count;
+	/**
+	 * Time from rgl_graph_run handing the graph over to graph threads until the last node finishes its CPU execution.
+	 * It does not include pending GPU operations.
+	 */
+	float run_mean_us;
+	float run_max_us;
+	/**
+	 * Number of times the client's thread had to wait for a node (e.g. to get its results).
+	 */
+	int32_t wakeup_count;
+	/**
+	 * Time from a node finishing its CPU execution until the client's thread waiting for it resumes.
+	 * This is the latency controlled by rgl_graph_set_wait_strategy.
+	 */
+	float wakeup_mean_us;
+	float wakeup_max_us;
+} rgl_graph_latency_t;
+
+#ifdef __cplusplus
+static_assert(sizeof(rgl_graph_latency_t) == 2 * sizeof(int32_t) + 4 * sizeof(float));
+static_assert(std::is_trivial<rgl_graph_latency_t>::value);
+static_assert(std::is_standard_layout<rgl_graph_latency_t>::value);
+#endif
+
+/**
+ * Statistics of a node collected when profiling is enabled, see rgl_graph_set_profiling.
+ * Times are given in microseconds. Point counts refer to rays for nodes that do not process points.
+ */
+typedef struct
+{
+	/**
+	 * Number of successful runs of the node since profiling was enabled.
+	 */
+	int32_t run_count;
+	/**
+	 * Time spent by the graph thread enqueueing the node's work.
+	 */
+	float cpu_time_mean_us;
+	float cpu_time_std_dev_us;
+	float cpu_time_last_us;
+	/**
+	 * Number of runs for which GPU time was available.
+	 */
+	int32_t gpu_run_count;
+	/**
+	 * Time between the start and the end of the node's work on its CUDA stream.
+	 */
+	float gpu_time_mean_us;
+	float gpu_time_std_dev_us;
+	float gpu_time_last_us;
+	/**
+	 * Bytes of memory allocated by the node's arrays, in total and in the last run.
+	 */
+	int64_t allocated_bytes_total;
+	int64_t allocated_bytes_last;
+	/**
+	 * Sum of point counts of the node's inputs.
+	 */
+	float points_in_mean;
+	int32_t points_in_last;
+	/**
+	 * Point count of the node's output.
+	 */
+	float points_out_mean;
+	int32_t points_out_last;
+} rgl_node_stats_t;
+
+#ifdef __cplusplus
+static_assert(sizeof(rgl_node_stats_t) == 4 * sizeof(int32_t) + 8 * sizeof(float) + 2 * sizeof(int64_t));
+static_assert(std::is_trivial<rgl_node_stats_t>::value);
+static_assert(std::is_standard_layout<rgl_node_stats_t>::value);
+#endif
+
 /**
  * Radar object class used in object tracking.
  */
@@ -513,6 +596,40 @@ typedef enum : int32_t
 	RGL_AXIS_Z = 3,
 } rgl_axis_t;
 
+/**
+ * Output formats of the graph profile, see rgl_graph_write_profile.
+ */
+typedef enum : int32_t
+{
+	/**
+	 * JSON array with statistics of each profiled node.
+	 */
+	RGL_PROFILE_FORMAT_JSON = 0,
+	/**
+	 * Recent runs of profiled nodes in the Trace Event Format, viewable in chrome://tracing or Perfetto.
+	 */
+	RGL_PROFILE_FORMAT_CHROME_TRACE = 1,
+} rgl_profile_format_t;
+
+/**
+ * Implementations of raytracing, see rgl_node_raytrace_configure_backend.
+ */
+typedef enum : int32_t
+{
+	/**
+	 * Hardware-accelerated raytracing with NVIDIA OptiX (default).
+	 */
+	RGL_RAYTRACE_BACKEND_OPTIX = 0,
+	/**
+	 * Multithreaded traversal of the scene on the CPU, using bounding volume hierarchies built on the host, without OptiX.
+	 * It still requires a CUDA device: scene data and the node's input and output are stored on the GPU
+	 * and copied to and from the host for each run.
+	 * Produces the same fields as OptiX backend. Beam divergence and raytrace batches are not supported.
+	 */
+	RGL_RAYTRACE_BACKEND_HOST_TRAVERSAL = 1,
+	RGL_RAYTRACE_BACKEND_COUNT
+} rgl_raytrace_backend_t;
+
 /******************************** GENERAL ********************************/
 
 /**
@@ -904,6 +1021,25 @@ RGL_API rgl_status_t rgl_node_raytrace_configure_default_intensity(rgl_node_t no
  */
 RGL_API rgl_status_t rgl_node_raytrace_configure_return_mode(rgl_node_t node, rgl_return_mode_t return_mode);
 
+/**
+ * Modifies RaytraceNode to be raytraced as a part of a batch.
+ * All RaytraceNodes with the same (non-zero) batch id are raytraced with a single launch, sharing the scene state.
+ * Members of a batch are expected to be in different graphs (or concurrent branches of a graph) which are run together.
+ * Launch waits (a few milliseconds at most) until all members are enqueued; members that are late are raytraced separately.
+ * Default batch id is 0, meaning the node is raytraced on its own.
+ * @param node RaytraceNode to modify.
+ * @param batch_id Id of the batch to join, or 0 to leave the current batch.
+ */
+RGL_API rgl_status_t rgl_node_raytrace_configure_batch(rgl_node_t node, int32_t batch_id);
+
+/**
+ * Modifies RaytraceNode to use the given raytracing backend. Default backend is RGL_RAYTRACE_BACKEND_OPTIX.
+ * Host traversal backend does not require OptiX to raytrace, but the node's output is still stored on the GPU.
+ * @param node RaytraceNode to modify.
+ * @param backend Raytracing backend to use.
+ */
+RGL_API rgl_status_t rgl_node_raytrace_configure_backend(rgl_node_t node, rgl_raytrace_backend_t backend);
+
 /**
  * Creates or modifies FormatPointsNode.
  * The Node converts internal representation into a binary format defined by the `fields` array.
@@ -970,6 +1106,19 @@ RGL_API rgl_status_t rgl_node_points_spatial_merge(rgl_node_t* node, const rgl_f
  */
 RGL_API rgl_status_t rgl_node_points_temporal_merge(rgl_node_t* node, const rgl_field_t* fields, int32_t field_count);
 
+/**
+ * Modifies TemporalMergePointsNode to accumulate only the most recent point clouds.
+ * Frames outside the window are evicted before merging a new one.
+ * If both limits are set, frames are evicted when exceeding any of them.
+ * Modifying the window clears accumulated data.
+ * @param node TemporalMergePointsNode to modify.
+ * @param max_frame_count Maximum number of merged point clouds. Zero means no limit.
+ * @param max_duration Maximum age of merged point clouds in seconds, based on the scene time. Zero means no limit.
+ *                     Requires scene time to be set (see rgl_scene_set_time).
+ */
+RGL_API rgl_status_t rgl_node_points_temporal_merge_configure_window(rgl_node_t node, int32_t max_frame_count,
+                                                                     float max_duration);
+
 /**
  * Creates or modifies FromArrayPointsNode.
  * The Node provides initial points for its children Nodes. This Node does not handle return mode - it is assumed that
@@ -1163,6 +1312,31 @@ RGL_API rgl_status_t rgl_graph_get_result_size(rgl_node_t node, rgl_field_t fiel
  */
 RGL_API rgl_status_t rgl_graph_get_result_data(rgl_node_t node, rgl_field_t field, void* data);
 
+/**
+ * Sets a client-owned buffer, to which the given field of Node's results is written at the end of each graph run.
+ * This avoids intermediate copies done by rgl_graph_get_result_data. If possible, the buffer is page-locked.
+ * Completion of the write can be polled with rgl_graph_query_result_buffer.
+ * The buffer must remain valid until it is replaced, unset, or the Node is destroyed.
+ * Its contents may be read only after the query reports it ready and before the next graph run.
+ * If the results do not fit in the buffer, the buffer is left intact and the query returns an error.
+ * @param node Node to get output from.
+ * @param field Field to get output from. Formatted output with FormatNode should be marked as RGL_FIELD_DYNAMIC_FORMAT.
+ * @param buffer Buffer to write results to. If null, the previously set buffer for this field is released.
+ * @param buffer_size Size of the buffer in bytes.
+ */
+RGL_API rgl_status_t rgl_graph_set_result_buffer(rgl_node_t node, rgl_field_t field, void* buffer, int64_t buffer_size);
+
+/**
+ * Checks whether results of the last graph run have been written to the buffer set with rgl_graph_set_result_buffer.
+ * This function does not block.
+ * @param node Node to get output from.
+ * @param field Field to get output from.
+ * @param out_ready Returns 1 if the buffer contains results of the last run, 0 otherwise.
+ * @param out_count Returns the number of written elements (e.g., points), if ready. It may be null.
+ */
+RGL_API rgl_status_t rgl_graph_query_result_buffer(rgl_node_t node, rgl_field_t field, int32_t* out_ready,
+                                                   int32_t* out_count);
+
 /**
  * Adds child to the parent Node
  * @param parent Node that will be set as the parent of (child)
@@ -1196,3 +1370,71 @@ RGL_API rgl_status_t rgl_graph_node_set_priority(rgl_node_t node, int32_t priori
  * @param out_priority Non-null pointer where priority will be stored.
  */
 RGL_API rgl_status_t rgl_graph_node_get_priority(rgl_node_t node, int32_t* out_priority);
+
+/**
+ * Enables or disables concurrent execution of independent branches of the graph containing the provided Node.
+ * When enabled, the graph is split into branches at forks and merges. Branches are executed on separate
+ * worker threads and CUDA streams, so that e.g. sibling post-processing pipelines of the same raytrace may overlap.
+ * Priorities then determine only the order in which ready branches are started.
+ * By default, concurrent execution is disabled and nodes are executed one after another.
+ * The setting is kept when the graph is modified; graphs joined by rgl_graph_node_add_child
+ * execute concurrently if any of them had it enabled.
+ * @param node Any Node from the graph to configure.
+ * @param enabled If true, independent branches will be executed concurrently.
+ */
+RGL_API rgl_status_t rgl_graph_set_concurrent_branches(rgl_node_t node, bool enabled);
+
+/**
+ * Configures how threads wait for the execution of the graph containing the provided Node.
+ * This applies to the client's thread waiting for nodes (e.g. in rgl_graph_get_result_data)
+ * and to graph threads waiting for work.
+ * A waiting thread first polls busily spin_count times, then polls yield_count times giving up its time slice,
+ * and finally goes to sleep until woken up by the OS.
+ * Spinning gives the lowest latency at the cost of occupied CPU cores, sleeping leaves the cores to the rest
+ * of the application (e.g. physics) at the cost of wake-up latency. Use rgl_graph_get_latency to compare both.
+ * By default, threads go to sleep immediately (spin_count = yield_count = 0).
+ * The setting is kept when the graph is modified; graphs joined by rgl_graph_node_add_child
+ * use the larger of the thresholds.
+ * @param node Any Node from the graph to configure.
+ * @param spin_count Number of busy polls before yielding, non-negative.
+ * @param yield_count Number of yielding polls before sleeping, non-negative.
+ */
+RGL_API rgl_status_t rgl_graph_set_wait_strategy(rgl_node_t node, int32_t spin_count, int32_t yield_count);
+
+/**
+ * Returns latency counters of the graph containing the provided Node.
+ * A run is measured once it is synchronized (e.g. by getting results or running the graph again).
+ * Counters are reset when the structure of the graph changes.
+ * @param node Any Node from the graph to query.
+ * @param out_latency Address to store the counters at.
+ */
+RGL_API rgl_status_t rgl_graph_get_latency(rgl_node_t node, rgl_graph_latency_t* out_latency);
+
+/**
+ * Enables or disables profiling of all nodes in the graph containing the provided Node.
+ * Profiled nodes collect rolling statistics of CPU enqueue time, GPU time, allocated memory and point counts.
+ * The overhead is a few clock reads and two CUDA event records per node, so it may be left enabled in production.
+ * Disabling profiling discards the collected statistics.
+ * The setting is kept per node when the graph is modified; nodes added later must be enabled separately.
+ * @param node Any Node from the graph to configure.
+ * @param enabled If true, nodes of the graph will be profiled.
+ */
+RGL_API rgl_status_t rgl_graph_set_profiling(rgl_node_t node, bool enabled);
+
+/**
+ * Returns statistics of the provided Node, collected since profiling was enabled.
+ * Waits for the graph to complete, so that the last run is included.
+ * If the node is not profiled, all values are zero.
+ * @param node Node to query.
+ * @param out_stats Address to store the statistics at.
+ */
+RGL_API rgl_status_t rgl_graph_get_node_stats(rgl_node_t node, rgl_node_stats_t* out_stats);
+
+/**
+ * Writes statistics or recent runs of profiled nodes of the graph containing the provided Node to a file.
+ * Waits for the graph to complete, so that the last run is included.
+ * @param node Any Node from the graph to dump.
+ * @param file_path Path of the output file, it will be overwritten.
+ * @param format Format of the output, see rgl_profile_format_t.
+ */
+RGL_API rgl_status_t rgl_graph_write_profile(rgl_node_t node, const char* file_path, rgl_profile_format_t format);
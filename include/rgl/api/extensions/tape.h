@@ -16,15 +16,62 @@
 
 #include <rgl/api/core.h>
 
+/**
+ * Determines what happens when an asynchronous recording buffer is full.
+ */
+typedef enum : int32_t
+{
+	/**
+	 * The recorded API call waits until the writer thread frees enough buffer memory. The tape is complete.
+	 */
+	RGL_TAPE_OVERFLOW_BLOCK = 0,
+	/**
+	 * The API call is executed, but not recorded. Calls following a dropped one may fail on playback,
+	 * e.g. if they refer to an object created by the dropped call.
+	 */
+	RGL_TAPE_OVERFLOW_DROP = 1,
+} rgl_tape_overflow_policy_t;
+
+/**
+ * Counters of the active recording session.
+ */
+typedef struct
+{
+	uint64_t recorded_call_count;
+	uint64_t dropped_call_count;     // Calls not recorded due to RGL_TAPE_OVERFLOW_DROP policy
+	uint64_t buffered_bytes;         // Data waiting for the writer thread (lag)
+	uint64_t max_buffered_bytes;     // Peak of buffered_bytes
+	uint64_t written_bytes;          // Data written by the writer thread
+	uint64_t blocked_time_ns;        // Total time API calls waited for buffer memory due to RGL_TAPE_OVERFLOW_BLOCK policy
+	uint64_t bin_data_bytes;         // Size of arrays passed to recorded calls
+	uint64_t deduplicated_bin_bytes; // Part of bin_data_bytes not written again, as identical arrays were on the tape
+} rgl_tape_record_stats_t;
+
+#ifdef __cplusplus
+static_assert(std::is_trivial<rgl_tape_record_stats_t>::value);
+static_assert(std::is_standard_layout<rgl_tape_record_stats_t>::value);
+#endif
+
 /**
  * Starts recording all API calls.
- * Two files will be created at the path location: .yaml and .bin file.
+ * Two files will be created at the path location: .calls and .bin file.
  * Only one record session can be executed at the same time.
  * Currently, Windows is not supported: throws RGL_TAPE_ERROR
  * @param path path to output files (should contain filename without extension)
  */
 RGL_API rgl_status_t rgl_tape_record_begin(const char* path);
 
+/**
+ * Starts recording all API calls, like rgl_tape_record_begin, but files are written by a background thread.
+ * Recorded data (e.g. mesh vertices) is copied to a buffer of a bounded size, so API calls are not delayed by file I/O.
+ * Currently, Windows is not supported: throws RGL_TAPE_ERROR
+ * @param path path to output files (should contain filename without extension)
+ * @param max_buffer_size maximal amount of memory [bytes] used to buffer data waiting to be written
+ * @param overflow_policy determines what happens when data of an API call does not fit in the buffer
+ */
+RGL_API rgl_status_t rgl_tape_record_begin_async(const char* path, size_t max_buffer_size,
+                                                 rgl_tape_overflow_policy_t overflow_policy);
+
 /**
  * Stops active recording session and saves the recorded data to files (path determined at recording start)
  * Currently, Windows is not supported: throws RGL_TAPE_ERROR
@@ -37,6 +84,12 @@ RGL_API rgl_status_t rgl_tape_record_end();
  */
 RGL_API rgl_status_t rgl_tape_record_is_active(bool* is_active);
 
+/**
+ * Returns counters of the active recording session. Counters of the writer thread are zero for synchronous recording.
+ * @param out_stats address to store the counters
+ */
+RGL_API rgl_status_t rgl_tape_record_get_stats(rgl_tape_record_stats_t* out_stats);
+
 /**
  * Loads recorded API calls from files and exectues them.
  * Currently, Windows is not supported: throws RGL_TAPE_ERROR
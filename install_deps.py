@@ -18,6 +18,9 @@ class Config:
     GOOGLETEST_DIR = os.path.join("external", "googletest")
     GOOGLETEST_VERSION = "release-1.11.0"
 
+    GOOGLEBENCHMARK_DIR = os.path.join("external", "benchmark")
+    GOOGLEBENCHMARK_VERSION = "v1.8.3"
+
 
 def install_deps():
     cfg = Config()
@@ -44,6 +47,10 @@ def install_deps():
         run_subprocess_command(
             f"git clone -b {cfg.GOOGLETEST_VERSION} --single-branch --depth 1 https://github.com/google/googletest {cfg.GOOGLETEST_DIR}")
 
+    if not os.path.isdir(cfg.GOOGLEBENCHMARK_DIR):
+        run_subprocess_command(
+            f"git clone -b {cfg.GOOGLEBENCHMARK_VERSION} --single-branch --depth 1 https://github.com/google/benchmark {cfg.GOOGLEBENCHMARK_DIR}")
+
     print("RGL deps installed successfully")
 
 
@@ -55,6 +62,11 @@ def are_deps_installed() -> bool:
            and os.path.isdir(cfg.GOOGLETEST_DIR)
 
 
+def are_benchmark_deps_installed() -> bool:
+    cfg = Config()
+    return os.path.isdir(cfg.GOOGLEBENCHMARK_DIR)
+
+
 def run_subprocess_command(command: str, shell=True, stderr=sys.stderr, stdout=sys.stdout):
     print(f"Executing command: '{command}'")
     process = subprocess.Popen(command, shell=shell, stderr=stderr, stdout=stdout)
@@ -68,6 +68,8 @@ def main():
                             help="Add run-time search path(s) for RGL library. $ORIGIN (actual library path) is added by default.")
         parser.add_argument("--build-taped-test", action='store_true',
                             help="Build taped test (requires RGL blobs repo in runtime)")
+    parser.add_argument("--build-benchmarks", action='store_true',
+                        help="Build benchmarks (rglBenchmarks executable)")
     if on_windows():
         parser.add_argument("--ninja", type=str, default=f"-j{os.cpu_count()}", dest="build_args",
                             help="Pass arguments to ninja. Usage: --ninja=\"args...\". Defaults to \"-j <cpu count>\"")
@@ -114,6 +116,10 @@ def main():
         raise RuntimeError(
             "RGL requires dependencies to be installed: run this script with --install-deps flag")
 
+    if args.build_benchmarks and not core_deps.are_benchmark_deps_installed():
+        raise RuntimeError(
+            "Benchmarks require Google Benchmark to be installed: run this script with --install-deps flag")
+
     if args.with_pcl and not pcl_deps.are_deps_installed():
         raise RuntimeError(
             "PCL extension requires dependencies to be installed: run this script with --install-pcl-deps flag")
@@ -147,7 +153,8 @@ def main():
         f"-DRGL_BUILD_PCL_EXTENSION={'ON' if args.with_pcl else 'OFF'}",
         f"-DRGL_BUILD_ROS2_EXTENSION={'ON' if args.with_ros2 else 'OFF'}",
         f"-DRGL_BUILD_UDP_EXTENSION={'ON' if args.with_udp else 'OFF'}",
-        f"-DRGL_BUILD_WEATHER_EXTENSION={'ON' if args.with_weather else 'OFF'}"
+        f"-DRGL_BUILD_WEATHER_EXTENSION={'ON' if args.with_weather else 'OFF'}",
+        f"-DRGL_BUILD_BENCHMARKS={'ON' if args.build_benchmarks else 'OFF'}"
     ]
 
     if on_linux():
@@ -14,6 +14,10 @@
 
 #pragma once
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 template<typename Key, typename CacheType>
 struct CacheManager
 {
@@ -36,8 +36,7 @@ struct GPUFieldDescBuilder
 		hostBuffer->resize(fieldsData.size(), true, false);
 		fillSizeAndOffset(getFields(fieldsData));
 		fillPointers(fieldsData);
-		deviceBuffer->setStream(stream);
-		deviceBuffer->copyFrom(hostBuffer);
+		uploadIfChanged(stream);
 		return *deviceBuffer;
 	}
 
@@ -48,12 +47,27 @@ struct GPUFieldDescBuilder
 		hostBuffer->resize(fieldsData.size(), true, false);
 		fillSizeAndOffset(getFields(fieldsData));
 		fillPointers(fieldsData);
-		deviceBuffer->setStream(stream);
-		deviceBuffer->copyFrom(hostBuffer);
+		uploadIfChanged(stream);
 		return *deviceBuffer;
 	}
 
 private:
+	// Descriptors usually stay the same between frames (same fields, same arrays), so the upload can be skipped
+	void uploadIfChanged(CudaStream::Ptr stream)
+	{
+		const GPUFieldDesc* descs = hostBuffer->getReadPtr();
+		size_t count = hostBuffer->getCount();
+		bool isUploaded = stream == uploadedStream && uploadedDescs.size() == count &&
+		                  memcmp(uploadedDescs.data(), descs, count * sizeof(GPUFieldDesc)) == 0;
+		if (isUploaded) {
+			return;
+		}
+		deviceBuffer->setStream(stream);
+		deviceBuffer->copyFrom(hostBuffer);
+		uploadedDescs.assign(descs, descs + count);
+		uploadedStream = stream;
+	}
+
 	void fillSizeAndOffset(const std::vector<rgl_field_t>& fields)
 	{
 		std::size_t offset = 0;
@@ -99,4 +113,6 @@ private:
 private:
 	HostPinnedArray<GPUFieldDesc>::Ptr hostBuffer = HostPinnedArray<GPUFieldDesc>::create();
 	DeviceAsyncArray<GPUFieldDesc>::Ptr deviceBuffer = DeviceAsyncArray<GPUFieldDesc>::create(CudaStream::getNullStream());
+	std::vector<GPUFieldDesc> uploadedDescs;
+	CudaStream::Ptr uploadedStream;
 };
@@ -0,0 +1,87 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <HostFormat.hpp>
+#include <gpu/FormatLayout.hpp>
+
+void hostFormatSoaToAos(size_t pointCount, const std::vector<std::pair<rgl_field_t, const void*>>& soaInData,
+                        char* aosOutData)
+{
+	bool isFormatted = visitFormatLayout(soaInData, [&](auto layout) {
+		using Layout = decltype(layout);
+		if (!Layout::isAligned(aosOutData)) {
+			return false;
+		}
+		auto soaPointers = Layout::makeReadPointers(soaInData);
+		for (size_t i = 0; i < pointCount; ++i) {
+			Layout::soaToAos(i, soaPointers, aosOutData);
+		}
+		return true;
+	});
+	if (isFormatted) {
+		return;
+	}
+
+	size_t pointSize = 0;
+	for (auto&& [field, _] : soaInData) {
+		pointSize += getFieldSize(field);
+	}
+	size_t offset = 0;
+	for (auto&& [field, data] : soaInData) {
+		size_t fieldSize = getFieldSize(field);
+		if (data != nullptr) {
+			const char* src = static_cast<const char*>(data);
+			for (size_t i = 0; i < pointCount; ++i) {
+				memcpy(aosOutData + i * pointSize + offset, src + i * fieldSize, fieldSize);
+			}
+		}
+		offset += fieldSize;
+	}
+}
+
+void hostFormatAosToSoa(size_t pointCount, const char* aosInData,
+                        const std::vector<std::pair<rgl_field_t, void*>>& soaOutData)
+{
+	bool isFormatted = visitFormatLayout(soaOutData, [&](auto layout) {
+		using Layout = decltype(layout);
+		if (!Layout::isAligned(aosInData)) {
+			return false;
+		}
+		auto soaPointers = Layout::makeWritePointers(soaOutData);
+		for (size_t i = 0; i < pointCount; ++i) {
+			Layout::aosToSoa(i, aosInData, soaPointers);
+		}
+		return true;
+	});
+	if (isFormatted) {
+		return;
+	}
+
+	size_t pointSize = 0;
+	for (auto&& [field, _] : soaOutData) {
+		pointSize += getFieldSize(field);
+	}
+	size_t offset = 0;
+	for (auto&& [field, data] : soaOutData) {
+		size_t fieldSize = getFieldSize(field);
+		if (data != nullptr) {
+			char* dst = static_cast<char*>(data);
+			for (size_t i = 0; i < pointCount; ++i) {
+				memcpy(dst + i * fieldSize, aosInData + i * pointSize + offset, fieldSize);
+			}
+		}
+		offset += fieldSize;
+	}
+}
@@ -0,0 +1,33 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <vector>
+
+#include <rgl/api/core.h>
+
+/*
+ * Host counterparts of gpuFormatSoaToAos and gpuFormatAosToSoa, used when point data resides in host memory.
+ * Layouts listed in SpecializedFormatLayouts use the same compile-time layout code as GPU kernels,
+ * whose fixed-size copies and whole-point word stores are compiled to SIMD moves.
+ * Other layouts are copied field by field.
+ * Fields with nullptr data (paddings) are skipped.
+ */
+
+void hostFormatSoaToAos(size_t pointCount, const std::vector<std::pair<rgl_field_t, const void*>>& soaInData,
+                        char* aosOutData);
+void hostFormatAosToSoa(size_t pointCount, const char* aosInData,
+                        const std::vector<std::pair<rgl_field_t, void*>>& soaOutData);
@@ -0,0 +1,263 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <latch>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <HostKernels.hpp>
+#include <graph/GraphExecutor.hpp>
+
+static GraphExecutor& getHostWorkers()
+{
+	// Shared by all callers; the calling thread works as well, hence one worker less than hardware threads.
+	static GraphExecutor::Ptr workers = GraphExecutor::create(std::max(std::thread::hardware_concurrency(), 2U) - 1);
+	return *workers;
+}
+
+// Calls f with the field size as a compile-time constant for common sizes, so that per-point copies become plain moves.
+template<typename F>
+static void visitFieldSize(size_t fieldSize, F&& f)
+{
+	switch (fieldSize) {
+		case 1: f(std::integral_constant<size_t, 1>{}); return;
+		case 2: f(std::integral_constant<size_t, 2>{}); return;
+		case 4: f(std::integral_constant<size_t, 4>{}); return;
+		case 8: f(std::integral_constant<size_t, 8>{}); return;
+		case 12: f(std::integral_constant<size_t, 12>{}); return;
+		case 16: f(std::integral_constant<size_t, 16>{}); return;
+		default: f(fieldSize);
+	}
+}
+
+#if defined(__SSE2__)
+// Multiplies four lanes by the multiplier, returns low halves of 64-bit products, high halves are written to hi
+static inline __m128i mulHiLo4(__m128i a, uint32_t multiplier, __m128i& hi)
+{
+	const __m128i m = _mm_set1_epi32(static_cast<int>(multiplier));
+	const __m128i even = _mm_mul_epu32(a, m);                    // Lanes 0 and 2
+	const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m); // Lanes 1 and 3
+	constexpr int LOW_HALVES = _MM_SHUFFLE(0, 0, 2, 0);
+	constexpr int HIGH_HALVES = _MM_SHUFFLE(0, 0, 3, 1);
+	hi = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, HIGH_HALVES), _mm_shuffle_epi32(odd, HIGH_HALVES));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, LOW_HALVES), _mm_shuffle_epi32(odd, LOW_HALVES));
+}
+
+// Philox4x32::generate for four consecutive indices; each register holds one word of the counter of four indices.
+// Only the first two words are returned, since they are all that is needed by Philox4x32::normal.
+static inline void philox4x32Sse2(uint64_t seed, uint32_t frame, uint32_t firstIndex, uint32_t* outBits0, uint32_t* outBits1)
+{
+	__m128i c0 = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(firstIndex)), _mm_setr_epi32(0, 1, 2, 3));
+	__m128i c1 = _mm_set1_epi32(static_cast<int>(frame));
+	__m128i c2 = _mm_setzero_si128();
+	__m128i c3 = _mm_setzero_si128();
+	uint32_t key0 = static_cast<uint32_t>(seed);
+	uint32_t key1 = static_cast<uint32_t>(seed >> 32);
+	for (int round = 0; round < Philox4x32::ROUNDS; ++round) {
+		if (round > 0) {
+			key0 += Philox4x32::WEYL_0;
+			key1 += Philox4x32::WEYL_1;
+		}
+		__m128i hi0, hi1;
+		const __m128i lo0 = mulHiLo4(c0, Philox4x32::MULTIPLIER_0, hi0);
+		const __m128i lo1 = mulHiLo4(c2, Philox4x32::MULTIPLIER_1, hi1);
+		c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), _mm_set1_epi32(static_cast<int>(key0)));
+		c1 = lo1;
+		c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32(static_cast<int>(key1)));
+		c3 = lo0;
+	}
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(outBits0), c0);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(outBits1), c1);
+}
+#endif
+
+void hostParallelFor(size_t count, size_t chunkSize, const std::function<void(size_t begin, size_t end)>& job)
+{
+	const size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+	if (chunkCount <= 1) {
+		if (count > 0) {
+			job(0, count);
+		}
+		return;
+	}
+
+	std::atomic<size_t> nextChunk{0};
+	auto runChunks = [&]() {
+		for (size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++) {
+			job(chunk * chunkSize, std::min((chunk + 1) * chunkSize, count));
+		}
+	};
+	auto& workers = getHostWorkers();
+	const auto helperCount = static_cast<ptrdiff_t>(std::min(workers.getWorkerCount(), chunkCount - 1));
+	std::latch helpersDone{helperCount};
+	for (ptrdiff_t i = 0; i < helperCount; ++i) {
+		workers.submit([&]() {
+			runChunks();
+			helpersDone.count_down();
+		});
+	}
+	runChunks();
+	helpersDone.wait();
+}
+
+size_t hostFindCompaction(size_t pointCount, const int32_t* shouldCompact, CompactionIndexType* hitCountInclusive)
+{
+	// Two-pass scan: chunks are summed in parallel, then each chunk is scanned starting from the sum of preceding chunks.
+	const size_t chunkCount = (pointCount + HOST_KERNEL_CHUNK_SIZE - 1) / HOST_KERNEL_CHUNK_SIZE;
+	std::vector<CompactionIndexType> chunkOffsets(chunkCount + 1, 0);
+	hostParallelFor(pointCount, HOST_KERNEL_CHUNK_SIZE, [&](size_t begin, size_t end) {
+		CompactionIndexType sum = 0;
+		for (size_t i = begin; i < end; ++i) {
+			sum += shouldCompact[i];
+		}
+		chunkOffsets[begin / HOST_KERNEL_CHUNK_SIZE + 1] = sum;
+	});
+	std::inclusive_scan(chunkOffsets.begin(), chunkOffsets.end(), chunkOffsets.begin());
+	hostParallelFor(pointCount, HOST_KERNEL_CHUNK_SIZE, [&](size_t begin, size_t end) {
+		CompactionIndexType sum = chunkOffsets[begin / HOST_KERNEL_CHUNK_SIZE];
+		for (size_t i = begin; i < end; ++i) {
+			sum += shouldCompact[i];
+			hitCountInclusive[i] = sum;
+		}
+	});
+	return static_cast<size_t>(chunkOffsets.back());
+}
+
+void hostApplyCompaction(size_t pointCount, size_t fieldSize, const int32_t* shouldWrite, const CompactionIndexType* writeIndex,
+                         char* dst, const char* src)
+{
+	visitFieldSize(fieldSize, [&](auto size) {
+		hostParallelFor(pointCount, HOST_KERNEL_CHUNK_SIZE, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				if (shouldWrite[i]) {
+					memcpy(dst + size * (writeIndex[i] - 1), src + size * i, size);
+				}
+			}
+		});
+	});
+}
+
+void hostTransformRays(size_t rayCount, const Mat3x4f* inRays, Mat3x4f* outRays, Mat3x4f transform)
+{
+	hostParallelFor(rayCount, HOST_KERNEL_CHUNK_SIZE, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			outRays[i] = transform * inRays[i];
+		}
+	});
+}
+
+void hostTransformPoints(size_t pointCount, const Field<XYZ_VEC3_F32>::type* inPoints, Field<XYZ_VEC3_F32>::type* outPoints,
+                         Mat3x4f transform)
+{
+	hostParallelFor(pointCount, HOST_KERNEL_CHUNK_SIZE, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			outPoints[i] = transform * inPoints[i];
+		}
+	});
+}
+
+void hostFilter(size_t count, const Field<RAY_IDX_U32>::type* indices, char* dst, const char* src, size_t fieldSize)
+{
+	visitFieldSize(fieldSize, [&](auto size) {
+		hostParallelFor(count, HOST_KERNEL_CHUNK_SIZE, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				memcpy(dst + i * size, src + indices[i] * size, size);
+			}
+		});
+	});
+}
+
+void hostFilterGroundPoints(size_t pointCount, Vec3f sensorUpVector, float groundAngleThreshold,
+                            const Field<NORMAL_VEC3_F32>::type* inNormals, Field<IS_GROUND_I32>::type* outNonGround)
+{
+	hostParallelFor(pointCount, HOST_KERNEL_CHUNK_SIZE, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			// Same formula as kFilterGroundPoints, so that both paths classify points identically
+			const float normalUpAngle = acosf(fabsf(inNormals[i].dot(sensorUpVector)));
+			outNonGround[i] = normalUpAngle > groundAngleThreshold;
+		}
+	});
+}
+
+void hostGenerateNormals(uint64_t seed, uint32_t frame, size_t firstIndex, size_t count, float* outNormals)
+{
+	size_t i = 0;
+#if defined(__SSE2__)
+	constexpr size_t LANES = 4;
+	uint32_t bits0[LANES], bits1[LANES];
+	for (; i + LANES <= count; i += LANES) {
+		philox4x32Sse2(seed, frame, static_cast<uint32_t>(firstIndex + i), bits0, bits1);
+		for (size_t lane = 0; lane < LANES; ++lane) {
+			outNormals[i + lane] = Philox4x32::toNormal(bits0[lane], bits1[lane]);
+		}
+	}
+#endif
+	for (; i < count; ++i) {
+		outNormals[i] = Philox4x32::normal(seed, frame, static_cast<uint32_t>(firstIndex + i));
+	}
+}
+
+void hostAddGaussianNoiseAngularHitpoint(size_t pointCount, float mean, float stDev, rgl_axis_t rotationAxis,
+                                         Mat3x4f lookAtOriginTransform, uint64_t seed, uint32_t frame,
+                                         const Field<XYZ_VEC3_F32>::type* inPoints, Field<XYZ_VEC3_F32>::type* outPoints,
+                                         Field<DISTANCE_F32>::type* outDistances)
+{
+	const Mat3x4f lookAtOriginTransformInverse = lookAtOriginTransform.inverse();
+	hostParallelFor(pointCount, HOST_KERNEL_CHUNK_SIZE, [&](size_t begin, size_t end) {
+		std::vector<float> normals(end - begin);
+		hostGenerateNormals(seed, frame, begin, end - begin, normals.data());
+		for (size_t i = begin; i < end; ++i) {
+			// Same formula as kAddGaussianNoiseAngularHitpoint
+			float angularError = mean + normals[i - begin] * stDev;
+			Field<XYZ_VEC3_F32>::type originWithNoisePoint = Mat3x4f::rotationRad(rotationAxis, angularError) *
+			                                                 (lookAtOriginTransform * inPoints[i]);
+			if (outDistances != nullptr) {
+				outDistances[i] = originWithNoisePoint.length();
+			}
+			outPoints[i] = lookAtOriginTransformInverse * originWithNoisePoint;
+		}
+	});
+}
+
+void hostAddGaussianNoiseDistance(size_t pointCount, float mean, float stDevBase, float stDevRisePerMeter,
+                                  Mat3x4f lookAtOriginTransform, uint64_t seed, uint32_t frame,
+                                  const Field<XYZ_VEC3_F32>::type* inPoints, const Field<DISTANCE_F32>::type* inDistances,
+                                  Field<XYZ_VEC3_F32>::type* outPoints, Field<DISTANCE_F32>::type* outDistances)
+{
+	const Mat3x4f lookAtOriginTransformInverse = lookAtOriginTransform.inverse();
+	hostParallelFor(pointCount, HOST_KERNEL_CHUNK_SIZE, [&](size_t begin, size_t end) {
+		std::vector<float> normals(end - begin);
+		hostGenerateNormals(seed, frame, begin, end - begin, normals.data());
+		for (size_t i = begin; i < end; ++i) {
+			// Same formula as kAddGaussianNoiseDistance
+			float totalStDev = inDistances[i] * stDevRisePerMeter + stDevBase;
+			float distanceError = mean + normals[i - begin] * totalStDev;
+			Field<XYZ_VEC3_F32>::type pointInRayOriginTransform = lookAtOriginTransform * inPoints[i];
+			outPoints[i] = lookAtOriginTransformInverse *
+			               (pointInRayOriginTransform + pointInRayOriginTransform.normalized() * distanceError);
+			outDistances[i] = inDistances[i] + distanceError;
+		}
+	});
+}
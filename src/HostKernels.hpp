@@ -0,0 +1,63 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include <gpu/nodeKernels.hpp>
+#include <math/Philox.hpp>
+
+/*
+ * Host counterparts of kernels declared in gpu/nodeKernels.hpp, used by nodes when their input resides in host memory
+ * (e.g. produced by TemporalMergePointsNode), so that such point clouds are not copied to the device and back.
+ * Unlike gpu* functions, they are synchronous and expect all pointers to be host-accessible.
+ * Inputs larger than HOST_KERNEL_CHUNK_SIZE are processed in chunks by a pool of threads shared by the whole library.
+ */
+
+static constexpr size_t HOST_KERNEL_CHUNK_SIZE = 16 * 1024;
+
+/**
+ * Calls job(begin, end) for consecutive chunks of [0, count), in parallel.
+ * Chunks are handed out dynamically, the calling thread processes chunks as well.
+ * Returns once all chunks are done.
+ */
+void hostParallelFor(size_t count, size_t chunkSize, const std::function<void(size_t begin, size_t end)>& job);
+
+/** Returns the number of points to keep, i.e. the last value of the inclusive prefix sum. */
+size_t hostFindCompaction(size_t pointCount, const int32_t* shouldCompact, CompactionIndexType* hitCountInclusive);
+void hostApplyCompaction(size_t pointCount, size_t fieldSize, const int32_t* shouldWrite, const CompactionIndexType* writeIndex,
+                         char* dst, const char* src);
+void hostTransformRays(size_t rayCount, const Mat3x4f* inRays, Mat3x4f* outRays, Mat3x4f transform);
+void hostTransformPoints(size_t pointCount, const Field<XYZ_VEC3_F32>::type* inPoints, Field<XYZ_VEC3_F32>::type* outPoints,
+                         Mat3x4f transform);
+void hostFilter(size_t count, const Field<RAY_IDX_U32>::type* indices, char* dst, const char* src, size_t fieldSize);
+void hostFilterGroundPoints(size_t pointCount, Vec3f sensorUpVector, float groundAngleThreshold,
+                            const Field<NORMAL_VEC3_F32>::type* inNormals, Field<IS_GROUND_I32>::type* outNonGround);
+
+/**
+ * Writes Philox4x32::normal(seed, frame, firstIndex + i) for i in [0, count).
+ * Random bits are generated for four indices at once using SSE2, if available.
+ */
+void hostGenerateNormals(uint64_t seed, uint32_t frame, size_t firstIndex, size_t count, float* outNormals);
+void hostAddGaussianNoiseAngularHitpoint(size_t pointCount, float mean, float stDev, rgl_axis_t rotationAxis,
+                                         Mat3x4f lookAtOriginTransform, uint64_t seed, uint32_t frame,
+                                         const Field<XYZ_VEC3_F32>::type* inPoints, Field<XYZ_VEC3_F32>::type* outPoints,
+                                         Field<DISTANCE_F32>::type* outDistances);
+void hostAddGaussianNoiseDistance(size_t pointCount, float mean, float stDevBase, float stDevRisePerMeter,
+                                  Mat3x4f lookAtOriginTransform, uint64_t seed, uint32_t frame,
+                                  const Field<XYZ_VEC3_F32>::type* inPoints, const Field<DISTANCE_F32>::type* inDistances,
+                                  Field<XYZ_VEC3_F32>::type* outPoints, Field<DISTANCE_F32>::type* outDistances);
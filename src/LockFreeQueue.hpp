@@ -0,0 +1,106 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/**
+ * Bounded, lock-free, multi-producer multi-consumer queue (D. Vyukov's design).
+ * Each cell carries a sequence number which tells whether it is ready to be written or read in the current lap.
+ * Push and pop never block, they return false if the queue is respectively full or empty.
+ * Capacity must be a power of two.
+ */
+template<typename T, size_t Capacity>
+struct LockFreeQueue
+{
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "LockFreeQueue capacity must be a power of two");
+
+	LockFreeQueue()
+	{
+		for (size_t i = 0; i < Capacity; ++i) {
+			cells[i].sequence.store(i, std::memory_order::relaxed);
+		}
+	}
+
+	LockFreeQueue(const LockFreeQueue&) = delete;
+	LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+	bool tryPush(T&& value)
+	{
+		size_t pos = enqueuePos.load(std::memory_order::relaxed);
+		Cell* cell = nullptr;
+		while (true) {
+			cell = &cells[pos & mask];
+			size_t seq = cell->sequence.load(std::memory_order::acquire);
+			auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+			if (diff == 0) {
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order::relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				return false; // Full
+			} else {
+				pos = enqueuePos.load(std::memory_order::relaxed);
+			}
+		}
+		cell->value = std::move(value);
+		cell->sequence.store(pos + 1, std::memory_order::release);
+		return true;
+	}
+
+	bool tryPop(T& value)
+	{
+		size_t pos = dequeuePos.load(std::memory_order::relaxed);
+		Cell* cell = nullptr;
+		while (true) {
+			cell = &cells[pos & mask];
+			size_t seq = cell->sequence.load(std::memory_order::acquire);
+			auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+			if (diff == 0) {
+				if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order::relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				return false; // Empty
+			} else {
+				pos = dequeuePos.load(std::memory_order::relaxed);
+			}
+		}
+		value = std::move(cell->value);
+		cell->value = T{}; // Release resources held by the moved-from value
+		cell->sequence.store(pos + mask + 1, std::memory_order::release);
+		return true;
+	}
+
+	static constexpr size_t getCapacity() { return Capacity; }
+
+private:
+	static constexpr size_t mask = Capacity - 1;
+	static constexpr size_t cacheLineSize = 64;
+
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	std::array<Cell, Capacity> cells;
+	alignas(cacheLineSize) std::atomic<size_t> enqueuePos{0};
+	alignas(cacheLineSize) std::atomic<size_t> dequeuePos{0};
+};
@@ -195,10 +195,10 @@ void Optix::initializeStaticOptixStructures()
 	OptixPipelineCompileOptions pipelineCompileOptions = {
 	    .usesMotionBlur = false,
 	    .traversableGraphFlags = OPTIX_TRAVERSABLE_GRAPH_FLAG_ALLOW_ANY,
-	    .numPayloadValues = 3,   // Ray origin: X, Y, Z
+	    .numPayloadValues = 3,   // Beam sample index, request index, beam index
 	    .numAttributeValues = 2, // Triangle barycentrics: X, Y
 	    .exceptionFlags = OPTIX_EXCEPTION_FLAG_NONE,
-	    .pipelineLaunchParamsVariableName = "ctx",
+	    .pipelineLaunchParamsVariableName = "launchParams",
 	};
 
 	OptixPipelineLinkOptions pipelineLinkOptions = {
@@ -146,20 +146,10 @@ inline void handleDestructorException(std::exception_ptr e, const char* what)
 	// We may be in graph thread which should get gracefully killed:
 	// TODO: Implement this in a thread-safe manner (accessing GraphRunCtx::instances)
 	for (auto&& ctx : GraphRunCtx::instances) {
-		if (!ctx->maybeThread.has_value()) {
+		if (!ctx->isThisThreadGraphThread()) {
 			continue;
 		}
-		if (ctx->maybeThread.value().get_id() != std::this_thread::get_id()) {
-			continue;
-		}
-		// We're a graph thread. Mark remaining nodes as executed and set exception.
-		for (auto&& [node, state] : ctx->executionStatus) {
-			if (state.enqueued.load(std::memory_order::relaxed)) {
-				continue;
-			}
-			state.exceptionPtr = std::current_exception();
-			state.enqueued.store(true, std::memory_order::release);
-			throw e; // In Graph thread, rethrow to die.
-		}
+		// We're a graph thread. The branch job will mark remaining nodes as executed and set exception.
+		throw e; // In Graph thread, rethrow to abort the current job.
 	}
 }
\ No newline at end of file
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstring>
+#include <fstream>
+
 #include <rgl/api/core.h>
 #include <rgl/api/extensions/tape.h>
 
@@ -634,7 +637,8 @@ void TapeCore::tape_graph_get_result_size(const YAML::Node& yamlNode, PlaybackSt
 
 RGL_API rgl_status_t rgl_graph_get_result_data(rgl_node_t node, rgl_field_t field, void* dst)
 {
-	static auto buffer = HostPinnedArray<char>::create();
+	// Staging buffer for pageable destinations; per thread, so that concurrent callers do not share it.
+	thread_local auto buffer = HostPinnedArray<char>::create();
 	auto status = rglSafeCall([&]() {
 		RGL_API_LOG("rgl_graph_get_result_data(node={}, field={}, data={})", repr(node), field, (void*) dst);
 		CHECK_ARG(node != nullptr);
@@ -660,27 +664,33 @@ RGL_API rgl_status_t rgl_graph_get_result_data(rgl_node_t node, rgl_field_t fiel
 		// After that, all pending operations on the source DAA are done, and it is safe to use it in the copy stream.
 		pointCloudNode->waitForResults();
 
-		// Temporary optimization to yield better results in AWSIM:
-		// YieldNode (which has complementary part of this optimization) prefetches XYZ to host mem.
-		// If we are asked for XYZ from YieldNode, we can use its host cache and immediately memcpy it.
-		// TODO: This should work for any field in YieldNode (encountered test fails for other fields)
-		if (auto yieldNode = std::dynamic_pointer_cast<YieldPointsNode>(pointCloudNode)) {
-			if (field == XYZ_VEC3_F32) {
-				auto fieldArray = yieldNode->getXYZCache();
-				size_t size = fieldArray->getCount() * fieldArray->getSizeOf();
-				memcpy(dst, fieldArray->getRawReadPtr(), size);
-				return;
-			}
-		}
-
-		auto fieldArray = pointCloudNode->getFieldData(field);
-		buffer->resize(fieldArray->getCount() * fieldArray->getSizeOf(), false, false);
-		void* bufferDst = buffer->getWritePtr();
+		// YieldNode prefetches its fields to host memory in the graph stream,
+		// so they can be served with a plain memcpy below.
+		auto yieldNode = std::dynamic_pointer_cast<YieldPointsNode>(pointCloudNode);
+		auto fieldArray = yieldNode != nullptr && !isDummy(field) ? yieldNode->getHostFieldData(field)
+		                                                          : pointCloudNode->getFieldData(field);
 		const void* src = fieldArray->getRawReadPtr();
 		size_t size = fieldArray->getCount() * fieldArray->getSizeOf();
+		if (isHost(fieldArray->getMemoryKind())) {
+			memcpy(dst, src, size);
+			return;
+		}
+
+		// Page-locked destination (e.g. registered by the client) can be copied to directly, without staging.
+		cudaPointerAttributes dstAttributes{};
+		bool isDstPageLocked = cudaPointerGetAttributes(&dstAttributes, dst) == cudaSuccess &&
+		                       dstAttributes.type == cudaMemoryTypeHost;
+		cudaGetLastError(); // Clear non-sticky error, if dst is unknown to CUDA
+		void* bufferDst = dst;
+		if (!isDstPageLocked) {
+			buffer->resize(size, false, false);
+			bufferDst = buffer->getWritePtr();
+		}
 		CHECK_CUDA(cudaMemcpyAsync(bufferDst, src, size, cudaMemcpyDefault, CudaStream::getCopyStream()->getHandle()));
 		CHECK_CUDA(cudaStreamSynchronize(CudaStream::getCopyStream()->getHandle()));
-		memcpy(dst, bufferDst, size);
+		if (!isDstPageLocked) {
+			memcpy(dst, bufferDst, size);
+		}
 	});
 	TAPE_HOOK(node, field, dst);
 	return status;
@@ -697,6 +707,74 @@ void TapeCore::tape_graph_get_result_data(const YAML::Node& yamlNode, PlaybackSt
 	rgl_graph_get_result_data(node, field, tmpVec.data());
 }
 
+RGL_API rgl_status_t rgl_graph_set_result_buffer(rgl_node_t node, rgl_field_t field, void* buffer, int64_t buffer_size)
+{
+	auto status = rglSafeCall([&]() {
+		RGL_API_LOG("rgl_graph_set_result_buffer(node={}, field={}, buffer={}, buffer_size={})", repr(node), field, buffer,
+		            buffer_size);
+		CHECK_ARG(node != nullptr);
+		CHECK_ARG(buffer == nullptr || buffer_size > 0);
+
+		auto pointCloudNode = Node::validatePtr<IPointsNode>(node);
+		// Export of the previous run may be still pending.
+		if (pointCloudNode->hasGraphRunCtx()) {
+			pointCloudNode->getGraphRunCtx()->synchronize();
+		}
+		pointCloudNode->setResultBuffer(field, buffer != nullptr ? ResultBuffer::create(buffer, buffer_size) : nullptr);
+	});
+	TAPE_HOOK(node, field, buffer, buffer_size);
+	return status;
+}
+
+void TapeCore::tape_graph_set_result_buffer(const YAML::Node& yamlNode, PlaybackState& state)
+{
+	rgl_node_t node = state.nodes.at(yamlNode[0].as<TapeAPIObjectID>());
+	rgl_field_t field = (rgl_field_t) yamlNode[1].as<int>();
+	auto bufferSize = yamlNode[3].as<int64_t>();
+	void* buffer = nullptr;
+	if (yamlNode[2].as<uintptr_t>() != 0) {
+		buffer = state.resultBuffers.emplace_back(bufferSize).data();
+	}
+	rgl_graph_set_result_buffer(node, field, buffer, bufferSize);
+}
+
+RGL_API rgl_status_t rgl_graph_query_result_buffer(rgl_node_t node, rgl_field_t field, int32_t* out_ready, int32_t* out_count)
+{
+	auto status = rglSafeCall([&]() {
+		RGL_API_LOG("rgl_graph_query_result_buffer(node={}, field={}, out_ready={}, out_count={})", repr(node), field,
+		            (void*) out_ready, (void*) out_count);
+		CHECK_ARG(node != nullptr);
+		CHECK_ARG(out_ready != nullptr);
+
+		auto pointCloudNode = Node::validatePtr<IPointsNode>(node);
+		auto buffer = pointCloudNode->getResultBuffer(field);
+		if (buffer == nullptr) {
+			auto msg = fmt::format("no result buffer was set for field {} of node {}", toString(field),
+			                       pointCloudNode->getName());
+			throw InvalidAPIArgument(msg);
+		}
+
+		std::optional<std::size_t> exportedCount = std::nullopt;
+		if (pointCloudNode->hasGraphRunCtx() && pointCloudNode->getGraphRunCtx()->isNodeEnqueued(pointCloudNode)) {
+			exportedCount = buffer->query(pointCloudNode->getGraphRunCtx()->getRunIndex());
+		}
+		*out_ready = exportedCount.has_value();
+		if (out_count != nullptr && exportedCount.has_value()) {
+			*out_count = static_cast<int32_t>(*exportedCount);
+		}
+	});
+	TAPE_HOOK(node, field, out_ready, out_count);
+	return status;
+}
+
+void TapeCore::tape_graph_query_result_buffer(const YAML::Node& yamlNode, PlaybackState& state)
+{
+	rgl_node_t node = state.nodes.at(yamlNode[0].as<TapeAPIObjectID>());
+	rgl_field_t field = (rgl_field_t) yamlNode[1].as<int>();
+	int32_t out_ready, out_count;
+	rgl_graph_query_result_buffer(node, field, &out_ready, &out_count);
+}
+
 RGL_API rgl_status_t rgl_graph_node_add_child(rgl_node_t parent, rgl_node_t child)
 {
 	auto status = rglSafeCall([&]() {
@@ -788,6 +866,205 @@ void TapeCore::tape_graph_node_get_priority(const YAML::Node& yamlNode, Playback
 	}
 }
 
+RGL_API rgl_status_t rgl_graph_set_concurrent_branches(rgl_node_t node, bool enabled)
+{
+	auto status = rglSafeCall([&]() {
+		RGL_API_LOG("rgl_graph_set_concurrent_branches(node={}, enabled={})", repr(node), enabled);
+		CHECK_ARG(node != nullptr);
+
+		Node::Ptr nodeShared = Node::validatePtr(node);
+		if (nodeShared->hasGraphRunCtx()) {
+			nodeShared->getGraphRunCtx()->synchronize();
+		}
+		for (auto&& graphNode : nodeShared->getConnectedComponentNodes()) {
+			graphNode->setConcurrentBranches(enabled);
+		}
+	});
+	TAPE_HOOK(node, enabled);
+	return status;
+}
+
+void TapeCore::tape_graph_set_concurrent_branches(const YAML::Node& yamlNode, PlaybackState& state)
+{
+	auto nodeId = yamlNode[0].as<TapeAPIObjectID>();
+	rgl_node_t node = state.nodes.at(nodeId);
+	rgl_graph_set_concurrent_branches(node, yamlNode[1].as<bool>());
+}
+
+RGL_API rgl_status_t rgl_graph_set_wait_strategy(rgl_node_t node, int32_t spin_count, int32_t yield_count)
+{
+	auto status = rglSafeCall([&]() {
+		RGL_API_LOG("rgl_graph_set_wait_strategy(node={}, spin_count={}, yield_count={})", repr(node), spin_count,
+		            yield_count);
+		CHECK_ARG(node != nullptr);
+		CHECK_ARG(spin_count >= 0);
+		CHECK_ARG(yield_count >= 0);
+
+		Node::Ptr nodeShared = Node::validatePtr(node);
+		if (nodeShared->hasGraphRunCtx()) {
+			nodeShared->getGraphRunCtx()->synchronize();
+		}
+		WaitStrategy strategy{static_cast<uint32_t>(spin_count), static_cast<uint32_t>(yield_count)};
+		for (auto&& graphNode : nodeShared->getConnectedComponentNodes()) {
+			graphNode->setWaitStrategy(strategy);
+		}
+	});
+	TAPE_HOOK(node, spin_count, yield_count);
+	return status;
+}
+
+void TapeCore::tape_graph_set_wait_strategy(const YAML::Node& yamlNode, PlaybackState& state)
+{
+	auto nodeId = yamlNode[0].as<TapeAPIObjectID>();
+	rgl_node_t node = state.nodes.at(nodeId);
+	rgl_graph_set_wait_strategy(node, yamlNode[1].as<int32_t>(), yamlNode[2].as<int32_t>());
+}
+
+RGL_API rgl_status_t rgl_graph_get_latency(rgl_node_t node, rgl_graph_latency_t* out_latency)
+{
+	auto status = rglSafeCall([&]() {
+		RGL_API_LOG("rgl_graph_get_latency(node={}, latency={})", repr(node), (void*) out_latency);
+		CHECK_ARG(node != nullptr);
+		CHECK_ARG(out_latency != nullptr);
+
+		Node::Ptr nodeShared = Node::validatePtr(node);
+		*out_latency = {};
+		if (!nodeShared->hasGraphRunCtx()) {
+			return; // Never run since the last change of the graph structure.
+		}
+		// No need to synchronize, counters are updated by the client's thread.
+		const auto& stats = nodeShared->getGraphRunCtx()->getLatencyStats();
+		out_latency->run_count = static_cast<int32_t>(stats.runMicroseconds.getSamplesCount());
+		out_latency->run_mean_us = static_cast<float>(stats.runMicroseconds.getMean());
+		out_latency->run_max_us = static_cast<float>(stats.runMaxMicroseconds);
+		out_latency->wakeup_count = static_cast<int32_t>(stats.wakeupMicroseconds.getSamplesCount());
+		out_latency->wakeup_mean_us = static_cast<float>(stats.wakeupMicroseconds.getMean());
+		out_latency->wakeup_max_us = static_cast<float>(stats.wakeupMaxMicroseconds);
+	});
+	TAPE_HOOK(node);
+	return status;
+}
+
+void TapeCore::tape_graph_get_latency(const YAML::Node& yamlNode, PlaybackState& state)
+{
+	// Latency depends on the machine, so it is not compared with the recorded one.
+	rgl_graph_latency_t latency;
+	rgl_graph_get_latency(state.nodes.at(yamlNode[0].as<TapeAPIObjectID>()), &latency);
+}
+
+RGL_API rgl_status_t rgl_graph_set_profiling(rgl_node_t node, bool enabled)
+{
+	auto status = rglSafeCall([&]() {
+		RGL_API_LOG("rgl_graph_set_profiling(node={}, enabled={})", repr(node), enabled);
+		CHECK_ARG(node != nullptr);
+
+		Node::Ptr nodeShared = Node::validatePtr(node);
+		if (nodeShared->hasGraphRunCtx()) {
+			nodeShared->getGraphRunCtx()->synchronize();
+		}
+		for (auto&& graphNode : nodeShared->getConnectedComponentNodes()) {
+			graphNode->setProfilingEnabled(enabled);
+		}
+	});
+	TAPE_HOOK(node, enabled);
+	return status;
+}
+
+void TapeCore::tape_graph_set_profiling(const YAML::Node& yamlNode, PlaybackState& state)
+{
+	auto nodeId = yamlNode[0].as<TapeAPIObjectID>();
+	rgl_node_t node = state.nodes.at(nodeId);
+	rgl_graph_set_profiling(node, yamlNode[1].as<bool>());
+}
+
+RGL_API rgl_status_t rgl_graph_get_node_stats(rgl_node_t node, rgl_node_stats_t* out_stats)
+{
+	auto status = rglSafeCall([&]() {
+		RGL_API_LOG("rgl_graph_get_node_stats(node={}, stats={})", repr(node), (void*) out_stats);
+		CHECK_ARG(node != nullptr);
+		CHECK_ARG(out_stats != nullptr);
+
+		Node::Ptr nodeShared = Node::validatePtr(node);
+		if (nodeShared->hasGraphRunCtx()) {
+			nodeShared->getGraphRunCtx()->synchronize(); // Profilers are updated when the run is synchronized.
+		}
+		*out_stats = {};
+		auto profiler = nodeShared->getProfiler();
+		if (profiler == nullptr) {
+			return;
+		}
+		const auto& stats = profiler->getStats();
+		out_stats->run_count = static_cast<int32_t>(stats.cpuMicroseconds.getSamplesCount());
+		out_stats->cpu_time_mean_us = static_cast<float>(stats.cpuMicroseconds.getMean());
+		out_stats->cpu_time_std_dev_us = static_cast<float>(stats.cpuMicroseconds.getStdDev());
+		out_stats->cpu_time_last_us = static_cast<float>(stats.cpuMicroseconds.getLastSample());
+		out_stats->gpu_run_count = static_cast<int32_t>(stats.gpuMicroseconds.getSamplesCount());
+		out_stats->gpu_time_mean_us = static_cast<float>(stats.gpuMicroseconds.getMean());
+		out_stats->gpu_time_std_dev_us = static_cast<float>(stats.gpuMicroseconds.getStdDev());
+		out_stats->gpu_time_last_us = static_cast<float>(stats.gpuMicroseconds.getLastSample());
+		out_stats->allocated_bytes_total = static_cast<int64_t>(stats.allocatedBytesTotal);
+		out_stats->allocated_bytes_last = static_cast<int64_t>(stats.allocatedBytesLast);
+		out_stats->points_in_mean = static_cast<float>(stats.pointsIn.getMean());
+		out_stats->points_in_last = static_cast<int32_t>(stats.pointsIn.getLastSample());
+		out_stats->points_out_mean = static_cast<float>(stats.pointsOut.getMean());
+		out_stats->points_out_last = static_cast<int32_t>(stats.pointsOut.getLastSample());
+	});
+	TAPE_HOOK(node);
+	return status;
+}
+
+void TapeCore::tape_graph_get_node_stats(const YAML::Node& yamlNode, PlaybackState& state)
+{
+	// Statistics depend on the machine, so they are not compared with the recorded ones.
+	rgl_node_stats_t stats;
+	rgl_graph_get_node_stats(state.nodes.at(yamlNode[0].as<TapeAPIObjectID>()), &stats);
+}
+
+RGL_API rgl_status_t rgl_graph_write_profile(rgl_node_t node, const char* file_path, rgl_profile_format_t format)
+{
+	auto status = rglSafeCall([&]() {
+		RGL_API_LOG("rgl_graph_write_profile(node={}, file={}, format={})", repr(node), file_path, format);
+		CHECK_ARG(node != nullptr);
+		CHECK_ARG(file_path != nullptr);
+		CHECK_ARG(file_path[0] != '\0');
+		CHECK_ARG(format == RGL_PROFILE_FORMAT_JSON || format == RGL_PROFILE_FORMAT_CHROME_TRACE);
+
+		Node::Ptr nodeShared = Node::validatePtr(node);
+		if (nodeShared->hasGraphRunCtx()) {
+			nodeShared->getGraphRunCtx()->synchronize(); // Profilers are updated when the run is synchronized.
+		}
+		std::vector<NodeProfiler::Entry> entries;
+		for (auto&& graphNode : nodeShared->getConnectedComponentNodes()) {
+			if (auto profiler = graphNode->getProfiler()) {
+				entries.push_back({graphNode->getName(), graphNode.get(), profiler});
+			}
+		}
+
+		std::ofstream file(file_path);
+		if (file.fail()) {
+			throw InvalidFilePath(fmt::format("could not open profile file '{}': {}", file_path, std::strerror(errno)));
+		}
+		if (format == RGL_PROFILE_FORMAT_JSON) {
+			NodeProfiler::writeJson(file, entries);
+		}
+		else {
+			NodeProfiler::writeChromeTrace(file, entries);
+		}
+		file.close();
+		if (file.fail()) {
+			throw InvalidFilePath(fmt::format("failed to write profile file '{}'", file_path));
+		}
+	});
+	TAPE_HOOK(node, file_path, format);
+	return status;
+}
+
+void TapeCore::tape_graph_write_profile(const YAML::Node& yamlNode, PlaybackState& state)
+{
+	rgl_graph_write_profile(state.nodes.at(yamlNode[0].as<TapeAPIObjectID>()), yamlNode[1].as<std::string>().c_str(),
+	                        static_cast<rgl_profile_format_t>(yamlNode[2].as<int32_t>()));
+}
+
 RGL_API rgl_status_t rgl_node_rays_from_mat3x4f(rgl_node_t* node, const rgl_mat3x4f* rays, int32_t ray_count)
 {
 	auto status = rglSafeCall([&]() {
@@ -1087,6 +1364,51 @@ void TapeCore::tape_node_raytrace_configure_return_mode(const YAML::Node& yamlNo
 	rgl_node_raytrace_configure_return_mode(node, returnMode);
 }
 
+RGL_API rgl_status_t rgl_node_raytrace_configure_batch(rgl_node_t node, int32_t batch_id)
+{
+	auto status = rglSafeCall([&]() {
+		RGL_API_LOG("rgl_node_raytrace_configure_batch(node={}, batch_id={})", repr(node), batch_id);
+		CHECK_ARG(node != nullptr);
+		RaytraceNode::Ptr raytraceNode = Node::validatePtr<RaytraceNode>(node);
+		if (raytraceNode->hasGraphRunCtx()) {
+			raytraceNode->getGraphRunCtx()->synchronize();
+		}
+		raytraceNode->setBatch(batch_id);
+	});
+	TAPE_HOOK(node, batch_id);
+	return status;
+}
+
+void TapeCore::tape_node_raytrace_configure_batch(const YAML::Node& yamlNode, PlaybackState& state)
+{
+	auto nodeId = yamlNode[0].as<TapeAPIObjectID>();
+	rgl_node_t node = state.nodes.contains(nodeId) ? state.nodes.at(nodeId) : nullptr;
+	rgl_node_raytrace_configure_batch(node, yamlNode[1].as<int32_t>());
+}
+
+RGL_API rgl_status_t rgl_node_raytrace_configure_backend(rgl_node_t node, rgl_raytrace_backend_t backend)
+{
+	auto status = rglSafeCall([&]() {
+		RGL_API_LOG("rgl_node_raytrace_configure_backend(node={}, backend={})", repr(node), backend);
+		CHECK_ARG(node != nullptr);
+		CHECK_ARG(backend >= 0 && backend < RGL_RAYTRACE_BACKEND_COUNT);
+		RaytraceNode::Ptr raytraceNode = Node::validatePtr<RaytraceNode>(node);
+		if (raytraceNode->hasGraphRunCtx()) {
+			raytraceNode->getGraphRunCtx()->synchronize();
+		}
+		raytraceNode->setBackend(backend);
+	});
+	TAPE_HOOK(node, backend);
+	return status;
+}
+
+void TapeCore::tape_node_raytrace_configure_backend(const YAML::Node& yamlNode, PlaybackState& state)
+{
+	auto nodeId = yamlNode[0].as<TapeAPIObjectID>();
+	rgl_node_t node = state.nodes.contains(nodeId) ? state.nodes.at(nodeId) : nullptr;
+	rgl_node_raytrace_configure_backend(node, static_cast<rgl_raytrace_backend_t>(yamlNode[1].as<int32_t>()));
+}
+
 RGL_API rgl_status_t rgl_node_points_format(rgl_node_t* node, const rgl_field_t* fields, int32_t field_count)
 {
 	auto status = rglSafeCall([&]() {
@@ -1197,6 +1519,29 @@ void TapeCore::tape_node_points_temporal_merge(const YAML::Node& yamlNode, Playb
 	state.nodes.insert({nodeId, node});
 }
 
+RGL_API rgl_status_t rgl_node_points_temporal_merge_configure_window(rgl_node_t node, int32_t max_frame_count,
+                                                                     float max_duration)
+{
+	auto status = rglSafeCall([&]() {
+		RGL_API_LOG("rgl_node_points_temporal_merge_configure_window(node={}, max_frame_count={}, max_duration={})", repr(node),
+		            max_frame_count, max_duration);
+		CHECK_ARG(node != nullptr);
+		CHECK_ARG(max_frame_count >= 0);
+		CHECK_ARG(max_duration >= 0.0f);
+		TemporalMergePointsNode::Ptr temporalMergeNode = Node::validatePtr<TemporalMergePointsNode>(node);
+		temporalMergeNode->setWindow(max_frame_count, max_duration);
+	});
+	TAPE_HOOK(node, max_frame_count, max_duration);
+	return status;
+}
+
+void TapeCore::tape_node_points_temporal_merge_configure_window(const YAML::Node& yamlNode, PlaybackState& state)
+{
+	auto nodeId = yamlNode[0].as<TapeAPIObjectID>();
+	rgl_node_t node = state.nodes.at(nodeId);
+	rgl_node_points_temporal_merge_configure_window(node, yamlNode[1].as<int32_t>(), yamlNode[2].as<float>());
+}
+
 RGL_API rgl_status_t rgl_node_points_from_array(rgl_node_t* node, const void* points, int32_t points_count,
                                                 const rgl_field_t* fields, int32_t field_count)
 {
@@ -1478,6 +1823,32 @@ RGL_API rgl_status_t rgl_tape_record_begin(const char* path)
 #endif //_WIN32
 }
 
+RGL_API rgl_status_t rgl_tape_record_begin_async(const char* path, size_t max_buffer_size,
+                                                 rgl_tape_overflow_policy_t overflow_policy)
+{
+#ifdef _WIN32
+	return rglSafeCall([&]() {
+		RGL_API_LOG("rgl_tape_record_begin_async(path={}, max_buffer_size={}, overflow_policy={})", path, max_buffer_size,
+		            overflow_policy);
+		throw RecordError("rgl_tape_record_begin_async() is not supported on Windows");
+	});
+#else
+	return rglSafeCall([&]() {
+		RGL_API_LOG("rgl_tape_record_begin_async(path={}, max_buffer_size={}, overflow_policy={})", path, max_buffer_size,
+		            overflow_policy);
+		CHECK_ARG(path != nullptr);
+		CHECK_ARG(path[0] != '\0');
+		CHECK_ARG(max_buffer_size > 0);
+		CHECK_ARG(overflow_policy == RGL_TAPE_OVERFLOW_BLOCK || overflow_policy == RGL_TAPE_OVERFLOW_DROP);
+		if (tapeRecorder.has_value()) {
+			throw RecordError("rgl_tape_record_begin_async: recording already active");
+		} else {
+			tapeRecorder.emplace(path, max_buffer_size, overflow_policy);
+		}
+	});
+#endif //_WIN32
+}
+
 RGL_API rgl_status_t rgl_tape_record_end()
 {
 #ifdef _WIN32
@@ -1491,6 +1862,11 @@ RGL_API rgl_status_t rgl_tape_record_end()
 		if (!tapeRecorder.has_value()) {
 			throw RecordError("rgl_tape_record_end: no recording active");
 		} else {
+			auto stats = tapeRecorder->getStats();
+			const uint64_t writtenBinBytes = stats.bin_data_bytes - stats.deduplicated_bin_bytes;
+			RGL_INFO("rgl_tape_record_end: recorded {} calls, binary data deduplicated from {} to {} bytes (ratio {:.2f})",
+			         stats.recorded_call_count, stats.bin_data_bytes, writtenBinBytes,
+			         writtenBinBytes > 0 ? static_cast<double>(stats.bin_data_bytes) / writtenBinBytes : 1.0);
 			tapeRecorder.reset();
 		}
 	});
@@ -1506,6 +1882,18 @@ RGL_API rgl_status_t rgl_tape_record_is_active(bool* is_active)
 	});
 }
 
+RGL_API rgl_status_t rgl_tape_record_get_stats(rgl_tape_record_stats_t* out_stats)
+{
+	return rglSafeCall([&]() {
+		RGL_API_LOG("rgl_tape_record_get_stats(out_stats={})", (void*) out_stats);
+		CHECK_ARG(out_stats != nullptr);
+		if (!tapeRecorder.has_value()) {
+			throw RecordError("rgl_tape_record_get_stats: no recording active");
+		}
+		*out_stats = tapeRecorder->getStats();
+	});
+}
+
 RGL_API rgl_status_t rgl_tape_play(const char* path)
 {
 #ifdef _WIN32
@@ -0,0 +1,277 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include <macros/cuda.hpp>
+#include <gpu/RaytraceRequestContext.hpp>
+#include <gpu/ShaderBindingTableTypes.h>
+#include <returnModeUtils.h>
+
+/*
+ * Writing of beam returns to the output fields of RaytraceRequestContext.
+ * Used by kReduceDivergentBeams (values taken from multi-return samples),
+ * by optix programs, which write returns directly when beam is not sampled (single-return fast path),
+ * and by the host traversal backend, which must produce the same outputs as optix programs.
+ */
+
+struct BeamSample
+{
+	float distance;
+	float intensity;
+	float laserRetro;
+	int entityId;
+	Vec3f absVelocity;
+	Vec3f relVelocity;
+	float radialSpeed;
+	Vec3f normal;
+	float incidentAngle;
+};
+
+inline DevFn BeamSample loadBeamSample(const RaytraceRequestContext* ctx, int sampleIdx)
+{
+	const MultiReturnSamplesPointers& mr = ctx->mrSamples;
+	BeamSample sample{};
+	sample.distance = mr.distance[sampleIdx];
+	sample.intensity = mr.intensity[sampleIdx];
+	sample.laserRetro = mr.laserRetro != nullptr ? mr.laserRetro[sampleIdx] : 0;
+	sample.entityId = mr.entityId != nullptr ? mr.entityId[sampleIdx] : RGL_ENTITY_INVALID_ID;
+	sample.absVelocity = mr.absVelocity != nullptr ? mr.absVelocity[sampleIdx] : Vec3f{NAN};
+	sample.relVelocity = mr.relVelocity != nullptr ? mr.relVelocity[sampleIdx] : Vec3f{NAN};
+	sample.radialSpeed = mr.radialSpeed != nullptr ? mr.radialSpeed[sampleIdx] : NAN;
+	sample.normal = mr.normal != nullptr ? mr.normal[sampleIdx] : Vec3f{NAN};
+	sample.incidentAngle = mr.incidentAngle != nullptr ? mr.incidentAngle[sampleIdx] : NAN;
+	return sample;
+}
+
+inline HostDevFn void saveReturnAsHit(const RaytraceRequestContext* ctx, int beamIdx, const BeamSample& sample,
+                                      int returnPointIdx, rgl_return_type_t returnType)
+{
+	if (ctx->xyz != nullptr) {
+		const Mat3x4f ray = ctx->raysWorld[beamIdx];
+		const Vec3f origin = ray * Vec3f{0, 0, 0};
+		const Vec3f dir = (ray * Vec3f{0, 0, 1} - origin).normalized();
+		ctx->xyz[returnPointIdx] = origin + dir * sample.distance;
+	}
+	if (ctx->isHit != nullptr) {
+		ctx->isHit[returnPointIdx] = true;
+	}
+	if (ctx->returnType != nullptr) {
+		ctx->returnType[returnPointIdx] = returnType;
+	}
+	if (ctx->distance != nullptr) {
+		ctx->distance[returnPointIdx] = sample.distance;
+	}
+	if (ctx->intensityF32 != nullptr) {
+		ctx->intensityF32[returnPointIdx] = sample.intensity;
+	}
+	if (ctx->intensityU8 != nullptr) {
+		// intensity < 0 not possible
+		ctx->intensityU8[returnPointIdx] = sample.intensity < UINT8_MAX ? static_cast<uint8_t>(std::round(sample.intensity)) :
+		                                                                  UINT8_MAX;
+	}
+	if (ctx->entityId != nullptr) {
+		ctx->entityId[returnPointIdx] = sample.entityId;
+	}
+	if (ctx->pointAbsVelocity != nullptr) {
+		ctx->pointAbsVelocity[returnPointIdx] = sample.absVelocity;
+	}
+	if (ctx->pointRelVelocity != nullptr) {
+		ctx->pointRelVelocity[returnPointIdx] = sample.relVelocity;
+	}
+	if (ctx->radialSpeed != nullptr) {
+		ctx->radialSpeed[returnPointIdx] = sample.radialSpeed;
+	}
+	if (ctx->normal != nullptr) {
+		ctx->normal[returnPointIdx] = sample.normal;
+	}
+	if (ctx->incidentAngle != nullptr) {
+		ctx->incidentAngle[returnPointIdx] = sample.incidentAngle;
+	}
+	if (ctx->laserRetro != nullptr) {
+		ctx->laserRetro[returnPointIdx] = sample.laserRetro;
+	}
+}
+
+inline HostDevFn void saveReturnAsNonHit(const RaytraceRequestContext* ctx, int beamIdx, float nonHitDistance,
+                                         int returnPointIdx, rgl_return_type_t returnType)
+{
+	if (ctx->xyz != nullptr) {
+		const Mat3x4f ray = ctx->raysWorld[beamIdx];
+		const Vec3f origin = ray * Vec3f{0, 0, 0};
+		const Vec3f dir = ray * Vec3f{0, 0, 1} - origin;
+		Vec3f displacement = dir.normalized() * nonHitDistance;
+		displacement = {std::isnan(displacement.x()) ? 0 : displacement.x(),
+		                std::isnan(displacement.y()) ? 0 : displacement.y(),
+		                std::isnan(displacement.z()) ? 0 : displacement.z()};
+		ctx->xyz[returnPointIdx] = origin + displacement;
+	}
+	if (ctx->isHit != nullptr) {
+		ctx->isHit[returnPointIdx] = false;
+	}
+	if (ctx->returnType != nullptr) {
+		ctx->returnType[returnPointIdx] = returnType;
+	}
+	if (ctx->distance != nullptr) {
+		ctx->distance[returnPointIdx] = nonHitDistance;
+	}
+	if (ctx->intensityF32 != nullptr) {
+		ctx->intensityF32[returnPointIdx] = 0;
+	}
+	if (ctx->intensityU8 != nullptr) {
+		ctx->intensityU8[returnPointIdx] = 0;
+	}
+	if (ctx->entityId != nullptr) {
+		ctx->entityId[returnPointIdx] = RGL_ENTITY_INVALID_ID;
+	}
+	if (ctx->pointAbsVelocity != nullptr) {
+		ctx->pointAbsVelocity[returnPointIdx] = Vec3f{NAN};
+	}
+	if (ctx->pointRelVelocity != nullptr) {
+		ctx->pointRelVelocity[returnPointIdx] = Vec3f{NAN};
+	}
+	if (ctx->radialSpeed != nullptr) {
+		ctx->radialSpeed[returnPointIdx] = 0;
+	}
+	if (ctx->normal != nullptr) {
+		ctx->normal[returnPointIdx] = Vec3f{NAN};
+	}
+	if (ctx->incidentAngle != nullptr) {
+		ctx->incidentAngle[returnPointIdx] = NAN;
+	}
+	if (ctx->laserRetro != nullptr) {
+		ctx->laserRetro[returnPointIdx] = 0;
+	}
+}
+
+// Without beam sampling, all returns of the beam come from the primary ray (first == last == strongest, etc.)
+inline HostDevFn void saveBeamReturnsAsHit(const RaytraceRequestContext& ctx, int beamIdx, const BeamSample& sample)
+{
+	for (int returnIdx = 0; returnIdx < ctx.returnCount; ++returnIdx) {
+		saveReturnAsHit(&ctx, beamIdx, sample, beamIdx * ctx.returnCount + returnIdx, getReturnType(ctx.returnMode, returnIdx));
+	}
+}
+
+inline HostDevFn void saveBeamReturnsAsNonHit(const RaytraceRequestContext& ctx, int beamIdx, float nonHitDistance)
+{
+	for (int returnIdx = 0; returnIdx < ctx.returnCount; ++returnIdx) {
+		saveReturnAsNonHit(&ctx, beamIdx, nonHitDistance, beamIdx * ctx.returnCount + returnIdx,
+		                   getReturnType(ctx.returnMode, returnIdx));
+	}
+}
+
+inline HostDevFn void saveBeamSharedData(const RaytraceRequestContext& ctx, int beamIdx, const Mat3x4f& rayLocal)
+{
+	for (int returnPointIdx = beamIdx * ctx.returnCount; returnPointIdx < (beamIdx + 1) * ctx.returnCount; ++returnPointIdx) {
+		if (ctx.rayIdx != nullptr) {
+			ctx.rayIdx[returnPointIdx] = beamIdx;
+		}
+
+		// Assuming up vector is Y, forward vector is Z (true for Unity).
+		// TODO(msz-rai): allow to define up and forward vectors in RGL
+		// Assuming rays are generated in left-handed coordinate system with the rotation applied in ZXY order.
+		// TODO(msz-rai): move ray generation to RGL to unify rotations
+		if (ctx.azimuth != nullptr) {
+			ctx.azimuth[returnPointIdx] = rayLocal.toRotationYOrderZXYLeftHandRad();
+		}
+		if (ctx.elevation != nullptr) {
+			ctx.elevation[returnPointIdx] = rayLocal.toRotationXOrderZXYLeftHandRad();
+		}
+
+		if (ctx.timestampF64 != nullptr) {
+			ctx.timestampF64[returnPointIdx] = ctx.doApplyDistortion ? ctx.rayTimeOffsetsMs[beamIdx] * 1e-3f : 0; // in seconds
+		}
+		if (ctx.timestampU32 != nullptr) {
+			ctx.timestampU32[returnPointIdx] = ctx.doApplyDistortion ?
+			                                       static_cast<uint32_t>(ctx.rayTimeOffsetsMs[beamIdx] * 1e6f) // in nanoseconds
+			                                       :
+			                                       0;
+		}
+		if (ctx.ringIdx != nullptr && ctx.ringIds != nullptr) {
+			ctx.ringIdx[returnPointIdx] = ctx.ringIds[beamIdx % ctx.ringIdsCount];
+		}
+	}
+}
+
+/**
+ * Computes the sample of a ray that hit the given triangle of the entity at barycentrics (u, v).
+ * Intensity (default or sampled from the entity's texture) is attenuated here according to the incident angle.
+ */
+inline HostDevFn BeamSample makeHitBeamSample(const RaytraceRequestContext& ctx, const EntitySBTData& entityData, int entityId,
+                                              const Mat3x4f& objectToWorld, const Vec3i& triangleIndices, float u, float v,
+                                              const Vec3f& hitObject, const Vec3f& hitWorld, float distance,
+                                              const Vec3f& rayDir, float intensity)
+{
+	// Normal vector
+	const Vec3f wA = objectToWorld * entityData.vertex[triangleIndices.x()];
+	const Vec3f wB = objectToWorld * entityData.vertex[triangleIndices.y()];
+	const Vec3f wC = objectToWorld * entityData.vertex[triangleIndices.z()];
+	const Vec3f wAB = wB - wA;
+	const Vec3f wCA = wC - wA;
+	const Vec3f wNormal = wAB.cross(wCA).normalized();
+
+	// Incident angle
+	const float cosIncidentAngle = fabsf(wNormal.dot(rayDir));
+	const float incidentAngle = acosf(cosIncidentAngle);
+	intensity *= cosIncidentAngle;
+
+	Vec3f absPointVelocity{NAN};
+	Vec3f relPointVelocity{NAN};
+	float radialSpeed{NAN};
+	bool isVelocityRequested = ctx.pointAbsVelocity != nullptr || ctx.pointRelVelocity != nullptr || ctx.radialSpeed != nullptr;
+	if (ctx.sceneDeltaTime > 0 && isVelocityRequested) {
+		Vec3f displacementFromTransformChange = {0, 0, 0};
+		if (entityData.hasPrevFrameLocalToWorld) {
+			// Computing hit point velocity in simple words:
+			// From raytracing, we get hit point in Entity's coordinate frame (hitObject).
+			// Think of it as a marker dot on the Entity.
+			// Having access to Entity's previous pose, we can compute (entityData.prevFrameLocalToWorld * hitObject),
+			// where the marker dot would be in the previous raytracing frame (displacementVectorOrigin).
+			// Then, we can connect marker dot in previous raytracing frame with its current position and obtain displacementFromTransformChange vector
+			// Dividing displacementFromTransformChange by time elapsed from the previous raytracing frame yields velocity vector.
+			Vec3f displacementVectorOrigin = entityData.prevFrameLocalToWorld * hitObject;
+			displacementFromTransformChange = hitWorld - displacementVectorOrigin;
+		}
+
+		// Some entities may have skinned meshes - in this case entity.vertexDisplacementSincePrevFrame will be non-null
+		Vec3f displacementFromSkinning = {0, 0, 0};
+		bool wasSkinned = entityData.vertexDisplacementSincePrevFrame != nullptr;
+		if (wasSkinned) {
+			const Vec3f& vA = objectToWorld.rotation() * entityData.vertexDisplacementSincePrevFrame[triangleIndices.x()];
+			const Vec3f& vB = objectToWorld.rotation() * entityData.vertexDisplacementSincePrevFrame[triangleIndices.y()];
+			const Vec3f& vC = objectToWorld.rotation() * entityData.vertexDisplacementSincePrevFrame[triangleIndices.z()];
+			displacementFromSkinning = objectToWorld.scaleVec() * Vec3f((1 - u - v) * vA + u * vB + v * vC);
+		}
+
+		absPointVelocity = (displacementFromTransformChange + displacementFromSkinning) /
+		                   static_cast<float>(ctx.sceneDeltaTime);
+
+		// Relative point velocity is a sum of linear velocities difference (between sensor and hit-point)
+		// and impact of sensor angular velocity
+		Vec3f absPointVelocityInSensorFrame = ctx.rayOriginToWorld.rotation().inverse() * absPointVelocity;
+		Vec3f relPointVelocityBasedOnSensorLinearVelocity = absPointVelocityInSensorFrame - ctx.sensorLinearVelocityXYZ;
+
+		Vec3f hitRays = ctx.rayOriginToWorld.inverse() * hitWorld;
+		Vec3f relPointVelocityBasedOnSensorAngularVelocity = Vec3f(.0f) - ctx.sensorAngularVelocityRPY.cross(hitRays);
+		relPointVelocity = relPointVelocityBasedOnSensorLinearVelocity + relPointVelocityBasedOnSensorAngularVelocity;
+
+		radialSpeed = hitRays.normalized().dot(relPointVelocity);
+	}
+
+	return BeamSample{distance, intensity, entityData.laserRetro, entityId, absPointVelocity, relPointVelocity,
+	                  radialSpeed, wNormal, incidentAngle};
+}
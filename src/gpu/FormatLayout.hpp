@@ -0,0 +1,203 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <tuple>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+#include <macros/cuda.hpp>
+#include <RGLFields.hpp>
+
+/*
+ * Point layouts known at compile time, used to format point clouds without per-point loops over field descriptors.
+ * Field sizes and offsets are derived from Field<> traits, so the compiler fully unrolls copying of a point.
+ * A point is assembled in a local buffer and stored with the widest aligned words (up to 16 bytes).
+ * The same code is used by GPU kernels (gpuFormat*Layout) and by the host fallback (hostFormat*).
+ * This header must remain compatible with nvcc (C++17).
+ */
+
+// Words used to store whole points, the widest that divides point size is used
+struct alignas(16) FormatWord16
+{
+	uint32_t v[4];
+};
+struct alignas(8) FormatWord8
+{
+	uint32_t v[2];
+};
+
+template<size_t PointSize>
+using FormatWord = std::conditional_t<
+    PointSize % 16 == 0, FormatWord16,
+    std::conditional_t<PointSize % 8 == 0, FormatWord8,
+                       std::conditional_t<PointSize % 4 == 0, uint32_t,
+                                          std::conditional_t<PointSize % 2 == 0, uint16_t, uint8_t>>>>;
+
+template<rgl_field_t field>
+constexpr bool isPaddingField = field == RGL_FIELD_PADDING_8 || field == RGL_FIELD_PADDING_16 || field == RGL_FIELD_PADDING_32;
+
+// Recursively copies fields between SoA arrays and a point buffer; offsets are computed at compile time
+template<size_t Index, size_t Offset, rgl_field_t... Fields>
+struct FormatFieldCopier
+{
+	HostDevFn static void toPoint(size_t, const char* const*, char*) {}
+	HostDevFn static void fromPoint(size_t, const char*, char* const*) {}
+};
+
+template<size_t Index, size_t Offset, rgl_field_t FieldName, rgl_field_t... Rest>
+struct FormatFieldCopier<Index, Offset, FieldName, Rest...>
+{
+	using Type = typename Field<FieldName>::type;
+	using Next = FormatFieldCopier<Index + 1, Offset + Field<FieldName>::size, Rest...>;
+
+	HostDevFn static void toPoint(size_t idx, const char* const* soa, char* point)
+	{
+		if constexpr (!isPaddingField<FieldName>) {
+			Type value = reinterpret_cast<const Type*>(soa[Index])[idx];
+			memcpy(point + Offset, &value, sizeof(Type));
+		}
+		Next::toPoint(idx, soa, point);
+	}
+
+	HostDevFn static void fromPoint(size_t idx, const char* point, char* const* soa)
+	{
+		if constexpr (!isPaddingField<FieldName>) {
+			Type value;
+			memcpy(&value, point + Offset, sizeof(Type));
+			reinterpret_cast<Type*>(soa[Index])[idx] = value;
+		}
+		Next::fromPoint(idx, point, soa);
+	}
+};
+
+template<rgl_field_t... Fields>
+struct FormatLayout
+{
+	static constexpr size_t FIELD_COUNT = sizeof...(Fields);
+	static constexpr size_t POINT_SIZE = (Field<Fields>::size + ... + 0);
+	using Word = FormatWord<POINT_SIZE>;
+	static constexpr size_t WORD_COUNT = POINT_SIZE / sizeof(Word);
+	using Copier = FormatFieldCopier<0, 0, Fields...>;
+
+	// Passed to kernels by value, so no descriptor upload is needed. Paddings have nullptr.
+	struct ReadPointers
+	{
+		const char* ptrs[FIELD_COUNT];
+	};
+	struct WritePointers
+	{
+		char* ptrs[FIELD_COUNT];
+	};
+
+	HostDevFn static void soaToAos(size_t idx, const ReadPointers& soa, char* aos)
+	{
+		alignas(16) char point[POINT_SIZE] = {};
+		Copier::toPoint(idx, soa.ptrs, point);
+		Word* dst = reinterpret_cast<Word*>(aos) + idx * WORD_COUNT;
+		for (size_t i = 0; i < WORD_COUNT; ++i) {
+			memcpy(dst + i, point + i * sizeof(Word), sizeof(Word));
+		}
+	}
+
+	HostDevFn static void aosToSoa(size_t idx, const char* aos, const WritePointers& soa)
+	{
+		alignas(16) char point[POINT_SIZE];
+		const Word* src = reinterpret_cast<const Word*>(aos) + idx * WORD_COUNT;
+		for (size_t i = 0; i < WORD_COUNT; ++i) {
+			memcpy(point + i * sizeof(Word), src + i, sizeof(Word));
+		}
+		Copier::fromPoint(idx, point, soa.ptrs);
+	}
+
+	template<typename PtrT>
+	static bool matches(const std::vector<std::pair<rgl_field_t, PtrT>>& fieldsData)
+	{
+		const rgl_field_t fields[] = {Fields...};
+		if (fieldsData.size() != FIELD_COUNT) {
+			return false;
+		}
+		for (size_t i = 0; i < FIELD_COUNT; ++i) {
+			if (fieldsData[i].first != fields[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static bool isAligned(const void* aos) { return reinterpret_cast<uintptr_t>(aos) % alignof(Word) == 0; }
+
+	static ReadPointers makeReadPointers(const std::vector<std::pair<rgl_field_t, const void*>>& fieldsData)
+	{
+		ReadPointers pointers{};
+		for (size_t i = 0; i < FIELD_COUNT; ++i) {
+			pointers.ptrs[i] = static_cast<const char*>(fieldsData[i].second);
+		}
+		return pointers;
+	}
+
+	static WritePointers makeWritePointers(const std::vector<std::pair<rgl_field_t, void*>>& fieldsData)
+	{
+		WritePointers pointers{};
+		for (size_t i = 0; i < FIELD_COUNT; ++i) {
+			pointers.ptrs[i] = static_cast<char*>(fieldsData[i].second);
+		}
+		return pointers;
+	}
+};
+
+/**
+ * Layouts formatted with specialized code. Other layouts use the generic, descriptor-driven path.
+ * Adding a layout here instantiates it for both GPU and host.
+ */
+using SpecializedFormatLayouts = std::tuple<
+    // XYZ (e.g. visualization)
+    FormatLayout<XYZ_VEC3_F32>,
+    // PCL PointXYZ
+    FormatLayout<XYZ_VEC3_F32, PADDING_32>,
+    // ROS2 PointXYZIR
+    FormatLayout<XYZ_VEC3_F32, PADDING_32, INTENSITY_F32, RING_ID_U16>,
+    // ROS2 XYZ + intensity + ring + time
+    FormatLayout<XYZ_VEC3_F32, INTENSITY_F32, RING_ID_U16, TIME_STAMP_F64>,
+    // ROS2 PointXYZIRCAEDT
+    FormatLayout<XYZ_VEC3_F32, INTENSITY_U8, RETURN_TYPE_U8, RING_ID_U16, AZIMUTH_F32, ELEVATION_F32, DISTANCE_F32,
+                 TIME_STAMP_U32>>;
+
+template<typename PtrT, typename Visitor, size_t... I>
+bool visitFormatLayoutImpl(const std::vector<std::pair<rgl_field_t, PtrT>>& fieldsData, Visitor&& visitor,
+                           std::index_sequence<I...>)
+{
+	bool visited = false;
+	((visited = visited || (std::tuple_element_t<I, SpecializedFormatLayouts>::matches(fieldsData) &&
+	                        visitor(std::tuple_element_t<I, SpecializedFormatLayouts>{}))),
+	 ...);
+	return visited;
+}
+
+/**
+ * Calls visitor with an instance of the FormatLayout matching given fields.
+ * Visitor returns false if it cannot use the layout (e.g. misaligned data).
+ * @return Whether the data was formatted by the visitor.
+ */
+template<typename PtrT, typename Visitor>
+bool visitFormatLayout(const std::vector<std::pair<rgl_field_t, PtrT>>& fieldsData, Visitor&& visitor)
+{
+	return visitFormatLayoutImpl(fieldsData, std::forward<Visitor>(visitor),
+	                             std::make_index_sequence<std::tuple_size_v<SpecializedFormatLayouts>>{});
+}
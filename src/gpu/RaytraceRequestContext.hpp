@@ -15,6 +15,7 @@
 #pragma once
 
 #include <optix.h>
+#include <macros/cuda.hpp>
 #include <RGLFields.hpp>
 #include <gpu/MultiReturn.hpp>
 
@@ -72,8 +73,42 @@ struct RaytraceRequestContext
 
 	// Multi-Return
 	MultiReturnSamplesPointers mrSamples;
+	rgl_return_mode_t returnMode;
 	int returnCount;
 	float hBeamHalfDivergenceRad;
 	float vBeamHalfDivergenceRad;
+	// If false, only the primary ray is shot and its result is written directly to output fields (mrSamples are not used).
+	bool doSampleBeams;
 };
 static_assert(std::is_trivially_copyable<RaytraceRequestContext>::value);
+
+/**
+ * Parameters of a single optix launch. One launch may serve multiple requests (e.g. batched sensors).
+ * Rays of consecutive requests are laid out one after another in the launch dimension.
+ */
+struct RaytraceLaunchParams
+{
+	const RaytraceRequestContext* requests;
+	const uint32_t* requestRayOffsets; // requestCount + 1 elements, index of the first ray of each request in the launch
+	int requestCount;
+};
+static_assert(std::is_trivially_copyable<RaytraceLaunchParams>::value);
+
+/**
+ * Returns index of the request that contains given launch index (ray in the launch).
+ * Requests without rays are never returned for valid launch indices.
+ */
+HostDevFn inline int findRaytraceRequest(const uint32_t* requestRayOffsets, int requestCount, uint32_t launchIdx)
+{
+	// Invariant: requestRayOffsets[first] <= launchIdx < requestRayOffsets[last]
+	int first = 0, last = requestCount;
+	while (last - first > 1) {
+		const int middle = first + (last - first) / 2;
+		if (requestRayOffsets[middle] <= launchIdx) {
+			first = middle;
+		} else {
+			last = middle;
+		}
+	}
+	return first;
+}
@@ -13,29 +13,29 @@
 // limitations under the License.
 
 #include <cuda.h>
-#include <curand_kernel.h>
 #include <gpu/kernelUtils.hpp>
 #include <gpu/gaussianNoiseKernels.hpp>
+#include <math/Philox.hpp>
 
 __global__ void kAddGaussianNoiseAngularRay(size_t rayCount, float mean, float stDev, rgl_axis_t rotationAxis,
-                                            Mat3x4f lookAtOriginTransform, curandStatePhilox4_32_10_t* randomStates,
+                                            Mat3x4f lookAtOriginTransform, uint64_t seed, uint32_t frame,
                                             const Mat3x4f* inRays, Mat3x4f* outRays)
 {
 	LIMIT(rayCount);
 
-	float angularError = mean + curand_normal(&randomStates[tid]) * stDev;
+	float angularError = mean + Philox4x32::normal(seed, frame, static_cast<uint32_t>(tid)) * stDev;
 	outRays[tid] = lookAtOriginTransform.inverse() *
 	               (Mat3x4f::rotationRad(rotationAxis, angularError) * (lookAtOriginTransform * inRays[tid]));
 }
 
 __global__ void kAddGaussianNoiseAngularHitpoint(size_t pointCount, float mean, float stDev, rgl_axis_t rotationAxis,
-                                                 Mat3x4f lookAtOriginTransform, curandStatePhilox4_32_10_t* randomStates,
+                                                 Mat3x4f lookAtOriginTransform, uint64_t seed, uint32_t frame,
                                                  const Field<XYZ_VEC3_F32>::type* inPoints,
                                                  Field<XYZ_VEC3_F32>::type* outPoints, Field<DISTANCE_F32>::type* outDistances)
 {
 	LIMIT(pointCount);
 
-	float angularError = mean + curand_normal(&randomStates[tid]) * stDev;
+	float angularError = mean + Philox4x32::normal(seed, frame, static_cast<uint32_t>(tid)) * stDev;
 	Field<XYZ_VEC3_F32>::type originWithNoisePoint = Mat3x4f::rotationRad(rotationAxis, angularError) *
 	                                                 (lookAtOriginTransform * inPoints[tid]);
 
@@ -47,7 +47,7 @@ __global__ void kAddGaussianNoiseAngularHitpoint(size_t pointCount, float mean,
 }
 
 __global__ void kAddGaussianNoiseDistance(size_t pointCount, float mean, float stDevBase, float stDevRisePerMeter,
-                                          Mat3x4f lookAtOriginTransform, curandStatePhilox4_32_10_t* randomStates,
+                                          Mat3x4f lookAtOriginTransform, uint64_t seed, uint32_t frame,
                                           const Field<XYZ_VEC3_F32>::type* inPoints,
                                           const Field<DISTANCE_F32>::type* inDistances, Field<XYZ_VEC3_F32>::type* outPoints,
                                           Field<DISTANCE_F32>::type* outDistances)
@@ -56,7 +56,7 @@ __global__ void kAddGaussianNoiseDistance(size_t pointCount, float mean, float s
 
 	float distanceInducedStDev = inDistances[tid] * stDevRisePerMeter;
 	float totalStDev = distanceInducedStDev + stDevBase;
-	float distanceError = mean + curand_normal(&randomStates[tid]) * totalStDev;
+	float distanceError = mean + Philox4x32::normal(seed, frame, static_cast<uint32_t>(tid)) * totalStDev;
 
 	Field<XYZ_VEC3_F32>::type pointInRayOriginTransform = lookAtOriginTransform * inPoints[tid];
 
@@ -66,27 +66,27 @@ __global__ void kAddGaussianNoiseDistance(size_t pointCount, float mean, float s
 }
 
 void gpuAddGaussianNoiseAngularRay(cudaStream_t stream, size_t rayCount, float mean, float stDev, rgl_axis_t rotationAxis,
-                                   Mat3x4f lookAtOriginTransform, curandStatePhilox4_32_10_t* randomStates,
+                                   Mat3x4f lookAtOriginTransform, uint64_t seed, uint32_t frame,
                                    const Mat3x4f* inRays, Mat3x4f* outRays)
 {
-	run(kAddGaussianNoiseAngularRay, stream, rayCount, mean, stDev, rotationAxis, lookAtOriginTransform, randomStates, inRays,
+	run(kAddGaussianNoiseAngularRay, stream, rayCount, mean, stDev, rotationAxis, lookAtOriginTransform, seed, frame, inRays,
 	    outRays);
 }
 
 void gpuAddGaussianNoiseAngularHitpoint(cudaStream_t stream, size_t pointCount, float mean, float stDev,
                                         rgl_axis_t rotationAxis, Mat3x4f lookAtOriginTransform,
-                                        curandStatePhilox4_32_10_t* randomStates, const Field<XYZ_VEC3_F32>::type* inPoints,
+                                        uint64_t seed, uint32_t frame, const Field<XYZ_VEC3_F32>::type* inPoints,
                                         Field<XYZ_VEC3_F32>::type* outPoints, Field<DISTANCE_F32>::type* outDistances)
 {
-	run(kAddGaussianNoiseAngularHitpoint, stream, pointCount, mean, stDev, rotationAxis, lookAtOriginTransform, randomStates,
+	run(kAddGaussianNoiseAngularHitpoint, stream, pointCount, mean, stDev, rotationAxis, lookAtOriginTransform, seed, frame,
 	    inPoints, outPoints, outDistances);
 }
 
 void gpuAddGaussianNoiseDistance(cudaStream_t stream, size_t pointCount, float mean, float stDevBase, float stDevRisePerMeter,
-                                 Mat3x4f lookAtOriginTransform, curandStatePhilox4_32_10_t* randomStates,
+                                 Mat3x4f lookAtOriginTransform, uint64_t seed, uint32_t frame,
                                  const Field<XYZ_VEC3_F32>::type* inPoints, const Field<DISTANCE_F32>::type* inDistances,
                                  Field<XYZ_VEC3_F32>::type* outPoints, Field<DISTANCE_F32>::type* outDistances)
 {
-	run(kAddGaussianNoiseDistance, stream, pointCount, mean, stDevBase, stDevRisePerMeter, lookAtOriginTransform, randomStates,
+	run(kAddGaussianNoiseDistance, stream, pointCount, mean, stDevBase, stDevRisePerMeter, lookAtOriginTransform, seed, frame,
 	    inPoints, inDistances, outPoints, outDistances);
 }
\ No newline at end of file
@@ -18,14 +18,19 @@
 #include <math/Mat3x4f.hpp>
 #include <RGLFields.hpp>
 
+/*
+ * Noise is a function of (seed, frame, index of the point or ray), see Philox4x32.
+ * The frame is meant to be changed in every run, to get different noise each time.
+ */
+
 void gpuAddGaussianNoiseAngularRay(cudaStream_t stream, size_t rayCount, float mean, float stDev, rgl_axis_t rotationAxis,
-                                   Mat3x4f lookAtOriginTransform, curandStatePhilox4_32_10_t* randomStates,
+                                   Mat3x4f lookAtOriginTransform, uint64_t seed, uint32_t frame,
                                    const Mat3x4f* inRays, Mat3x4f* outRays);
 void gpuAddGaussianNoiseAngularHitpoint(cudaStream_t stream, size_t pointCount, float mean, float stDev,
                                         rgl_axis_t rotationAxis, Mat3x4f lookAtOriginTransform,
-                                        curandStatePhilox4_32_10_t* randomStates, const Field<XYZ_VEC3_F32>::type* inPoints,
+                                        uint64_t seed, uint32_t frame, const Field<XYZ_VEC3_F32>::type* inPoints,
                                         Field<XYZ_VEC3_F32>::type* outPoints, Field<DISTANCE_F32>::type* outDistances);
 void gpuAddGaussianNoiseDistance(cudaStream_t stream, size_t pointCount, float mean, float stDevBase, float stDevRisePerMeter,
-                                 Mat3x4f lookAtOriginTransform, curandStatePhilox4_32_10_t* randomStates,
+                                 Mat3x4f lookAtOriginTransform, uint64_t seed, uint32_t frame,
                                  const Field<XYZ_VEC3_F32>::type* inPoints, const Field<DISTANCE_F32>::type* inDistances,
                                  Field<XYZ_VEC3_F32>::type* outPoints, Field<DISTANCE_F32>::type* outDistances);
@@ -14,7 +14,9 @@
 
 #include <gpu/kernelUtils.hpp>
 #include <gpu/nodeKernels.hpp>
+#include <gpu/BeamReturns.hpp>
 #include <gpu/GPUFieldDesc.hpp>
+#include <gpu/FormatLayout.hpp>
 #include <macros/cuda.hpp>
 #include <returnModeUtils.h>
 
@@ -42,6 +44,20 @@ __global__ void kFormatAosToSoa(size_t pointCount, size_t pointSize, size_t fiel
 	}
 }
 
+template<typename Layout>
+__global__ void kFormatSoaToAosLayout(size_t pointCount, typename Layout::ReadPointers soaInData, char* aosOutData)
+{
+	LIMIT(pointCount);
+	Layout::soaToAos(tid, soaInData, aosOutData);
+}
+
+template<typename Layout>
+__global__ void kFormatAosToSoaLayout(size_t pointCount, const char* aosInData, typename Layout::WritePointers soaOutData)
+{
+	LIMIT(pointCount);
+	Layout::aosToSoa(tid, aosInData, soaOutData);
+}
+
 __global__ void kTransformRays(size_t rayCount, const Mat3x4f* inRays, Mat3x4f* outRays, Mat3x4f transform)
 {
 	LIMIT(rayCount);
@@ -100,112 +116,6 @@ __device__ Vec3f reflectPolarization(const Vec3f& pol, const Vec3f& hitNormal, c
 	return -polCompR * refPolR + polCompU * refPolU;
 }
 
-__device__ void saveReturnAsHit(const RaytraceRequestContext* ctx, int beamIdx, int sampleIdx, int returnPointIdx,
-                                rgl_return_type_t returnType)
-{
-	if (ctx->xyz != nullptr) {
-		const Mat3x4f ray = ctx->raysWorld[beamIdx];
-		const Vec3f origin = ray * Vec3f{0, 0, 0};
-		const Vec3f dir = (ray * Vec3f{0, 0, 1} - origin).normalized();
-		ctx->xyz[returnPointIdx] = origin + dir * ctx->mrSamples.distance[sampleIdx];
-	}
-	if (ctx->isHit != nullptr) {
-		ctx->isHit[returnPointIdx] = ctx->mrSamples.isHit[sampleIdx];
-	}
-	if (ctx->returnType != nullptr) {
-		ctx->returnType[returnPointIdx] = returnType;
-	}
-	if (ctx->distance != nullptr) {
-		ctx->distance[returnPointIdx] = ctx->mrSamples.distance[sampleIdx];
-	}
-	if (ctx->intensityF32 != nullptr) {
-		ctx->intensityF32[returnPointIdx] = ctx->mrSamples.intensity[sampleIdx];
-	}
-	if (ctx->intensityU8 != nullptr) {
-		// intensity < 0 not possible
-		ctx->intensityU8[returnPointIdx] = ctx->mrSamples.intensity[sampleIdx] < UINT8_MAX ?
-		                                       static_cast<uint8_t>(std::round(ctx->mrSamples.intensity[sampleIdx])) :
-		                                       UINT8_MAX;
-	}
-	if (ctx->entityId != nullptr) {
-		ctx->entityId[returnPointIdx] = ctx->mrSamples.entityId[sampleIdx];
-	}
-	if (ctx->pointAbsVelocity != nullptr) {
-		ctx->pointAbsVelocity[returnPointIdx] = ctx->mrSamples.absVelocity[sampleIdx];
-	}
-	if (ctx->pointRelVelocity != nullptr) {
-		ctx->pointRelVelocity[returnPointIdx] = ctx->mrSamples.relVelocity[sampleIdx];
-	}
-	if (ctx->radialSpeed != nullptr) {
-		ctx->radialSpeed[returnPointIdx] = ctx->mrSamples.radialSpeed[sampleIdx];
-	}
-	if (ctx->normal != nullptr) {
-		ctx->normal[returnPointIdx] = ctx->mrSamples.normal[sampleIdx];
-	}
-	if (ctx->incidentAngle != nullptr) {
-		ctx->incidentAngle[returnPointIdx] = ctx->mrSamples.incidentAngle[sampleIdx];
-	}
-	if (ctx->laserRetro != nullptr) {
-		ctx->laserRetro[returnPointIdx] = ctx->mrSamples.laserRetro[sampleIdx];
-	}
-}
-
-__device__ void saveReturnAsNonHit(const RaytraceRequestContext* ctx, int beamIdx, int returnPointIdx,
-                                   rgl_return_type_t returnType)
-{
-	// Arbitrary decision - if all samples are non hits, I just take the distance from center ray. This distance will be either
-	// ctx.nearNonHitDistance or ctx.farNonHitDistance, based on optix kernel processing - check optixPrograms.cu. This provides
-	// being able to set below minRange, above maxRange and non hit results with the same code. Moreover, results for sample
-	// at idx 0 are always present with current implementation.
-	const auto nonHitDistance = ctx->mrSamples.distance[0];
-
-	if (ctx->xyz != nullptr) {
-		const Mat3x4f ray = ctx->raysWorld[beamIdx];
-		const Vec3f origin = ray * Vec3f{0, 0, 0};
-		const Vec3f dir = ray * Vec3f{0, 0, 1} - origin;
-		Vec3f displacement = dir.normalized() * nonHitDistance;
-		displacement = {isnan(displacement.x()) ? 0 : displacement.x(), isnan(displacement.y()) ? 0 : displacement.y(),
-		                isnan(displacement.z()) ? 0 : displacement.z()};
-		ctx->xyz[returnPointIdx] = origin + displacement;
-	}
-	if (ctx->isHit != nullptr) {
-		ctx->isHit[returnPointIdx] = false;
-	}
-	if (ctx->returnType != nullptr) {
-		ctx->returnType[returnPointIdx] = returnType;
-	}
-	if (ctx->distance != nullptr) {
-		ctx->distance[returnPointIdx] = nonHitDistance;
-	}
-	if (ctx->intensityF32 != nullptr) {
-		ctx->intensityF32[returnPointIdx] = 0;
-	}
-	if (ctx->intensityU8 != nullptr) {
-		ctx->intensityU8[returnPointIdx] = 0;
-	}
-	if (ctx->entityId != nullptr) {
-		ctx->entityId[returnPointIdx] = RGL_ENTITY_INVALID_ID;
-	}
-	if (ctx->pointAbsVelocity != nullptr) {
-		ctx->pointAbsVelocity[returnPointIdx] = Vec3f{NAN};
-	}
-	if (ctx->pointRelVelocity != nullptr) {
-		ctx->pointRelVelocity[returnPointIdx] = Vec3f{NAN};
-	}
-	if (ctx->radialSpeed != nullptr) {
-		ctx->radialSpeed[returnPointIdx] = 0;
-	}
-	if (ctx->normal != nullptr) {
-		ctx->normal[returnPointIdx] = Vec3f{NAN};
-	}
-	if (ctx->incidentAngle != nullptr) {
-		ctx->incidentAngle[returnPointIdx] = NAN;
-	}
-	if (ctx->laserRetro != nullptr) {
-		ctx->laserRetro[returnPointIdx] = 0;
-	}
-}
-
 __global__ void kRadarComputeEnergy(size_t count, float rayAzimuthStepRad, float rayElevationStepRad, float freq,
                                     Mat3x4f lookAtOriginTransform, const Field<RAY_POSE_MAT3x4_F32>::type* rayPose,
                                     const Field<DISTANCE_F32>::type* hitDist, const Field<NORMAL_VEC3_F32>::type* hitNorm,
@@ -355,10 +265,15 @@ __global__ void kReduceDivergentBeams(size_t beamCount, int samplesPerBeam, rgl_
 
 	// There were no hits within beam samples.
 	if (first == -1) {
+		// Arbitrary decision - if all samples are non hits, I just take the distance from center ray. This distance will be
+		// either ctx.nearNonHitDistance or ctx.farNonHitDistance, based on optix kernel processing - check optixPrograms.cu.
+		// This provides being able to set below minRange, above maxRange and non hit results with the same code.
+		// Moreover, results for sample at idx 0 are always present with current implementation.
+		const auto nonHitDistance = ctx->mrSamples.distance[0];
 		for (int returnIdx = 0; returnIdx < returnCount; ++returnIdx) {
 			const auto returnPointIdx = beamIdx * returnCount + returnIdx;
 			const auto returnType = getReturnType(returnMode, returnIdx);
-			saveReturnAsNonHit(ctx, beamIdx, returnPointIdx, returnType);
+			saveReturnAsNonHit(ctx, beamIdx, nonHitDistance, returnPointIdx, returnType);
 		}
 		return;
 	}
@@ -414,7 +329,7 @@ __global__ void kReduceDivergentBeams(size_t beamCount, int samplesPerBeam, rgl_
 		// More useful solution would be a way to verify returnMode somewhere before even calling kernels.
 		if (sampleIdx >= 0) {
 			const auto returnPointIdx = beamIdx * returnCount + returnIdx;
-			saveReturnAsHit(ctx, beamIdx, sampleIdx, returnPointIdx, returnType);
+			saveReturnAsHit(ctx, beamIdx, loadBeamSample(ctx, sampleIdx), returnPointIdx, returnType);
 		}
 	}
 }
@@ -445,6 +360,32 @@ void gpuFormatAosToSoa(cudaStream_t stream, size_t pointCount, size_t pointSize,
 	run(kFormatAosToSoa, stream, pointCount, pointSize, fieldCount, aosInData, soaOutData);
 }
 
+bool gpuFormatSoaToAosLayout(cudaStream_t stream, size_t pointCount,
+                             const std::vector<std::pair<rgl_field_t, const void*>>& soaInData, char* aosOutData)
+{
+	return visitFormatLayout(soaInData, [&](auto layout) {
+		using Layout = decltype(layout);
+		if (!Layout::isAligned(aosOutData)) {
+			return false;
+		}
+		run(kFormatSoaToAosLayout<Layout>, stream, pointCount, Layout::makeReadPointers(soaInData), aosOutData);
+		return true;
+	});
+}
+
+bool gpuFormatAosToSoaLayout(cudaStream_t stream, size_t pointCount, const char* aosInData,
+                             const std::vector<std::pair<rgl_field_t, void*>>& soaOutData)
+{
+	return visitFormatLayout(soaOutData, [&](auto layout) {
+		using Layout = decltype(layout);
+		if (!Layout::isAligned(aosInData)) {
+			return false;
+		}
+		run(kFormatAosToSoaLayout<Layout>, stream, pointCount, aosInData, Layout::makeWritePointers(soaOutData));
+		return true;
+	});
+}
+
 void gpuTransformRays(cudaStream_t stream, size_t rayCount, const Mat3x4f* inRays, Mat3x4f* outRays, Mat3x4f transform)
 {
 	run(kTransformRays, stream, rayCount, inRays, outRays, transform);
@@ -16,6 +16,7 @@
 
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 #include <rgl/api/core.h>
 #include <gpu/GPUFieldDesc.hpp>
@@ -38,6 +39,11 @@ void gpuFormatSoaToAos(cudaStream_t, size_t pointCount, size_t pointSize, size_t
                        char* aosOutData);
 void gpuFormatAosToSoa(cudaStream_t, size_t pointCount, size_t pointSize, size_t fieldCount, const char* aosInData,
                        const GPUFieldDesc* soaOutData);
+// Specialized formatting of layouts listed in SpecializedFormatLayouts; returns false if not applicable.
+bool gpuFormatSoaToAosLayout(cudaStream_t, size_t pointCount, const std::vector<std::pair<rgl_field_t, const void*>>& soaInData,
+                             char* aosOutData);
+bool gpuFormatAosToSoaLayout(cudaStream_t, size_t pointCount, const char* aosInData,
+                             const std::vector<std::pair<rgl_field_t, void*>>& soaOutData);
 void gpuTransformRays(cudaStream_t, size_t rayCount, const Mat3x4f* inRays, Mat3x4f* outRays, Mat3x4f transform);
 void gpuApplyCompaction(cudaStream_t, size_t pointCount, size_t fieldSize, const int* shouldWrite,
                         const CompactionIndexType* writeIndex, char* dst, const char* src);
@@ -23,6 +23,8 @@
 
 #include <gpu/RaytraceRequestContext.hpp>
 #include <gpu/ShaderBindingTableTypes.h>
+#include <gpu/BeamReturns.hpp>
+#include <returnModeUtils.h>
 
 #include <rgl/api/core.h>
 
@@ -30,31 +32,38 @@
 static constexpr float toDeg = (180.0f / M_PI);
 
 // Globals
-extern "C" static __constant__ RaytraceRequestContext ctx;
+extern "C" static __constant__ RaytraceLaunchParams launchParams;
 
 // Helper functions
-__device__ void saveSampleAsNonHit(int sampleIdx, float nonHitDistance);
-__device__ void saveSampleAsHit(int sampleIdx, float distance, float intensity, float laserRetro, int objectID,
-                                const Vec3f& absVelocity, const Vec3f& relVelocity, float radialSpeed, const Vec3f& normal,
-                                float incidentAngle);
-__device__ void saveNonHitBeamSamples(int beamIdx, float nonHitDistance);
-__device__ void saveBeamSharedData(int beamIdx, const Mat3x4f& rayLocal);
-__device__ void shootSamplingRay(const Mat3x4f& ray, float maxRange, unsigned sampleBeamIdx);
-__device__ Mat3x4f makeBeamSampleRayTransform(float hHalfDivergenceRad, float vHalfDivergenceRad, unsigned layerIdx,
-                                              unsigned vertexIdx);
+__device__ void saveSampleAsNonHit(const RaytraceRequestContext& ctx, int sampleIdx, float nonHitDistance);
+__device__ void saveSampleAsHit(const RaytraceRequestContext& ctx, int sampleIdx, const BeamSample& sample);
+__device__ void saveNonHitBeamSamples(const RaytraceRequestContext& ctx, int beamIdx, float nonHitDistance);
+__device__ void shootSamplingRay(const RaytraceRequestContext& ctx, const Mat3x4f& ray, float maxRange, unsigned sampleBeamIdx,
+                                 unsigned requestIdx, unsigned beamIdx);
+__device__ Mat3x4f makeBeamSampleRayTransform(const RaytraceRequestContext& ctx, float hHalfDivergenceRad,
+                                              float vHalfDivergenceRad, unsigned layerIdx, unsigned vertexIdx);
 
 extern "C" __global__ void __raygen__()
 {
-	const int rayIdx = static_cast<int>(optixGetLaunchIndex().x);
+	// A launch may serve multiple requests (batched sensors), their rays are laid out one after another.
+	const unsigned launchIdx = optixGetLaunchIndex().x;
+	const int requestIdx = findRaytraceRequest(launchParams.requestRayOffsets, launchParams.requestCount, launchIdx);
+	const RaytraceRequestContext& ctx = launchParams.requests[requestIdx];
+	const int rayIdx = static_cast<int>(launchIdx - launchParams.requestRayOffsets[requestIdx]);
 	Mat3x4f ray = ctx.raysWorld[rayIdx];
 	const Mat3x4f rayLocal =
 	    ctx.rayOriginToWorld.inverse() *
 	    ray; // TODO(prybicki): instead of computing inverse, we should pass rays in local CF and then transform them to world CF.
 
 	// Saving data for non-hit samples is necessary here - otherwise this data will not be initialized.
-	saveNonHitBeamSamples(rayIdx, ctx.farNonHitDistance);
-	saveBeamSharedData(rayIdx, rayLocal);
+	if (ctx.doSampleBeams) {
+		saveNonHitBeamSamples(ctx, rayIdx, ctx.farNonHitDistance);
+	}
+	saveBeamSharedData(ctx, rayIdx, rayLocal);
 	if (ctx.rayMask != nullptr && ctx.rayMask[rayIdx] == 0) {
+		if (!ctx.doSampleBeams) {
+			saveBeamReturnsAsNonHit(ctx, rayIdx, ctx.farNonHitDistance);
+		}
 		return;
 	}
 
@@ -71,16 +80,16 @@ extern "C" __global__ void __raygen__()
 
 	float maxRange = ctx.rayRangesCount == 1 ? ctx.rayRanges[0].y() : ctx.rayRanges[rayIdx].y();
 
-	shootSamplingRay(ray, maxRange, 0); // Shoot primary ray
-	if (ctx.hBeamHalfDivergenceRad > 0.0f && ctx.vBeamHalfDivergenceRad > 0.0f) {
+	shootSamplingRay(ctx, ray, maxRange, 0, requestIdx, rayIdx); // Shoot primary ray
+	if (ctx.doSampleBeams) {
 		// Shoot multi-return sampling rays
 		for (int layerIdx = 0; layerIdx < MULTI_RETURN_BEAM_LAYERS; ++layerIdx) {
 			for (int vertexIdx = 0; vertexIdx < MULTI_RETURN_BEAM_VERTICES; vertexIdx++) {
-				Mat3x4f sampleRay = ray * makeBeamSampleRayTransform(ctx.hBeamHalfDivergenceRad, ctx.vBeamHalfDivergenceRad,
-				                                                     layerIdx, vertexIdx);
+				Mat3x4f sampleRay = ray * makeBeamSampleRayTransform(ctx, ctx.hBeamHalfDivergenceRad,
+				                                                     ctx.vBeamHalfDivergenceRad, layerIdx, vertexIdx);
 				// Sampling rays indexes start from 1, 0 is reserved for the primary ray
 				const unsigned beamSampleRayIdx = 1 + layerIdx * MULTI_RETURN_BEAM_VERTICES + vertexIdx;
-				shootSamplingRay(sampleRay, maxRange, beamSampleRayIdx);
+				shootSamplingRay(ctx, sampleRay, maxRange, beamSampleRayIdx, requestIdx, rayIdx);
 			}
 		}
 	}
@@ -88,9 +97,14 @@ extern "C" __global__ void __raygen__()
 
 extern "C" __global__ void __miss__()
 {
-	const int beamIdx = static_cast<int>(optixGetLaunchIndex().x);
 	const int beamSampleIdx = static_cast<int>(optixGetPayload_0());
-	saveSampleAsNonHit(beamIdx * MULTI_RETURN_BEAM_SAMPLES + beamSampleIdx, ctx.farNonHitDistance);
+	const RaytraceRequestContext& ctx = launchParams.requests[optixGetPayload_1()];
+	const int beamIdx = static_cast<int>(optixGetPayload_2());
+	if (!ctx.doSampleBeams) {
+		saveBeamReturnsAsNonHit(ctx, beamIdx, ctx.farNonHitDistance);
+		return;
+	}
+	saveSampleAsNonHit(ctx, beamIdx * MULTI_RETURN_BEAM_SAMPLES + beamSampleIdx, ctx.farNonHitDistance);
 }
 
 extern "C" __global__ void __closesthit__()
@@ -111,12 +125,12 @@ extern "C" __global__ void __closesthit__()
 	const Vec3f& C = entityData.vertex[triangleIndices.z()];
 
 	// Ray
-	const int beamIdx = static_cast<int>(optixGetLaunchIndex().x);
 	const int beamSampleRayIdx = static_cast<int>(optixGetPayload_0());
+	const RaytraceRequestContext& ctx = launchParams.requests[optixGetPayload_1()];
+	const int beamIdx = static_cast<int>(optixGetPayload_2());
 	const int mrSampleIdx = beamIdx * MULTI_RETURN_BEAM_SAMPLES + beamSampleRayIdx;
 	const Vec3f beamSampleOrigin = optixGetWorldRayOrigin();
 	const int entityId = static_cast<int>(optixGetInstanceId());
-	const float laserRetro = entityData.laserRetro;
 
 	// Hitpoint
 	Vec3f hitObject = Vec3f((1 - u - v) * A + u * B + v * C);
@@ -129,25 +143,16 @@ extern "C" __global__ void __closesthit__()
 	const double distance = (hwrd - hso).length();
 
 	// Early out for points that are too close to the sensor
-	float minRange = ctx.rayRangesCount == 1 ? ctx.rayRanges[0].x() : ctx.rayRanges[optixGetLaunchIndex().x].x();
+	float minRange = ctx.rayRangesCount == 1 ? ctx.rayRanges[0].x() : ctx.rayRanges[beamIdx].x();
 	if (distance < minRange) {
-		saveSampleAsNonHit(mrSampleIdx, ctx.nearNonHitDistance);
+		if (!ctx.doSampleBeams) {
+			saveBeamReturnsAsNonHit(ctx, beamIdx, ctx.nearNonHitDistance);
+			return;
+		}
+		saveSampleAsNonHit(ctx, mrSampleIdx, ctx.nearNonHitDistance);
 		return;
 	}
 
-	// Normal vector
-	Vec3f rayDir = optixGetWorldRayDirection();
-	const Vec3f wA = optixTransformPointFromObjectToWorldSpace(A);
-	const Vec3f wB = optixTransformPointFromObjectToWorldSpace(B);
-	const Vec3f wC = optixTransformPointFromObjectToWorldSpace(C);
-	const Vec3f wAB = wB - wA;
-	const Vec3f wCA = wC - wA;
-	const Vec3f wNormal = wAB.cross(wCA).normalized();
-
-	// Incident angle
-	const float cosIncidentAngle = fabs(wNormal.dot(rayDir));
-	const float incidentAngle = acosf(cosIncidentAngle);
-
 	float intensity = ctx.defaultIntensity;
 	// TODO(Pawel): Check if it is possible to read this only based on mode requested - if any requested
 	// return is strongest or second strongest.
@@ -164,71 +169,35 @@ extern "C" __global__ void __closesthit__()
 
 		intensity = tex2D<TextureTexelFormat>(entityData.texture, uv[0], uv[1]);
 	}
-	intensity *= cosIncidentAngle;
-
-	Vec3f absPointVelocity{NAN};
-	Vec3f relPointVelocity{NAN};
-	float radialSpeed{NAN};
-	bool isVelocityRequested = ctx.pointAbsVelocity != nullptr || ctx.pointRelVelocity != nullptr || ctx.radialSpeed != nullptr;
-	if (ctx.sceneDeltaTime > 0 && isVelocityRequested) {
-		Vec3f displacementFromTransformChange = {0, 0, 0};
-		if (entityData.hasPrevFrameLocalToWorld) {
-			// Computing hit point velocity in simple words:
-			// From raytracing, we get hit point in Entity's coordinate frame (hitObject).
-			// Think of it as a marker dot on the Entity.
-			// Having access to Entity's previous pose, we can compute (entityData.prevFrameLocalToWorld * hitObject),
-			// where the marker dot would be in the previous raytracing frame (displacementVectorOrigin).
-			// Then, we can connect marker dot in previous raytracing frame with its current position and obtain displacementFromTransformChange vector
-			// Dividing displacementFromTransformChange by time elapsed from the previous raytracing frame yields velocity vector.
-			Vec3f displacementVectorOrigin = entityData.prevFrameLocalToWorld * hitObject;
-			displacementFromTransformChange = hitWorldRaytraced - displacementVectorOrigin;
-		}
-
-		// Some entities may have skinned meshes - in this case entity.vertexDisplacementSincePrevFrame will be non-null
-		Vec3f displacementFromSkinning = {0, 0, 0};
-		bool wasSkinned = entityData.vertexDisplacementSincePrevFrame != nullptr;
-		if (wasSkinned) {
-			Mat3x4f objectToWorld;
-			optixGetObjectToWorldTransformMatrix(reinterpret_cast<float*>(objectToWorld.rc));
-			const Vec3f& vA = objectToWorld.rotation() * entityData.vertexDisplacementSincePrevFrame[triangleIndices.x()];
-			const Vec3f& vB = objectToWorld.rotation() * entityData.vertexDisplacementSincePrevFrame[triangleIndices.y()];
-			const Vec3f& vC = objectToWorld.rotation() * entityData.vertexDisplacementSincePrevFrame[triangleIndices.z()];
-			displacementFromSkinning = objectToWorld.scaleVec() * Vec3f((1 - u - v) * vA + u * vB + v * vC);
-		}
-
-		absPointVelocity = (displacementFromTransformChange + displacementFromSkinning) /
-		                   static_cast<float>(ctx.sceneDeltaTime);
 
-		// Relative point velocity is a sum of linear velocities difference (between sensor and hit-point)
-		// and impact of sensor angular velocity
-		Vec3f absPointVelocityInSensorFrame = ctx.rayOriginToWorld.rotation().inverse() * absPointVelocity;
-		Vec3f relPointVelocityBasedOnSensorLinearVelocity = absPointVelocityInSensorFrame - ctx.sensorLinearVelocityXYZ;
-
-		Vec3f hitRays = ctx.rayOriginToWorld.inverse() * hitWorldRaytraced;
-		Vec3f relPointVelocityBasedOnSensorAngularVelocity = Vec3f(.0f) - ctx.sensorAngularVelocityRPY.cross(hitRays);
-		relPointVelocity = relPointVelocityBasedOnSensorLinearVelocity + relPointVelocityBasedOnSensorAngularVelocity;
-
-		radialSpeed = hitRays.normalized().dot(relPointVelocity);
+	Mat3x4f objectToWorld;
+	optixGetObjectToWorldTransformMatrix(reinterpret_cast<float*>(objectToWorld.rc));
+	const BeamSample sample = makeHitBeamSample(ctx, entityData, entityId, objectToWorld, triangleIndices, u, v, hitObject,
+	                                            hitWorldRaytraced, static_cast<float>(distance), optixGetWorldRayDirection(),
+	                                            intensity);
+	if (!ctx.doSampleBeams) {
+		saveBeamReturnsAsHit(ctx, beamIdx, sample);
+		return;
 	}
-
-	saveSampleAsHit(mrSampleIdx, distance, intensity, laserRetro, entityId, absPointVelocity, relPointVelocity, radialSpeed,
-	                wNormal, incidentAngle);
+	saveSampleAsHit(ctx, mrSampleIdx, sample);
 }
 
 extern "C" __global__ void __anyhit__() {}
 
 // Helper functions implementations
 
-__device__ void shootSamplingRay(const Mat3x4f& ray, float maxRange, unsigned int beamSampleRayIdx)
+__device__ void shootSamplingRay(const RaytraceRequestContext& ctx, const Mat3x4f& ray, float maxRange,
+                                 unsigned int beamSampleRayIdx, unsigned int requestIdx, unsigned int beamIdx)
 {
 	Vec3f origin = ray * Vec3f{0, 0, 0};
 	Vec3f dir = ray * Vec3f{0, 0, 1} - origin;
 	const unsigned int flags = OPTIX_RAY_FLAG_DISABLE_ANYHIT; // TODO: try adding OPTIX_RAY_FLAG_CULL_BACK_FACING_TRIANGLES
-	optixTrace(ctx.scene, origin, dir, 0.0f, maxRange, 0.0f, OptixVisibilityMask(255), flags, 0, 1, 0, beamSampleRayIdx);
+	optixTrace(ctx.scene, origin, dir, 0.0f, maxRange, 0.0f, OptixVisibilityMask(255), flags, 0, 1, 0, beamSampleRayIdx,
+	           requestIdx, beamIdx);
 }
 
-__device__ Mat3x4f makeBeamSampleRayTransform(float hHalfDivergenceRad, float vHalfDivergenceRad, unsigned int layerIdx,
-                                              unsigned int vertexIdx)
+__device__ Mat3x4f makeBeamSampleRayTransform(const RaytraceRequestContext& ctx, float hHalfDivergenceRad,
+                                              float vHalfDivergenceRad, unsigned int layerIdx, unsigned int vertexIdx)
 {
 	if (ctx.hBeamHalfDivergenceRad == 0.0f && ctx.vBeamHalfDivergenceRad == 0.0f) {
 		return Mat3x4f::identity();
@@ -247,80 +216,45 @@ __device__ Mat3x4f makeBeamSampleRayTransform(float hHalfDivergenceRad, float vH
 	return Mat3x4f::rotationRad(vAngle, 0.0f, 0.0f) * Mat3x4f::rotationRad(0.0f, hAngle, 0.0f);
 }
 
-__device__ void saveSampleAsNonHit(int sampleIdx, float nonHitDistance)
+__device__ void saveSampleAsNonHit(const RaytraceRequestContext& ctx, int sampleIdx, float nonHitDistance)
 {
 	ctx.mrSamples.isHit[sampleIdx] = false;
 	ctx.mrSamples.distance[sampleIdx] = nonHitDistance;
 }
 
-__device__ void saveSampleAsHit(int sampleIdx, float distance, float intensity, float laserRetro, int objectID,
-                                const Vec3f& absVelocity, const Vec3f& relVelocity, float radialSpeed, const Vec3f& normal,
-                                float incidentAngle)
+__device__ void saveSampleAsHit(const RaytraceRequestContext& ctx, int sampleIdx, const BeamSample& sample)
 {
 	ctx.mrSamples.isHit[sampleIdx] = true;
-	ctx.mrSamples.distance[sampleIdx] = distance;
-	ctx.mrSamples.intensity[sampleIdx] = intensity;
+	ctx.mrSamples.distance[sampleIdx] = sample.distance;
+	ctx.mrSamples.intensity[sampleIdx] = sample.intensity;
 
 	if (ctx.mrSamples.laserRetro != nullptr) {
-		ctx.mrSamples.laserRetro[sampleIdx] = laserRetro;
+		ctx.mrSamples.laserRetro[sampleIdx] = sample.laserRetro;
 	}
 	if (ctx.mrSamples.entityId != nullptr) {
-		ctx.mrSamples.entityId[sampleIdx] = objectID;
+		ctx.mrSamples.entityId[sampleIdx] = sample.entityId;
 	}
 	if (ctx.mrSamples.absVelocity != nullptr) {
-		ctx.mrSamples.absVelocity[sampleIdx] = absVelocity;
+		ctx.mrSamples.absVelocity[sampleIdx] = sample.absVelocity;
 	}
 	if (ctx.mrSamples.relVelocity != nullptr) {
-		ctx.mrSamples.relVelocity[sampleIdx] = relVelocity;
+		ctx.mrSamples.relVelocity[sampleIdx] = sample.relVelocity;
 	}
 	if (ctx.mrSamples.radialSpeed != nullptr) {
-		ctx.mrSamples.radialSpeed[sampleIdx] = radialSpeed;
+		ctx.mrSamples.radialSpeed[sampleIdx] = sample.radialSpeed;
 	}
 	if (ctx.mrSamples.normal != nullptr) {
-		ctx.mrSamples.normal[sampleIdx] = normal;
+		ctx.mrSamples.normal[sampleIdx] = sample.normal;
 	}
 	if (ctx.mrSamples.incidentAngle != nullptr) {
-		ctx.mrSamples.incidentAngle[sampleIdx] = incidentAngle;
+		ctx.mrSamples.incidentAngle[sampleIdx] = sample.incidentAngle;
 	}
 }
 
-__device__ void saveNonHitBeamSamples(int beamIdx, float nonHitDistance)
+__device__ void saveNonHitBeamSamples(const RaytraceRequestContext& ctx, int beamIdx, float nonHitDistance)
 {
 	for (int sampleIdx = beamIdx * MULTI_RETURN_BEAM_SAMPLES; sampleIdx < (beamIdx + 1) * MULTI_RETURN_BEAM_SAMPLES;
 	     ++sampleIdx) {
-		saveSampleAsNonHit(sampleIdx, nonHitDistance);
-	}
-}
-
-__device__ void saveBeamSharedData(int beamIdx, const Mat3x4f& rayLocal)
-{
-	for (int returnPointIdx = beamIdx * ctx.returnCount; returnPointIdx < (beamIdx + 1) * ctx.returnCount; ++returnPointIdx) {
-		if (ctx.rayIdx != nullptr) {
-			ctx.rayIdx[returnPointIdx] = beamIdx;
-		}
-
-		// Assuming up vector is Y, forward vector is Z (true for Unity).
-		// TODO(msz-rai): allow to define up and forward vectors in RGL
-		// Assuming rays are generated in left-handed coordinate system with the rotation applied in ZXY order.
-		// TODO(msz-rai): move ray generation to RGL to unify rotations
-		if (ctx.azimuth != nullptr) {
-			ctx.azimuth[returnPointIdx] = rayLocal.toRotationYOrderZXYLeftHandRad();
-		}
-		if (ctx.elevation != nullptr) {
-			ctx.elevation[returnPointIdx] = rayLocal.toRotationXOrderZXYLeftHandRad();
-		}
-
-		if (ctx.timestampF64 != nullptr) {
-			ctx.timestampF64[returnPointIdx] = ctx.doApplyDistortion ? ctx.rayTimeOffsetsMs[beamIdx] * 1e-3f : 0; // in seconds
-		}
-		if (ctx.timestampU32 != nullptr) {
-			ctx.timestampU32[returnPointIdx] = ctx.doApplyDistortion ?
-			                                       static_cast<uint32_t>(ctx.rayTimeOffsetsMs[beamIdx] * 1e6f) // in nanoseconds
-			                                       :
-			                                       0;
-		}
-		if (ctx.ringIdx != nullptr && ctx.ringIds != nullptr) {
-			ctx.ringIdx[returnPointIdx] = ctx.ringIds[beamIdx % ctx.ringIdsCount];
-		}
+		saveSampleAsNonHit(ctx, sampleIdx, nonHitDistance);
 	}
 }
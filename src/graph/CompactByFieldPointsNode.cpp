@@ -17,6 +17,7 @@
 #include <RGLFields.hpp>
 #include <repr.hpp>
 #include <graph/GraphRunCtx.hpp>
+#include <HostKernels.hpp>
 
 void CompactByFieldPointsNode::setParameters(rgl_field_t field) { this->fieldToCompactBy = field; }
 
@@ -33,14 +34,23 @@ void CompactByFieldPointsNode::validateImpl()
 void CompactByFieldPointsNode::enqueueExecImpl()
 {
 	cacheManager.trigger();
-	inclusivePrefixSum->resize(input->getHeight() * input->getWidth(), false, false);
 	size_t pointCount = input->getWidth() * input->getHeight();
 
 	auto requestedFieldData = input->getFieldData(fieldToCompactBy);
-	auto typedRequestedFieldDataPtr = requestedFieldData->asTyped<int32_t>()->asSubclass<DeviceAsyncArray>()->getReadPtr();
 
-	if (pointCount > 0) {
-		gpuFindCompaction(getStreamHandle(), pointCount, typedRequestedFieldDataPtr, inclusivePrefixSum->getWritePtr(), &width);
+	// Outputs of host execution are host arrays as well
+	isHostExecution = prepareHostExecution({requestedFieldData});
+	if (isHostExecution) {
+		inclusivePrefixSumHost->resize(pointCount, false, false);
+		auto typedRequestedFieldDataPtr = requestedFieldData->asTyped<int32_t>()->asSubclass<HostArray>()->getReadPtr();
+		width = hostFindCompaction(pointCount, typedRequestedFieldDataPtr, inclusivePrefixSumHost->getWritePtr());
+	} else {
+		inclusivePrefixSum->resize(pointCount, false, false);
+		auto typedRequestedFieldDataPtr = requestedFieldData->asTyped<int32_t>()->asSubclass<DeviceAsyncArray>()->getReadPtr();
+		if (pointCount > 0) {
+			gpuFindCompaction(getStreamHandle(), pointCount, typedRequestedFieldDataPtr, inclusivePrefixSum->getWritePtr(),
+			                  &width);
+		}
 	}
 
 	// getFieldData may be called in client's thread from rgl_graph_get_result_data
@@ -60,11 +70,37 @@ IAnyArray::ConstPtr CompactByFieldPointsNode::getFieldData(rgl_field_t field)
 {
 	std::lock_guard lock{getFieldDataMutex};
 
+	// Cached arrays are recreated if the input moved between host and device memory
+	if (cacheManager.contains(field) && isHost(cacheManager.getValue(field)->getMemoryKind()) != isHostExecution) {
+		cacheManager.remove(field);
+	}
+
 	if (!cacheManager.contains(field)) {
-		auto fieldData = createArray<DeviceAsyncArray>(field, arrayMgr);
+		auto fieldData = isHostExecution ? createArray<HostPageableArray>(field)
+		                                 : createArray<DeviceAsyncArray>(field, arrayMgr);
 		cacheManager.insert(field, fieldData, true);
 	}
 
+	if (!cacheManager.isLatest(field) && isHostExecution) {
+		auto fieldData = cacheManager.getValue(field);
+		fieldData->resize(width, false, false);
+		if (width > 0) {
+			auto fieldArray = input->getFieldData(field);
+			if (!isHost(fieldArray->getMemoryKind())) {
+				auto msg = fmt::format("CompactByFieldPointsNode requires its input to reside in host memory "
+				                       "if {} does, {} does not",
+				                       fieldToCompactBy, field);
+				throw InvalidPipeline(msg);
+			}
+			auto requestedFieldData = input->getFieldData(fieldToCompactBy);
+			auto typedRequestedFieldDataPtr = requestedFieldData->asTyped<int32_t>()->asSubclass<HostArray>()->getReadPtr();
+			hostApplyCompaction(input->getPointCount(), getFieldSize(field), typedRequestedFieldDataPtr,
+			                    inclusivePrefixSumHost->getReadPtr(), static_cast<char*>(fieldData->getRawWritePtr()),
+			                    static_cast<const char*>(fieldArray->getRawReadPtr()));
+		}
+		cacheManager.setUpdated(field);
+	}
+
 	if (!cacheManager.isLatest(field)) {
 		auto fieldData = cacheManager.getValue(field);
 		fieldData->resize(width, false, false);
@@ -83,11 +119,12 @@ IAnyArray::ConstPtr CompactByFieldPointsNode::getFieldData(rgl_field_t field)
 			gpuApplyCompaction(getStreamHandle(), input->getPointCount(), getFieldSize(field), typedRequestedFieldDataPtr, indices, outPtr,
 			                   inputPtr);
 			bool calledFromEnqueue = graphRunCtx.value()->isThisThreadGraphThread();
-			if (!calledFromEnqueue) {
+			if (!calledFromEnqueue || graphRunCtx.value()->hasConcurrentBranches()) {
 				// This is a special case, where API calls getFieldData for this field for the first time
 				// We did not enqueued compaction in enqueueExecImpl, yet, we are asked for results.
 				// This operation was enqueued in the graph stream, but API won't wait for whole graph stream.
 				// Therefore, we need a manual sync here.
+				// The same applies to a child node executed in another branch (stream) of the graph.
 				// TODO: remove this cancer.
 				CHECK_CUDA(cudaStreamSynchronize(getStreamHandle()));
 			}
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <graph/NodesCore.hpp>
+#include <HostKernels.hpp>
 
 void FilterGroundPointsNode::setParameters(const Vec3f& sensor_up_vector, float ground_angle_threshold)
 {
@@ -25,6 +26,16 @@ void FilterGroundPointsNode::validateImpl() { IPointsNodeSingleInput::validateIm
 void FilterGroundPointsNode::enqueueExecImpl()
 {
 	auto pointCount = input->getPointCount();
+
+	const auto inNormals = input->getFieldDataTyped<NORMAL_VEC3_F32>();
+	isHostExecution = prepareHostExecution({inNormals});
+	if (isHostExecution) {
+		outNonGroundHost->resize(pointCount, false, false);
+		hostFilterGroundPoints(pointCount, sensor_up_vector, ground_angle_threshold,
+		                       inNormals->asSubclass<HostArray>()->getReadPtr(), outNonGroundHost->getWritePtr());
+		return;
+	}
+
 	outNonGround->resize(pointCount, false, false);
 
 	const auto* inXyzPtr = input->getFieldDataTyped<XYZ_VEC3_F32>()->asSubclass<DeviceAsyncArray>()->getReadPtr();
@@ -38,6 +49,9 @@ void FilterGroundPointsNode::enqueueExecImpl()
 IAnyArray::ConstPtr FilterGroundPointsNode::getFieldData(rgl_field_t field)
 {
 	if (field == IS_GROUND_I32) {
+		if (isHostExecution) {
+			return outNonGroundHost;
+		}
 		return outNonGround;
 	}
 
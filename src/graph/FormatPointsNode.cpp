@@ -14,6 +14,7 @@
 
 #include <graph/NodesCore.hpp>
 #include <gpu/nodeKernels.hpp>
+#include <HostFormat.hpp>
 #include <RGLFields.hpp>
 #include <graph/GraphRunCtx.hpp>
 
@@ -27,9 +28,19 @@ void FormatPointsNode::setParameters(const std::vector<rgl_field_t>& fields)
 
 void FormatPointsNode::enqueueExecImpl()
 {
-	formatAsync(output, input, fields, gpuFieldDescBuilder);
 	auto bytes = getPointSize(fields) * input->getPointCount();
 	outputHost->resize(bytes, false, false);
+
+	// Input fields may reside in host memory (e.g. produced by TemporalMergePointsNode)
+	if (auto hostFieldsData = getHostFieldToPointerMappings(input, fields); hostFieldsData.has_value()) {
+		hostFormatSoaToAos(input->getPointCount(), *hostFieldsData, static_cast<char*>(outputHost->getRawWritePtr()));
+		output->resize(bytes, false, false);
+		CHECK_CUDA(cudaMemcpyAsync(output->getRawWritePtr(), outputHost->getRawReadPtr(), bytes, cudaMemcpyHostToDevice,
+		                           getStreamHandle()));
+		return;
+	}
+
+	formatAsync(output, input, fields, gpuFieldDescBuilder);
 	CHECK_CUDA(cudaMemcpyAsync(outputHost->getRawWritePtr(), output->getRawReadPtr(), bytes, cudaMemcpyDeviceToHost,
 	                           getStreamHandle()));
 }
@@ -43,9 +54,12 @@ void FormatPointsNode::formatAsync(DeviceAsyncArray<char>::Ptr output, const IPo
 	output->resize(pointCount * pointSize, false, false);
 
 	// Kernel Call
-	const GPUFieldDesc* gpuFieldsPtr =
-	    gpuFieldDescBuilder.buildReadableAsync(output->getStream(), getFieldToPointerMappings(input, fields)).getReadPtr();
+	auto fieldsData = getFieldToPointerMappings(input, fields);
 	char* outputPtr = output->getWritePtr();
+	if (gpuFormatSoaToAosLayout(output->getStream()->getHandle(), pointCount, fieldsData, outputPtr)) {
+		return;
+	}
+	const GPUFieldDesc* gpuFieldsPtr = gpuFieldDescBuilder.buildReadableAsync(output->getStream(), fieldsData).getReadPtr();
 	gpuFormatSoaToAos(output->getStream()->getHandle(), pointCount, pointSize, fields.size(), gpuFieldsPtr, outputPtr);
 }
 
@@ -89,3 +103,20 @@ std::vector<std::pair<rgl_field_t, const void*>> FormatPointsNode::getFieldToPoi
 	}
 	return outFieldsData;
 }
+
+std::optional<std::vector<std::pair<rgl_field_t, const void*>>> FormatPointsNode::getHostFieldToPointerMappings(
+    const IPointsNode::Ptr& input, const std::vector<rgl_field_t>& fields)
+{
+	std::vector<std::pair<rgl_field_t, const void*>> outFieldsData;
+	for (auto&& field : fields) {
+		outFieldsData.push_back({field, nullptr});
+		if (!isDummy(field)) {
+			IAnyArray::ConstPtr fieldArray = input->getFieldData(field);
+			if (isDeviceAccessible(fieldArray->getMemoryKind())) {
+				return std::nullopt;
+			}
+			outFieldsData.rbegin()->second = fieldArray->getRawReadPtr();
+		}
+	}
+	return outFieldsData;
+}
@@ -39,9 +39,12 @@ void FromArrayPointsNode::setParameters(const void* points, size_t pointCount, c
 	inputData->copyFromExternal(static_cast<const char*>(points), pointCount * pointSize);
 	const char* inputPtr = inputData->getReadPtr();
 
-	auto&& gpuFields = gpuFieldDescBuilder.buildWritableAsync(arrayMgr.getStream(), getFieldToPointerMappings(fields));
-	gpuFormatAosToSoa(arrayMgr.getStream()->getHandle(), pointCount, pointSize, fields.size(), inputPtr,
-	                  gpuFields.getReadPtr());
+	auto fieldsData = getFieldToPointerMappings(fields);
+	if (!gpuFormatAosToSoaLayout(arrayMgr.getStream()->getHandle(), pointCount, inputPtr, fieldsData)) {
+		auto&& gpuFields = gpuFieldDescBuilder.buildWritableAsync(arrayMgr.getStream(), fieldsData);
+		gpuFormatAosToSoa(arrayMgr.getStream()->getHandle(), pointCount, pointSize, fields.size(), inputPtr,
+		                  gpuFields.getReadPtr());
+	}
 	CHECK_CUDA(cudaStreamSynchronize(arrayMgr.getStream()->getHandle()));
 }
 
@@ -12,9 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <gpu/helpersKernels.hpp>
 #include <gpu/gaussianNoiseKernels.hpp>
 #include <graph/NodesCore.hpp>
+#include <HostKernels.hpp>
 
 void GaussianNoiseAngularHitpointNode::setParameters(float mean, float stDev, rgl_axis_t rotationAxis)
 {
@@ -42,6 +42,24 @@ void GaussianNoiseAngularHitpointNode::validateImpl()
 void GaussianNoiseAngularHitpointNode::enqueueExecImpl()
 {
 	auto pointCount = input->getPointCount();
+	auto frame = runCounter++;
+	const auto inXyz = input->getFieldDataTyped<XYZ_VEC3_F32>();
+
+	// Host execution produces the same noise
+	isHostExecution = prepareHostExecution({inXyz});
+	if (isHostExecution) {
+		outXyzHost->resize(pointCount, false, false);
+		Field<DISTANCE_F32>::type* outDistancePtr = nullptr;
+		if (outDistance != nullptr) {
+			outDistanceHost->resize(pointCount, false, false);
+			outDistancePtr = outDistanceHost->getWritePtr();
+		}
+		hostAddGaussianNoiseAngularHitpoint(pointCount, mean, stDev, rotationAxis, input->getLookAtOriginTransform(), seed,
+		                                    frame, inXyz->asSubclass<HostArray>()->getReadPtr(), outXyzHost->getWritePtr(),
+		                                    outDistancePtr);
+		return;
+	}
+
 	outXyz->resize(pointCount, false, false);
 
 	Field<DISTANCE_F32>::type* outDistancePtr = nullptr;
@@ -50,24 +68,24 @@ void GaussianNoiseAngularHitpointNode::enqueueExecImpl()
 		outDistancePtr = outDistance->getWritePtr();
 	}
 
-	if (randomizationStates->getCount() < pointCount) {
-		randomizationStates->resize(pointCount, false, false);
-		gpuSetupRandomNumberGenerator(getStreamHandle(), pointCount, randomDevice(), randomizationStates->getWritePtr());
-	}
-
-	const auto* inXyzPtr = input->getFieldDataTyped<XYZ_VEC3_F32>()->asSubclass<DeviceAsyncArray>()->getReadPtr();
+	const auto* inXyzPtr = inXyz->asSubclass<DeviceAsyncArray>()->getReadPtr();
 	auto* outXyzPtr = outXyz->getWritePtr();
-	auto* randPtr = randomizationStates->getWritePtr();
 	gpuAddGaussianNoiseAngularHitpoint(getStreamHandle(), pointCount, mean, stDev, rotationAxis,
-	                                   input->getLookAtOriginTransform(), randPtr, inXyzPtr, outXyzPtr, outDistancePtr);
+	                                   input->getLookAtOriginTransform(), seed, frame, inXyzPtr, outXyzPtr, outDistancePtr);
 }
 
 IAnyArray::ConstPtr GaussianNoiseAngularHitpointNode::getFieldData(rgl_field_t field)
 {
 	if (field == XYZ_VEC3_F32) {
+		if (isHostExecution) {
+			return outXyzHost;
+		}
 		return outXyz;
 	}
 	if (field == DISTANCE_F32 && outDistance != nullptr) {
+		if (isHostExecution) {
+			return outDistanceHost;
+		}
 		return outDistance;
 	}
 	return input->getFieldData(field);
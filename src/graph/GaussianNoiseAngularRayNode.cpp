@@ -12,7 +12,6 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <gpu/helpersKernels.hpp>
 #include <gpu/gaussianNoiseKernels.hpp>
 #include <graph/NodesCore.hpp>
 
@@ -29,14 +28,8 @@ void GaussianNoiseAngularRaysNode::enqueueExecImpl()
 	auto rayCount = input->getRayCount();
 	rays->resize(rayCount, false, false);
 
-	if (randomizationStates->getCount() < rayCount) {
-		randomizationStates->resize(rayCount, false, false);
-		gpuSetupRandomNumberGenerator(getStreamHandle(), rayCount, randomDevice(), randomizationStates->getWritePtr());
-	}
-
 	const auto* inRaysPtr = input->getRays()->asSubclass<DeviceAsyncArray>()->getReadPtr();
 	auto* outRaysPtr = rays->getWritePtr();
-	auto* randPtr = randomizationStates->getWritePtr();
 	gpuAddGaussianNoiseAngularRay(getStreamHandle(), getRayCount(), mean, stDev, rotationAxis,
-	                              input->getCumulativeRayTransfrom().inverse(), randPtr, inRaysPtr, outRaysPtr);
+	                              input->getCumulativeRayTransfrom().inverse(), seed, runCounter++, inRaysPtr, outRaysPtr);
 }
@@ -14,7 +14,7 @@
 
 #include <graph/NodesCore.hpp>
 #include <gpu/gaussianNoiseKernels.hpp>
-#include <gpu/helpersKernels.hpp>
+#include <HostKernels.hpp>
 
 void GaussianNoiseDistanceNode::setParameters(float mean, float stDevBase, float stDevRisePerMeter)
 {
@@ -26,29 +26,45 @@ void GaussianNoiseDistanceNode::setParameters(float mean, float stDevBase, float
 void GaussianNoiseDistanceNode::enqueueExecImpl()
 {
 	auto pointCount = input->getPointCount();
-	outXyz->resize(pointCount, false, false);
-	outDistance->resize(pointCount, false, false);
+	auto frame = runCounter++;
+	const auto inXyz = input->getFieldDataTyped<XYZ_VEC3_F32>();
+	const auto inDistance = input->getFieldDataTyped<DISTANCE_F32>();
 
-	if (randomizationStates->getCount() < pointCount) {
-		randomizationStates->resize(pointCount, false, false);
-		gpuSetupRandomNumberGenerator(getStreamHandle(), pointCount, randomDevice(), randomizationStates->getWritePtr());
+	// Host execution produces the same noise
+	isHostExecution = prepareHostExecution({inXyz, inDistance});
+	if (isHostExecution) {
+		outXyzHost->resize(pointCount, false, false);
+		outDistanceHost->resize(pointCount, false, false);
+		hostAddGaussianNoiseDistance(pointCount, mean, stDevBase, stDevRisePerMeter, input->getLookAtOriginTransform(), seed,
+		                             frame, inXyz->asSubclass<HostArray>()->getReadPtr(),
+		                             inDistance->asSubclass<HostArray>()->getReadPtr(), outXyzHost->getWritePtr(),
+		                             outDistanceHost->getWritePtr());
+		return;
 	}
 
-	const auto* inXyzPtr = input->getFieldDataTyped<XYZ_VEC3_F32>()->asSubclass<DeviceAsyncArray>()->getReadPtr();
-	const auto* inDistancePtr = input->getFieldDataTyped<DISTANCE_F32>()->asSubclass<DeviceAsyncArray>()->getReadPtr();
+	outXyz->resize(pointCount, false, false);
+	outDistance->resize(pointCount, false, false);
+	const auto* inXyzPtr = inXyz->asSubclass<DeviceAsyncArray>()->getReadPtr();
+	const auto* inDistancePtr = inDistance->asSubclass<DeviceAsyncArray>()->getReadPtr();
 	auto* outXyzPtr = outXyz->getWritePtr();
 	auto* outDistancePtr = outDistance->getWritePtr();
-	auto* randPtr = randomizationStates->getWritePtr();
 	gpuAddGaussianNoiseDistance(getStreamHandle(), pointCount, mean, stDevBase, stDevRisePerMeter,
-	                            input->getLookAtOriginTransform(), randPtr, inXyzPtr, inDistancePtr, outXyzPtr, outDistancePtr);
+	                            input->getLookAtOriginTransform(), seed, frame, inXyzPtr, inDistancePtr, outXyzPtr,
+	                            outDistancePtr);
 }
 
 IAnyArray::ConstPtr GaussianNoiseDistanceNode::getFieldData(rgl_field_t field)
 {
 	if (field == XYZ_VEC3_F32) {
+		if (isHostExecution) {
+			return outXyzHost;
+		}
 		return outXyz;
 	}
 	if (field == DISTANCE_F32) {
+		if (isHostExecution) {
+			return outDistanceHost;
+		}
 		return outDistance;
 	}
 	return input->getFieldData(field);
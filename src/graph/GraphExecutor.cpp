@@ -0,0 +1,95 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+
+#include <graph/GraphExecutor.hpp>
+
+GraphExecutor::GraphExecutor(size_t workerCount)
+{
+	workers.reserve(std::max<size_t>(workerCount, 1));
+	for (size_t i = 0; i < std::max<size_t>(workerCount, 1); ++i) {
+		workers.emplace_back(&GraphExecutor::workerMain, this);
+	}
+}
+
+void GraphExecutor::submit(Job job)
+{
+	// Queue is expected to hold at most a few jobs, in the unlikely case it is full, let workers catch up.
+	// If a job submits another one, the worker cannot wait for itself, so it helps by running a pending job.
+	while (!queue.tryPush(std::move(job))) {
+		if (!isWorkerThread() || !tryRunPendingJob()) {
+			std::this_thread::yield();
+		}
+	}
+	submittedCount.fetch_add(1, std::memory_order::release);
+	submittedCount.notify_one();
+}
+
+void GraphExecutor::waitIdle()
+{
+	const uint64_t target = submittedCount.load(std::memory_order::acquire);
+	uint64_t completed = completedCount.load(std::memory_order::acquire);
+	while (completed < target) {
+		completedCount.wait(completed, std::memory_order::acquire);
+		completed = completedCount.load(std::memory_order::acquire);
+	}
+}
+
+bool GraphExecutor::isWorkerThread() const
+{
+	return std::any_of(workers.begin(), workers.end(),
+	                   [](const std::thread& worker) { return worker.get_id() == std::this_thread::get_id(); });
+}
+
+bool GraphExecutor::tryRunPendingJob()
+{
+	Job job;
+	if (!queue.tryPop(job)) {
+		return false;
+	}
+	job();
+	job = nullptr;
+	completedCount.fetch_add(1, std::memory_order::release);
+	completedCount.notify_all();
+	return true;
+}
+
+void GraphExecutor::workerMain()
+{
+	uint64_t seenSubmitted = 0;
+	while (true) {
+		// Wait until something is submitted or stop is requested.
+		waitStrategy.load(std::memory_order::relaxed).waitWhileEqual(submittedCount, seenSubmitted, std::memory_order::acquire);
+		seenSubmitted = submittedCount.load(std::memory_order::acquire);
+
+		while (tryRunPendingJob())
+			;
+
+		if (stopRequested.load(std::memory_order::acquire)) {
+			return;
+		}
+	}
+}
+
+GraphExecutor::~GraphExecutor()
+{
+	stopRequested.store(true, std::memory_order::release);
+	// Bump the counter to wake up the workers, there is no job associated with it.
+	submittedCount.fetch_add(1, std::memory_order::release);
+	submittedCount.notify_all();
+	for (auto&& worker : workers) {
+		worker.join();
+	}
+}
@@ -0,0 +1,75 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <LockFreeQueue.hpp>
+#include <graph/WaitStrategy.hpp>
+
+/**
+ * Long-lived worker thread(s) executing jobs submitted through a lock-free queue.
+ * It replaces spawning (and joining) a new std::thread on every graph run.
+ * When there is no work, workers wait on an atomic counter according to the WaitStrategy (by default futex-backed sleep).
+ * Jobs are started in submission order; with a single worker they are also completed in that order.
+ * Jobs must not throw (GraphRunCtx catches everything on its own).
+ */
+struct GraphExecutor
+{
+	using Ptr = std::shared_ptr<GraphExecutor>;
+	using Job = std::function<void()>;
+
+	static GraphExecutor::Ptr create(size_t workerCount = 1) { return GraphExecutor::Ptr(new GraphExecutor(workerCount)); }
+
+	/**
+	 * Enqueues job for the worker thread. Never blocks unless the queue is full.
+	 */
+	void submit(Job job);
+
+	/**
+	 * Waits until all jobs submitted so far have finished.
+	 */
+	void waitIdle();
+
+	bool isWorkerThread() const;
+
+	size_t getWorkerCount() const { return workers.size(); }
+
+	/**
+	 * Sets how idle workers wait for new jobs. Takes effect from the next wait.
+	 */
+	void setWaitStrategy(WaitStrategy strategy) { waitStrategy.store(strategy, std::memory_order::relaxed); }
+
+	~GraphExecutor();
+
+private:
+	explicit GraphExecutor(size_t workerCount);
+
+	void workerMain();
+	bool tryRunPendingJob();
+
+	static constexpr size_t QUEUE_CAPACITY = 16;
+
+	LockFreeQueue<Job, QUEUE_CAPACITY> queue;
+	std::atomic<uint64_t> submittedCount{0};
+	std::atomic<uint64_t> completedCount{0};
+	std::atomic<bool> stopRequested{false};
+	std::atomic<WaitStrategy> waitStrategy{};
+	std::vector<std::thread> workers;
+};
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+
 #include <graph/GraphRunCtx.hpp>
 #include <graph/NodesCore.hpp>
 #include <graph/Node.hpp>
@@ -33,7 +35,9 @@ std::shared_ptr<GraphRunCtx> GraphRunCtx::createAndAttach(std::shared_ptr<Node>
 			throw std::logic_error(msg);
 		}
 		currentNode->setGraphRunCtx(graphRunCtx);
+		graphRunCtx->waitStrategy = WaitStrategy::strongest(graphRunCtx->waitStrategy, currentNode->getWaitStrategy());
 	}
+	graphRunCtx->executor->setWaitStrategy(graphRunCtx->waitStrategy);
 
 	graphRunCtx->graphOrdinal = GraphRunCtx::instances.size() + 1;
 	GraphRunCtx::instances.push_back(graphRunCtx);
@@ -47,6 +51,7 @@ void GraphRunCtx::executeAsync()
 
 	if (executionOrder.empty()) {
 		executionOrder = GraphRunCtx::findExecutionOrder(nodes);
+		prepareBranches();
 	}
 
 	// Perform validation in client's thread, this makes error reporting easier.
@@ -61,44 +66,146 @@ void GraphRunCtx::executeAsync()
 	for (auto&& node : executionOrder) {
 		executionStatus.try_emplace(node);
 	}
-	execThreadCanStart.store(false, std::memory_order_relaxed);
-
-	// TODO: this also applies to validation and executionStatus clearing
-	// In other parts of the code we rely on the following logic
-	// IF graph thread is working THEN this->thread.has_value()
-	// However, there is a very tight gap, where this is not true,
-	// because the graph thread could start before maybeThread is assigned.
-	// Therefore, the graph thread waits for execThreadCanStart
-	// which is set to true after client maybeThread has been assigned.
-	maybeThread = std::thread(&GraphRunCtx::executeThreadMain, this);
-	execThreadCanStart.store(true, std::memory_order::release);
-}
+	for (auto&& [head, _] : branchIndexOfHead) {
+		executionStatus.at(head).pendingInputCount.store(head->getInputs().size(), std::memory_order::relaxed);
+	}
 
+	// Unique among all graphs, so that results exported by a destroyed GraphRunCtx are not mistaken for the current ones.
+	static std::atomic<uint64_t> lastRunIndex{0};
+	runIndex = lastRunIndex.fetch_add(1, std::memory_order::relaxed) + 1;
 
-void GraphRunCtx::executeThreadMain()
-try {
-	// Wait for trigger from the client's thread
-	while (!execThreadCanStart.load(std::memory_order::acquire))
-		;
+	// Graph threads are persistent, here we only hand over the jobs.
+	// isExecutionPending must be set before submitting, because jobs may complete before submit() returns.
+	isExecutionPending = true;
+	runStartNanoseconds = nowNanoseconds();
+	if (std::any_of(executionOrder.begin(), executionOrder.end(), [](auto&& node) { return node->getProfiler() != nullptr; })) {
+		runStartTime = NodeProfiler::Clock::now();
+		CHECK_CUDA(cudaEventRecord(runStarted->getHandle(), stream->getHandle()));
+	}
+	for (size_t branchIdx = 0; branchIdx < branches.size(); ++branchIdx) {
+		if (branches.at(branchIdx).nodes.front()->getInputs().empty()) {
+			submitBranch(branchIdx);
+		}
+	}
+}
 
+void GraphRunCtx::prepareBranches()
+{
+	const bool concurrent = std::any_of(nodes.begin(), nodes.end(),
+	                                    [](const Node::Ptr& node) { return node->getConcurrentBranches(); });
+	branches.clear();
+	branchIndexOfHead.clear();
+	std::unordered_map<Node::ConstPtr, size_t> branchIndexOfNode;
 	for (auto&& node : executionOrder) {
-		RGL_DEBUG("Enqueueing node: {}", *node);
-		NvtxRange rg{graphOrdinal, NVTX_COL_WORK, "Enqueue({})", node->getName()};
-		node->enqueueExec();
-		executionStatus.at(node).enqueued.store(true);
-		executionStatus.at(node).enqueued.notify_all();
+		bool continuesInputBranch = !branches.empty() && !concurrent;
+		if (concurrent && node->getInputs().size() == 1) {
+			const auto& input = node->getInputs().front();
+			continuesInputBranch = input->getOutputs().front() == node;
+		}
+		if (continuesInputBranch) {
+			auto branchIdx = concurrent ? branchIndexOfNode.at(node->getInputs().front()) : 0;
+			branches.at(branchIdx).nodes.push_back(node);
+			branchIndexOfNode.insert({node, branchIdx});
+			continue;
+		}
+		branchIndexOfHead.insert({node, branches.size()});
+		branchIndexOfNode.insert({node, branches.size()});
+		branches.push_back({.nodes = {node}});
 	}
-	RGL_DEBUG("Node enqueueing done"); // This also logs the time diff for the last one
+
+	// There is no point in having more workers than CPU cores. Streams are assigned round-robin to match workers.
+	const size_t workerCount = std::clamp<size_t>(branches.size(), 1, std::max(std::thread::hardware_concurrency(), 1U));
+	while (auxStreams.size() + 1 < workerCount) {
+		auxStreams.push_back(CudaStream::create(cudaStreamNonBlocking));
+	}
+	auxStreams.resize(workerCount - 1);
+	for (size_t branchIdx = 0; branchIdx < branches.size(); ++branchIdx) {
+		auto& branch = branches.at(branchIdx);
+		branch.stream = (branchIdx == 0 || auxStreams.empty()) ? stream : auxStreams.at((branchIdx - 1) % auxStreams.size());
+		for (auto&& node : branch.nodes) {
+			node->setExecStream(branch.stream);
+		}
+	}
+
+	if (executor->getWorkerCount() != workerCount) {
+		executor = GraphExecutor::create(workerCount); // Previous executor is idle, because the graph was synchronized.
+		executor->setWaitStrategy(waitStrategy);
+	}
+	RGL_DEBUG("Graph {} split into {} branch(es) executed by {} worker(s)", graphOrdinal, branches.size(), workerCount);
 }
-catch (...) {
-	// Exception most likely happened in a Node, but might have happened around executionOrder loop.
+
+void GraphRunCtx::submitBranch(size_t branchIdx)
+{
+	// Incremented before submitting, so that synchronize() cannot observe zero while a branch is about to start.
+	runningBranchCount.fetch_add(1, std::memory_order::relaxed);
+	executor->submit([this, branchIdx]() { executeBranch(branchIdx); });
+}
+
+void GraphRunCtx::executeBranch(size_t branchIdx)
+{
+	const auto& branch = branches.at(branchIdx);
+	Node::Ptr currentNode = nullptr;
+	size_t enqueuedNodeCount = 0;
+	try {
+		// Inputs of the branch head may be enqueued to other streams.
+		for (auto&& input : branch.nodes.front()->getInputs()) {
+			CHECK_CUDA(cudaStreamWaitEvent(branch.stream->getHandle(), input->execCompleted->getHandle()));
+		}
+		for (auto&& node : branch.nodes) {
+			if (executionStatus.at(node).claimed.exchange(true, std::memory_order::acq_rel)) {
+				break; // Execution has been aborted by another branch.
+			}
+			currentNode = node;
+			RGL_DEBUG("Enqueueing node: {}", *node);
+			{
+				NvtxRange rg{graphOrdinal, NVTX_COL_WORK, "Enqueue({})", node->getName()};
+				node->enqueueExec();
+			}
+			currentNode = nullptr;
+			enqueuedNodeCount += 1;
+			executionStatus.at(node).enqueuedNanoseconds = nowNanoseconds();
+			executionStatus.at(node).enqueued.store(true);
+			executionStatus.at(node).enqueued.notify_all();
+
+			// Start branches that were waiting for this node.
+			for (auto&& output : node->getOutputs()) {
+				auto headIt = branchIndexOfHead.find(output);
+				if (headIt == branchIndexOfHead.end()) {
+					continue;
+				}
+				if (executionStatus.at(output).pendingInputCount.fetch_sub(1, std::memory_order::acq_rel) == 1) {
+					submitBranch(headIt->second);
+				}
+			}
+		}
+		RGL_DEBUG("Node enqueueing done"); // This also logs the time diff for the last one
+	}
+	catch (...) {
+		abortExecution(currentNode, std::current_exception());
+	}
+	// Exported after the whole branch is enqueued, so that copies do not delay the remaining nodes.
+	// Nodes enqueued before a failure still have valid results, so they are exported too.
+	for (size_t nodeIdx = 0; nodeIdx < enqueuedNodeCount; ++nodeIdx) {
+		branch.nodes.at(nodeIdx)->enqueueResultExport(runIndex);
+	}
+	if (runningBranchCount.fetch_sub(1, std::memory_order::acq_rel) == 1) {
+		runningBranchCount.notify_all();
+	}
+}
+
+void GraphRunCtx::abortExecution(const Node::Ptr& failedNode, std::exception_ptr exception)
+{
+	// Exception most likely happened in a Node, but might have happened around the branch loop.
 	// We still need to communicate that nodes 'executed' (even though some may not have a chance to start).
 	// If we didn't, we could hang client's thread in synchronizeNodeCPU() waiting for a Node that will never run.
+	// Nodes being executed by other branches are left to them (claimed), they will stop at their next node.
 	for (auto&& [node, state] : executionStatus) {
-		if (state.enqueued.load(std::memory_order::relaxed)) {
+		bool claimedByUs = node == failedNode;
+		if (!claimedByUs && state.claimed.exchange(true, std::memory_order::acq_rel)) {
 			continue;
 		}
-		state.exceptionPtr = std::current_exception();
+		state.exceptionPtr = exception;
+		state.enqueuedNanoseconds = nowNanoseconds();
 		state.enqueued.store(true);
 		state.enqueued.notify_all();
 	}
@@ -143,7 +250,7 @@ std::vector<std::shared_ptr<Node>> GraphRunCtx::findExecutionOrder(std::set<std:
 
 GraphRunCtx::~GraphRunCtx()
 {
-	// If GraphRunCtx is destroyed, we expect that thread was joined and stream was synced.
+	// If GraphRunCtx is destroyed, we expect that execution was completed and stream was synced.
 
 	// Log error if stream has pending work.
 	cudaError_t status = cudaStreamQuery(stream->getHandle());
@@ -152,9 +259,14 @@ GraphRunCtx::~GraphRunCtx()
 		status = cudaSuccess; // Ignore further checks.
 	}
 	CHECK_CUDA_NO_THROW(status);
+	for (auto&& auxStream : auxStreams) {
+		if (cudaStreamQuery(auxStream->getHandle()) == cudaErrorNotReady) {
+			RGL_WARN("~GraphRunCtx(): auxiliary stream has pending work!");
+		}
+	}
 
-	if (maybeThread.has_value()) {
-		RGL_WARN("~GraphRunCtx(): maybeThread has value!");
+	if (isExecutionPending) {
+		RGL_WARN("~GraphRunCtx(): execution is still pending!");
 	}
 }
 
@@ -170,29 +282,71 @@ void GraphRunCtx::detachAndDestroy()
 void GraphRunCtx::synchronize()
 {
 	NvtxRange rg{graphOrdinal, NVTX_COL_SYNC, "SyncGraph({})", graphOrdinal};
-	if (!maybeThread.has_value()) {
+	if (!isExecutionPending) {
 		return; // Already synchronized or never run.
 	}
 	// This order must be preserved.
 	for (auto&& node : executionOrder) {
 		synchronizeNodeCPU(node);
 	}
+	// Branch jobs may still be finishing (e.g. exporting results) after marking their last node.
+	for (auto running = runningBranchCount.load(std::memory_order::acquire); running != 0;
+	     running = runningBranchCount.load(std::memory_order::acquire)) {
+		waitStrategy.waitWhileEqual(runningBranchCount, running, std::memory_order::acquire);
+	}
 	CHECK_CUDA(cudaStreamSynchronize(stream->getHandle()));
-	maybeThread->join();
-	maybeThread.reset();
+	for (auto&& auxStream : auxStreams) {
+		CHECK_CUDA(cudaStreamSynchronize(auxStream->getHandle()));
+	}
+	isExecutionPending = false;
+
+	int64_t runEndNanoseconds = runStartNanoseconds;
+	for (auto&& [node, state] : executionStatus) {
+		runEndNanoseconds = std::max(runEndNanoseconds, state.enqueuedNanoseconds);
+	}
+	double runMicroseconds = static_cast<double>(runEndNanoseconds - runStartNanoseconds) / 1000.0;
+	latencyStats.runMicroseconds.addSample(runMicroseconds);
+	latencyStats.runMaxMicroseconds = std::max(latencyStats.runMaxMicroseconds, runMicroseconds);
+
+	completeProfiledRun();
+}
+
+void GraphRunCtx::completeProfiledRun()
+{
+	// Rays are counted for nodes that do not process points.
+	auto getElementCount = [](const Node::Ptr& node) -> size_t {
+		if (auto pointsNode = std::dynamic_pointer_cast<IPointsNode>(node)) {
+			return pointsNode->getPointCount();
+		}
+		if (auto raysNode = std::dynamic_pointer_cast<IRaysNode>(node)) {
+			return raysNode->getRayCount();
+		}
+		return 0;
+	};
+	for (auto&& node : executionOrder) {
+		auto profiler = node->getProfiler();
+		if (profiler == nullptr || !profiler->hasPendingRun()) {
+			continue;
+		}
+		size_t pointsIn = 0;
+		for (auto&& input : node->getInputs()) {
+			pointsIn += getElementCount(input);
+		}
+		profiler->completeRun(pointsIn, getElementCount(node), runStarted, runStartTime);
+	}
 }
 
 void GraphRunCtx::synchronizeNodeCPU(Node::ConstPtr nodeToSynchronize)
 {
-	if (!maybeThread.has_value()) {
+	if (!isExecutionPending) {
 		return; // Already synchronized or never run.
 	}
 	// Wait until node is executed
 	// This is call executed in client's thread, which is often engine's main thread.
-	// Therefore, we choose busy wait, since putting it to sleep & waking up would add additional latency.
+	// Therefore, the wait strategy is configurable: spinning reduces latency, sleeping leaves the core to the engine.
 	{
 		NvtxRange rg{graphOrdinal, NVTX_COL_SYNC_CPU, "SyncCPU({})", nodeToSynchronize->getName()};
-		executionStatus.at(nodeToSynchronize).enqueued.wait(false);
+		waitUntilNodeEnqueued(nodeToSynchronize);
 	}
 	// Rethrow exception, if any
 	if (auto ex = executionStatus.at(nodeToSynchronize).exceptionPtr) {
@@ -202,6 +356,41 @@ void GraphRunCtx::synchronizeNodeCPU(Node::ConstPtr nodeToSynchronize)
 	}
 }
 
+void GraphRunCtx::waitUntilNodeEnqueued(const Node::ConstPtr& node)
+{
+	auto& status = executionStatus.at(node);
+	if (status.enqueued.load(std::memory_order::acquire)) {
+		return; // Nothing to wait for, do not count it as a wakeup.
+	}
+	waitStrategy.waitWhileEqual(status.enqueued, false, std::memory_order::acquire);
+	double wakeupMicroseconds = static_cast<double>(nowNanoseconds() - status.enqueuedNanoseconds) / 1000.0;
+	latencyStats.wakeupMicroseconds.addSample(wakeupMicroseconds);
+	latencyStats.wakeupMaxMicroseconds = std::max(latencyStats.wakeupMaxMicroseconds, wakeupMicroseconds);
+}
+
+void GraphRunCtx::setWaitStrategy(WaitStrategy strategy)
+{
+	waitStrategy = strategy;
+	executor->setWaitStrategy(strategy);
+}
+
+bool GraphRunCtx::isNodeEnqueued(Node::ConstPtr node)
+{
+	if (!isExecutionPending) {
+		return true;
+	}
+	if (!executionStatus.at(node).enqueued.load(std::memory_order::acquire)) {
+		return false;
+	}
+	// Rethrow exception, if any
+	if (auto ex = executionStatus.at(node).exceptionPtr) {
+		// Avoid double throw
+		executionStatus.at(node).exceptionPtr = nullptr;
+		std::rethrow_exception(ex);
+	}
+	return true;
+}
+
 void GraphRunCtx::synchronizeAll()
 {
 	// No need to lock here, because the only concurrent modification may happen in the same thread.
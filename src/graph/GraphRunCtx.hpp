@@ -14,14 +14,18 @@
 
 #pragma once
 
+#include <chrono>
 #include <list>
 #include <set>
 #include <vector>
 #include <thread>
 
 #include <CudaStream.hpp>
+#include <graph/GraphExecutor.hpp>
 #include <graph/Node.hpp>
 #include <graph/NodesCore.hpp>
+#include <graph/WaitStrategy.hpp>
+#include <math/RunningStats.hpp>
 
 /**
  * Structure storing context for running a graph.
@@ -47,8 +51,8 @@ struct GraphRunCtx
 	/**
 	 * Waits until this GraphRunCtx
 	 * - finishes execution
-	 * - joins its thread
-	 * - synchronizes graph stream (all pending GPU operations)
+	 * - its executor finishes all branch jobs
+	 * - synchronizes graph streams (all pending GPU operations)
 	 */
 	void synchronize();
 
@@ -63,6 +67,37 @@ struct GraphRunCtx
 	 */
 	void synchronizeNodeCPU(Node::ConstPtr nodeToSynchronize);
 
+	/**
+	 * Does not block.
+	 * @return True if given node has finished its CPU execution in the current run (or the graph is not running).
+	 * If the node has failed, rethrows its exception.
+	 */
+	bool isNodeEnqueued(Node::ConstPtr node);
+
+	/**
+	 * @return Identifier of the last run of this GraphRunCtx, unique among all GraphRunCtx instances, zero if never run.
+	 */
+	uint64_t getRunIndex() const { return runIndex; }
+
+	/**
+	 * Latency of graph runs, measured in the client's thread when a run is synchronized.
+	 * - run: from the call to executeAsync() until the last node finishes its CPU execution
+	 * - wakeup: from the moment a node finishes until the client's thread waiting for it resumes (counted only if it waited)
+	 * Wakeup latency is the one affected by the WaitStrategy.
+	 */
+	struct LatencyStats
+	{
+		RunningStats<double> runMicroseconds;
+		double runMaxMicroseconds{0};
+		RunningStats<double> wakeupMicroseconds;
+		double wakeupMaxMicroseconds{0};
+	};
+
+	const LatencyStats& getLatencyStats() const { return latencyStats; }
+
+	void setWaitStrategy(WaitStrategy strategy);
+	WaitStrategy getWaitStrategy() const { return waitStrategy; }
+
 	/**
 	 * Marks all nodes dirty.
 	 */
@@ -75,27 +110,66 @@ struct GraphRunCtx
 
 	bool isThisThreadGraphThread() const
 	{
-		return maybeThread.has_value() && maybeThread->get_id() == std::this_thread::get_id();
+		return executor->isWorkerThread();
 	}
 
 	CudaStream::Ptr getStream() const { return stream; }
+	bool hasConcurrentBranches() const { return branches.size() > 1; }
 	const std::set<std::shared_ptr<Node>>& getNodes() const { return nodes; }
 
 	virtual ~GraphRunCtx();
 
 private:
-	GraphRunCtx() : stream(CudaStream::create(cudaStreamNonBlocking)) {}
+	GraphRunCtx() : stream(CudaStream::create(cudaStreamNonBlocking)), executor(GraphExecutor::create()) {}
 
 	static std::vector<std::shared_ptr<Node>> findExecutionOrder(std::set<std::shared_ptr<Node>> nodes);
 
-	void executeThreadMain();
+	/**
+	 * Splits executionOrder into branches - chains of nodes that can be enqueued independently of each other.
+	 * A new branch starts at every entry node, merge node and at every child of a fork except the first one.
+	 * If concurrent branches are disabled, the whole executionOrder forms a single branch.
+	 * Assigns streams to nodes and adjusts the number of executor's workers.
+	 */
+	void prepareBranches();
+
+	void submitBranch(size_t branchIdx);
+	void executeBranch(size_t branchIdx);
+	void abortExecution(const Node::Ptr& failedNode, std::exception_ptr exception);
+
+	using Clock = std::chrono::steady_clock;
+
+	static int64_t nowNanoseconds() { return std::chrono::nanoseconds(Clock::now().time_since_epoch()).count(); }
+
+	void waitUntilNodeEnqueued(const Node::ConstPtr& node);
+
+	/**
+	 * Passes measurements of the synchronized run to profilers of the nodes.
+	 */
+	void completeProfiledRun();
 
 	// Internal fields
 	CudaStream::Ptr stream;
-	std::optional<std::thread> maybeThread;
+	GraphExecutor::Ptr executor;
+	WaitStrategy waitStrategy{};
+	LatencyStats latencyStats;     // Modified only by client's thread
+	int64_t runStartNanoseconds{0}; // Modified only by client's thread
+	CudaEvent::Ptr runStarted{CudaEvent::create(cudaEventDefault)}; // Recorded only if any node is profiled
+	NodeProfiler::Clock::time_point runStartTime;
+	bool isExecutionPending{false}; // Modified only by client's thread
 	std::set<Node::Ptr> nodes;
 	std::vector<Node::Ptr> executionOrder;
+
+	struct ExecBranch
+	{
+		std::vector<Node::Ptr> nodes; // Subsequence of executionOrder, each node is the only child of the previous one
+		CudaStream::Ptr stream;
+	};
+	std::vector<ExecBranch> branches;
+	std::unordered_map<Node::ConstPtr, size_t> branchIndexOfHead;
+	std::vector<CudaStream::Ptr> auxStreams;  // Streams for branches other than the first one
+	std::atomic<uint32_t> runningBranchCount{0}; // Submitted, but not yet finished branch jobs
 	uint32_t graphOrdinal; // I.e. How many graphs already existed when this was created + 1
+	uint64_t runIndex{0};  // Modified only by client's thread, before submitting branches
 
 	// Used to synchronize all existing instances (e.g. to safely access Scene).
 	// Modified by client's thread, read by graph thread
@@ -107,11 +181,19 @@ private:
 		// If true, then execution has succeeded or an exception has been thrown.
 		std::atomic<bool> enqueued{false};
 
+		// Set by the thread that takes responsibility for completing this status (executing or aborting the node).
+		std::atomic<bool> claimed{false};
+
+		// Time (Clock) at which `enqueued` has been set; written before it, so the same rules as for exceptionPtr apply.
+		int64_t enqueuedNanoseconds{0};
+
+		// Used for branch heads only - number of inputs that are not enqueued yet.
+		std::atomic<uint32_t> pendingInputCount{0};
+
 		// exceptionPtr may be read by client's thread only after it acquire-read true `completed`
 		// exceptionPtr may be written by graph thread only before it release-stores true `completed`
 		std::exception_ptr exceptionPtr{nullptr};
 	};
 
 	std::unordered_map<Node::ConstPtr, NodeExecStatus> executionStatus;
-	std::atomic<bool> execThreadCanStart;
 };
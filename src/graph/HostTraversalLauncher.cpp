@@ -0,0 +1,204 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+#include <type_traits>
+
+#include <graph/HostTraversalLauncher.hpp>
+#include <gpu/BeamReturns.hpp>
+#include <scene/Scene.hpp>
+#include <RGLExceptions.hpp>
+#include <HostKernels.hpp>
+
+static constexpr float toDeg = (180.0f / M_PI);
+
+// Staged arrays are aligned for any field type
+static constexpr size_t STAGING_ALIGNMENT = 16;
+
+static size_t alignUp(size_t offset, size_t alignment) { return (offset + alignment - 1) / alignment * alignment; }
+
+template<typename Fn>
+static void forEachInput(RaytraceRequestContext& ctx, Fn&& fn)
+{
+	fn(ctx.raysWorld, ctx.rayCount);
+	fn(ctx.rayRanges, ctx.rayRangesCount);
+	fn(ctx.ringIds, ctx.ringIdsCount);
+	fn(ctx.rayTimeOffsetsMs, ctx.rayTimeOffsetsCount);
+	fn(ctx.rayMask, ctx.rayCount);
+}
+
+template<typename Fn>
+static void forEachOutput(RaytraceRequestContext& ctx, Fn&& fn)
+{
+	fn(ctx.xyz);
+	fn(ctx.isHit);
+	fn(ctx.rayIdx);
+	fn(ctx.ringIdx);
+	fn(ctx.returnType);
+	fn(ctx.distance);
+	fn(ctx.intensityF32);
+	fn(ctx.intensityU8);
+	fn(ctx.laserRetro);
+	fn(ctx.timestampF64);
+	fn(ctx.timestampU32);
+	fn(ctx.entityId);
+	fn(ctx.pointAbsVelocity);
+	fn(ctx.pointRelVelocity);
+	fn(ctx.radialSpeed);
+	fn(ctx.azimuth);
+	fn(ctx.elevation);
+	fn(ctx.normal);
+	fn(ctx.incidentAngle);
+}
+
+/**
+ * Host counterpart of __raygen__ and __closesthit__ / __miss__ optix programs for a single (non-divergent) beam.
+ */
+static void traceRay(const HostScene& scene, const RaytraceRequestContext& ctx, const Mat3x4f& worldToRayOrigin, int rayIdx)
+{
+	Mat3x4f ray = ctx.raysWorld[rayIdx];
+	const Mat3x4f rayLocal = worldToRayOrigin * ray;
+
+	saveBeamSharedData(ctx, rayIdx, rayLocal);
+	if (ctx.rayMask != nullptr && ctx.rayMask[rayIdx] == 0) {
+		saveBeamReturnsAsNonHit(ctx, rayIdx, ctx.farNonHitDistance);
+		return;
+	}
+
+	if (ctx.doApplyDistortion) {
+		// See __raygen__ for details
+		ray = Mat3x4f::TRS((ctx.rayTimeOffsetsMs[rayIdx] * ctx.sensorLinearVelocityXYZ) * 0.001f,
+		                   (ctx.rayTimeOffsetsMs[rayIdx] * (ctx.sensorAngularVelocityRPY * toDeg)) * 0.001f) *
+		      rayLocal;
+		ray = ctx.rayOriginToWorld * ray;
+	}
+
+	const float maxRange = ctx.rayRangesCount == 1 ? ctx.rayRanges[0].y() : ctx.rayRanges[rayIdx].y();
+	const Vec3f origin = ray * Vec3f{0, 0, 0};
+	const Vec3f dir = ray * Vec3f{0, 0, 1} - origin;
+	HostScene::Hit hit{};
+	if (!scene.intersect(origin, dir, maxRange, hit)) {
+		saveBeamReturnsAsNonHit(ctx, rayIdx, ctx.farNonHitDistance);
+		return;
+	}
+
+	const HostScene::Instance& instance = scene.getInstances()[hit.instanceIdx];
+	const EntitySBTData& entityData = instance.data;
+	const Vec3i triangleIndices = entityData.index[hit.triangleIdx];
+	const Vec3f& A = entityData.vertex[triangleIndices.x()];
+	const Vec3f& B = entityData.vertex[triangleIndices.y()];
+	const Vec3f& C = entityData.vertex[triangleIndices.z()];
+	const float u = hit.u;
+	const float v = hit.v;
+
+	const Vec3f hitObject = Vec3f((1 - u - v) * A + u * B + v * C);
+	const Vec3f hitWorld = instance.objectToWorld * hitObject;
+	const Vector<3, double> hwrd = hitWorld;
+	const Vector<3, double> hso = origin;
+	const double distance = (hwrd - hso).length();
+
+	const float minRange = ctx.rayRangesCount == 1 ? ctx.rayRanges[0].x() : ctx.rayRanges[rayIdx].x();
+	if (distance < minRange) {
+		saveBeamReturnsAsNonHit(ctx, rayIdx, ctx.nearNonHitDistance);
+		return;
+	}
+
+	float intensity = ctx.defaultIntensity;
+	if (entityData.textureCoords != nullptr && instance.texture != nullptr) {
+		const Vec2f& uvA = entityData.textureCoords[triangleIndices.x()];
+		const Vec2f& uvB = entityData.textureCoords[triangleIndices.y()];
+		const Vec2f& uvC = entityData.textureCoords[triangleIndices.z()];
+		intensity = instance.texture->sample((1 - u - v) * uvA + u * uvB + v * uvC);
+	}
+
+	const BeamSample sample = makeHitBeamSample(ctx, entityData, instance.entityId, instance.objectToWorld, triangleIndices, u,
+	                                            v, hitObject, hitWorld, static_cast<float>(distance), dir, intensity);
+	saveBeamReturnsAsHit(ctx, rayIdx, sample);
+}
+
+void HostTraversalLauncher::launch(cudaStream_t stream, RaytraceRequestContext request)
+{
+	if (request.doSampleBeams) {
+		throw InvalidPipeline("host traversal backend does not support beam divergence");
+	}
+	auto scene = Scene::instance().getHostSceneLocked();
+	request.scene = static_cast<OptixTraversableHandle>(0);
+	request.sceneDeltaTime = static_cast<float>(Scene::instance().getDeltaTime().value_or(Time::zero()).asSeconds());
+
+	// Stage inputs
+	size_t inputSize = 0;
+	forEachInput(request, [&](auto*& ptr, size_t count) {
+		if (ptr != nullptr) {
+			inputSize = alignUp(inputSize, STAGING_ALIGNMENT) + count * sizeof(*ptr);
+		}
+	});
+	inputStaging->resize(inputSize, false, false);
+	size_t inputOffset = 0;
+	forEachInput(request, [&](auto*& ptr, size_t count) {
+		if (ptr == nullptr) {
+			return;
+		}
+		inputOffset = alignUp(inputOffset, STAGING_ALIGNMENT);
+		char* hostPtr = inputStaging->getWritePtr() + inputOffset;
+		CHECK_CUDA(cudaMemcpyAsync(hostPtr, ptr, count * sizeof(*ptr), cudaMemcpyDeviceToHost, stream));
+		ptr = reinterpret_cast<std::remove_reference_t<decltype(ptr)>>(hostPtr);
+		inputOffset += count * sizeof(*ptr);
+	});
+
+	// Redirect outputs to the staging, remembering where to copy them back
+	struct OutputCopy
+	{
+		void* devicePtr;
+		const void* hostPtr;
+		size_t size;
+	};
+	const size_t returnPointCount = request.rayCount * request.returnCount;
+	size_t outputSize = 0;
+	forEachOutput(request, [&](auto*& ptr) {
+		if (ptr != nullptr) {
+			outputSize = alignUp(outputSize, STAGING_ALIGNMENT) + returnPointCount * sizeof(*ptr);
+		}
+	});
+	outputStaging->resize(outputSize, false, false);
+	std::vector<OutputCopy> outputCopies;
+	size_t outputOffset = 0;
+	forEachOutput(request, [&](auto*& ptr) {
+		if (ptr == nullptr) {
+			return;
+		}
+		outputOffset = alignUp(outputOffset, STAGING_ALIGNMENT);
+		char* hostPtr = outputStaging->getWritePtr() + outputOffset;
+		outputCopies.push_back({ptr, hostPtr, returnPointCount * sizeof(*ptr)});
+		ptr = reinterpret_cast<std::remove_reference_t<decltype(ptr)>>(hostPtr);
+		outputOffset += returnPointCount * sizeof(*ptr);
+	});
+
+	// Inputs must be ready before tracing
+	CHECK_CUDA(cudaStreamSynchronize(stream));
+
+	// Rays are traced in chunks, handed out dynamically, since the cost of rays varies a lot
+	const Mat3x4f worldToRayOrigin = request.rayOriginToWorld.inverse();
+	hostParallelFor(request.rayCount, RAYS_PER_CHUNK, [&](size_t begin, size_t end) {
+		for (size_t rayIdx = begin; rayIdx < end; ++rayIdx) {
+			traceRay(*scene, request, worldToRayOrigin, static_cast<int>(rayIdx));
+		}
+	});
+
+	for (auto&& copy : outputCopies) {
+		CHECK_CUDA(cudaMemcpyAsync(copy.devicePtr, copy.hostPtr, copy.size, cudaMemcpyHostToDevice, stream));
+	}
+	// Staging is reused by the next launch
+	CHECK_CUDA(cudaStreamSynchronize(stream));
+}
@@ -0,0 +1,44 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <cstddef>
+
+#include <memory/Array.hpp>
+#include <gpu/RaytraceRequestContext.hpp>
+
+/**
+ * Raytraces requests by traversing the host snapshot of the scene on the CPU (see Scene::getHostSceneLocked).
+ * It is an alternative to RaytraceLauncher that does not use optix, producing the same outputs as optix programs.
+ * Inputs of the request are staged to the host, rays are traced by a pool of threads in chunks,
+ * then outputs are copied back to the device arrays of the request, so the rest of the graph is not affected.
+ * Beam divergence (sampling of multi-return beams) is not supported.
+ */
+struct HostTraversalLauncher
+{
+	static constexpr size_t RAYS_PER_CHUNK = 256;
+
+	/**
+	 * Raytraces the request after the work already enqueued in the given stream.
+	 * Returns once the results are written, i.e. the stream does not need to wait for anything.
+	 */
+	void launch(cudaStream_t stream, RaytraceRequestContext request);
+
+private:
+	// Reused between launches to avoid pinned allocations
+	HostPinnedArray<char>::Ptr inputStaging = HostPinnedArray<char>::create();
+	HostPinnedArray<char>::Ptr outputStaging = HostPinnedArray<char>::create();
+};
@@ -20,6 +20,7 @@
 #include <gpu/GPUFieldDesc.hpp>
 
 #include <memory/Array.hpp>
+#include <graph/ResultBuffer.hpp>
 
 struct IRaysNode : virtual Node
 {
@@ -99,6 +100,42 @@ struct IPointsNode : virtual Node
 	{
 		return getFieldData(field)->template asTyped<typename Field<field>::type>();
 	}
+
+	// Client's buffers, to which results are exported after each run
+	void setResultBuffer(rgl_field_t field, ResultBuffer::Ptr buffer)
+	{
+		if (buffer == nullptr) {
+			resultBuffers.erase(field);
+			return;
+		}
+		resultBuffers.insert_or_assign(field, buffer);
+	}
+
+	ResultBuffer::Ptr getResultBuffer(rgl_field_t field) const
+	{
+		auto it = resultBuffers.find(field);
+		return it != resultBuffers.end() ? it->second : nullptr;
+	}
+
+protected:
+	void enqueueResultExport(uint64_t runIndex) override
+	{
+		for (auto&& [field, buffer] : resultBuffers) {
+			try {
+				if (!hasField(field)) {
+					auto msg = fmt::format("node {} does not provide field {}", getName(), toString(field));
+					throw InvalidPipeline(msg);
+				}
+				buffer->enqueueExport(getFieldData(field), getFieldPointSize(field), getStreamHandle(), runIndex);
+			}
+			catch (...) {
+				buffer->setExportFailed(std::current_exception(), runIndex);
+			}
+		}
+	}
+
+private:
+	std::unordered_map<rgl_field_t, ResultBuffer::Ptr> resultBuffers;
 };
 
 struct IPointsNodeSingleInput : IPointsNode
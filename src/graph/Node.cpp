@@ -123,8 +123,14 @@ void Node::enqueueExec()
 		auto msg = fmt::format("{}: attempted to call enqueueExec() despite !isValid()", getName());
 		throw std::logic_error(msg);
 	}
+	if (profiler != nullptr) {
+		profiler->beginEnqueue(getStreamHandle());
+	}
 	this->enqueueExecImpl();
-	CHECK_CUDA(cudaEventRecord(execCompleted->getHandle(), getGraphRunCtx()->getStream()->getHandle()));
+	if (profiler != nullptr) {
+		profiler->endEnqueue(getStreamHandle());
+	}
+	CHECK_CUDA(cudaEventRecord(execCompleted->getHandle(), getStreamHandle()));
 }
 
 std::set<Node::Ptr> Node::getConnectedComponentNodes()
@@ -183,7 +189,17 @@ void Node::waitForResults()
 	synchronize();
 }
 
-cudaStream_t Node::getStreamHandle() { return getGraphRunCtx()->getStream()->getHandle(); }
+cudaStream_t Node::getStreamHandle() { return arrayMgr.getStream()->getHandle(); }
+
+bool Node::prepareHostExecution(std::initializer_list<std::shared_ptr<const IAnyArray>> inputArrays)
+{
+	bool allHost = std::all_of(inputArrays.begin(), inputArrays.end(),
+	                           [](auto&& array) { return isHost(array->getMemoryKind()); });
+	if (allHost) {
+		CHECK_CUDA(cudaStreamSynchronize(getStreamHandle()));
+	}
+	return allHost;
+}
 
 void Node::setPriority(int32_t requestedPriority)
 {
@@ -213,4 +229,33 @@ void Node::setPriority(int32_t requestedPriority)
 		// Synchronized with Graph thread on API level
 		graphRunCtx.value()->executionOrder.clear();
 	}
-}
\ No newline at end of file
+}
+
+void Node::setConcurrentBranches(bool enabled)
+{
+	if (enabled == concurrentBranches) {
+		return;
+	}
+	concurrentBranches = enabled;
+	if (hasGraphRunCtx()) {
+		// Synchronized with Graph thread on API level
+		graphRunCtx.value()->executionOrder.clear();
+	}
+}
+
+void Node::setWaitStrategy(WaitStrategy strategy)
+{
+	waitStrategy = strategy;
+	if (hasGraphRunCtx()) {
+		// Synchronized with Graph thread on API level
+		graphRunCtx.value()->setWaitStrategy(strategy);
+	}
+}
+
+void Node::setProfilingEnabled(bool enabled)
+{
+	if (enabled == (profiler != nullptr)) {
+		return;
+	}
+	profiler = enabled ? NodeProfiler::create() : nullptr;
+}
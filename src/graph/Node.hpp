@@ -25,6 +25,8 @@
 #include <RGLFields.hpp>
 #include <rgl/api/core.h>
 #include <StreamBoundObjectsManager.hpp>
+#include <graph/NodeProfiler.hpp>
+#include <graph/WaitStrategy.hpp>
 
 struct GraphRunCtx;
 
@@ -110,6 +112,26 @@ struct Node : APIObject<Node>, std::enable_shared_from_this<Node>
 	void setPriority(int32_t);
 	int32_t getPriority() const { return priority; }
 
+	/**
+	 * If enabled for any node in the graph, independent branches of the graph are executed concurrently,
+	 * each on its own worker thread and stream. Priorities then order only the start of branches.
+	 */
+	void setConcurrentBranches(bool enabled);
+	bool getConcurrentBranches() const { return concurrentBranches; }
+
+	/**
+	 * Determines how threads wait for the execution of the graph (client's thread for nodes, workers for jobs).
+	 * Applies to the whole graph; graphs joined by rgl_graph_node_add_child use the most latency-oriented one.
+	 */
+	void setWaitStrategy(WaitStrategy strategy);
+	WaitStrategy getWaitStrategy() const { return waitStrategy; }
+
+	/**
+	 * Enables collecting per-run statistics of this node (see NodeProfiler). Disabling discards collected statistics.
+	 */
+	void setProfilingEnabled(bool enabled);
+	NodeProfiler::Ptr getProfiler() const { return profiler; }
+
 public: // Debug methods
 	std::string getName() const { return name(typeid(*this)); }
 
@@ -132,6 +154,12 @@ protected: // Member methods
 	 */
 	virtual void validateImpl() = 0;
 
+	/**
+	 * Placeholder to enqueue copies of node's results to buffers registered by the client.
+	 * Called by GraphRunCtx once the whole branch containing this node is enqueued. Must not throw.
+	 */
+	virtual void enqueueResultExport(uint64_t runIndex) {}
+
 	/**
 	 * @return True, if node can be executed.
 	 */
@@ -146,6 +174,14 @@ protected: // Member methods
 
 	cudaStream_t getStreamHandle();
 
+	/**
+	 * Nodes supporting it process host-resident input (e.g. from TemporalMergePointsNode) on the host,
+	 * without copying it to the device and back.
+	 * @return True, if all given arrays reside in host memory. The node's stream is then synchronized,
+	 * because copies writing the arrays may still be enqueued in it.
+	 */
+	bool prepareHostExecution(std::initializer_list<std::shared_ptr<const IAnyArray>> inputArrays);
+
 	template<typename T>
 	typename T::Ptr getExactlyOneInputOfType()
 	{
@@ -160,6 +196,11 @@ private: // Used by friend GraphRunCtx
 	 */
 	void setGraphRunCtx(std::optional<std::shared_ptr<GraphRunCtx>> graph);
 
+	/**
+	 * Called by GraphRunCtx to select the stream (one of GraphRunCtx's streams) this node enqueues its work to.
+	 */
+	void setExecStream(CudaStream::Ptr stream) { arrayMgr.setStream(stream); }
+
 public: // Static methods
 	template<template<typename, typename...> typename Container, typename... CArgs>
 	static std::string getNamesOfNodes(const Container<Node::Ptr, CArgs...>& nodes, std::string_view separator = ", ")
@@ -205,6 +246,9 @@ protected:
 	std::vector<Node::Ptr> inputs{};
 	std::vector<Node::Ptr> outputs{}; // Always sorted by priority (descending)
 	int32_t priority{0};              // Must be >= than children priorities
+	bool concurrentBranches{false};
+	WaitStrategy waitStrategy{};
+	NodeProfiler::Ptr profiler{nullptr};
 
 	bool dirty{true};
 	CudaEvent::Ptr execCompleted{nullptr};
@@ -0,0 +1,127 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <functional>
+#include <string_view>
+#include <thread>
+
+#include <graph/NodeProfiler.hpp>
+#include <memory/AllocationCounter.hpp>
+
+void NodeProfiler::beginEnqueue(cudaStream_t stream)
+{
+	CHECK_CUDA(cudaEventRecord(gpuStarted->getHandle(), stream));
+	allocatedBytesAtStart = AllocationCounter::getThreadAllocatedBytes();
+	cpuStart = Clock::now();
+}
+
+void NodeProfiler::endEnqueue(cudaStream_t stream)
+{
+	cpuEnd = Clock::now();
+	allocatedBytes = AllocationCounter::getThreadAllocatedBytes() - allocatedBytesAtStart;
+	CHECK_CUDA(cudaEventRecord(gpuCompleted->getHandle(), stream));
+	threadId = std::hash<std::thread::id>{}(std::this_thread::get_id());
+	streamId = reinterpret_cast<uintptr_t>(stream);
+	runPending = true;
+}
+
+void NodeProfiler::completeRun(size_t pointsIn, size_t pointsOut, const CudaEvent::Ptr& runStarted,
+                               Clock::time_point runStartTime)
+{
+	if (!runPending) {
+		return;
+	}
+	runPending = false;
+
+	TraceEvent event{
+	    .cpuStart = toMicroseconds(cpuStart),
+	    .cpuDuration = std::chrono::duration<double, std::micro>(cpuEnd - cpuStart).count(),
+	    .threadId = threadId,
+	    .streamId = streamId,
+	};
+	float gpuMilliseconds = 0.0f;
+	if (cudaEventElapsedTime(&gpuMilliseconds, gpuStarted->getHandle(), gpuCompleted->getHandle()) == cudaSuccess) {
+		event.gpuDuration = gpuMilliseconds * 1000.0;
+		if (runStarted != nullptr &&
+		    cudaEventElapsedTime(&gpuMilliseconds, runStarted->getHandle(), gpuStarted->getHandle()) == cudaSuccess) {
+			event.gpuStart = toMicroseconds(runStartTime) + gpuMilliseconds * 1000.0;
+		}
+	}
+	else {
+		// GPU time is not available (e.g. events were not reached); clear the error state and keep CPU measurements.
+		cudaGetLastError();
+	}
+
+	stats.cpuMicroseconds.addSample(event.cpuDuration);
+	if (event.gpuDuration.has_value()) {
+		stats.gpuMicroseconds.addSample(event.gpuDuration.value());
+	}
+	stats.allocatedBytesTotal += allocatedBytes;
+	stats.allocatedBytesLast = allocatedBytes;
+	stats.pointsIn.addSample(static_cast<double>(pointsIn));
+	stats.pointsOut.addSample(static_cast<double>(pointsOut));
+
+	traceEvents.push_back(event);
+	if (traceEvents.size() > MAX_TRACE_EVENTS) {
+		traceEvents.pop_front();
+	}
+}
+
+void NodeProfiler::writeJson(std::ostream& out, const std::vector<Entry>& entries)
+{
+	auto formatStats = [](const RunningStats<double>& rs) {
+		return fmt::format(R"({{"count": {}, "mean": {:.3f}, "std_dev": {:.3f}, "last": {:.3f}}})", rs.getSamplesCount(),
+		                   rs.getMean(), rs.getStdDev(), rs.getLastSample());
+	};
+	out << "[";
+	for (size_t i = 0; i < entries.size(); ++i) {
+		const auto& [name, id, profiler] = entries.at(i);
+		const auto& stats = profiler->getStats();
+		out << (i == 0 ? "\n" : ",\n");
+		out << fmt::format(R"(  {{"name": "{}", "id": "{}", "cpu_us": {}, "gpu_us": {}, )", name, id,
+		                   formatStats(stats.cpuMicroseconds), formatStats(stats.gpuMicroseconds));
+		out << fmt::format(R"("allocated_bytes": {{"total": {}, "last": {}}}, "points_in": {}, "points_out": {}}})",
+		                   stats.allocatedBytesTotal, stats.allocatedBytesLast, formatStats(stats.pointsIn),
+		                   formatStats(stats.pointsOut));
+	}
+	out << "\n]\n";
+}
+
+void NodeProfiler::writeChromeTrace(std::ostream& out, const std::vector<Entry>& entries)
+{
+	static constexpr int CPU_PID = 0;
+	static constexpr int GPU_PID = 1;
+	auto formatProcessName = [](int pid, std::string_view name) {
+		return fmt::format(R"({{"name": "process_name", "ph": "M", "pid": {}, "args": {{"name": "{}"}}}})", pid, name);
+	};
+	out << R"({"displayTimeUnit": "ms", "traceEvents": [)" << "\n";
+	out << "  " << formatProcessName(CPU_PID, "CPU (enqueue)") << ",\n";
+	out << "  " << formatProcessName(GPU_PID, "GPU (streams)");
+	for (auto&& [name, id, profiler] : entries) {
+		for (auto&& event : profiler->getTraceEvents()) {
+			out << fmt::format(
+			    ",\n  {{\"name\": \"{}\", \"cat\": \"cpu\", \"ph\": \"X\", \"ts\": {:.3f}, \"dur\": {:.3f}, \"pid\": {}, "
+			    "\"tid\": {}, \"args\": {{\"id\": \"{}\"}}}}",
+			    name, event.cpuStart, event.cpuDuration, CPU_PID, event.threadId, id);
+			if (!event.gpuStart.has_value() || !event.gpuDuration.has_value()) {
+				continue;
+			}
+			out << fmt::format(
+			    ",\n  {{\"name\": \"{}\", \"cat\": \"gpu\", \"ph\": \"X\", \"ts\": {:.3f}, \"dur\": {:.3f}, \"pid\": {}, "
+			    "\"tid\": {}, \"args\": {{\"id\": \"{}\"}}}}",
+			    name, event.gpuStart.value(), event.gpuDuration.value(), GPU_PID, event.streamId, id);
+		}
+	}
+	out << "\n]}\n";
+}
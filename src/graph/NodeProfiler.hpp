@@ -0,0 +1,132 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <CudaEvent.hpp>
+#include <math/RunningStats.hpp>
+
+/**
+ * Collects rolling statistics of a single Node: CPU enqueue time, GPU time, allocated memory and point counts.
+ * Measurement is split in two parts to keep the overhead low enough to be left enabled:
+ * - beginEnqueue() / endEnqueue() are called by the graph thread around Node::enqueueExecImpl();
+ *   they only read the clock and the AllocationCounter and record two CUDA events,
+ * - completeRun() is called by the client's thread once the run is synchronized;
+ *   GPU work is complete by then, so reading the events does not block.
+ */
+struct NodeProfiler
+{
+	using Ptr = std::shared_ptr<NodeProfiler>;
+	using ConstPtr = std::shared_ptr<const NodeProfiler>;
+	using Clock = std::chrono::steady_clock;
+
+	// Number of the most recent runs kept for traces.
+	static constexpr size_t MAX_TRACE_EVENTS = 256;
+
+	struct Stats
+	{
+		RunningStats<double> cpuMicroseconds;
+		RunningStats<double> gpuMicroseconds;
+		uint64_t allocatedBytesTotal{0};
+		uint64_t allocatedBytesLast{0};
+		RunningStats<double> pointsIn;
+		RunningStats<double> pointsOut;
+	};
+
+	/**
+	 * Single run of the node. Timestamps are microseconds since the epoch of Clock.
+	 */
+	struct TraceEvent
+	{
+		double cpuStart;
+		double cpuDuration;
+		size_t threadId;
+		std::optional<double> gpuStart; // Estimated, relative to the run start event, see completeRun()
+		std::optional<double> gpuDuration;
+		uintptr_t streamId;
+	};
+
+	/**
+	 * Profiled node as seen by the writers.
+	 */
+	struct Entry
+	{
+		std::string name;
+		const void* id;
+		NodeProfiler::ConstPtr profiler;
+	};
+
+	static NodeProfiler::Ptr create() { return NodeProfiler::Ptr(new NodeProfiler()); }
+
+	static double toMicroseconds(Clock::time_point time)
+	{
+		return std::chrono::duration<double, std::micro>(time.time_since_epoch()).count();
+	}
+
+	void beginEnqueue(cudaStream_t stream);
+	void endEnqueue(cudaStream_t stream);
+
+	/**
+	 * @return True if the node has been enqueued since the last completeRun().
+	 */
+	bool hasPendingRun() const { return runPending; }
+
+	/**
+	 * Adds the last enqueued run to the statistics, does nothing if there is none.
+	 * Must be called after all GPU work of the run has completed.
+	 * @param runStarted Optional event recorded at the start of the run (at runStartTime),
+	 * used to place GPU work on the CPU timeline. This is an estimate, assuming that the event was reached immediately.
+	 */
+	void completeRun(size_t pointsIn, size_t pointsOut, const CudaEvent::Ptr& runStarted, Clock::time_point runStartTime);
+
+	const Stats& getStats() const { return stats; }
+	const std::deque<TraceEvent>& getTraceEvents() const { return traceEvents; }
+
+	/**
+	 * Writes statistics of the given nodes as a JSON array.
+	 */
+	static void writeJson(std::ostream& out, const std::vector<Entry>& entries);
+
+	/**
+	 * Writes recent runs of the given nodes in the Trace Event Format (chrome://tracing, Perfetto).
+	 * CPU enqueueing is shown per thread, GPU work per stream.
+	 */
+	static void writeChromeTrace(std::ostream& out, const std::vector<Entry>& entries);
+
+private:
+	NodeProfiler() = default;
+
+	CudaEvent::Ptr gpuStarted = CudaEvent::create(cudaEventDefault);
+	CudaEvent::Ptr gpuCompleted = CudaEvent::create(cudaEventDefault);
+
+	// Written by graph thread, read by client's thread after synchronization
+	Clock::time_point cpuStart;
+	Clock::time_point cpuEnd;
+	uint64_t allocatedBytesAtStart{0};
+	uint64_t allocatedBytes{0};
+	size_t threadId{0};
+	uintptr_t streamId{0};
+	bool runPending{false};
+
+	Stats stats;
+	std::deque<TraceEvent> traceEvents;
+};
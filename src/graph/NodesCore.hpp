@@ -23,16 +23,21 @@
 #include <algorithm>
 #include <random>
 #include <queue>
-#include <curand_kernel.h>
+#include <deque>
+#include <array>
 
 #include <graph/Node.hpp>
 #include <graph/Interfaces.hpp>
+#include <graph/RadarClustering.hpp>
+#include <graph/RaytraceBatch.hpp>
+#include <graph/HostTraversalLauncher.hpp>
 #include <gpu/RaytraceRequestContext.hpp>
 #include <gpu/nodeKernels.hpp>
 #include <CacheManager.hpp>
 #include <GPUFieldDescBuilder.hpp>
 #include <math/Aabb.h>
 #include <math/RunningStats.hpp>
+#include <math/Philox.hpp>
 #include <gpu/MultiReturn.hpp>
 #include <returnModeUtils.h>
 #include <Time.hpp>
@@ -68,6 +73,10 @@ struct FormatPointsNode : IPointsNodeSingleInput
 	                                                                                  const std::vector<rgl_field_t>& fields);
 
 private:
+	// Returns mappings only if all input fields reside in host-only memory
+	static std::optional<std::vector<std::pair<rgl_field_t, const void*>>> getHostFieldToPointerMappings(
+	    const IPointsNode::Ptr& input, const std::vector<rgl_field_t>& fields);
+
 	std::vector<rgl_field_t> fields;
 	DeviceAsyncArray<char>::Ptr output = DeviceAsyncArray<char>::create(arrayMgr);
 	HostPinnedArray<char>::Ptr outputHost = HostPinnedArray<char>::create();
@@ -98,6 +107,9 @@ private:
 	rgl_field_t fieldToCompactBy;
 	size_t width = {0};
 	DeviceAsyncArray<CompactionIndexType>::Ptr inclusivePrefixSum = DeviceAsyncArray<CompactionIndexType>::create(arrayMgr);
+	// Used instead of inclusivePrefixSum if the input resides in host memory; outputs are host arrays then as well
+	HostPageableArray<CompactionIndexType>::Ptr inclusivePrefixSumHost = HostPageableArray<CompactionIndexType>::create();
+	bool isHostExecution{false};
 	CacheManager<rgl_field_t, IAnyArray::Ptr> cacheManager;
 	std::mutex getFieldDataMutex;
 };
@@ -106,6 +118,7 @@ struct RaytraceNode : IPointsNode
 {
 	using Ptr = std::shared_ptr<RaytraceNode>;
 	void setParameters();
+	~RaytraceNode() override;
 
 	// Node
 	void validateImpl() override;
@@ -150,6 +163,8 @@ struct RaytraceNode : IPointsNode
 		hBeamHalfDivergenceRad = hDivergenceRad / 2.0f;
 		vBeamHalfDivergenceRad = vDivergenceRad / 2.0f;
 	}
+	void setBatch(int32_t batchId);
+	void setBackend(rgl_raytrace_backend_t newBackend) { backend = newBackend; }
 
 private:
 	struct MultiReturnSamples
@@ -191,6 +206,8 @@ private:
 			resizeField(incidentAngle, size);
 		}
 
+		size_t getCapacity() const { return isHit->getCapacity(); }
+
 		MultiReturnSamplesPointers getPointers() const
 		{
 			return MultiReturnSamplesPointers{
@@ -251,8 +268,10 @@ private:
 
 	DeviceAsyncArray<int8_t>::Ptr rayMask;
 
-	HostPinnedArray<RaytraceRequestContext>::Ptr requestCtxHst = HostPinnedArray<RaytraceRequestContext>::create();
-	DeviceAsyncArray<RaytraceRequestContext>::Ptr requestCtxDev = DeviceAsyncArray<RaytraceRequestContext>::create(arrayMgr);
+	rgl_raytrace_backend_t backend = RGL_RAYTRACE_BACKEND_OPTIX;
+	RaytraceLauncher launcher;
+	HostTraversalLauncher hostTraversalLauncher;
+	RaytraceBatch::Ptr batch; // If set, the node is raytraced as a part of the batch launch.
 
 	std::unordered_map<rgl_field_t, IAnyArray::Ptr> fieldData; // All should be DeviceAsyncArray
 
@@ -284,6 +303,9 @@ struct TransformPointsNode : IPointsNodeSingleInput
 private:
 	Mat3x4f transform;
 	DeviceAsyncArray<Field<XYZ_VEC3_F32>::type>::Ptr output = DeviceAsyncArray<Field<XYZ_VEC3_F32>::type>::create(arrayMgr);
+	// Used instead of output if the input resides in host memory
+	HostPageableArray<Field<XYZ_VEC3_F32>::type>::Ptr outputHost = HostPageableArray<Field<XYZ_VEC3_F32>::type>::create();
+	bool isHostExecution{false};
 };
 
 struct TransformRaysNode : IRaysNodeSingleInput
@@ -295,12 +317,21 @@ struct TransformRaysNode : IRaysNodeSingleInput
 	void enqueueExecImpl() override;
 
 	// Data getters
-	Array<Mat3x4f>::ConstPtr getRays() const override { return transformedRays; }
+	Array<Mat3x4f>::ConstPtr getRays() const override
+	{
+		if (isHostExecution) {
+			return transformedRaysHost;
+		}
+		return transformedRays;
+	}
 	Mat3x4f getCumulativeRayTransfrom() const override { return transform * input->getCumulativeRayTransfrom(); }
 
 private:
 	Mat3x4f transform;
 	DeviceAsyncArray<Mat3x4f>::Ptr transformedRays = DeviceAsyncArray<Mat3x4f>::create(arrayMgr);
+	// Used instead of transformedRays if the input rays reside in host memory
+	HostPageableArray<Mat3x4f>::Ptr transformedRaysHost = HostPageableArray<Mat3x4f>::create();
+	bool isHostExecution{false};
 };
 
 struct FromMat3x4fRaysNode : IRaysNode, INoInputNode
@@ -402,12 +433,16 @@ struct YieldPointsNode : IPointsNodeSingleInput
 	// Data getters
 	IAnyArray::ConstPtr getFieldData(rgl_field_t field) override { return results.at(field); }
 
-	HostPinnedArray<Field<XYZ_VEC3_F32>::type>::Ptr getXYZCache() { return xyzHostCache; }
+	/**
+	 * Returns host-accessible copy of the yielded field from the last run.
+	 * It is valid once the node's results are ready (see waitForResults), until the next run is enqueued.
+	 */
+	IAnyArray::ConstPtr getHostFieldData(rgl_field_t field);
 
 private:
 	std::vector<rgl_field_t> fields;
 	std::unordered_map<rgl_field_t, IAnyArray::ConstPtr> results;
-	HostPinnedArray<Field<XYZ_VEC3_F32>::type>::Ptr xyzHostCache = HostPinnedArray<Field<XYZ_VEC3_F32>::type>::create();
+	std::unordered_map<rgl_field_t, IAnyArray::Ptr> hostMirrors;
 };
 
 struct SpatialMergePointsNode : IPointsNode
@@ -434,22 +469,28 @@ struct SpatialMergePointsNode : IPointsNode
 	std::size_t getReturnCount() const override { return 1; }
 
 	// Data getters
-	IAnyArray::ConstPtr getFieldData(rgl_field_t field) override
-	{
-		return std::const_pointer_cast<const IAnyArray>(mergedData.at(field));
-	}
+	IAnyArray::ConstPtr getFieldData(rgl_field_t field) override;
 
 private:
 	std::vector<IPointsNode::Ptr> pointInputs;
+	// Fields are merged on demand; cache tracks which of them have been merged in the current run.
 	std::unordered_map<rgl_field_t, IAnyArray::Ptr> mergedData;
+	CacheManager<rgl_field_t, IAnyArray::Ptr> cacheManager;
+	std::mutex getFieldDataMutex;
 	std::size_t width = 0;
 };
 
 struct TemporalMergePointsNode : IPointsNodeSingleInput
 {
-	using Ptr = std::shared_ptr<YieldPointsNode>;
+	using Ptr = std::shared_ptr<TemporalMergePointsNode>;
 	void setParameters(const std::vector<rgl_field_t>& fields);
 
+	/**
+	 * Limits accumulated points to the last frames. Zero disables the respective limit.
+	 * Changing the window clears accumulated data.
+	 */
+	void setWindow(int32_t maxFrameCount, float maxDurationSeconds);
+
 	// Node
 	void validateImpl() override;
 	void enqueueExecImpl() override;
@@ -457,22 +498,43 @@ struct TemporalMergePointsNode : IPointsNodeSingleInput
 	// Node requirements
 	std::vector<rgl_field_t> getRequiredFieldList() const override
 	{
-		return {std::views::keys(mergedData).begin(), std::views::keys(mergedData).end()};
+		return {std::views::keys(ringData).begin(), std::views::keys(ringData).end()};
 	}
 
 	// Point cloud description
-	bool hasField(rgl_field_t field) const override { return mergedData.contains(field); }
+	bool hasField(rgl_field_t field) const override { return ringData.contains(field); }
 	std::size_t getWidth() const override { return width; }
 
 	// Data getters
-	IAnyArray::ConstPtr getFieldData(rgl_field_t field) override
-	{
-		return std::const_pointer_cast<const IAnyArray>(mergedData.at(field));
-	}
+	IAnyArray::ConstPtr getFieldData(rgl_field_t field) override;
 
 private:
-	std::unordered_map<rgl_field_t, IAnyArray::Ptr> mergedData;
+	struct FrameSegment
+	{
+		std::size_t begin; // Index of the first point in the ring
+		std::size_t count;
+		std::optional<Time> time;
+	};
+
+	void clearFrames();
+	void evictFrames(std::optional<Time> now);
+	void growRing(std::size_t minCapacity);
+	void setRingCount(std::size_t count);
+
+	// Points are stored in ring buffers (one per field) sharing frame layout.
+	// Evicting a frame only advances ringBegin, appending a frame wraps around the ring's end.
+	std::unordered_map<rgl_field_t, IAnyArray::Ptr> ringData;
+	std::deque<FrameSegment> frames;
+	std::size_t ringBegin = 0;
+	std::size_t ringCapacity = 0;
 	std::size_t width = 0;
+
+	// If the window does not start at the ring's beginning, it is linearized here on demand
+	CacheManager<rgl_field_t, IAnyArray::Ptr> linearizedCache;
+	std::mutex getFieldDataMutex;
+
+	int32_t maxFrameCount = 0;
+	float maxDurationSeconds = 0.0f;
 };
 
 struct FromArrayPointsNode : IPointsNode, INoInputNode
@@ -525,10 +587,9 @@ private:
 	float mean;
 	float stDev;
 	rgl_axis_t rotationAxis;
-	std::random_device randomDevice;
+	uint64_t seed{Philox4x32::makeSeed()};
+	uint32_t runCounter{0};
 
-	DeviceAsyncArray<curandStatePhilox4_32_10_t>::Ptr randomizationStates =
-	    DeviceAsyncArray<curandStatePhilox4_32_10_t>::create(arrayMgr);
 	DeviceAsyncArray<Mat3x4f>::Ptr rays = DeviceAsyncArray<Mat3x4f>::create(arrayMgr);
 };
 
@@ -552,12 +613,15 @@ private:
 	float mean;
 	float stDev;
 	rgl_axis_t rotationAxis;
-	std::random_device randomDevice;
+	uint64_t seed{Philox4x32::makeSeed()};
+	uint32_t runCounter{0};
 
-	DeviceAsyncArray<curandStatePhilox4_32_10_t>::Ptr randomizationStates =
-	    DeviceAsyncArray<curandStatePhilox4_32_10_t>::create(arrayMgr);
 	DeviceAsyncArray<Field<XYZ_VEC3_F32>::type>::Ptr outXyz = DeviceAsyncArray<Field<XYZ_VEC3_F32>::type>::create(arrayMgr);
 	DeviceAsyncArray<Field<DISTANCE_F32>::type>::Ptr outDistance = nullptr;
+	// Used instead of outXyz and outDistance if the input resides in host memory
+	HostPageableArray<Field<XYZ_VEC3_F32>::type>::Ptr outXyzHost = HostPageableArray<Field<XYZ_VEC3_F32>::type>::create();
+	HostPageableArray<Field<DISTANCE_F32>::type>::Ptr outDistanceHost = HostPageableArray<Field<DISTANCE_F32>::type>::create();
+	bool isHostExecution{false};
 };
 
 struct GaussianNoiseDistanceNode : IPointsNodeSingleInput
@@ -579,13 +643,16 @@ private:
 	float mean;
 	float stDevBase;
 	float stDevRisePerMeter;
-	std::random_device randomDevice;
+	uint64_t seed{Philox4x32::makeSeed()};
+	uint32_t runCounter{0};
 
-	DeviceAsyncArray<curandStatePhilox4_32_10_t>::Ptr randomizationStates =
-	    DeviceAsyncArray<curandStatePhilox4_32_10_t>::create(arrayMgr);
 	DeviceAsyncArray<Field<XYZ_VEC3_F32>::type>::Ptr outXyz = DeviceAsyncArray<Field<XYZ_VEC3_F32>::type>::create(arrayMgr);
 	DeviceAsyncArray<Field<DISTANCE_F32>::type>::Ptr outDistance = DeviceAsyncArray<Field<DISTANCE_F32>::type>::create(
 	    arrayMgr);
+	// Used instead of outXyz and outDistance if the input resides in host memory
+	HostPageableArray<Field<XYZ_VEC3_F32>::type>::Ptr outXyzHost = HostPageableArray<Field<XYZ_VEC3_F32>::type>::create();
+	HostPageableArray<Field<DISTANCE_F32>::type>::Ptr outDistanceHost = HostPageableArray<Field<DISTANCE_F32>::type>::create();
+	bool isHostExecution{false};
 };
 
 struct RadarPostprocessPointsNode : IPointsNodeSingleInput
@@ -613,6 +680,9 @@ struct RadarPostprocessPointsNode : IPointsNodeSingleInput
 	const std::vector<Aabb3Df>& getClusterAabbs() const { return clusterAabbs; }
 
 private:
+	template<rgl_field_t field>
+	const typename Field<field>::type* getEnergyInputPtr();
+
 	// Data containers
 	std::vector<Field<RAY_IDX_U32>::type> filteredIndicesHost;
 	DeviceAsyncArray<Field<RAY_IDX_U32>::type>::Ptr filteredIndices = DeviceAsyncArray<Field<RAY_IDX_U32>::type>::create(
@@ -627,6 +697,7 @@ private:
 	    DeviceAsyncArray<Vector<3, thrust::complex<float>>>::create(arrayMgr);
 	HostPinnedArray<Vector<3, thrust::complex<float>>>::Ptr outBUBRFactorHost =
 	    HostPinnedArray<Vector<3, thrust::complex<float>>>::create();
+	std::unordered_map<rgl_field_t, IAnyArray::Ptr> energyInputsDev; // Device copies of host-resident inputs
 
 	HostPageableArray<Field<RCS_F32>::type>::Ptr clusterRcsHost = HostPageableArray<Field<RCS_F32>::type>::create();
 	HostPageableArray<Field<POWER_F32>::type>::Ptr clusterPowerHost = HostPageableArray<Field<POWER_F32>::type>::create();
@@ -647,6 +718,7 @@ private:
 	float receivedNoiseStDevDb;
 
 	std::vector<rgl_radar_scope_t> radarScopes;
+	RadarClusterBuilder clusterBuilder;
 	std::vector<Aabb3Df> clusterAabbs;
 
 	std::random_device randomDevice;
@@ -654,26 +726,6 @@ private:
 	// RGL related members
 	std::mutex getFieldDataMutex;
 	mutable CacheManager<rgl_field_t, IAnyArray::Ptr> cacheManager;
-
-	struct RadarCluster
-	{
-		RadarCluster(Field<RAY_IDX_U32>::type index, float distance, float azimuth, float radialSpeed, float elevation);
-		RadarCluster(RadarCluster&& other) noexcept = default;
-		RadarCluster& operator=(RadarCluster&& other) noexcept = default;
-
-		void addPoint(Field<RAY_IDX_U32>::type index, float distance, float azimuth, float radialSpeed, float elevation);
-		inline bool isCandidate(float distance, float azimuth, float radialSpeed, const rgl_radar_scope_t& separations) const;
-		inline bool canMergeWith(const RadarCluster& other, const std::vector<rgl_radar_scope_t>& radarScopes) const;
-		void takeIndicesFrom(RadarCluster&& other);
-		Field<RAY_IDX_U32>::type findDirectionalCenterIndex(const Field<AZIMUTH_F32>::type* azimuths,
-		                                                    const Field<ELEVATION_F32>::type* elevations) const;
-
-		std::vector<Field<RAY_IDX_U32>::type> indices;
-		Vector<2, Field<DISTANCE_F32>::type> minMaxDistance;
-		Vector<2, Field<AZIMUTH_F32>::type> minMaxAzimuth;
-		Vector<2, Field<RADIAL_SPEED_F32>::type> minMaxRadialSpeed;
-		Vector<2, Field<ELEVATION_F32>::type> minMaxElevation; // For finding directional center only
-	};
 };
 
 struct RadarTrackObjectsNode : IPointsNodeSingleInput
@@ -769,6 +821,10 @@ private:
 	                       ObjectStatus objectStatus, double currentTimeMs, double deltaTimeMs, const Vec3f& absVelocity,
 	                       const Vec3f& relVelocity);
 	void updateOutputData();
+	void groupDetections(int detectionCount);
+	int findDetectionRoot(int detectionIndex);
+	void indexNewObjects();
+	std::optional<size_t> findClosestNewObject(const Vec3f& predictedPosition) const;
 
 	std::list<ObjectState> objectStates;
 	std::unordered_map<Field<ENTITY_ID_I32>::type, rgl_radar_object_class_t> entityIdsToClasses;
@@ -806,6 +862,17 @@ private:
 
 	HostPinnedArray<Field<XYZ_VEC3_F32>::type>::Ptr outXyzHostPtr = HostPinnedArray<Field<XYZ_VEC3_F32>::type>::create();
 	HostPinnedArray<Field<ENTITY_ID_I32>::type>::Ptr outEntityIdHostPtr = HostPinnedArray<Field<ENTITY_ID_I32>::type>::create();
+
+	// Buffers used to group detections into objects and to match them with tracked objects. Kept to avoid reallocations.
+	std::vector<int> detectionParents;                             // Union-find forest, roots represent objects
+	std::unordered_map<uint64_t, std::vector<int>> detectionCells; // Grid over (distance, azimuth, elevation)
+	std::vector<int> unindexedDetections;                          // Do not fit in the grid, compared with all others
+	std::vector<std::vector<int>> objectIndices;                   // Detection indices of every object in current frame
+	std::vector<ObjectBounds> newObjectBounds;
+	std::vector<bool> isNewObjectMatched;
+	std::unordered_map<uint64_t, std::vector<size_t>> newObjectCells; // Grid over positions of objects in current frame
+	std::vector<size_t> unindexedNewObjects;                          // Do not fit in the grid, always checked
+	float newObjectCellSize{0.0f};
 };
 
 struct FilterGroundPointsNode : IPointsNodeSingleInput
@@ -828,4 +895,8 @@ private:
 	float ground_angle_threshold;
 	DeviceAsyncArray<Field<IS_GROUND_I32>::type>::Ptr outNonGround = DeviceAsyncArray<Field<IS_GROUND_I32>::type>::create(
 	    arrayMgr);
+	// Used instead of outNonGround if the input resides in host memory
+	HostPageableArray<Field<IS_GROUND_I32>::type>::Ptr outNonGroundHost =
+	    HostPageableArray<Field<IS_GROUND_I32>::type>::create();
+	bool isHostExecution{false};
 };
@@ -0,0 +1,492 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include <graph/RadarClustering.hpp>
+
+std::optional<rgl_radar_scope_t> getRadarScopeWithinDistance(const std::vector<rgl_radar_scope_t>& radarScopes,
+                                                             Field<DISTANCE_F32>::type distance)
+{
+	for (auto&& scope : radarScopes) {
+		if (scope.begin_distance <= distance && distance <= scope.end_distance) {
+			return scope;
+		}
+	}
+	return std::nullopt;
+}
+
+RadarCluster::RadarCluster(Field<RAY_IDX_U32>::type index, float distance, float azimuth, float radialSpeed, float elevation)
+{
+	indices.emplace_back(index);
+	minMaxDistance = {distance, distance};
+	minMaxAzimuth = {azimuth, azimuth};
+	minMaxRadialSpeed = {radialSpeed, radialSpeed};
+	minMaxElevation = {elevation, elevation};
+}
+
+void RadarCluster::addPoint(Field<RAY_IDX_U32>::type index, float distance, float azimuth, float radialSpeed,
+                            float elevation)
+{
+	indices.emplace_back(index);
+	minMaxDistance[0] = std::min(minMaxDistance[0], distance);
+	minMaxDistance[1] = std::max(minMaxDistance[1], distance);
+	minMaxAzimuth[0] = std::min(minMaxAzimuth[0], azimuth);
+	minMaxAzimuth[1] = std::max(minMaxAzimuth[1], azimuth);
+
+	// There are three reasonable cases that should be handled as intended:
+	// - limit and radialSpeed are nans - limit will be set to nan (from radialSpeed)
+	// - limit is nan and radialSpeed if a number - limit will be set to a number (from radialSpeed)
+	// - limit and radialSpeed are numbers - std::min will be called.
+	// There can technically be a fourth case:
+	// - limit is a number and radialSpeed is nan - this should technically be handled via order of arguments in std::min
+	//   (assumption that comparison inside will return false); what is more important, such candidate should be eliminated
+	//   with isCandidate method;
+	// The fourth case should not occur - radial speed is either nan for all entities (first raycast, with delta time = 0) or
+	// has value for all entities.
+	minMaxRadialSpeed[0] = std::isnan(minMaxRadialSpeed[0]) ? radialSpeed : std::min(minMaxRadialSpeed[0], radialSpeed);
+	minMaxRadialSpeed[1] = std::isnan(minMaxRadialSpeed[1]) ? radialSpeed : std::max(minMaxRadialSpeed[1], radialSpeed);
+
+	minMaxElevation[0] = std::min(minMaxElevation[0], elevation);
+	minMaxElevation[1] = std::max(minMaxElevation[1], elevation);
+}
+
+bool RadarCluster::isCandidate(float distance, float azimuth, float radialSpeed, const rgl_radar_scope_t& radarScope) const
+{
+	const auto isWithinDistanceLowerBound = distance + radarScope.distance_separation_threshold >= minMaxDistance[0];
+	const auto isWithinDistanceUpperBound = distance - radarScope.distance_separation_threshold <= minMaxDistance[1];
+	const auto isWithinAzimuthLowerBound = azimuth + radarScope.azimuth_separation_threshold >= minMaxAzimuth[0];
+	const auto isWithinAzimuthUpperBound = azimuth - radarScope.azimuth_separation_threshold <= minMaxAzimuth[1];
+
+	const auto isWithinRadialSpeedLowerBound = radialSpeed + radarScope.radial_speed_separation_threshold >=
+	                                           minMaxRadialSpeed[0];
+	const auto isWithinRadialSpeedUpperBound = radialSpeed - radarScope.radial_speed_separation_threshold <=
+	                                           minMaxRadialSpeed[1];
+
+	// Radial speed may be nan if this is the first raytracing call (delta time equals 0). When cluster has nan radial speed
+	// limits (technically just do not have radial speed information), the goal below is to ignore radial speed checkout. The
+	// next goal is to allow adding points to cluster, if these points have non nan radial speed - to eliminate undefined
+	// radial speed information from cluster. This should also work well, when limits are fine and candidate's radial speed
+	// is nan - then radial speed checkouts will give false and the candidate will not pass.
+	// Context for radial speed checkouts below - this can be interpreted as "true if any radial speed limit is nan or
+	// candidate's radial speed is within limits"
+	return isWithinDistanceLowerBound && isWithinDistanceUpperBound && isWithinAzimuthLowerBound && isWithinAzimuthUpperBound &&
+	       (std::isunordered(minMaxRadialSpeed[0], minMaxRadialSpeed[1]) ||
+	        (isWithinRadialSpeedLowerBound && isWithinRadialSpeedUpperBound));
+}
+
+bool RadarCluster::canMergeWith(const RadarCluster& other, const std::vector<rgl_radar_scope_t>& radarScopes) const
+{
+	// Helper functions
+	auto doRangesOverlap = [](const Vec2f& a, const Vec2f& b) {
+		return (b[0] <= a[1] && b[1] >= a[0]) || (a[0] <= b[1] && a[1] >= b[0]);
+	};
+	auto areRangesWithinThreshold = [](const Vec2f& a, const Vec2f& b, float threshold) {
+		return std::abs(a[1] - b[0]) <= threshold || std::abs(b[1] - a[0]) <= threshold;
+	};
+
+	// Find distances that will be compared with each other:
+	// |---cluster1---|    |---cluster2---|
+	//                ^    ^
+	const float minDistanceToCompare = std::max(minMaxDistance[0], other.minMaxDistance[0]);
+	const float maxDistanceToCompare = std::min(minMaxDistance[1], other.minMaxDistance[1]);
+	const auto radarScope = getRadarScopeWithinDistance(radarScopes, std::max(minDistanceToCompare, maxDistanceToCompare));
+
+	assert(radarScope.has_value()); // Must have value because it was already checked when creating clusters
+
+	bool isDistanceGood = doRangesOverlap(minMaxDistance, other.minMaxDistance) ||
+	                      areRangesWithinThreshold(minMaxDistance, other.minMaxDistance,
+	                                               radarScope->distance_separation_threshold);
+
+	bool isAzimuthGood = doRangesOverlap(minMaxAzimuth, other.minMaxAzimuth) ||
+	                     areRangesWithinThreshold(minMaxAzimuth, other.minMaxAzimuth, radarScope->azimuth_separation_threshold);
+
+	bool isRadialSpeedGood = doRangesOverlap(minMaxRadialSpeed, other.minMaxRadialSpeed) ||
+	                         areRangesWithinThreshold(minMaxRadialSpeed, other.minMaxRadialSpeed,
+	                                                  radarScope->radial_speed_separation_threshold);
+
+	// Radial speed check is ignored if one of limits on it, in one of clusters, is nan.
+	return isDistanceGood && isAzimuthGood &&
+	       (isRadialSpeedGood || std::isunordered(minMaxRadialSpeed[0], minMaxRadialSpeed[1]) ||
+	        std::isunordered(other.minMaxRadialSpeed[0], other.minMaxRadialSpeed[1]));
+}
+
+void RadarCluster::takeIndicesFrom(RadarCluster&& other)
+{
+	minMaxDistance[0] = std::min(minMaxDistance[0], other.minMaxDistance[0]);
+	minMaxDistance[1] = std::max(minMaxDistance[1], other.minMaxDistance[1]);
+	minMaxAzimuth[0] = std::min(minMaxAzimuth[0], other.minMaxAzimuth[0]);
+	minMaxAzimuth[1] = std::max(minMaxAzimuth[1], other.minMaxAzimuth[1]);
+	minMaxRadialSpeed[0] = std::isnan(other.minMaxRadialSpeed[0]) ? minMaxRadialSpeed[0] : std::min(other.minMaxRadialSpeed[0], minMaxRadialSpeed[0]);
+	minMaxRadialSpeed[1] = std::isnan(other.minMaxRadialSpeed[1]) ? minMaxRadialSpeed[1] : std::min(other.minMaxRadialSpeed[1], minMaxRadialSpeed[1]);
+	minMaxElevation[0] = std::min(minMaxElevation[0], other.minMaxElevation[0]);
+	minMaxElevation[1] = std::max(minMaxElevation[1], other.minMaxElevation[1]);
+
+	// Move indices
+	std::size_t n = indices.size();
+	indices.resize(indices.size() + other.indices.size());
+	std::move(other.indices.begin(), other.indices.end(), indices.begin() + n);
+}
+
+Field<RAY_IDX_U32>::type RadarCluster::findDirectionalCenterIndex(const Field<AZIMUTH_F32>::type* azimuths,
+                                                                 const Field<ELEVATION_F32>::type* elevations) const
+{
+	auto meanAzimuth = (minMaxAzimuth[0] + minMaxAzimuth[1]) / 2.0f;
+	auto meanElevation = (minMaxElevation[0] + minMaxElevation[1]) / 2.0f;
+
+	float minDistance = FLT_MAX;
+	uint32_t minIndex = indices.front();
+
+	for (auto&& i : indices) {
+		float distance = std::abs(azimuths[i] - meanAzimuth) + std::abs(elevations[i] - meanElevation);
+		if (distance < minDistance) {
+			minDistance = distance;
+			minIndex = i;
+		}
+	}
+	return minIndex;
+}
+
+// RadarClusterBuilder
+
+template<typename Fn>
+static void forEachCell(const Vec3i& begin, const Vec3i& end, Fn&& fn)
+{
+	for (int distanceCell = begin[0]; distanceCell <= end[0]; ++distanceCell) {
+		for (int azimuthCell = begin[1]; azimuthCell <= end[1]; ++azimuthCell) {
+			for (int radialSpeedCell = begin[2]; radialSpeedCell <= end[2]; ++radialSpeedCell) {
+				fn(Vec3i{distanceCell, azimuthCell, radialSpeedCell});
+			}
+		}
+	}
+}
+
+std::vector<RadarCluster>& RadarClusterBuilder::build(const std::vector<rgl_radar_scope_t>& radarScopes, size_t pointCount,
+                                                      const Field<DISTANCE_F32>::type* distances,
+                                                      const Field<AZIMUTH_F32>::type* azimuths,
+                                                      const Field<RADIAL_SPEED_F32>::type* radialSpeeds,
+                                                      const Field<ELEVATION_F32>::type* elevations)
+{
+	this->radarScopes = &radarScopes;
+	clusters.clear();
+	parents.clear();
+	lastQueryStamps.clear();
+	lastCellStamps.clear();
+	queryStamp = 0;
+	cellStamp = 0;
+
+	// Cells are twice as large as the largest thresholds, so a query spans only a few of them.
+	maxThresholds = Vec3f{0.0f};
+	isGridUsable = true;
+	isRadialSpeedIndexed = true;
+	for (auto&& scope : radarScopes) {
+		isGridUsable &= std::isfinite(scope.distance_separation_threshold) &&
+		                std::isfinite(scope.azimuth_separation_threshold);
+		isRadialSpeedIndexed &= std::isfinite(scope.radial_speed_separation_threshold);
+		maxThresholds[0] = std::max(maxThresholds[0], scope.distance_separation_threshold);
+		maxThresholds[1] = std::max(maxThresholds[1], scope.azimuth_separation_threshold);
+		maxThresholds[2] = std::max(maxThresholds[2], scope.radial_speed_separation_threshold);
+	}
+	// Clusters with nan radial speed limits accept points of any radial speed, so the axis is indexed only if all speeds are known.
+	isRadialSpeedIndexed &= std::all_of(radialSpeeds, radialSpeeds + pointCount, [](float v) { return std::isfinite(v); });
+	Vec3f cellSize{0.0f};
+	for (int axis = 0; axis < 3; ++axis) {
+		cellSize[axis] = maxThresholds[axis] > 0.0f ? 2.0f * maxThresholds[axis] : 1.0f;
+	}
+	for (auto&& level : gridLevels) {
+		level.cellSize = cellSize;
+		level.cells.clear();
+		level.registered.clear();
+		level.oversizedClusters.clear();
+		cellSize *= Vec3f{GRID_LEVEL_SCALE};
+	}
+
+	// Assign points to the first candidate cluster
+	for (size_t i = 0; i < pointCount; ++i) {
+		const auto distance = distances[i];
+		const auto azimuth = azimuths[i];
+		const auto radialSpeed = radialSpeeds[i];
+		const auto elevation = elevations[i];
+		const auto radarScope = getRadarScopeWithinDistance(radarScopes, distance);
+		if (!radarScope.has_value()) {
+			continue;
+		}
+		const auto index = static_cast<Field<RAY_IDX_U32>::type>(i);
+		if (auto candidate = findCandidateCluster(distance, azimuth, radialSpeed, radarScope.value())) {
+			clusters[*candidate].addPoint(index, distance, azimuth, radialSpeed, elevation);
+			registerCluster(*candidate);
+			continue;
+		}
+		// Create a new cluster
+		const auto id = static_cast<ClusterId>(clusters.size());
+		clusters.emplace_back(index, distance, azimuth, radialSpeed, elevation);
+		parents.emplace_back(id);
+		for (auto&& level : gridLevels) {
+			level.registered.emplace_back(CellRange{Vec3i{0}, Vec3i{-1}}); // Empty range, nothing registered yet
+		}
+		lastQueryStamps.emplace_back(0);
+		lastCellStamps.emplace_back(0);
+		registerCluster(id);
+	}
+
+	// Merge clusters if are close enough, in the same order as restarting the search after every merge would.
+	// Invariant: clusters before `nextRow` (except `current`) are not mergeable with any other cluster.
+	// After `current` absorbs another cluster, it may have become mergeable with a preceding one - that pair goes first.
+	ClusterId current = 0;
+	ClusterId nextRow = 0;
+	bool hasGrown = false;
+	while (current < clusters.size()) {
+		if (parents[current] != current) {
+			++current;
+			continue;
+		}
+		if (hasGrown) {
+			if (auto preceding = findMergeableCluster(current, true)) {
+				merge(*preceding, current);
+				current = *preceding;
+				continue;
+			}
+		}
+		if (auto following = findMergeableCluster(current, false)) {
+			merge(current, *following);
+			hasGrown = true;
+			continue;
+		}
+		hasGrown = false;
+		nextRow = std::max(nextRow, current + 1);
+		current = nextRow;
+	}
+
+	// Drop absorbed clusters, keeping the order of the remaining ones
+	size_t remainingCount = 0;
+	for (ClusterId id = 0; id < clusters.size(); ++id) {
+		if (parents[id] != id) {
+			continue;
+		}
+		if (remainingCount != id) {
+			clusters[remainingCount] = std::move(clusters[id]);
+		}
+		++remainingCount;
+	}
+	clusters.erase(clusters.begin() + static_cast<ptrdiff_t>(remainingCount), clusters.end());
+	return clusters;
+}
+
+bool RadarClusterBuilder::CellRange::contains(const Vec3i& cell) const
+{
+	for (int axis = 0; axis < 3; ++axis) {
+		if (cell[axis] < begin[axis] || end[axis] < cell[axis]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+std::optional<RadarClusterBuilder::CellRange> RadarClusterBuilder::getCellRange(const GridLevel& level, Vec3f min, Vec3f max) const
+{
+	if (!isGridUsable) {
+		return std::nullopt;
+	}
+	if (!isRadialSpeedIndexed) {
+		min[2] = 0.0f;
+		max[2] = 0.0f;
+	}
+	CellRange range{};
+	int64_t cellCount = 1;
+	for (int axis = 0; axis < 3; ++axis) {
+		// Floor of division is monotonic, so overlapping ranges always share at least one cell.
+		const float begin = std::floor(min[axis] / level.cellSize[axis]);
+		const float end = std::floor(max[axis] / level.cellSize[axis]);
+		// Also rejects nans and infinities
+		if (!(std::abs(begin) < MAX_CELL_COORD && std::abs(end) < MAX_CELL_COORD) || end < begin) {
+			return std::nullopt;
+		}
+		range.begin[axis] = static_cast<int>(begin);
+		range.end[axis] = static_cast<int>(end);
+		cellCount *= range.end[axis] - range.begin[axis] + 1;
+	}
+	if (cellCount > MAX_CELL_COUNT) {
+		return std::nullopt;
+	}
+	return range;
+}
+
+void RadarClusterBuilder::registerCluster(ClusterId id)
+{
+	if (!isGridUsable) {
+		return;
+	}
+	const Vec3f min = getMinLimits(clusters[id]);
+	const Vec3f max = getMaxLimits(clusters[id]);
+	for (auto&& level : gridLevels) {
+		auto& previous = level.registered[id];
+		if (!previous.has_value()) {
+			continue; // Once oversized, cluster stays on the list (being tested needlessly does not affect the result)
+		}
+		const auto range = getCellRange(level, min, max);
+		if (!range.has_value()) {
+			level.oversizedClusters.emplace_back(id);
+			previous.reset();
+			continue;
+		}
+		// Register only in cells that were not covered before.
+		// Radial speed limits may shrink after merging, then the cluster just stays in some redundant cells.
+		forEachCell(range->begin, range->end, [&](const Vec3i& cell) {
+			if (!previous->contains(cell)) {
+				level.cells[getCellKey(cell)].emplace_back(id);
+			}
+		});
+		previous = range;
+	}
+}
+
+void RadarClusterBuilder::gatherCandidates(const Vec3f& min, const Vec3f& max)
+{
+	candidates.clear();
+	// Find the finest level at which the query spans a reasonable number of cells
+	auto level = gridLevels.begin();
+	std::optional<CellRange> range;
+	for (; level != gridLevels.end() && !range.has_value(); ++level) {
+		range = getCellRange(*level, min, max);
+	}
+	if (!range.has_value()) {
+		// Fallback to testing all clusters
+		for (ClusterId id = 0; id < clusters.size(); ++id) {
+			if (parents[id] == id) {
+				candidates.emplace_back(id);
+			}
+		}
+		return;
+	}
+	--level;
+
+	++queryStamp;
+	auto addCandidate = [this](ClusterId id) {
+		if (lastQueryStamps[id] != queryStamp) {
+			lastQueryStamps[id] = queryStamp;
+			candidates.emplace_back(id);
+		}
+	};
+	forEachCell(range->begin, range->end, [&](const Vec3i& cellCoords) {
+		auto cellIt = level->cells.find(getCellKey(cellCoords));
+		if (cellIt == level->cells.end()) {
+			return;
+		}
+		// Replace absorbed clusters with the ones that absorbed them, dropping duplicates, so cells do not bloat.
+		++cellStamp;
+		auto& cell = cellIt->second;
+		size_t keptCount = 0;
+		for (auto&& id : cell) {
+			const ClusterId root = findRoot(id);
+			if (lastCellStamps[root] == cellStamp) {
+				continue;
+			}
+			lastCellStamps[root] = cellStamp;
+			cell[keptCount++] = root;
+			addCandidate(root);
+		}
+		cell.resize(keptCount);
+	});
+	for (auto&& id : level->oversizedClusters) {
+		addCandidate(findRoot(id));
+	}
+	// Candidates are tested in creation order, as the first matching cluster wins
+	std::sort(candidates.begin(), candidates.end());
+}
+
+std::optional<RadarClusterBuilder::ClusterId> RadarClusterBuilder::findCandidateCluster(float distance, float azimuth,
+                                                                                        float radialSpeed,
+                                                                                        const rgl_radar_scope_t& radarScope)
+{
+	// Same expressions as in RadarCluster::isCandidate, so the query range is not affected by rounding differences.
+	const Vec3f min{distance - radarScope.distance_separation_threshold, azimuth - radarScope.azimuth_separation_threshold,
+	                radialSpeed - radarScope.radial_speed_separation_threshold};
+	const Vec3f max{distance + radarScope.distance_separation_threshold, azimuth + radarScope.azimuth_separation_threshold,
+	                radialSpeed + radarScope.radial_speed_separation_threshold};
+	gatherCandidates(min, max);
+	for (auto&& id : candidates) {
+		if (clusters[id].isCandidate(distance, azimuth, radialSpeed, radarScope)) {
+			return id;
+		}
+	}
+	return std::nullopt;
+}
+
+std::optional<RadarClusterBuilder::ClusterId> RadarClusterBuilder::findMergeableCluster(ClusterId id, bool searchBefore)
+{
+	const auto& cluster = clusters[id];
+	// Thresholds used for merging depend on the scope, so the largest ones are used to select candidates.
+	// The margin covers rounding differences between this range and the exact check.
+	Vec3f min = getMinLimits(cluster);
+	Vec3f max = getMaxLimits(cluster);
+	for (int axis = 0; axis < 3; ++axis) {
+		const float margin = (std::max(std::abs(min[axis]), std::abs(max[axis])) + maxThresholds[axis]) * 1e-6f;
+		min[axis] -= maxThresholds[axis] + margin;
+		max[axis] += maxThresholds[axis] + margin;
+	}
+	gatherCandidates(min, max);
+	for (auto&& other : candidates) {
+		if (searchBefore) {
+			if (other >= id) {
+				break;
+			}
+			if (clusters[other].canMergeWith(cluster, *radarScopes)) {
+				return other;
+			}
+		} else if (other > id && cluster.canMergeWith(clusters[other], *radarScopes)) {
+			return other;
+		}
+	}
+	return std::nullopt;
+}
+
+void RadarClusterBuilder::merge(ClusterId into, ClusterId from)
+{
+	clusters[into].takeIndicesFrom(std::move(clusters[from]));
+	parents[from] = into;
+	registerCluster(into);
+}
+
+RadarClusterBuilder::ClusterId RadarClusterBuilder::findRoot(ClusterId id)
+{
+	while (parents[id] != id) {
+		parents[id] = parents[parents[id]]; // Path halving
+		id = parents[id];
+	}
+	return id;
+}
+
+Vec3f RadarClusterBuilder::getMinLimits(const RadarCluster& cluster)
+{
+	return {cluster.minMaxDistance[0], cluster.minMaxAzimuth[0], cluster.minMaxRadialSpeed[0]};
+}
+
+Vec3f RadarClusterBuilder::getMaxLimits(const RadarCluster& cluster)
+{
+	return {cluster.minMaxDistance[1], cluster.minMaxAzimuth[1], cluster.minMaxRadialSpeed[1]};
+}
+
+uint64_t RadarClusterBuilder::getCellKey(const Vec3i& cell)
+{
+	// 21 bits per axis, coordinates are offset to be non-negative
+	constexpr int64_t offset = 1 << 20;
+	constexpr uint64_t mask = (1 << 21) - 1;
+	uint64_t key = 0;
+	for (int axis = 0; axis < 3; ++axis) {
+		key = (key << 21) | (static_cast<uint64_t>(cell[axis] + offset) & mask);
+	}
+	return key;
+}
@@ -0,0 +1,124 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <RGLFields.hpp>
+#include <math/Vector.hpp>
+
+std::optional<rgl_radar_scope_t> getRadarScopeWithinDistance(const std::vector<rgl_radar_scope_t>& radarScopes,
+                                                             Field<DISTANCE_F32>::type distance);
+
+struct RadarCluster
+{
+	RadarCluster(Field<RAY_IDX_U32>::type index, float distance, float azimuth, float radialSpeed, float elevation);
+	RadarCluster(RadarCluster&& other) noexcept = default;
+	RadarCluster& operator=(RadarCluster&& other) noexcept = default;
+
+	void addPoint(Field<RAY_IDX_U32>::type index, float distance, float azimuth, float radialSpeed, float elevation);
+	bool isCandidate(float distance, float azimuth, float radialSpeed, const rgl_radar_scope_t& separations) const;
+	bool canMergeWith(const RadarCluster& other, const std::vector<rgl_radar_scope_t>& radarScopes) const;
+	void takeIndicesFrom(RadarCluster&& other);
+	Field<RAY_IDX_U32>::type findDirectionalCenterIndex(const Field<AZIMUTH_F32>::type* azimuths,
+	                                                    const Field<ELEVATION_F32>::type* elevations) const;
+
+	std::vector<Field<RAY_IDX_U32>::type> indices;
+	Vector<2, Field<DISTANCE_F32>::type> minMaxDistance;
+	Vector<2, Field<AZIMUTH_F32>::type> minMaxAzimuth;
+	Vector<2, Field<RADIAL_SPEED_F32>::type> minMaxRadialSpeed;
+	Vector<2, Field<ELEVATION_F32>::type> minMaxElevation; // For finding directional center only
+};
+
+/**
+ * Groups radar detections into clusters.
+ * The result is exactly the same as of the straightforward algorithm:
+ * - every point joins the first cluster (in creation order) it is a candidate for, or starts a new one,
+ * - then, as long as any pair is mergeable, the first such pair (i, j), i < j, is merged into cluster i.
+ * However, instead of testing all clusters, candidates are looked up in a grid over (distance, azimuth, radial speed),
+ * with cells sized after the largest separation thresholds of radar scopes, so only clusters from nearby cells are tested.
+ * Large clusters (e.g. walls) would cover too many cells, so there are a few grid levels, each with coarser cells,
+ * and a query uses the finest level at which it spans a reasonable number of cells.
+ * Merged clusters are tracked with union-find, so stale grid entries resolve to the cluster that absorbed them.
+ * Buffers are kept between calls to avoid reallocations on every frame.
+ */
+struct RadarClusterBuilder
+{
+	/**
+	 * Returns clusters in creation order. Points outside all radar scopes are skipped.
+	 * Returned reference is valid until the next call.
+	 */
+	std::vector<RadarCluster>& build(const std::vector<rgl_radar_scope_t>& radarScopes, size_t pointCount,
+	                                 const Field<DISTANCE_F32>::type* distances, const Field<AZIMUTH_F32>::type* azimuths,
+	                                 const Field<RADIAL_SPEED_F32>::type* radialSpeeds,
+	                                 const Field<ELEVATION_F32>::type* elevations);
+
+private:
+	using ClusterId = uint32_t;
+
+	struct CellRange
+	{
+		Vec3i begin; // Inclusive
+		Vec3i end;   // Inclusive
+
+		bool contains(const Vec3i& cell) const;
+	};
+
+	struct GridLevel
+	{
+		Vec3f cellSize;
+		std::unordered_map<uint64_t, std::vector<ClusterId>> cells;
+		std::vector<std::optional<CellRange>> registered; // Per cluster, nullopt if it covers too many cells
+		std::vector<ClusterId> oversizedClusters;         // Clusters covering too many cells, always candidates
+	};
+
+	// Ranges covering more cells are not indexed at the given level.
+	static constexpr int64_t MAX_CELL_COUNT = 256;
+	static constexpr int GRID_LEVEL_COUNT = 3;
+	static constexpr float GRID_LEVEL_SCALE = 8.0f;
+	static constexpr float MAX_CELL_COORD = 1 << 19; // Must fit in 21 bits of the cell key
+
+	std::optional<CellRange> getCellRange(const GridLevel& level, Vec3f min, Vec3f max) const;
+	void registerCluster(ClusterId id);
+	void gatherCandidates(const Vec3f& min, const Vec3f& max);
+	std::optional<ClusterId> findCandidateCluster(float distance, float azimuth, float radialSpeed,
+	                                              const rgl_radar_scope_t& radarScope);
+	std::optional<ClusterId> findMergeableCluster(ClusterId id, bool searchBefore);
+	void merge(ClusterId into, ClusterId from);
+	ClusterId findRoot(ClusterId id);
+
+	static Vec3f getMinLimits(const RadarCluster& cluster);
+	static Vec3f getMaxLimits(const RadarCluster& cluster);
+	static uint64_t getCellKey(const Vec3i& cell);
+
+	const std::vector<rgl_radar_scope_t>* radarScopes{nullptr};
+	Vec3f maxThresholds{0.0f};
+	bool isGridUsable{true};
+	bool isRadialSpeedIndexed{true}; // Radial speed is nan on the first frame, then clusters accept points of any speed
+
+	std::vector<RadarCluster> clusters;
+	std::vector<ClusterId> parents; // Union-find forest, absorbed clusters point to absorbing ones
+	std::array<GridLevel, GRID_LEVEL_COUNT> gridLevels;
+
+	std::vector<ClusterId> candidates;
+	std::vector<uint32_t> lastQueryStamps; // Per cluster, used to skip duplicates when gathering candidates
+	std::vector<uint32_t> lastCellStamps;  // Per cluster, used to skip duplicates when compacting a cell
+	uint32_t queryStamp{0};
+	uint32_t cellStamp{0};
+};
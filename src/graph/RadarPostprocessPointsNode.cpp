@@ -18,17 +18,7 @@
 #include <repr.hpp>
 #include <graph/NodesCore.hpp>
 #include <gpu/nodeKernels.hpp>
-
-inline static std::optional<rgl_radar_scope_t> getRadarScopeWithinDistance(const std::vector<rgl_radar_scope_t>& radarScopes,
-                                                                           Field<DISTANCE_F32>::type distance)
-{
-	for (auto&& scope : radarScopes) {
-		if (scope.begin_distance <= distance && distance <= scope.end_distance) {
-			return scope;
-		}
-	}
-	return std::nullopt;
-}
+#include <HostKernels.hpp>
 
 void RadarPostprocessPointsNode::setParameters(const std::vector<rgl_radar_scope_t>& radarScopes, float rayAzimuthStepRad,
                                                float rayElevationStepRad, float frequency, float powerTransmitted,
@@ -62,10 +52,10 @@ void RadarPostprocessPointsNode::enqueueExecImpl()
 {
 	cacheManager.trigger();
 
-	auto raysPtr = input->getFieldDataTyped<RAY_POSE_MAT3x4_F32>()->asSubclass<DeviceAsyncArray>()->getReadPtr();
-	auto distancePtr = input->getFieldDataTyped<DISTANCE_F32>()->asSubclass<DeviceAsyncArray>()->getReadPtr();
-	auto normalPtr = input->getFieldDataTyped<NORMAL_VEC3_F32>()->asSubclass<DeviceAsyncArray>()->getReadPtr();
-	auto xyzPtr = input->getFieldDataTyped<XYZ_VEC3_F32>()->asSubclass<DeviceAsyncArray>()->getReadPtr();
+	auto raysPtr = getEnergyInputPtr<RAY_POSE_MAT3x4_F32>();
+	auto distancePtr = getEnergyInputPtr<DISTANCE_F32>();
+	auto normalPtr = getEnergyInputPtr<NORMAL_VEC3_F32>();
+	auto xyzPtr = getEnergyInputPtr<XYZ_VEC3_F32>();
 	outBUBRFactorDev->resize(input->getPointCount(), false, false);
 	gpuRadarComputeEnergy(getStreamHandle(), input->getPointCount(), rayAzimuthStepRad, rayElevationStepRad, frequencyHz,
 	                      input->getLookAtOriginTransform(), raysPtr, distancePtr, normalPtr, xyzPtr,
@@ -74,6 +64,7 @@ void RadarPostprocessPointsNode::enqueueExecImpl()
 	CHECK_CUDA(cudaStreamSynchronize(getStreamHandle()));
 
 	if (input->getPointCount() == 0) {
+		filteredIndicesHost.clear();
 		filteredIndices->resize(0, false, false);
 		return;
 	}
@@ -84,49 +75,9 @@ void RadarPostprocessPointsNode::enqueueExecImpl()
 	radialSpeedInputHost->copyFrom(input->getFieldData(RADIAL_SPEED_F32));
 	elevationInputHost->copyFrom(input->getFieldData(ELEVATION_F32));
 
-	std::vector<RadarCluster> clusters;
-	for (int i = 0; i < input->getPointCount(); ++i) {
-		const auto distance = distanceInputHost->at(i);
-		const auto azimuth = azimuthInputHost->at(i);
-		const auto radialSpeed = radialSpeedInputHost->at(i);
-		const auto elevation = elevationInputHost->at(i);
-		bool isPointClustered = false;
-		const auto radarScope = getRadarScopeWithinDistance(radarScopes, distance);
-		if (!radarScope.has_value()) {
-			continue;
-		}
-		for (auto&& cluster : clusters) {
-			if (cluster.isCandidate(distance, azimuth, radialSpeed, radarScope.value())) {
-				cluster.addPoint(i, distance, azimuth, radialSpeed, elevation);
-				isPointClustered = true;
-				break;
-			}
-		}
-
-		if (!isPointClustered) {
-			// Create a new cluster
-			clusters.emplace_back(i, distance, azimuth, radialSpeed, elevation);
-		}
-	}
-
-	// Merge clusters if are close enough
-	bool allClustersGood = false;
-	while (clusters.size() > 1 && !allClustersGood) {
-		allClustersGood = true;
-		for (int i = 0; i < clusters.size(); ++i) {
-			for (int j = i + 1; j < clusters.size(); ++j) {
-				if (clusters[i].canMergeWith(clusters[j], radarScopes)) {
-					clusters[i].takeIndicesFrom(std::move(clusters[j]));
-					clusters.erase(clusters.begin() + j);
-					allClustersGood = false;
-					break;
-				}
-			}
-			if (!allClustersGood) {
-				break;
-			}
-		}
-	}
+	const auto& clusters = clusterBuilder.build(radarScopes, input->getPointCount(), distanceInputHost->getReadPtr(),
+	                                            azimuthInputHost->getReadPtr(), radialSpeedInputHost->getReadPtr(),
+	                                            elevationInputHost->getReadPtr());
 
 	filteredIndicesHost.clear();
 	for (auto&& cluster : clusters) {
@@ -228,8 +179,15 @@ IAnyArray::ConstPtr RadarPostprocessPointsNode::getFieldData(rgl_field_t field)
 		return clusterSnrDev->asAny();
 	}
 
+	// Host-resident fields are filtered on the host, cached arrays are recreated if a field moved between host and device
+	auto fieldArray = input->getFieldData(field);
+	const bool isHostField = isHost(fieldArray->getMemoryKind());
+	if (cacheManager.contains(field) && isHost(cacheManager.getValue(field)->getMemoryKind()) != isHostField) {
+		cacheManager.remove(field);
+	}
+
 	if (!cacheManager.contains(field)) {
-		auto fieldData = createArray<DeviceAsyncArray>(field, arrayMgr);
+		auto fieldData = isHostField ? createArray<HostPageableArray>(field) : createArray<DeviceAsyncArray>(field, arrayMgr);
 		fieldData->resize(filteredIndices->getCount(), false, false);
 		cacheManager.insert(field, fieldData, true);
 	}
@@ -238,158 +196,37 @@ IAnyArray::ConstPtr RadarPostprocessPointsNode::getFieldData(rgl_field_t field)
 		auto fieldData = cacheManager.getValue(field);
 		fieldData->resize(filteredIndices->getCount(), false, false);
 		char* outPtr = static_cast<char*>(fieldData->getRawWritePtr());
-		auto fieldArray = input->getFieldData(field);
-		if (!isDeviceAccessible(fieldArray->getMemoryKind())) {
-			auto msg = fmt::format("RadarPostprocessPoints requires its input to be device-accessible, {} is not", field);
-			throw InvalidPipeline(msg);
-		}
 		const char* inputPtr = static_cast<const char*>(fieldArray->getRawReadPtr());
-		gpuFilter(getStreamHandle(), filteredIndices->getCount(), filteredIndices->getReadPtr(), outPtr, inputPtr,
-		          getFieldSize(field));
-		CHECK_CUDA(cudaStreamSynchronize(getStreamHandle()));
+		if (isHostField) {
+			hostFilter(filteredIndicesHost.size(), filteredIndicesHost.data(), outPtr, inputPtr, getFieldSize(field));
+		} else {
+			gpuFilter(getStreamHandle(), filteredIndices->getCount(), filteredIndices->getReadPtr(), outPtr, inputPtr,
+			          getFieldSize(field));
+			CHECK_CUDA(cudaStreamSynchronize(getStreamHandle()));
+		}
 		cacheManager.setUpdated(field);
 	}
 
 	return cacheManager.getValue(field);
 }
 
-std::vector<rgl_field_t> RadarPostprocessPointsNode::getRequiredFieldList() const
+template<rgl_field_t field>
+const typename Field<field>::type* RadarPostprocessPointsNode::getEnergyInputPtr()
 {
-	return {DISTANCE_F32, AZIMUTH_F32, ELEVATION_F32, RADIAL_SPEED_F32, RAY_POSE_MAT3x4_F32, NORMAL_VEC3_F32, XYZ_VEC3_F32};
-}
-
-// RadarCluster methods implementation
-
-RadarPostprocessPointsNode::RadarCluster::RadarCluster(Field<RAY_IDX_U32>::type index, float distance, float azimuth,
-                                                       float radialSpeed, float elevation)
-{
-	indices.emplace_back(index);
-	minMaxDistance = {distance, distance};
-	minMaxAzimuth = {azimuth, azimuth};
-	minMaxRadialSpeed = {radialSpeed, radialSpeed};
-	minMaxElevation = {elevation, elevation};
-}
-
-void RadarPostprocessPointsNode::RadarCluster::addPoint(Field<RAY_IDX_U32>::type index, float distance, float azimuth,
-                                                        float radialSpeed, float elevation)
-{
-	indices.emplace_back(index);
-	minMaxDistance[0] = std::min(minMaxDistance[0], distance);
-	minMaxDistance[1] = std::max(minMaxDistance[1], distance);
-	minMaxAzimuth[0] = std::min(minMaxAzimuth[0], azimuth);
-	minMaxAzimuth[1] = std::max(minMaxAzimuth[1], azimuth);
-
-	// There are three reasonable cases that should be handled as intended:
-	// - limit and radialSpeed are nans - limit will be set to nan (from radialSpeed)
-	// - limit is nan and radialSpeed if a number - limit will be set to a number (from radialSpeed)
-	// - limit and radialSpeed are numbers - std::min will be called.
-	// There can technically be a fourth case:
-	// - limit is a number and radialSpeed is nan - this should technically be handled via order of arguments in std::min
-	//   (assumption that comparison inside will return false); what is more important, such candidate should be eliminated
-	//   with isCandidate method;
-	// The fourth case should not occur - radial speed is either nan for all entities (first raycast, with delta time = 0) or
-	// has value for all entities.
-	minMaxRadialSpeed[0] = std::isnan(minMaxRadialSpeed[0]) ? radialSpeed : std::min(minMaxRadialSpeed[0], radialSpeed);
-	minMaxRadialSpeed[1] = std::isnan(minMaxRadialSpeed[1]) ? radialSpeed : std::max(minMaxRadialSpeed[1], radialSpeed);
-
-	minMaxElevation[0] = std::min(minMaxElevation[0], elevation);
-	minMaxElevation[1] = std::max(minMaxElevation[1], elevation);
-}
-
-inline bool RadarPostprocessPointsNode::RadarCluster::isCandidate(float distance, float azimuth, float radialSpeed,
-                                                                  const rgl_radar_scope_t& radarScope) const
-{
-	const auto isWithinDistanceLowerBound = distance + radarScope.distance_separation_threshold >= minMaxDistance[0];
-	const auto isWithinDistanceUpperBound = distance - radarScope.distance_separation_threshold <= minMaxDistance[1];
-	const auto isWithinAzimuthLowerBound = azimuth + radarScope.azimuth_separation_threshold >= minMaxAzimuth[0];
-	const auto isWithinAzimuthUpperBound = azimuth - radarScope.azimuth_separation_threshold <= minMaxAzimuth[1];
-
-	const auto isWithinRadialSpeedLowerBound = radialSpeed + radarScope.radial_speed_separation_threshold >=
-	                                           minMaxRadialSpeed[0];
-	const auto isWithinRadialSpeedUpperBound = radialSpeed - radarScope.radial_speed_separation_threshold <=
-	                                           minMaxRadialSpeed[1];
-
-	// Radial speed may be nan if this is the first raytracing call (delta time equals 0). When cluster has nan radial speed
-	// limits (technically just do not have radial speed information), the goal below is to ignore radial speed checkout. The
-	// next goal is to allow adding points to cluster, if these points have non nan radial speed - to eliminate undefined
-	// radial speed information from cluster. This should also work well, when limits are fine and candidate's radial speed
-	// is nan - then radial speed checkouts will give false and the candidate will not pass.
-	// Context for radial speed checkouts below - this can be interpreted as "true if any radial speed limit is nan or
-	// candidate's radial speed is within limits"
-	return isWithinDistanceLowerBound && isWithinDistanceUpperBound && isWithinAzimuthLowerBound && isWithinAzimuthUpperBound &&
-	       (std::isunordered(minMaxRadialSpeed[0], minMaxRadialSpeed[1]) ||
-	        (isWithinRadialSpeedLowerBound && isWithinRadialSpeedUpperBound));
-}
-
-inline bool RadarPostprocessPointsNode::RadarCluster::canMergeWith(const RadarCluster& other,
-                                                                   const std::vector<rgl_radar_scope_t>& radarScopes) const
-{
-	// Helper functions
-	auto doRangesOverlap = [](const Vec2f& a, const Vec2f& b) {
-		return (b[0] <= a[1] && b[1] >= a[0]) || (a[0] <= b[1] && a[1] >= b[0]);
-	};
-	auto areRangesWithinThreshold = [](const Vec2f& a, const Vec2f& b, float threshold) {
-		return std::abs(a[1] - b[0]) <= threshold || std::abs(b[1] - a[0]) <= threshold;
-	};
-
-	// Find distances that will be compared with each other:
-	// |---cluster1---|    |---cluster2---|
-	//                ^    ^
-	const float minDistanceToCompare = std::max(minMaxDistance[0], other.minMaxDistance[0]);
-	const float maxDistanceToCompare = std::min(minMaxDistance[1], other.minMaxDistance[1]);
-	const auto radarScope = getRadarScopeWithinDistance(radarScopes, std::max(minDistanceToCompare, maxDistanceToCompare));
-
-	assert(radarScope.has_value()); // Must have value because it was already checked when creating clusters
-
-	bool isDistanceGood = doRangesOverlap(minMaxDistance, other.minMaxDistance) ||
-	                      areRangesWithinThreshold(minMaxDistance, other.minMaxDistance,
-	                                               radarScope->distance_separation_threshold);
-
-	bool isAzimuthGood = doRangesOverlap(minMaxAzimuth, other.minMaxAzimuth) ||
-	                     areRangesWithinThreshold(minMaxAzimuth, other.minMaxAzimuth, radarScope->azimuth_separation_threshold);
-
-	bool isRadialSpeedGood = doRangesOverlap(minMaxRadialSpeed, other.minMaxRadialSpeed) ||
-	                         areRangesWithinThreshold(minMaxRadialSpeed, other.minMaxRadialSpeed,
-	                                                  radarScope->radial_speed_separation_threshold);
-
-	// Radial speed check is ignored if one of limits on it, in one of clusters, is nan.
-	return isDistanceGood && isAzimuthGood &&
-	       (isRadialSpeedGood || std::isunordered(minMaxRadialSpeed[0], minMaxRadialSpeed[1]) ||
-	        std::isunordered(other.minMaxRadialSpeed[0], other.minMaxRadialSpeed[1]));
-}
-
-void RadarPostprocessPointsNode::RadarCluster::takeIndicesFrom(RadarCluster&& other)
-{
-	minMaxDistance[0] = std::min(minMaxDistance[0], other.minMaxDistance[0]);
-	minMaxDistance[1] = std::max(minMaxDistance[1], other.minMaxDistance[1]);
-	minMaxAzimuth[0] = std::min(minMaxAzimuth[0], other.minMaxAzimuth[0]);
-	minMaxAzimuth[1] = std::max(minMaxAzimuth[1], other.minMaxAzimuth[1]);
-	minMaxRadialSpeed[0] = std::isnan(other.minMaxRadialSpeed[0]) ? minMaxRadialSpeed[0] : std::min(other.minMaxRadialSpeed[0], minMaxRadialSpeed[0]);
-	minMaxRadialSpeed[1] = std::isnan(other.minMaxRadialSpeed[1]) ? minMaxRadialSpeed[1] : std::min(other.minMaxRadialSpeed[1], minMaxRadialSpeed[1]);
-	minMaxElevation[0] = std::min(minMaxElevation[0], other.minMaxElevation[0]);
-	minMaxElevation[1] = std::max(minMaxElevation[1], other.minMaxElevation[1]);
-
-	// Move indices
-	std::size_t n = indices.size();
-	indices.resize(indices.size() + other.indices.size());
-	std::move(other.indices.begin(), other.indices.end(), indices.begin() + n);
+	auto fieldArray = input->getFieldDataTyped<field>();
+	if (!isHost(fieldArray->getMemoryKind())) {
+		return fieldArray->template asSubclass<DeviceAsyncArray>()->getReadPtr();
+	}
+	// Computing energy has no host counterpart yet, so host-resident inputs are uploaded
+	if (!energyInputsDev.contains(field)) {
+		energyInputsDev.insert({field, createArray<DeviceAsyncArray>(field, arrayMgr)});
+	}
+	auto deviceArray = energyInputsDev.at(field);
+	deviceArray->copyFrom(fieldArray);
+	return deviceArray->template asTyped<typename Field<field>::type>()->template asSubclass<DeviceAsyncArray>()->getReadPtr();
 }
 
-Field<RAY_IDX_U32>::type RadarPostprocessPointsNode::RadarCluster::findDirectionalCenterIndex(
-    const Field<AZIMUTH_F32>::type* azimuths, const Field<ELEVATION_F32>::type* elevations) const
+std::vector<rgl_field_t> RadarPostprocessPointsNode::getRequiredFieldList() const
 {
-	auto meanAzimuth = (minMaxAzimuth[0] + minMaxAzimuth[1]) / 2.0f;
-	auto meanElevation = (minMaxElevation[0] + minMaxElevation[1]) / 2.0f;
-
-	float minDistance = FLT_MAX;
-	uint32_t minIndex = indices.front();
-
-	for (auto&& i : indices) {
-		float distance = std::abs(azimuths[i] - meanAzimuth) + std::abs(elevations[i] - meanElevation);
-		if (distance < minDistance) {
-			minDistance = distance;
-			minIndex = i;
-		}
-	}
-	return minIndex;
+	return {DISTANCE_F32, AZIMUTH_F32, ELEVATION_F32, RADIAL_SPEED_F32, RAY_POSE_MAT3x4_F32, NORMAL_VEC3_F32, XYZ_VEC3_F32};
 }
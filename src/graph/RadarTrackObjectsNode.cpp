@@ -12,9 +12,51 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <numeric>
+
 #include <graph/NodesCore.hpp>
 #include <scene/Scene.hpp>
 
+// Cell coordinates must fit in 21 bits of a cell key, margin is left for neighbouring cells.
+static constexpr float MAX_CELL_COORD = 1 << 19;
+
+static std::optional<Vec3i> getCellCoords(const Vec3f& value, const Vec3f& cellSize)
+{
+	Vec3i cell;
+	for (int axis = 0; axis < 3; ++axis) {
+		const float coord = std::floor(value[axis] / cellSize[axis]);
+		if (!(std::abs(coord) < MAX_CELL_COORD)) { // Also catches nan
+			return std::nullopt;
+		}
+		cell[axis] = static_cast<int>(coord);
+	}
+	return cell;
+}
+
+static uint64_t getCellKey(const Vec3i& cell)
+{
+	// 21 bits per axis, coordinates are offset to be non-negative
+	constexpr int64_t offset = 1 << 20;
+	constexpr uint64_t mask = (1 << 21) - 1;
+	uint64_t key = 0;
+	for (int axis = 0; axis < 3; ++axis) {
+		key = (key << 21) | (static_cast<uint64_t>(cell[axis] + offset) & mask);
+	}
+	return key;
+}
+
+template<typename Fn>
+static void forEachNeighbourCellKey(const Vec3i& cell, Fn&& fn)
+{
+	for (int dx = -1; dx <= 1; ++dx) {
+		for (int dy = -1; dy <= 1; ++dy) {
+			for (int dz = -1; dz <= 1; ++dz) {
+				fn(getCellKey({cell[0] + dx, cell[1] + dy, cell[2] + dz}));
+			}
+		}
+	}
+}
+
 
 // TODO(Pawel): Consider adding more output fields here, maybe usable for ROS 2 message or visualization. Consider also returning detections, when object states are returned through public method.
 RadarTrackObjectsNode::RadarTrackObjectsNode()
@@ -66,57 +108,11 @@ void RadarTrackObjectsNode::enqueueExecImpl()
 	const auto detectionAabbs = radarPostprocessPointsNode ? radarPostprocessPointsNode->getClusterAabbs() :
 	                                                         std::vector<Aabb3Df>(input->getPointCount());
 
-	// Top level in this list is for objects. Bottom level is for detections that belong to specific objects. Below is an initialization of a helper
-	// structure for region growing, which starts with a while-loop.
-	std::list<std::list<int>> objectIndices;
-	for (int i = 0; i < input->getPointCount(); ++i) {
-		objectIndices.emplace_back(1, i);
-	}
-
-	int leftIndex = 0;
-	while (leftIndex + 1 < objectIndices.size()) {
-		auto ownIt = objectIndices.begin();
-		std::advance(ownIt, leftIndex);
-		auto checkedIt = std::next(ownIt);
-		bool reorganizationTookPlace = false;
-
-		while (checkedIt != objectIndices.end()) {
-			auto& checkedIndices = *checkedIt;
-
-			// TODO(Pawel): In theory, I do not have to check the same indices multiple times when growing this subset in next iterations.
-			for (auto ownDetectionId : *ownIt) {
-				const auto isPartOfSameObject = [&, distance = distanceHostPtr->at(ownDetectionId),
-				                                 azimuth = azimuthHostPtr->at(ownDetectionId),
-				                                 elevation = elevationHostPtr->at(ownDetectionId),
-				                                 radialSpeed = radialSpeedHostPtr->at(ownDetectionId)](int checkedDetectionId) {
-					return std::abs(distanceHostPtr->at(checkedDetectionId) - distance) <= distanceThreshold &&
-					       std::abs(azimuthHostPtr->at(checkedDetectionId) - azimuth) <= azimuthThreshold &&
-					       std::abs(elevationHostPtr->at(checkedDetectionId) - elevation) <= elevationThreshold &&
-					       (std::isunordered(radialSpeed, radialSpeedHostPtr->at(checkedDetectionId)) ||
-					        std::abs(radialSpeedHostPtr->at(checkedDetectionId) - radialSpeed) <= radialSpeedThreshold);
-				};
-
-				if (std::any_of(checkedIndices.cbegin(), checkedIndices.cend(), isPartOfSameObject)) {
-					ownIt->splice(ownIt->cend(), checkedIndices);
-					break;
-				}
-			}
-			if (checkedIndices.empty()) {
-				checkedIt = objectIndices.erase(checkedIt);
-				reorganizationTookPlace = true;
-			} else {
-				++checkedIt;
-			}
-		}
-
-		if (!reorganizationTookPlace) {
-			// We are done with growing this object, no more matching detections are available.
-			++leftIndex;
-		}
-	}
+	// Group detections into objects - detections close to each other (transitively) belong to the same object.
+	groupDetections(static_cast<int>(input->getPointCount()));
 
 	// Calculate positions of objects detected in current frame.
-	std::list<ObjectBounds> newObjectBounds;
+	newObjectBounds.clear();
 	for (const auto& separateObjectIndices : objectIndices) {
 		auto& objectBounds = newObjectBounds.emplace_back();
 		auto entityIdHist = std::unordered_map<Field<ENTITY_ID_I32>::type, int>();
@@ -139,6 +135,7 @@ void RadarTrackObjectsNode::enqueueExecImpl()
 		objectBounds.relVelocity *= 1 / static_cast<float>(separateObjectIndices.size());
 		objectBounds.absVelocity *= 1 / static_cast<float>(separateObjectIndices.size());
 	}
+	indexNewObjects();
 
 	// We cannot use `Scene::instance().getPrevTime()` because scene could be updated more frequently than given sensor
 	const auto deltaTime = Scene::instance().getTime().value_or(Time::zero()).asMilliseconds() - currentTime;
@@ -149,18 +146,16 @@ void RadarTrackObjectsNode::enqueueExecImpl()
 	for (auto objectStateIt = objectStates.begin(); objectStateIt != objectStates.end();) {
 		auto& objectState = *objectStateIt;
 		const auto predictedPosition = predictObjectPosition(objectState, deltaTime);
-		const auto closestObjectIt = std::min_element(
-		    newObjectBounds.cbegin(), newObjectBounds.cend(), [&](const auto& a, const auto& b) {
-			    return (a.position - predictedPosition).lengthSquared() < (b.position - predictedPosition).lengthSquared();
-		    });
+		const auto closestObjectIdx = findClosestNewObject(predictedPosition);
 
 		// There is a newly detected object (current frame) that matches the predicted position of one of objects from previous frame.
 		// Update object from previous frame to newly detected object position and remove this positions for next checkouts.
-		if (const auto& closestObject = *closestObjectIt;
-		    (predictedPosition - closestObject.position).length() < maxMatchingDistance) {
+		if (closestObjectIdx.has_value() &&
+		    (predictedPosition - newObjectBounds[*closestObjectIdx].position).length() < maxMatchingDistance) {
+			const auto& closestObject = newObjectBounds[*closestObjectIdx];
 			updateObjectState(objectState, closestObject.position, closestObject.aabb, ObjectStatus::Measured, currentTime,
 			                  deltaTime, closestObject.absVelocity, closestObject.relVelocity);
-			newObjectBounds.erase(closestObjectIt);
+			isNewObjectMatched[*closestObjectIdx] = true;
 			++objectStateIt;
 			continue;
 		}
@@ -182,8 +177,10 @@ void RadarTrackObjectsNode::enqueueExecImpl()
 	}
 
 	// All newly detected object position that do not have a match in previous frame - create new object state.
-	for (const auto& newObject : newObjectBounds) {
-		createObjectState(newObject, currentTime);
+	for (size_t i = 0; i < newObjectBounds.size(); ++i) {
+		if (!isNewObjectMatched[i]) {
+			createObjectState(newObjectBounds[i], currentTime);
+		}
 	}
 
 	updateOutputData();
@@ -344,3 +341,143 @@ void RadarTrackObjectsNode::updateOutputData()
 	fieldData[XYZ_VEC3_F32]->copyFrom(outXyzHostPtr);
 	fieldData[ENTITY_ID_I32]->copyFrom(outEntityIdHostPtr);
 }
+
+void RadarTrackObjectsNode::groupDetections(int detectionCount)
+{
+	const auto isPartOfSameObject = [&](int lhs, int rhs) {
+		const auto radialSpeed = radialSpeedHostPtr->at(lhs);
+		return std::abs(distanceHostPtr->at(rhs) - distanceHostPtr->at(lhs)) <= distanceThreshold &&
+		       std::abs(azimuthHostPtr->at(rhs) - azimuthHostPtr->at(lhs)) <= azimuthThreshold &&
+		       std::abs(elevationHostPtr->at(rhs) - elevationHostPtr->at(lhs)) <= elevationThreshold &&
+		       (std::isunordered(radialSpeed, radialSpeedHostPtr->at(rhs)) ||
+		        std::abs(radialSpeedHostPtr->at(rhs) - radialSpeed) <= radialSpeedThreshold);
+	};
+	const auto tryJoin = [&](int lhs, int rhs) {
+		const int lhsRoot = findDetectionRoot(lhs);
+		const int rhsRoot = findDetectionRoot(rhs);
+		if (lhsRoot != rhsRoot && isPartOfSameObject(lhs, rhs)) {
+			detectionParents[std::max(lhsRoot, rhsRoot)] = std::min(lhsRoot, rhsRoot);
+		}
+	};
+
+	// Detections closer than thresholds are at most one cell apart. Radial speed is not indexed, because detections with
+	// unknown radial speed match any other. Cells are slightly larger than thresholds to be safe from rounding errors.
+	const auto getCellSize = [](float threshold) { return threshold > 0.0f ? threshold * 1.001f : 1.0f; };
+	const Vec3f cellSize{getCellSize(distanceThreshold), getCellSize(azimuthThreshold), getCellSize(elevationThreshold)};
+	const bool isGridUsable = std::isfinite(cellSize[0]) && std::isfinite(cellSize[1]) && std::isfinite(cellSize[2]);
+
+	detectionParents.resize(detectionCount);
+	std::iota(detectionParents.begin(), detectionParents.end(), 0);
+	detectionCells.clear();
+	unindexedDetections.clear();
+	for (int i = 0; i < detectionCount; ++i) {
+		const Vec3f coords{distanceHostPtr->at(i), azimuthHostPtr->at(i), elevationHostPtr->at(i)};
+		const auto cell = isGridUsable ? getCellCoords(coords, cellSize) : std::nullopt;
+		if (!cell.has_value()) {
+			// Out of grid (e.g. infinite thresholds) - fall back to comparing with all previous detections.
+			for (int j = 0; j < i; ++j) {
+				tryJoin(j, i);
+			}
+			unindexedDetections.emplace_back(i);
+			continue;
+		}
+		forEachNeighbourCellKey(*cell, [&](uint64_t key) {
+			if (auto cellIt = detectionCells.find(key); cellIt != detectionCells.end()) {
+				for (auto&& j : cellIt->second) {
+					tryJoin(j, i);
+				}
+			}
+		});
+		for (auto&& j : unindexedDetections) {
+			tryJoin(j, i);
+		}
+		detectionCells[getCellKey(*cell)].emplace_back(i);
+	}
+
+	// Objects are ordered by their first detection, roots are always the smallest indices of their trees.
+	objectIndices.clear();
+	std::vector<int> rootToObject(detectionCount, -1);
+	for (int i = 0; i < detectionCount; ++i) {
+		const int root = findDetectionRoot(i);
+		if (rootToObject[root] < 0) {
+			rootToObject[root] = static_cast<int>(objectIndices.size());
+			objectIndices.emplace_back();
+		}
+		objectIndices[rootToObject[root]].emplace_back(i);
+	}
+}
+
+int RadarTrackObjectsNode::findDetectionRoot(int detectionIndex)
+{
+	// Path halving
+	while (detectionParents[detectionIndex] != detectionIndex) {
+		detectionParents[detectionIndex] = detectionParents[detectionParents[detectionIndex]];
+		detectionIndex = detectionParents[detectionIndex];
+	}
+	return detectionIndex;
+}
+
+void RadarTrackObjectsNode::indexNewObjects()
+{
+	// Objects closer than maxMatchingDistance to the predicted position are at most one cell apart from it.
+	// Further ones are never matched, so only neighbouring cells need to be searched.
+	const bool isGridUsable = maxMatchingDistance > 0.0f && std::isfinite(maxMatchingDistance);
+	newObjectCellSize = maxMatchingDistance * 1.001f;
+
+	isNewObjectMatched.assign(newObjectBounds.size(), false);
+	newObjectCells.clear();
+	unindexedNewObjects.clear();
+	for (size_t i = 0; i < newObjectBounds.size(); ++i) {
+		const auto cell = isGridUsable ? getCellCoords(newObjectBounds[i].position, Vec3f{newObjectCellSize}) : std::nullopt;
+		if (cell.has_value()) {
+			newObjectCells[getCellKey(*cell)].emplace_back(i);
+		} else {
+			unindexedNewObjects.emplace_back(i);
+		}
+	}
+}
+
+std::optional<size_t> RadarTrackObjectsNode::findClosestNewObject(const Vec3f& predictedPosition) const
+{
+	std::optional<size_t> closestObjectIdx;
+	float closestDistanceSquared = 0.0f;
+	const auto checkObject = [&](size_t i) {
+		if (isNewObjectMatched[i]) {
+			return;
+		}
+		const auto distanceSquared = (newObjectBounds[i].position - predictedPosition).lengthSquared();
+		// On ties, the object detected first wins.
+		if (!closestObjectIdx.has_value() || distanceSquared < closestDistanceSquared ||
+		    (distanceSquared == closestDistanceSquared && i < *closestObjectIdx)) {
+			closestObjectIdx = i;
+			closestDistanceSquared = distanceSquared;
+		}
+	};
+
+	if (newObjectCells.empty()) {
+		for (auto&& i : unindexedNewObjects) {
+			checkObject(i);
+		}
+		return closestObjectIdx;
+	}
+
+	const auto cell = getCellCoords(predictedPosition, Vec3f{newObjectCellSize});
+	if (!cell.has_value()) {
+		// Predicted position is out of the grid, which is rare enough to check all objects.
+		for (size_t i = 0; i < newObjectBounds.size(); ++i) {
+			checkObject(i);
+		}
+		return closestObjectIdx;
+	}
+	forEachNeighbourCellKey(*cell, [&](uint64_t key) {
+		if (auto cellIt = newObjectCells.find(key); cellIt != newObjectCells.end()) {
+			for (auto&& i : cellIt->second) {
+				checkObject(i);
+			}
+		}
+	});
+	for (auto&& i : unindexedNewObjects) {
+		checkObject(i);
+	}
+	return closestObjectIdx;
+}
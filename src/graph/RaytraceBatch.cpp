@@ -0,0 +1,169 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <graph/RaytraceBatch.hpp>
+
+#include <Optix.hpp>
+#include <scene/Scene.hpp>
+#include <gpu/nodeKernels.hpp>
+#include <macros/optix.hpp>
+#include <RGLExceptions.hpp>
+
+static size_t alignUp(size_t offset, size_t alignment) { return (offset + alignment - 1) / alignment * alignment; }
+
+RaytraceLaunchData RaytraceLaunchData::create(std::vector<RaytraceRequestContext> requests, OptixTraversableHandle scene,
+                                              float sceneDeltaTime)
+{
+	RaytraceLaunchData data{.requests = std::move(requests)};
+	data.requestRayOffsets.reserve(data.requests.size() + 1);
+	size_t rayCount = 0;
+	for (auto&& request : data.requests) {
+		request.scene = scene;
+		request.sceneDeltaTime = sceneDeltaTime;
+		data.requestRayOffsets.push_back(static_cast<uint32_t>(rayCount));
+		rayCount += request.rayCount;
+		if (rayCount > maxRayCount) {
+			auto msg = fmt::format("raytrace launch exceeds the limit of {} rays", maxRayCount);
+			throw InvalidPipeline(msg);
+		}
+	}
+	data.requestRayOffsets.push_back(static_cast<uint32_t>(rayCount));
+	data.rayCount = static_cast<uint32_t>(rayCount);
+	return data;
+}
+
+CudaEvent::Ptr RaytraceLauncher::launch(cudaStream_t stream, std::vector<RaytraceRequestContext> requests)
+{
+	// Even though we are in graph thread here, we can access Scene class (see comment there)
+	auto [sceneAS, sceneSBT] = Scene::instance().getASAndSBTLocked();
+	auto sceneDeltaTime = static_cast<float>(Scene::instance().getDeltaTime().value_or(Time::zero()).asSeconds());
+	auto data = RaytraceLaunchData::create(std::move(requests), sceneAS, sceneDeltaTime);
+
+	const size_t requestsOffset = alignUp(sizeof(RaytraceLaunchParams), alignof(RaytraceRequestContext));
+	const size_t rayOffsetsOffset = alignUp(requestsOffset + data.requests.size() * sizeof(RaytraceRequestContext),
+	                                        alignof(uint32_t));
+	const size_t bufferSize = rayOffsetsOffset + data.requestRayOffsets.size() * sizeof(uint32_t);
+
+	if (lastLaunchCompleted != nullptr) {
+		CHECK_CUDA(cudaStreamWaitEvent(stream, lastLaunchCompleted->getHandle()));
+	}
+	launchBufferDev->resize(bufferSize, false, false);
+	char* bufferDev = launchBufferDev->getWritePtr();
+	auto requestsDev = reinterpret_cast<const RaytraceRequestContext*>(bufferDev + requestsOffset);
+	const RaytraceLaunchParams params{
+	    .requests = requestsDev,
+	    .requestRayOffsets = reinterpret_cast<const uint32_t*>(bufferDev + rayOffsetsOffset),
+	    .requestCount = static_cast<int>(data.requests.size()),
+	};
+	launchBufferHst.resize(bufferSize);
+	memcpy(launchBufferHst.data(), &params, sizeof(params));
+	memcpy(launchBufferHst.data() + requestsOffset, data.requests.data(),
+	       data.requests.size() * sizeof(RaytraceRequestContext));
+	memcpy(launchBufferHst.data() + rayOffsetsOffset, data.requestRayOffsets.data(),
+	       data.requestRayOffsets.size() * sizeof(uint32_t));
+	// Copy from pageable memory returns once the source is staged, so launchBufferHst may be reused afterwards.
+	CHECK_CUDA(cudaMemcpyAsync(bufferDev, launchBufferHst.data(), bufferSize, cudaMemcpyHostToDevice, stream));
+
+	if (data.rayCount > 0) {
+		CHECK_OPTIX(optixLaunch(Optix::getOrCreate().pipeline, stream, reinterpret_cast<CUdeviceptr>(bufferDev),
+		                        sizeof(RaytraceLaunchParams), &sceneSBT, data.rayCount, 1, 1));
+	}
+	for (size_t requestIdx = 0; requestIdx < data.requests.size(); ++requestIdx) {
+		const auto& request = data.requests.at(requestIdx);
+		if (request.doSampleBeams) {
+			gpuReduceDivergentBeams(stream, request.rayCount, MULTI_RETURN_BEAM_SAMPLES, request.returnMode,
+			                        requestsDev + requestIdx);
+		}
+	}
+
+	lastLaunchCompleted = CudaEvent::create();
+	CHECK_CUDA(cudaEventRecord(lastLaunchCompleted->getHandle(), stream));
+	return lastLaunchCompleted;
+}
+
+RaytraceBatch::Ptr RaytraceBatch::getOrCreate(int32_t batchId)
+{
+	static std::mutex registryMutex;
+	static std::unordered_map<int32_t, std::weak_ptr<RaytraceBatch>> registry;
+
+	std::lock_guard lock{registryMutex};
+	auto batch = registry[batchId].lock();
+	if (batch == nullptr) {
+		batch = std::make_shared<RaytraceBatch>();
+		registry[batchId] = batch;
+	}
+	return batch;
+}
+
+void RaytraceBatch::addMember(const RaytraceNode* member)
+{
+	std::lock_guard lock{mutex};
+	members.try_emplace(member, CudaEvent::create());
+}
+
+void RaytraceBatch::removeMember(const RaytraceNode* member)
+{
+	std::lock_guard lock{mutex};
+	members.erase(member);
+}
+
+void RaytraceBatch::enqueue(const RaytraceNode* member, const RaytraceRequestContext& request, cudaStream_t stream)
+{
+	std::unique_lock lock{mutex};
+	auto memberIt = members.find(member);
+	if (memberIt == members.end()) {
+		throw std::logic_error("attempted to enqueue raytracing of a node that is not a member of the batch");
+	}
+	auto submission = std::make_shared<Submission>(Submission{.request = request, .memberReady = memberIt->second});
+	CHECK_CUDA(cudaEventRecord(submission->memberReady->getHandle(), stream));
+	pending.push_back(submission);
+
+	if (pending.size() < members.size()) {
+		launched.wait_for(lock, maxGatherTime, [&]() { return submission->isLaunched; });
+	}
+	if (!submission->isLaunched) {
+		// Either all members have submitted, or the rest did not make it in time.
+		launchPending(stream);
+	}
+	if (submission->launchException != nullptr) {
+		std::rethrow_exception(submission->launchException);
+	}
+	CHECK_CUDA(cudaStreamWaitEvent(stream, submission->launchCompleted->getHandle()));
+}
+
+void RaytraceBatch::launchPending(cudaStream_t stream)
+{
+	try {
+		std::vector<RaytraceRequestContext> requests;
+		requests.reserve(pending.size());
+		for (auto&& submission : pending) {
+			CHECK_CUDA(cudaStreamWaitEvent(stream, submission->memberReady->getHandle()));
+			requests.push_back(submission->request);
+		}
+		auto launchCompleted = launcher.launch(stream, std::move(requests));
+		for (auto&& submission : pending) {
+			submission->launchCompleted = launchCompleted;
+		}
+	}
+	catch (...) {
+		for (auto&& submission : pending) {
+			submission->launchException = std::current_exception();
+		}
+	}
+	for (auto&& submission : pending) {
+		submission->isLaunched = true;
+	}
+	pending.clear();
+	launched.notify_all();
+}
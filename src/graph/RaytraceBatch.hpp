@@ -0,0 +1,116 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <mutex>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <exception>
+#include <unordered_map>
+#include <condition_variable>
+
+#include <CudaEvent.hpp>
+#include <memory/Array.hpp>
+#include <gpu/RaytraceRequestContext.hpp>
+
+struct RaytraceNode;
+
+/**
+ * Requests of a single optix launch, laid out as expected by optix programs (see RaytraceLaunchParams).
+ */
+struct RaytraceLaunchData
+{
+	// Optix limits launch size (width * height * depth) to 2^30.
+	static constexpr uint32_t maxRayCount = 1U << 30;
+
+	std::vector<RaytraceRequestContext> requests;
+	std::vector<uint32_t> requestRayOffsets;
+	uint32_t rayCount{0};
+
+	/**
+	 * Lays out rays of the requests one after another. All requests get the same scene snapshot.
+	 */
+	static RaytraceLaunchData create(std::vector<RaytraceRequestContext> requests, OptixTraversableHandle scene,
+	                                 float sceneDeltaTime);
+};
+
+/**
+ * Raytraces one or more requests with a single optix launch and a single scene snapshot.
+ * Divergent beams of requests that sample beams are reduced right after the launch.
+ */
+struct RaytraceLauncher
+{
+	/**
+	 * Enqueues raytracing of the requests in the given stream.
+	 * @return Event recorded once results of all requests are written.
+	 */
+	CudaEvent::Ptr launch(cudaStream_t stream, std::vector<RaytraceRequestContext> requests);
+
+private:
+	// RaytraceLaunchParams, requests and ray offsets, copied to the device with a single memcpy.
+	std::vector<char> launchBufferHst;
+	DeviceSyncArray<char>::Ptr launchBufferDev = DeviceSyncArray<char>::create();
+	// Guards launchBufferDev from being overwritten while the previous launch may still read it.
+	CudaEvent::Ptr lastLaunchCompleted;
+};
+
+/**
+ * Fuses raytracing of multiple RaytraceNodes, possibly from different graphs, into a single optix launch.
+ * Members submit requests from their graph threads. The last one to submit launches the whole batch in its stream.
+ * Other members wait until then and make their streams wait for the launch.
+ * Therefore, members should be enqueued concurrently, i.e. belong to different graphs (or concurrent branches).
+ * If not all members submit within maxGatherTime (e.g. some graph was not run), requests gathered so far are launched.
+ */
+struct RaytraceBatch
+{
+	using Ptr = std::shared_ptr<RaytraceBatch>;
+
+	static constexpr auto maxGatherTime = std::chrono::milliseconds(5);
+
+	/**
+	 * Returns batch with the given id, creating it if needed. Batch exists as long as it is referenced by its members.
+	 */
+	static RaytraceBatch::Ptr getOrCreate(int32_t batchId);
+
+	void addMember(const RaytraceNode* member);
+	void removeMember(const RaytraceNode* member);
+
+	/**
+	 * Enqueues raytracing of the member's request, as a part of the batch launch.
+	 * Returns once the launch is enqueued and the given stream waits for it.
+	 */
+	void enqueue(const RaytraceNode* member, const RaytraceRequestContext& request, cudaStream_t stream);
+
+private:
+	struct Submission
+	{
+		RaytraceRequestContext request;
+		CudaEvent::Ptr memberReady;
+		CudaEvent::Ptr launchCompleted;
+		std::exception_ptr launchException;
+		bool isLaunched{false};
+	};
+
+	// Must be called with the mutex locked.
+	void launchPending(cudaStream_t stream);
+
+	std::mutex mutex;
+	std::condition_variable launched;
+	std::unordered_map<const RaytraceNode*, CudaEvent::Ptr> members; // Value is recorded in member's stream on submission
+	std::vector<std::shared_ptr<Submission>> pending;
+	RaytraceLauncher launcher;
+};
@@ -26,6 +26,24 @@ void RaytraceNode::setParameters()
 	defaultRange->copyFromExternal(&defaultRangeValue, 1);
 }
 
+RaytraceNode::~RaytraceNode()
+{
+	if (batch != nullptr) {
+		batch->removeMember(this);
+	}
+}
+
+void RaytraceNode::setBatch(int32_t batchId)
+{
+	if (batch != nullptr) {
+		batch->removeMember(this);
+	}
+	batch = batchId != 0 ? RaytraceBatch::getOrCreate(batchId) : nullptr;
+	if (batch != nullptr) {
+		batch->addMember(this);
+	}
+}
+
 void RaytraceNode::validateImpl()
 {
 	// It should be viewed as a temporary solution. Will change in v14.
@@ -71,27 +89,26 @@ void RaytraceNode::enqueueExecImpl()
 	for (auto const& [_, data] : fieldData) {
 		data->resize(returnCount * raysNode->getRayCount(), false, false);
 	}
-	// TODO(Pawel): This should be updated at some point for a case without divergence - only single ray will be casted per
-	// beam, so only one sample would be necessary. Or, this may even be handles without samples, basically skipping
-	// gpuReduceDivergentBeams call at the bottom of this method. However, this will make the pipeline less clear and will
-	// require more tests.
-	mrSampleData.resize(MULTI_RETURN_BEAM_SAMPLES * raysNode->getRayCount());
+	// Without divergence, only the primary ray is shot per beam and optix programs write returns directly to the output
+	// fields. Multi-return samples (and gpuReduceDivergentBeams) are needed only when beam is sampled.
+	const bool doSampleBeams = hBeamHalfDivergenceRad > 0.0f && vBeamHalfDivergenceRad > 0.0f;
+	if (doSampleBeams) {
+		mrSampleData.resize(MULTI_RETURN_BEAM_SAMPLES * raysNode->getRayCount());
+	} else if (mrSampleData.getCapacity() > 0) {
+		// Divergence has been disabled, release samples memory.
+		mrSampleData = MultiReturnSamples{arrayMgr};
+		mrSampleData.adjustToFields(fieldData, arrayMgr);
+	}
 
-	// Even though we are in graph thread here, we can access Scene class (see comment there)
 	const Mat3x4f* raysPtr = raysNode->getRays()->asSubclass<DeviceAsyncArray>()->getReadPtr();
-	auto sceneAS = Scene::instance().getASLocked();
-	auto sceneSBT = Scene::instance().getSBTLocked();
-	dim3 launchDims = {static_cast<unsigned int>(raysNode->getRayCount()), 1, 1};
 
 	// Optional
 	auto rayRanges = raysNode->getRanges();
 	auto ringIds = raysNode->getRingIds();
 	auto timeOffsets = raysNode->getTimeOffsets();
 
-	// Note: requestCtx is a HostPinnedArray just for convenience (Host meme accessible from GPU), may be optimized.
-	requestCtxHst->resize(1, true, false);
-
-	requestCtxHst->at(0) = RaytraceRequestContext{
+	// Scene and its delta time are filled in by the launcher, the same for all requests of the launch.
+	const RaytraceRequestContext requestCtx{
 	    .sensorLinearVelocityXYZ = sensorLinearVelocityXYZ,
 	    .sensorAngularVelocityRPY = sensorAngularVelocityRPY,
 	    .doApplyDistortion = doApplyDistortion,
@@ -109,8 +126,6 @@ void RaytraceNode::enqueueExecImpl()
 	    .rayTimeOffsetsMs = timeOffsets.has_value() ? (*timeOffsets)->asSubclass<DeviceAsyncArray>()->getReadPtr() : nullptr,
 	    .rayTimeOffsetsCount = timeOffsets.has_value() ? (*timeOffsets)->getCount() : 0,
 	    .rayMask = (rayMask != nullptr) ? rayMask->getReadPtr() : nullptr,
-	    .scene = sceneAS,
-	    .sceneDeltaTime = static_cast<float>(Scene::instance().getDeltaTime().value_or(Time::zero()).asSeconds()),
 	    .xyz = getPtrTo<XYZ_VEC3_F32>(),
 	    .isHit = getPtrTo<IS_HIT_I32>(),
 	    .rayIdx = getPtrTo<RAY_IDX_U32>(),
@@ -131,18 +146,22 @@ void RaytraceNode::enqueueExecImpl()
 	    .normal = getPtrTo<NORMAL_VEC3_F32>(),
 	    .incidentAngle = getPtrTo<INCIDENT_ANGLE_F32>(),
 	    .mrSamples = mrSampleData.getPointers(),
+	    .returnMode = returnMode,
 	    .returnCount = static_cast<int>(returnCount),
 	    .hBeamHalfDivergenceRad = hBeamHalfDivergenceRad,
 	    .vBeamHalfDivergenceRad = vBeamHalfDivergenceRad,
+	    .doSampleBeams = doSampleBeams,
 	};
-	requestCtxDev->copyFrom(requestCtxHst);
-	CUdeviceptr pipelineArgsPtr = requestCtxDev->getDeviceReadPtr();
-	std::size_t pipelineArgsSize = requestCtxDev->getSizeOf() * requestCtxDev->getCount();
-	CHECK_OPTIX(optixLaunch(Optix::getOrCreate().pipeline, getStreamHandle(), pipelineArgsPtr, pipelineArgsSize, &sceneSBT,
-	                        launchDims.x, launchDims.y, launchDims.y));
-
-	gpuReduceDivergentBeams(getStreamHandle(), raysNode->getRayCount(), MULTI_RETURN_BEAM_SAMPLES, returnMode,
-	                        requestCtxDev->getReadPtr());
+	if (backend == RGL_RAYTRACE_BACKEND_HOST_TRAVERSAL) {
+		if (batch != nullptr) {
+			throw InvalidPipeline("raytrace batch is not supported by host traversal backend");
+		}
+		hostTraversalLauncher.launch(getStreamHandle(), requestCtx);
+	} else if (batch != nullptr) {
+		batch->enqueue(this, requestCtx, getStreamHandle());
+	} else {
+		launcher.launch(getStreamHandle(), {requestCtx});
+	}
 }
 
 void RaytraceNode::setFields(const std::set<rgl_field_t>& fields)
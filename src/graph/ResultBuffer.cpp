@@ -0,0 +1,81 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <graph/ResultBuffer.hpp>
+#include <RGLExceptions.hpp>
+
+ResultBuffer::ResultBuffer(void* data, std::size_t size) : data(data), size(size)
+{
+	// Page-locking makes the copy a single DMA transfer, but it may fail, e.g. if the memory is already registered.
+	// In such case, the buffer is still usable, although copies to it may be slower.
+	cudaError_t status = cudaHostRegister(data, size, cudaHostRegisterDefault);
+	isRegistered = status == cudaSuccess;
+	if (!isRegistered) {
+		cudaGetLastError(); // Clear non-sticky error
+		RGL_WARN("Failed to page-lock result buffer {} ({} bytes): {}", data, size, cudaGetErrorString(status));
+	}
+}
+
+void ResultBuffer::enqueueExport(IAnyArray::ConstPtr src, std::size_t pointSize, cudaStream_t stream, uint64_t runIndex)
+{
+	exportedBytes = src->getCount() * src->getSizeOf();
+	exportedPointCount = exportedBytes / pointSize;
+	exportException = nullptr;
+	if (exportedBytes <= size) {
+		if (isHost(src->getMemoryKind())) {
+			memcpy(data, src->getRawReadPtr(), exportedBytes);
+		} else {
+			CHECK_CUDA(cudaMemcpyAsync(data, src->getRawReadPtr(), exportedBytes, cudaMemcpyDefault, stream));
+		}
+	}
+	CHECK_CUDA(cudaEventRecord(exportCompleted->getHandle(), stream));
+	exportedRun.store(runIndex, std::memory_order::release);
+}
+
+void ResultBuffer::setExportFailed(std::exception_ptr exception, uint64_t runIndex)
+{
+	exportException = exception;
+	exportedRun.store(runIndex, std::memory_order::release);
+}
+
+std::optional<std::size_t> ResultBuffer::query(uint64_t runIndex)
+{
+	if (runIndex == 0 || exportedRun.load(std::memory_order::acquire) != runIndex) {
+		return std::nullopt;
+	}
+	if (exportException != nullptr) {
+		std::rethrow_exception(exportException);
+	}
+	if (exportedBytes > size) {
+		auto msg = fmt::format("result buffer is too small: results take {} bytes, buffer has {} bytes", exportedBytes, size);
+		throw InvalidPipeline(msg);
+	}
+	cudaError_t status = cudaEventQuery(exportCompleted->getHandle());
+	if (status == cudaErrorNotReady) {
+		return std::nullopt;
+	}
+	CHECK_CUDA(status);
+	return exportedPointCount;
+}
+
+ResultBuffer::~ResultBuffer()
+try {
+	// Pending export must not write to the buffer after it is returned to the client.
+	CHECK_CUDA(cudaEventSynchronize(exportCompleted->getHandle()));
+	if (isRegistered) {
+		CHECK_CUDA(cudaHostUnregister(data));
+	}
+}
+HANDLE_DESTRUCTOR_EXCEPTION
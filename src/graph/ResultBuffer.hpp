@@ -0,0 +1,71 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <optional>
+
+#include <CudaEvent.hpp>
+#include <memory/IAnyArray.hpp>
+
+/**
+ * Client-owned buffer to which a field of node's results is exported at the end of each graph run.
+ * The buffer is page-locked (if possible), so that results are transferred directly to it, without staging copies.
+ * Export is performed by the graph thread, its completion is polled by the client's thread.
+ */
+struct ResultBuffer
+{
+	using Ptr = std::shared_ptr<ResultBuffer>;
+
+	static ResultBuffer::Ptr create(void* data, std::size_t size) { return ResultBuffer::Ptr(new ResultBuffer(data, size)); }
+
+	/**
+	 * Enqueues copy of src to the buffer in the given stream.
+	 * If src does not fit, the buffer is left intact and the error is reported by query().
+	 * @param pointSize Size of a point in bytes, used to compute exported point count.
+	 * @param runIndex Identifier of the graph run producing src.
+	 */
+	void enqueueExport(IAnyArray::ConstPtr src, std::size_t pointSize, cudaStream_t stream, uint64_t runIndex);
+
+	/**
+	 * Marks export of the given run as failed. The exception will be rethrown by query().
+	 */
+	void setExportFailed(std::exception_ptr exception, uint64_t runIndex);
+
+	/**
+	 * Does not block.
+	 * @return Number of exported points, if export of the given run has been completed.
+	 */
+	std::optional<std::size_t> query(uint64_t runIndex);
+
+	~ResultBuffer();
+
+private:
+	ResultBuffer(void* data, std::size_t size);
+
+	void* data;
+	std::size_t size;
+	bool isRegistered{false};
+	CudaEvent::Ptr exportCompleted = CudaEvent::create();
+
+	// Written by graph thread before release-storing exportedRun, read by client's thread after acquire-loading it.
+	std::size_t exportedBytes{0};
+	std::size_t exportedPointCount{0};
+	std::exception_ptr exportException{nullptr};
+	std::atomic<uint64_t> exportedRun{0}; // Run indices start from 1
+};
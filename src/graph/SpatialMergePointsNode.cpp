@@ -22,6 +22,7 @@ void SpatialMergePointsNode::setParameters(const std::vector<rgl_field_t>& field
 	}
 
 	mergedData.clear();
+	cacheManager.clear();
 	width = 0;
 
 	for (auto&& field : fields) {
@@ -60,19 +61,33 @@ void SpatialMergePointsNode::validateImpl()
 
 void SpatialMergePointsNode::enqueueExecImpl()
 {
+	cacheManager.trigger();
 	width = 0;
 	for (const auto& input : pointInputs) {
 		width += input->getWidth();
 	}
+}
+
+IAnyArray::ConstPtr SpatialMergePointsNode::getFieldData(rgl_field_t field)
+{
+	std::lock_guard lock{getFieldDataMutex};
 
-	// This could work lazily - merging only on demand
-	for (const auto& [field, data] : mergedData) {
-		data->resize(0, false, false);
+	// Downstream nodes often consume only some of the merged fields, therefore merging is deferred until requested.
+	if (!cacheManager.contains(field)) {
+		cacheManager.insert(field, mergedData.at(field), true);
+	}
+
+	if (!cacheManager.isLatest(field)) {
+		std::vector<IAnyArray::ConstPtr> segments;
+		segments.reserve(pointInputs.size());
 		for (const auto& input : pointInputs) {
-			const auto toMergeData = input->getFieldData(field);
-			data->appendFrom(toMergeData);
+			segments.emplace_back(input->getFieldData(field));
 		}
+		cacheManager.getValue(field)->copyFromSegments(segments);
+		cacheManager.setUpdated(field);
 	}
+
+	return std::const_pointer_cast<const IAnyArray>(cacheManager.getValue(field));
 }
 
 bool SpatialMergePointsNode::isDense() const
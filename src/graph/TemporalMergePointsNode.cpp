@@ -12,7 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <bit>
+
 #include <graph/NodesCore.hpp>
+#include <scene/Scene.hpp>
 #include <RGLFields.hpp>
 
 void TemporalMergePointsNode::setParameters(const std::vector<rgl_field_t>& fields)
@@ -21,16 +24,30 @@ void TemporalMergePointsNode::setParameters(const std::vector<rgl_field_t>& fiel
 		throw InvalidAPIArgument("cannot perform temporal merge on field 'RGL_FIELD_DYNAMIC_FORMAT'");
 	}
 
-	mergedData.clear();
-	width = 0;
+	ringData.clear();
+	ringCapacity = 0;
+	clearFrames();
 
 	for (auto&& field : fields) {
-		if (!mergedData.contains(field) && !isDummy(field)) {
-			mergedData.insert({field, createArray<HostPageableArray>(field)});
+		if (!ringData.contains(field) && !isDummy(field)) {
+			ringData.insert({field, createArray<HostPageableArray>(field)});
 		}
 	}
 }
 
+void TemporalMergePointsNode::setWindow(int32_t maxFrameCount, float maxDurationSeconds)
+{
+	if (maxFrameCount < 0) {
+		throw InvalidAPIArgument("temporal merge window frame count must be non-negative");
+	}
+	if (maxDurationSeconds < 0.0f) {
+		throw InvalidAPIArgument("temporal merge window duration must be non-negative");
+	}
+	this->maxFrameCount = maxFrameCount;
+	this->maxDurationSeconds = maxDurationSeconds;
+	clearFrames();
+}
+
 void TemporalMergePointsNode::validateImpl()
 {
 	IPointsNodeSingleInput::validateImpl();
@@ -44,11 +61,132 @@ void TemporalMergePointsNode::validateImpl()
 
 void TemporalMergePointsNode::enqueueExecImpl()
 {
-	// This could work lazily - merging only on demand
-	for (const auto& [field, data] : mergedData) {
-		size_t pointCount = input->getPointCount();
-		const auto toMergeData = input->getFieldData(field);
-		data->appendFrom(toMergeData);
+	// Unlike SpatialMergePointsNode, merging cannot be deferred here:
+	// input buffers are overwritten in the next run, so every frame has to be captured now.
+	std::optional<Time> now = Scene::instance().getTime();
+	if (maxDurationSeconds > 0.0f && !now.has_value()) {
+		auto msg = fmt::format("{} has time window configured, but cannot get time from scene", getName());
+		throw InvalidPipeline(msg);
+	}
+
+	evictFrames(now);
+
+	std::size_t frameCount = input->getWidth();
+	setRingCount(ringCapacity);
+	if (width + frameCount > ringCapacity) {
+		growRing(width + frameCount);
+	}
+
+	if (frameCount > 0) {
+		std::size_t frameBegin = (ringBegin + width) % ringCapacity;
+		std::size_t tailCount = std::min(frameCount, ringCapacity - frameBegin);
+		for (const auto& [field, data] : ringData) {
+			const auto toMergeData = input->getFieldData(field);
+			data->copyRangeFrom(toMergeData, 0, frameBegin, tailCount);
+			if (frameCount > tailCount) {
+				data->copyRangeFrom(toMergeData, tailCount, 0, frameCount - tailCount);
+			}
+		}
+		frames.push_back({frameBegin, frameCount, now});
+		width += frameCount;
+	}
+
+	// Window starting at the ring's beginning cannot wrap, so it can be exposed without copying.
+	if (ringBegin == 0) {
+		setRingCount(width);
+	}
+	linearizedCache.trigger();
+}
+
+IAnyArray::ConstPtr TemporalMergePointsNode::getFieldData(rgl_field_t field)
+{
+	std::lock_guard lock{getFieldDataMutex};
+
+	const auto& ring = ringData.at(field);
+	if (ringBegin == 0) {
+		return std::const_pointer_cast<const IAnyArray>(ring);
+	}
+
+	if (!linearizedCache.contains(field)) {
+		auto fieldData = createArray<HostPageableArray>(field);
+		linearizedCache.insert(field, fieldData, true);
+	}
+
+	if (!linearizedCache.isLatest(field)) {
+		auto& fieldData = linearizedCache.getValue(field);
+		fieldData->resize(width, false, false);
+		std::size_t tailCount = std::min(width, ringCapacity - ringBegin);
+		fieldData->copyRangeFrom(ring, ringBegin, 0, tailCount);
+		if (width > tailCount) {
+			fieldData->copyRangeFrom(ring, 0, tailCount, width - tailCount);
+		}
+		linearizedCache.setUpdated(field);
+	}
+
+	return std::const_pointer_cast<const IAnyArray>(linearizedCache.getValue(field));
+}
+
+void TemporalMergePointsNode::clearFrames()
+{
+	frames.clear();
+	ringBegin = 0;
+	width = 0;
+	setRingCount(0);
+	linearizedCache.clear();
+}
+
+void TemporalMergePointsNode::evictFrames(std::optional<Time> now)
+{
+	auto isExpired = [&](const FrameSegment& frame) {
+		if (maxFrameCount > 0 && frames.size() >= static_cast<std::size_t>(maxFrameCount)) {
+			return true; // Make room for the incoming frame
+		}
+		if (maxDurationSeconds > 0.0f && frame.time.has_value()) {
+			// Time going backwards (e.g. simulation reset) invalidates the whole window
+			return now->asNanoseconds() < frame.time->asNanoseconds() ||
+			       (*now - *frame.time).asSeconds() > maxDurationSeconds;
+		}
+		return false;
+	};
+
+	while (!frames.empty() && isExpired(frames.front())) {
+		ringBegin = (ringBegin + frames.front().count) % ringCapacity;
+		width -= frames.front().count;
+		frames.pop_front();
+	}
+
+	if (frames.empty()) {
+		ringBegin = 0;
+	}
+}
+
+void TemporalMergePointsNode::growRing(std::size_t minCapacity)
+{
+	std::size_t newCapacity = std::bit_ceil(minCapacity);
+	std::size_t tailCount = std::min(width, ringCapacity - ringBegin);
+	for (auto& [field, data] : ringData) {
+		auto grownData = createArray<HostPageableArray>(field);
+		grownData->resize(newCapacity, false, false);
+		grownData->copyRangeFrom(data, ringBegin, 0, tailCount);
+		if (width > tailCount) {
+			grownData->copyRangeFrom(data, 0, tailCount, width - tailCount);
+		}
+		data = grownData;
+	}
+
+	std::size_t frameBegin = 0;
+	for (auto& frame : frames) {
+		frame.begin = frameBegin;
+		frameBegin += frame.count;
+	}
+	ringBegin = 0;
+	ringCapacity = newCapacity;
+}
+
+void TemporalMergePointsNode::setRingCount(std::size_t count)
+{
+	// Capacity of the ring is already ensured, so this neither reallocates nor copies
+	for (auto& [field, data] : ringData) {
+		data->resize(count, false, true);
 	}
-	width += input->getWidth();
 }
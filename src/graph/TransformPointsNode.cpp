@@ -14,12 +14,23 @@
 
 #include <graph/NodesCore.hpp>
 #include <gpu/nodeKernels.hpp>
+#include <HostKernels.hpp>
 
 void TransformPointsNode::enqueueExecImpl()
 {
 	auto pointCount = input->getWidth() * input->getHeight();
+	const auto inputArray = input->getFieldDataTyped<XYZ_VEC3_F32>();
+
+	isHostExecution = prepareHostExecution({inputArray});
+	if (isHostExecution) {
+		outputHost->resize(pointCount, false, false);
+		const auto* inputPtr = inputArray->asSubclass<HostArray>()->getReadPtr();
+		hostTransformPoints(pointCount, inputPtr, outputHost->getWritePtr(), transform);
+		return;
+	}
+
 	output->resize(pointCount, false, false);
-	const auto inputField = input->getFieldDataTyped<XYZ_VEC3_F32>()->asSubclass<DeviceAsyncArray>();
+	const auto inputField = inputArray->asSubclass<DeviceAsyncArray>();
 	const auto* inputPtr = inputField->getReadPtr();
 	auto* outputPtr = output->getWritePtr();
 	gpuTransformPoints(getStreamHandle(), pointCount, inputPtr, outputPtr, transform);
@@ -28,6 +39,9 @@ void TransformPointsNode::enqueueExecImpl()
 IAnyArray::ConstPtr TransformPointsNode::getFieldData(rgl_field_t field)
 {
 	if (field == XYZ_VEC3_F32) {
+		if (isHostExecution) {
+			return outputHost;
+		}
 		return output;
 	}
 	return input->getFieldData(field);
@@ -14,9 +14,18 @@
 
 #include <graph/NodesCore.hpp>
 #include <gpu/nodeKernels.hpp>
+#include <HostKernels.hpp>
 
 void TransformRaysNode::enqueueExecImpl()
 {
+	isHostExecution = prepareHostExecution({input->getRays()});
+	if (isHostExecution) {
+		transformedRaysHost->resize(getRayCount(), false, false);
+		const Mat3x4f* inRaysPtr = input->getRays()->asSubclass<HostArray>()->getReadPtr();
+		hostTransformRays(getRayCount(), inRaysPtr, transformedRaysHost->getWritePtr(), transform);
+		return;
+	}
+
 	transformedRays->resize(getRayCount(), false, false);
 
 	// Kernel Call
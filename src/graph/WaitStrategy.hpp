@@ -0,0 +1,76 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+/**
+ * Describes how a thread waits for an atomic value to change:
+ * it first busy-polls (spinCount times), then polls yielding its time slice (yieldCount times),
+ * and finally sleeps in std::atomic::wait (futex-backed on Linux) until notified.
+ * Spinning gives the lowest wake-up latency, sleeping leaves CPU cores to the rest of the process.
+ * The default (no spinning, no yielding) is the CPU-friendly mode.
+ */
+struct WaitStrategy
+{
+	uint32_t spinCount{0};
+	uint32_t yieldCount{0};
+
+	bool operator==(const WaitStrategy&) const = default;
+
+	/**
+	 * Blocks until value differs from old.
+	 */
+	template<typename T>
+	void waitWhileEqual(const std::atomic<T>& value, T old, std::memory_order order = std::memory_order::seq_cst) const
+	{
+		for (uint32_t i = 0; i < spinCount; ++i) {
+			if (value.load(order) != old) {
+				return;
+			}
+			cpuRelax();
+		}
+		for (uint32_t i = 0; i < yieldCount; ++i) {
+			if (value.load(order) != old) {
+				return;
+			}
+			std::this_thread::yield();
+		}
+		value.wait(old, order);
+	}
+
+	/**
+	 * Combines strategies of graphs being joined, the more latency-oriented thresholds win.
+	 */
+	static WaitStrategy strongest(const WaitStrategy& lhs, const WaitStrategy& rhs)
+	{
+		return {std::max(lhs.spinCount, rhs.spinCount), std::max(lhs.yieldCount, rhs.yieldCount)};
+	}
+
+private:
+	static void cpuRelax()
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		_mm_pause(); // Hint for the CPU that this is a spin loop (saves power, frees resources for the sibling hyper-thread)
+#endif
+	}
+};
@@ -26,10 +26,26 @@ void YieldPointsNode::enqueueExecImpl()
 {
 	for (auto&& field : fields) {
 		results[field] = input->getFieldData(field);
+		if (isDummy(field)) {
+			continue;
+		}
+		// Prefetch to host in the graph stream, so that the client can read results without a device-to-host copy.
+		if (!hostMirrors.contains(field)) {
+			hostMirrors[field] = createArray<HostPinnedArray>(field);
+		}
+		auto&& mirror = hostMirrors.at(field);
+		auto&& result = results.at(field);
+		mirror->resize(result->getCount(), false, false);
+		CHECK_CUDA(cudaMemcpyAsync(mirror->getRawWritePtr(), result->getRawReadPtr(), result->getCount() * result->getSizeOf(),
+		                           cudaMemcpyDefault, getStreamHandle()));
 	}
-	if (results.contains(XYZ_VEC3_F32)) {
-		xyzHostCache->resize(results.at(XYZ_VEC3_F32)->getCount(), false, false);
-		CHECK_CUDA(cudaMemcpyAsync(xyzHostCache->getWritePtr(), results[XYZ_VEC3_F32]->getRawReadPtr(),
-		                           xyzHostCache->getCount() * xyzHostCache->getSizeOf(), cudaMemcpyDefault, getStreamHandle()));
+}
+
+IAnyArray::ConstPtr YieldPointsNode::getHostFieldData(rgl_field_t field)
+{
+	if (!hostMirrors.contains(field)) {
+		auto msg = fmt::format("{} does not have host copy of field {}", getName(), toString(field));
+		throw InvalidPipeline(msg);
 	}
+	return hostMirrors.at(field);
 }
@@ -0,0 +1,110 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <random>
+
+#include <macros/cuda.hpp>
+
+/**
+ * Counter-based random number generator Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+ * Random bits are a pure function of a key and a counter, so there is no state to initialize, store or advance.
+ * Noise nodes use their seed as the key and the run counter and point (or ray) index as the counter:
+ * a run with a given seed is reproducible on host and device, and no per-point state is kept between runs.
+ * Bits match Random123 and cuRAND Philox4_32_10 for the same key and counter.
+ * The same code is compiled for host and device; see hostGenerateNormals for a SIMD host version.
+ */
+struct Philox4x32
+{
+	static constexpr int ROUNDS = 10;
+	static constexpr uint32_t MULTIPLIER_0 = 0xD2511F53;
+	static constexpr uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+	static constexpr uint32_t WEYL_0 = 0x9E3779B9;
+	static constexpr uint32_t WEYL_1 = 0xBB67AE85;
+
+	struct Bits
+	{
+		uint32_t x[4];
+	};
+
+	HostDevFn static inline Bits generate(Bits counter, uint32_t key0, uint32_t key1)
+	{
+		for (int round = 0; round < ROUNDS; ++round) {
+			if (round > 0) {
+				key0 += WEYL_0;
+				key1 += WEYL_1;
+			}
+			uint32_t hi0, hi1;
+			const uint32_t lo0 = mulHiLo(MULTIPLIER_0, counter.x[0], hi0);
+			const uint32_t lo1 = mulHiLo(MULTIPLIER_1, counter.x[2], hi1);
+			counter = {hi1 ^ counter.x[1] ^ key0, lo1, hi0 ^ counter.x[3] ^ key1, lo0};
+		}
+		return counter;
+	}
+
+	/**
+	 * Random bits of the element (e.g. point or ray) with the given index in the given frame.
+	 * Seed is the key, so that different seeds give independent streams.
+	 */
+	HostDevFn static inline Bits generate(uint64_t seed, uint32_t frame, uint32_t index)
+	{
+		return generate(Bits{index, frame, 0, 0}, static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32));
+	}
+
+	/** Returns a nondeterministic seed with all 64 bits filled (random_device yields 32 bits per call). */
+	static uint64_t makeSeed()
+	{
+		std::random_device randomDevice;
+		return static_cast<uint64_t>(randomDevice()) << 32 | randomDevice();
+	}
+
+	/** Maps bits to (0, 1], the same way as curand_uniform. */
+	HostDevFn static inline float toUniform(uint32_t bits)
+	{
+		constexpr float TWO_POW_MINUS_32 = 2.3283064e-10f;
+		return static_cast<float>(bits) * TWO_POW_MINUS_32 + TWO_POW_MINUS_32 / 2.0f;
+	}
+
+	/** Maps two words of bits to a sample of the standard normal distribution (Box-Muller transform). */
+	HostDevFn static inline float toNormal(uint32_t bits0, uint32_t bits1)
+	{
+		constexpr float TWO_PI = 6.2831853f;
+		const float radius = sqrtf(-2.0f * logf(toUniform(bits0)));
+		return radius * cosf(TWO_PI * toUniform(bits1));
+	}
+
+	/** Sample of the standard normal distribution for the element with the given index in the given frame. */
+	HostDevFn static inline float normal(uint64_t seed, uint32_t frame, uint32_t index)
+	{
+		const Bits bits = generate(seed, frame, index);
+		return toNormal(bits.x[0], bits.x[1]);
+	}
+
+private:
+	HostDevFn static inline uint32_t mulHiLo(uint32_t a, uint32_t b, uint32_t& hi)
+	{
+#ifdef __CUDA_ARCH__
+		hi = __umulhi(a, b);
+		return a * b;
+#else
+		const uint64_t product = static_cast<uint64_t>(a) * b;
+		hi = static_cast<uint32_t>(product >> 32);
+		return static_cast<uint32_t>(product);
+#endif
+	}
+};
@@ -0,0 +1,33 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Counts bytes allocated by Arrays in the calling thread.
+ * Since a node is enqueued entirely by a single thread, the difference of the counter taken around
+ * its enqueueExec() gives the memory allocated by that node (see NodeProfiler).
+ * It is a plain thread-local integer, so it is cheap enough to be always enabled.
+ */
+struct AllocationCounter
+{
+	static void add(std::size_t bytes) { threadAllocatedBytes += bytes; }
+	static uint64_t getThreadAllocatedBytes() { return threadAllocatedBytes; }
+
+private:
+	static inline thread_local uint64_t threadAllocatedBytes{0};
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory/Array.hpp>
+#include <memory/AllocationCounter.hpp>
 #include <macros/handleDestructorException.hpp>
 
 template<typename T>
@@ -53,6 +54,7 @@ void Array<T>::reserve(std::size_t newCapacity, bool preserveData) {
 	}
 
 	T* newMem = reinterpret_cast<T*>(memOps.allocate(sizeof(T) * newCapacity));
+	AllocationCounter::add(sizeof(T) * newCapacity);
 
 	if (preserveData && data != nullptr) {
 		memOps.copy(newMem, data, sizeof(T) * count);
@@ -14,8 +14,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <typeindex>
+#include <vector>
 
 #include <memory/MemoryKind.hpp>
 #include <memory/InvalidArrayCast.hpp>
@@ -156,6 +158,62 @@ struct IAnyArray : public std::enable_shared_from_this<IAnyArray>
 		this->insertAt(src, this->getCount() - src->getCount());
 	}
 
+	/**
+	 * Replaces current data with concatenation of data from srcs.
+	 * The array is resized once, then each source is copied directly to its offset.
+	 * All copies are enqueued before waiting for any of them.
+	 */
+	void copyFromSegments(const std::vector<IAnyArray::ConstPtr>& srcs)
+	{
+		std::size_t totalCount = 0;
+		for (auto&& src : srcs) {
+			if (shared_from_this() == src) {
+				throw std::runtime_error("attempted to copy Array segment from itself");
+			}
+			if (this->typeIndex != src->typeIndex) {
+				throw std::runtime_error("attempted to copy segment from Array with different data type");
+			}
+			totalCount += src->getCount();
+		}
+		this->resize(totalCount, false, false);
+
+		std::vector<CudaStream::Ptr> copyStreams;
+		std::size_t skipCount = 0;
+		for (auto&& src : srcs) {
+			auto copyStream = enqueueCopy(src, 0, skipCount, src->getCount());
+			if (copyStream != nullptr && std::find(copyStreams.begin(), copyStreams.end(), copyStream) == copyStreams.end()) {
+				copyStreams.push_back(copyStream);
+			}
+			skipCount += src->getCount();
+		}
+		for (auto&& copyStream : copyStreams) {
+			CHECK_CUDA(cudaStreamSynchronize(copyStream->getHandle()));
+		}
+	}
+
+	/**
+	 * Overwrites elements [dstIndex, dstIndex + count) with elements [srcIndex, srcIndex + count) of src.
+	 * Does not change the number of elements, both ranges must be within the arrays' counts.
+	 */
+	void copyRangeFrom(IAnyArray::ConstPtr src, std::size_t srcIndex, std::size_t dstIndex, std::size_t count)
+	{
+		if (shared_from_this() == src) {
+			throw std::runtime_error("attempted to copy Array range from itself");
+		}
+		if (this->typeIndex != src->typeIndex) {
+			throw std::runtime_error("attempted to copy range from Array with different data type");
+		}
+		if (srcIndex + count > src->getCount() || dstIndex + count > this->getCount()) {
+			auto msg = fmt::format("copied range is out of bounds: src=[{}, {}) of {}, dst=[{}, {}) of {}", srcIndex,
+			                       srcIndex + count, src->getCount(), dstIndex, dstIndex + count, this->getCount());
+			throw std::out_of_range(msg);
+		}
+		auto copyStream = enqueueCopy(src, srcIndex, dstIndex, count);
+		if (copyStream != nullptr) {
+			CHECK_CUDA(cudaStreamSynchronize(copyStream->getHandle()));
+		}
+	}
+
 	virtual ~IAnyArray() = default;
 
 protected:
@@ -164,15 +222,27 @@ protected:
 private:
 	void insertAt(IAnyArray::ConstPtr src, std::size_t skipCount)
 	{
-		size_t offset = skipCount * src->getSizeOf();
-		size_t byteCount = src->getCount() * src->getSizeOf();
-		void* writePtr = reinterpret_cast<char*>(this->getRawWritePtr()) + offset;
+		auto copyStream = enqueueCopy(src, 0, skipCount, src->getCount());
+		if (copyStream != nullptr) {
+			CHECK_CUDA(cudaStreamSynchronize(copyStream->getHandle()));
+		}
+	}
+
+	/**
+	 * Copies count elements of src, starting at srcIndex, to this array, starting at dstIndex.
+	 * @return Stream on which the copy was enqueued or nullptr if it has been already completed.
+	 */
+	CudaStream::Ptr enqueueCopy(IAnyArray::ConstPtr src, std::size_t srcIndex, std::size_t dstIndex, std::size_t count)
+	{
+		size_t byteCount = count * src->getSizeOf();
+		void* writePtr = reinterpret_cast<char*>(this->getRawWritePtr()) + dstIndex * src->getSizeOf();
+		const void* readPtr = reinterpret_cast<const char*>(src->getRawReadPtr()) + srcIndex * src->getSizeOf();
 
 		// Both operands are on host - either pageable or pinned.
 		// Standard memcpy is faster + avoids the overhead of cudaMemcpy*
 		if (isHost(this->getMemoryKind()) && isHost(src->getMemoryKind())) {
-			memcpy(writePtr, src->getRawReadPtr(), byteCount);
-			return;
+			memcpy(writePtr, readPtr, byteCount);
+			return nullptr;
 		}
 
 		// Ensure src is ready (one day, it can be optimized to some waiting on some cudaEvent, not entire stream)
@@ -187,8 +257,8 @@ private:
 		CudaStream::Ptr copyStream = dstStreamBound != nullptr ? dstStreamBound->getStream() :
 		                             srcStreamBound != nullptr ? srcStreamBound->getStream() :
 		                                                         CudaStream::getNullStream();
-		CHECK_CUDA(cudaMemcpyAsync(writePtr, src->getRawReadPtr(), byteCount, cudaMemcpyDefault, copyStream->getHandle()));
-		CHECK_CUDA(cudaStreamSynchronize(copyStream->getHandle()));
+		CHECK_CUDA(cudaMemcpyAsync(writePtr, readPtr, byteCount, cudaMemcpyDefault, copyStream->getHandle()));
+		return copyStream;
 	}
 
 	std::type_index typeIndex;
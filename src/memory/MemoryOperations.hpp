@@ -18,11 +18,13 @@
 
 #include <macros/cuda.hpp>
 #include <memory/MemoryKind.hpp>
+#include <memory/MemoryPools.hpp>
 #include <CudaStream.hpp>
 
 /**
  * MemoryOperations encapsulate 4 basic memory operations needed to implement dynamic-size array.
  * It also provides factory method to create MemoryOperations corresponding to those defined in MemoryKind enum.
+ * Allocations are served by per-MemoryKind arenas, see MemoryPools.
  * Warning: deallocate, copy and clear can work ONLY on the memory kind returned by allocate.
  */
 struct MemoryOperations
@@ -38,22 +40,18 @@ struct MemoryOperations
 	{
 		// clang-format off
 		if constexpr (memoryKind == MemoryKind::HostPageable) {
+			MemoryPool* pool = &MemoryPools::getHostPool(memoryKind);
 			return {
-				.allocate = malloc,
-				.deallocate = free,
+				.allocate = [=](size_t bytes) { return pool->allocate(bytes); },
+				.deallocate = [=](void* ptr) { pool->deallocate(ptr); },
 				.copy = memcpy,
 				.clear = memset };
 		}
 		else if constexpr (memoryKind == MemoryKind::HostPinned) {
+			MemoryPool* pool = &MemoryPools::getHostPool(memoryKind);
 			return {
-				.allocate = [](size_t bytes) {
-					void* ptr = nullptr;
-					CHECK_CUDA(cudaMallocHost(&ptr, bytes));
-					return ptr;
-				},
-				.deallocate = [](void* ptr) {
-					CHECK_CUDA(cudaFreeHost(ptr));
-				},
+				.allocate = [=](size_t bytes) { return pool->allocate(bytes); },
+				.deallocate = [=](void* ptr) { pool->deallocate(ptr); },
 				// Regular memcpy and memset avoid the overhead of cuda[Memcpy|Memset] and achieve higher performance.
 				.copy = memcpy,
 				.clear = memset };
@@ -78,11 +76,12 @@ struct MemoryOperations
 		}
 		else if constexpr (memoryKind == MemoryKind::DeviceAsync) {
 			auto stream = maybeStream.value();
+			cudaMemPool_t pool = MemoryPools::getDeviceAsyncPool();
 			return {
 				// Note: capture-by-value to ensure CudaStream lifetime.
 				.allocate = [=](size_t bytes) {
 					void* ptr = nullptr;
-					CHECK_CUDA(cudaMallocAsync(&ptr, bytes, stream->getHandle()));
+					CHECK_CUDA(cudaMallocFromPoolAsync(&ptr, bytes, pool, stream->getHandle()));
 					return ptr;
 				},
 				.deallocate = [=](void* ptr) {
@@ -0,0 +1,136 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <bit>
+#include <new>
+#include <algorithm>
+#include <stdexcept>
+
+#include <memory/MemoryPool.hpp>
+
+MemoryPool::MemoryPool(Allocate backingAllocate, Deallocate backingDeallocate, size_t maxCachedBytes,
+                       size_t maxPooledBlockBytes, Synchronize synchronize)
+  : backingAllocate(std::move(backingAllocate)),
+    backingDeallocate(std::move(backingDeallocate)),
+    synchronize(std::move(synchronize)),
+    maxCachedBytes(maxCachedBytes),
+    maxPooledBlockBytes(maxPooledBlockBytes)
+{}
+
+MemoryPool::~MemoryPool()
+{
+	// Live blocks are owned by their users, only the cache is released.
+	std::lock_guard lock(mutex);
+	trimLocked(0);
+}
+
+size_t MemoryPool::getSizeClass(size_t bytes)
+{
+	if (bytes <= MIN_BLOCK_BYTES) {
+		return MIN_BLOCK_BYTES;
+	}
+	// Split [2^(n-1), 2^n] into 4 classes
+	size_t step = std::bit_ceil(bytes) / 8;
+	return (bytes + step - 1) / step * step;
+}
+
+void* MemoryPool::allocate(size_t bytes)
+{
+	size_t sizeClass = getSizeClass(bytes);
+	std::lock_guard lock(mutex);
+	void* ptr = nullptr;
+	if (auto it = cachedBlocks.find(sizeClass); it != cachedBlocks.end() && !it->second.empty()) {
+		if (synchronize && it->second.back().releaseEpoch > syncedEpoch) {
+			// One synchronization makes all blocks released so far safe to reuse
+			synchronize();
+			syncedEpoch = releaseCount;
+			stats.syncCount += 1;
+		}
+		ptr = it->second.back().ptr;
+		it->second.pop_back();
+		stats.bytesCached -= sizeClass;
+		stats.hitCount += 1;
+	} else {
+		ptr = backingAllocate(sizeClass);
+		if (ptr == nullptr) {
+			throw std::bad_alloc();
+		}
+		stats.missCount += 1;
+	}
+	liveBlocks.emplace(ptr, sizeClass);
+	stats.bytesLive += sizeClass;
+	stats.bytesPeak = std::max(stats.bytesPeak, stats.bytesLive);
+	return ptr;
+}
+
+void MemoryPool::deallocate(void* ptr)
+{
+	if (ptr == nullptr) {
+		return;
+	}
+	std::lock_guard lock(mutex);
+	auto it = liveBlocks.find(ptr);
+	if (it == liveBlocks.end()) {
+		throw std::invalid_argument("attempted to deallocate memory not allocated by the pool");
+	}
+	size_t sizeClass = it->second;
+	liveBlocks.erase(it);
+	stats.bytesLive -= sizeClass;
+
+	if (sizeClass > maxPooledBlockBytes || sizeClass > maxCachedBytes) {
+		backingDeallocate(ptr);
+		stats.trimCount += 1;
+		return;
+	}
+	releaseCount += 1;
+	cachedBlocks[sizeClass].push_back({ptr, releaseCount});
+	stats.bytesCached += sizeClass;
+	trimLocked(maxCachedBytes);
+}
+
+void MemoryPool::setMaxCachedBytes(size_t bytes)
+{
+	std::lock_guard lock(mutex);
+	maxCachedBytes = bytes;
+	trimLocked(maxCachedBytes);
+}
+
+void MemoryPool::trim(size_t maxBytes)
+{
+	std::lock_guard lock(mutex);
+	trimLocked(maxBytes);
+}
+
+void MemoryPool::trimLocked(size_t maxBytes)
+{
+	// Largest blocks first, they are the most expensive to keep and the least likely to be reused
+	auto it = cachedBlocks.rbegin();
+	while (stats.bytesCached > maxBytes && it != cachedBlocks.rend()) {
+		auto& [sizeClass, blocks] = *it;
+		while (stats.bytesCached > maxBytes && !blocks.empty()) {
+			backingDeallocate(blocks.back().ptr);
+			blocks.pop_back();
+			stats.bytesCached -= sizeClass;
+			stats.trimCount += 1;
+		}
+		++it;
+	}
+}
+
+MemoryPoolStats MemoryPool::getStats() const
+{
+	std::lock_guard lock(mutex);
+	return stats;
+}
@@ -0,0 +1,102 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <map>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+
+/**
+ * Counters describing usage of a memory pool. All sizes are in bytes, rounded up to size classes.
+ */
+struct MemoryPoolStats
+{
+	size_t bytesLive{0};   // Allocated and not yet deallocated by the users of the pool
+	size_t bytesPeak{0};   // Maximum of bytesLive
+	size_t bytesCached{0}; // Deallocated, but kept for reuse
+	size_t hitCount{0};    // Allocations served from the cache
+	size_t missCount{0};   // Allocations served by the backing allocator
+	size_t trimCount{0};   // Cached blocks returned to the backing allocator
+	size_t syncCount{0};   // Calls to synchronize made before reusing a block
+};
+
+/**
+ * Caching allocator placed between Arrays and the backing allocator (e.g. cudaMallocHost).
+ * Requested sizes are rounded up to size classes (4 classes per power of two, wasting at most 25%),
+ * so that blocks freed by one array can be reused by another array of a slightly different size.
+ * Freed blocks are cached per size class as long as the total cached size is below maxCachedBytes (high-water mark);
+ * above it, cached blocks are returned to the backing allocator, starting from the largest ones.
+ * Blocks larger than maxPooledBlockBytes are never cached.
+ * If the backing memory may still be accessed asynchronously after deallocate (e.g. by cudaMemcpyAsync from pinned memory),
+ * synchronize must be given: it is called before a block freed after its previous call is handed out again.
+ * This class is thread-safe and does not depend on CUDA.
+ */
+struct MemoryPool
+{
+	using Allocate = std::function<void*(size_t)>;
+	using Deallocate = std::function<void(void*)>;
+	using Synchronize = std::function<void()>;
+
+	static constexpr size_t MIN_BLOCK_BYTES = 256;
+	static constexpr size_t DEFAULT_MAX_POOLED_BLOCK_BYTES = 1ULL << 30;
+
+	MemoryPool(Allocate backingAllocate, Deallocate backingDeallocate, size_t maxCachedBytes,
+	           size_t maxPooledBlockBytes = DEFAULT_MAX_POOLED_BLOCK_BYTES, Synchronize synchronize = nullptr);
+	~MemoryPool();
+
+	MemoryPool(const MemoryPool&) = delete;
+	MemoryPool(MemoryPool&&) = delete;
+	MemoryPool& operator=(const MemoryPool&) = delete;
+	MemoryPool& operator=(MemoryPool&&) = delete;
+
+	void* allocate(size_t bytes);
+	void deallocate(void* ptr);
+
+	/** Changes the high-water mark, trimming the cache if needed. */
+	void setMaxCachedBytes(size_t bytes);
+
+	/** Returns cached blocks to the backing allocator until at most maxCachedBytes remain cached. */
+	void trim(size_t maxCachedBytes = 0);
+
+	MemoryPoolStats getStats() const;
+
+	static size_t getSizeClass(size_t bytes);
+
+private:
+	struct CachedBlock
+	{
+		void* ptr;
+		uint64_t releaseEpoch; // Value of releaseCount when the block was deallocated
+	};
+
+	void trimLocked(size_t maxBytes);
+
+	Allocate backingAllocate;
+	Deallocate backingDeallocate;
+	Synchronize synchronize;
+	size_t maxCachedBytes;
+	size_t maxPooledBlockBytes;
+
+	mutable std::mutex mutex;
+	uint64_t releaseCount{0}; // Number of blocks deallocated into the cache
+	uint64_t syncedEpoch{0};  // Blocks with releaseEpoch up to this value are no longer accessed asynchronously
+	std::map<size_t, std::vector<CachedBlock>> cachedBlocks; // Size class -> blocks
+	std::unordered_map<void*, size_t> liveBlocks;      // Block -> size class
+	MemoryPoolStats stats;
+};
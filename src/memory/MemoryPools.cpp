@@ -0,0 +1,90 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <mutex>
+#include <stdexcept>
+
+#include <macros/cuda.hpp>
+#include <memory/MemoryPools.hpp>
+
+MemoryPool& MemoryPools::getHostPool(MemoryKind kind)
+{
+	static MemoryPool* hostPageablePool = new MemoryPool(malloc, free, DEFAULT_MAX_CACHED_BYTES);
+	static MemoryPool* hostPinnedPool = new MemoryPool(
+	    [](size_t bytes) {
+		    void* ptr = nullptr;
+		    CHECK_CUDA(cudaMallocHost(&ptr, bytes));
+		    return ptr;
+	    },
+	    [](void* ptr) { CHECK_CUDA(cudaFreeHost(ptr)); }, DEFAULT_MAX_CACHED_BYTES, MemoryPool::DEFAULT_MAX_POOLED_BLOCK_BYTES,
+	    // Pinned arrays are not bound to streams, so pending async copies from any stream must complete before reuse.
+	    // cudaFreeHost synchronized the device in the same way on every release.
+	    []() { CHECK_CUDA(cudaDeviceSynchronize()); });
+
+	switch (kind) {
+		case MemoryKind::HostPageable: return *hostPageablePool;
+		case MemoryKind::HostPinned: return *hostPinnedPool;
+		default: throw std::invalid_argument("memory pool requested for non-host memory kind");
+	}
+}
+
+cudaMemPool_t MemoryPools::getDeviceAsyncPool()
+{
+	static cudaMemPool_t pool = []() {
+		int device = 0;
+		cudaMemPool_t defaultPool = nullptr;
+		CHECK_CUDA(cudaGetDevice(&device));
+		CHECK_CUDA(cudaDeviceGetDefaultMemPool(&defaultPool, device));
+		uint64_t releaseThreshold = DEFAULT_MAX_CACHED_BYTES;
+		CHECK_CUDA(cudaMemPoolSetAttribute(defaultPool, cudaMemPoolAttrReleaseThreshold, &releaseThreshold));
+		return defaultPool;
+	}();
+	return pool;
+}
+
+MemoryPoolStats MemoryPools::getStats(MemoryKind kind)
+{
+	if (isHost(kind)) {
+		return getHostPool(kind).getStats();
+	}
+	if (kind != MemoryKind::DeviceAsync) {
+		return {};
+	}
+	uint64_t usedCurrent = 0, usedHigh = 0, reservedCurrent = 0;
+	CHECK_CUDA(cudaMemPoolGetAttribute(getDeviceAsyncPool(), cudaMemPoolAttrUsedMemCurrent, &usedCurrent));
+	CHECK_CUDA(cudaMemPoolGetAttribute(getDeviceAsyncPool(), cudaMemPoolAttrUsedMemHigh, &usedHigh));
+	CHECK_CUDA(cudaMemPoolGetAttribute(getDeviceAsyncPool(), cudaMemPoolAttrReservedMemCurrent, &reservedCurrent));
+	return MemoryPoolStats{
+	    .bytesLive = usedCurrent,
+	    .bytesPeak = usedHigh,
+	    .bytesCached = reservedCurrent - usedCurrent,
+	};
+}
+
+void MemoryPools::setMaxCachedBytes(size_t bytes)
+{
+	getHostPool(MemoryKind::HostPageable).setMaxCachedBytes(bytes);
+	getHostPool(MemoryKind::HostPinned).setMaxCachedBytes(bytes);
+	uint64_t releaseThreshold = bytes;
+	CHECK_CUDA(cudaMemPoolSetAttribute(getDeviceAsyncPool(), cudaMemPoolAttrReleaseThreshold, &releaseThreshold));
+}
+
+void MemoryPools::trim()
+{
+	getHostPool(MemoryKind::HostPageable).trim();
+	getHostPool(MemoryKind::HostPinned).trim();
+	// Memory of cudaFreeAsync calls not yet completed in their streams stays reserved
+	CHECK_CUDA(cudaMemPoolTrimTo(getDeviceAsyncPool(), 0));
+}
@@ -0,0 +1,51 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <cuda_runtime_api.h>
+
+#include <memory/MemoryKind.hpp>
+#include <memory/MemoryPool.hpp>
+
+/**
+ * Provides per-MemoryKind arenas used by MemoryOperations:
+ * - HostPageable and HostPinned memory is served by MemoryPool (caching allocator) instances.
+ *   Freed HostPinned blocks are reused only after the device is synchronized, because async copies may still access them.
+ * - DeviceAsync memory is served by the CUDA stream-ordered allocator (cudaMallocAsync) using the device's default pool.
+ *   Its release threshold is set to the same high-water mark, so the memory freed in one frame
+ *   is reused in the next one instead of being returned to the driver on each synchronization.
+ * - DeviceSync memory is not pooled, because code using it relies on implicit synchronization of cudaFree.
+ * Pools are intentionally never destroyed, because Arrays may be released during static destruction.
+ */
+struct MemoryPools
+{
+	static constexpr size_t DEFAULT_MAX_CACHED_BYTES = RGL_MEMORY_POOL_MAX_CACHED_MB * (1ULL << 20);
+
+	/** Returns the caching allocator for the given host MemoryKind. */
+	static MemoryPool& getHostPool(MemoryKind kind);
+
+	/** Returns the CUDA memory pool used for DeviceAsync allocations, configuring it on the first call. */
+	static cudaMemPool_t getDeviceAsyncPool();
+
+	/** Returns counters of the arena of the given MemoryKind. For DeviceAsync, hit / miss / trim counts are not available. */
+	static MemoryPoolStats getStats(MemoryKind kind);
+
+	/** Sets the high-water mark of all arenas. */
+	static void setMaxCachedBytes(size_t bytes);
+
+	/** Returns cached memory of all arenas to the system. */
+	static void trim();
+};
@@ -15,6 +15,8 @@
 #pragma once
 
 #include <cassert>
+#include <string>
+#include <unordered_map>
 
 #include <macros/cuda.hpp>
 #include <rgl/api/core.h>
@@ -22,7 +22,12 @@ void ASBuildScratchpad::resizeToFit(OptixBuildInput input, OptixAccelBuildOption
 	CHECK_OPTIX(optixAccelComputeMemoryUsage(Optix::getOrCreate().context, &options, &input, 1, &bufferSizes));
 
 	// Short-circuit evaluation workaround
-	dTemp->resize(bufferSizes.tempSizeInBytes, false, false);
+	// Update (refit) has its own temporary memory requirement; output buffer must be kept as is
+	const bool isUpdate = options.operation == OPTIX_BUILD_OPERATION_UPDATE;
+	dTemp->resize(isUpdate ? bufferSizes.tempUpdateSizeInBytes : bufferSizes.tempSizeInBytes, false, false);
+	if (isUpdate) {
+		return;
+	}
 	dFull->resize(bufferSizes.outputSizeInBytes, false, false);
 	dCompactedSize->resize(1, false, false);
 }
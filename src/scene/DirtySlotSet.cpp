@@ -0,0 +1,52 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+
+#include <scene/DirtySlotSet.hpp>
+
+void DirtySlotSet::mark(size_t slot)
+{
+	if (slot >= isSlotDirty.size()) {
+		isSlotDirty.resize(slot + 1, false);
+	}
+	if (!isSlotDirty[slot]) {
+		isSlotDirty[slot] = true;
+		dirtySlots.push_back(slot);
+	}
+}
+
+void DirtySlotSet::clear()
+{
+	for (auto&& slot : dirtySlots) {
+		isSlotDirty[slot] = false;
+	}
+	dirtySlots.clear();
+}
+
+std::vector<DirtySlotSet::SlotRange> DirtySlotSet::getRanges(size_t maxGap) const
+{
+	std::vector<size_t> slots = dirtySlots;
+	std::sort(slots.begin(), slots.end());
+	std::vector<SlotRange> ranges;
+	for (auto&& slot : slots) {
+		if (!ranges.empty() && slot - ranges.back().end <= maxGap) {
+			ranges.back().end = slot + 1;
+		} else {
+			ranges.push_back({slot, slot + 1});
+		}
+	}
+	return ranges;
+}
@@ -0,0 +1,49 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Set of slots (indices of a table mirrored to the device) whose content changed and needs to be uploaded.
+ * Marking a slot and clearing the set take time proportional to the number of dirty slots, not the table size.
+ * This class does not depend on CUDA / OptiX.
+ */
+struct DirtySlotSet
+{
+	struct SlotRange
+	{
+		size_t begin;
+		size_t end; // Exclusive
+	};
+
+	void mark(size_t slot);
+	void clear();
+
+	/**
+	 * Returns sorted ranges of dirty slots. Ranges separated by at most maxGap clean slots are merged,
+	 * which trades copying some clean slots for issuing fewer copies.
+	 */
+	std::vector<SlotRange> getRanges(size_t maxGap = 0) const;
+
+	bool isEmpty() const { return dirtySlots.empty(); }
+	size_t getCount() const { return dirtySlots.size(); }
+
+private:
+	std::vector<bool> isSlotDirty;
+	std::vector<size_t> dirtySlots;
+};
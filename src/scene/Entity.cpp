@@ -36,8 +36,8 @@ void Entity::setTransform(Mat3x4f newTransform)
 {
 	formerTransformInfo = transformInfo;
 	transformInfo = {newTransform, Scene::instance().getTime()};
-	Scene::instance().requestASRebuild();  // Current transform
-	Scene::instance().requestSBTRebuild(); // Previous transform
+	Scene::instance().requestASUpdate(*this);  // Current transform
+	Scene::instance().requestSBTUpdate(*this); // Previous transform
 }
 
 void Entity::setId(int newId)
@@ -48,19 +48,19 @@ void Entity::setId(int newId)
 		throw std::invalid_argument(msg);
 	}
 	id = newId;
-	Scene::instance().requestASRebuild(); // Update instanceId field in AS
+	Scene::instance().requestASUpdate(*this); // Update instanceId field in AS
 }
 
 void Entity::setLaserRetro(float retro)
 {
 	laserRetro = retro;
-	Scene::instance().requestSBTRebuild();
+	Scene::instance().requestSBTUpdate(*this);
 }
 
 void Entity::setIntensityTexture(std::shared_ptr<Texture> texture)
 {
 	intensityTexture = texture;
-	Scene::instance().requestSBTRebuild();
+	Scene::instance().requestSBTUpdate(*this);
 }
 
 std::optional<Mat3x4f> Entity::getPreviousFrameLocalToWorldTransform() const
@@ -109,8 +109,8 @@ void Entity::updateAnimationTime()
 {
 	formerAnimationTime = currentAnimationTime;
 	currentAnimationTime = Scene::instance().getTime();
-	Scene::instance().requestASRebuild();  // Vertices themselves
-	Scene::instance().requestSBTRebuild(); // Vertices displacement
+	Scene::instance().requestASUpdate(*this);  // Vertices themselves (refit is enough for updated GAS)
+	Scene::instance().requestSBTUpdate(*this); // Vertices displacement
 }
 
 const Vec3f* Entity::getVertexDisplacementSincePrevFrame()
@@ -114,7 +114,7 @@ private:
 	Entity(std::shared_ptr<Mesh> mesh);
 
 	/**
-	 * Updates animation time to current scene time and requests AS & SBT to rebuild.
+	 * Updates animation time to current scene time and requests AS & SBT to update.
 	 */
 	void updateAnimationTime();
 
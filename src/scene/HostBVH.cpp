@@ -0,0 +1,203 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+#include <spdlog/fmt/fmt.h>
+
+#include <scene/HostBVH.hpp>
+
+static float surfaceArea(const Aabb3Df& bounds)
+{
+	const Vec3f size = bounds.maxCorner() - bounds.minCorner();
+	return 2.0f * (size.x() * size.y() + size.y() * size.z() + size.z() * size.x());
+}
+
+HostBVH::HostBVH(const std::vector<Aabb3Df>& primitiveBounds, bool allowParallelBuild)
+{
+	if (primitiveBounds.empty()) {
+		return;
+	}
+	std::vector<Vec3f> centroids(primitiveBounds.size());
+	for (size_t i = 0; i < primitiveBounds.size(); ++i) {
+		centroids[i] = (primitiveBounds[i].minCorner() + primitiveBounds[i].maxCorner()) * 0.5f;
+	}
+	std::vector<uint32_t> orderedPrimitives(primitiveBounds.size());
+	std::iota(orderedPrimitives.begin(), orderedPrimitives.end(), 0);
+
+	// Each parallel level doubles the number of threads
+	int maxParallelDepth = 0;
+	if (allowParallelBuild) {
+		while ((1U << maxParallelDepth) < std::thread::hardware_concurrency()) {
+			++maxParallelDepth;
+		}
+	}
+	nodes.reserve(2 * primitiveBounds.size() - 1);
+	buildSubtree({primitiveBounds, centroids, orderedPrimitives, maxParallelDepth}, nodes, 0,
+	             static_cast<uint32_t>(primitiveBounds.size()), 0);
+	primitiveIndices = std::make_shared<const std::vector<uint32_t>>(std::move(orderedPrimitives));
+}
+
+void HostBVH::refit(const std::vector<Aabb3Df>& primitiveBounds)
+{
+	if (primitiveBounds.size() != primitiveIndices->size()) {
+		auto msg = fmt::format("cannot refit BVH built over {} primitives to {} primitives", primitiveIndices->size(),
+		                       primitiveBounds.size());
+		throw std::invalid_argument(msg);
+	}
+	// Children follow their parents in the flattened layout, so children are always refitted first
+	for (size_t nodeIdx = nodes.size(); nodeIdx-- > 0;) {
+		Node& node = nodes[nodeIdx];
+		Aabb3Df bounds;
+		if (node.isLeaf()) {
+			const uint32_t end = node.rightChildOrFirstPrimitive + node.primitiveCount;
+			for (uint32_t i = node.rightChildOrFirstPrimitive; i < end; ++i) {
+				bounds += primitiveBounds[(*primitiveIndices)[i]];
+			}
+		} else {
+			for (const Node* child : {&nodes[nodeIdx + 1], &nodes[node.rightChildOrFirstPrimitive]}) {
+				bounds.expand(child->boundsMin);
+				bounds.expand(child->boundsMax);
+			}
+		}
+		node.boundsMin = bounds.minCorner();
+		node.boundsMax = bounds.maxCorner();
+	}
+}
+
+std::vector<Aabb3Df> HostBVH::getTriangleBounds(const std::vector<Vec3f>& vertices, const std::vector<Vec3i>& indices)
+{
+	std::vector<Aabb3Df> triangleBounds(indices.size());
+	for (size_t i = 0; i < indices.size(); ++i) {
+		const Vec3i& triangle = indices[i];
+		triangleBounds[i] = Aabb3Df{} + vertices[triangle.x()] + vertices[triangle.y()] + vertices[triangle.z()];
+	}
+	return triangleBounds;
+}
+
+void HostBVH::buildSubtree(const BuildInput& input, std::vector<Node>& subtreeNodes, uint32_t begin, uint32_t end, int depth)
+{
+	const auto& primitiveBounds = input.primitiveBounds;
+	const auto& centroids = input.centroids;
+	auto& indices = input.primitiveIndices;
+
+	// Nodes vector grows during recursion, so nodes are referred to by index only
+	const auto nodeIdx = static_cast<uint32_t>(subtreeNodes.size());
+	subtreeNodes.emplace_back();
+
+	Aabb3Df bounds;
+	Aabb3Df centroidBounds;
+	for (uint32_t i = begin; i < end; ++i) {
+		bounds += primitiveBounds[indices[i]];
+		centroidBounds += centroids[indices[i]];
+	}
+	subtreeNodes[nodeIdx].boundsMin = bounds.minCorner();
+	subtreeNodes[nodeIdx].boundsMax = bounds.maxCorner();
+
+	// The last level is reserved, so that traversal stack of MAX_DEPTH entries never overflows
+	if (end - begin <= MAX_LEAF_PRIMITIVES || depth >= MAX_DEPTH - 1) {
+		subtreeNodes[nodeIdx].rightChildOrFirstPrimitive = begin;
+		subtreeNodes[nodeIdx].primitiveCount = end - begin;
+		return;
+	}
+	// Binned SAH: primitives are assigned to bins by their centroids, split is searched only between bins
+	int bestAxis = -1;
+	int bestSplit = 0;
+	float bestCost = std::numeric_limits<float>::infinity();
+	const Vec3f centroidExtent = centroidBounds.maxCorner() - centroidBounds.minCorner();
+	auto binOf = [&](const Vec3f& centroid, int axis) {
+		const float relative = (centroid[axis] - centroidBounds.minCorner()[axis]) / centroidExtent[axis];
+		return std::min(static_cast<int>(relative * SAH_BIN_COUNT), SAH_BIN_COUNT - 1);
+	};
+	for (int axis = 0; axis < 3; ++axis) {
+		if (centroidExtent[axis] <= 0.0f) {
+			continue;
+		}
+		Aabb3Df binBounds[SAH_BIN_COUNT];
+		uint32_t binCounts[SAH_BIN_COUNT] = {};
+		for (uint32_t i = begin; i < end; ++i) {
+			const int bin = binOf(centroids[indices[i]], axis);
+			binBounds[bin] += primitiveBounds[indices[i]];
+			++binCounts[bin];
+		}
+		// Sweep from the right to get costs of the right sides, then from the left to evaluate each split
+		float rightCosts[SAH_BIN_COUNT] = {};
+		Aabb3Df rightBounds;
+		uint32_t rightCount = 0;
+		for (int bin = SAH_BIN_COUNT - 1; bin > 0; --bin) {
+			rightBounds += binBounds[bin];
+			rightCount += binCounts[bin];
+			rightCosts[bin] = rightCount > 0 ? surfaceArea(rightBounds) * static_cast<float>(rightCount) : 0.0f;
+		}
+		Aabb3Df leftBounds;
+		uint32_t leftCount = 0;
+		for (int split = 1; split < SAH_BIN_COUNT; ++split) {
+			leftBounds += binBounds[split - 1];
+			leftCount += binCounts[split - 1];
+			if (leftCount == 0 || leftCount == end - begin) {
+				continue;
+			}
+			const float cost = surfaceArea(leftBounds) * static_cast<float>(leftCount) + rightCosts[split];
+			if (cost < bestCost) {
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = split;
+			}
+		}
+	}
+
+	uint32_t middle = 0;
+	if (bestAxis >= 0) {
+		auto isLeft = [&](uint32_t primitiveIdx) { return binOf(centroids[primitiveIdx], bestAxis) < bestSplit; };
+		auto* middleIt = std::partition(indices.data() + begin, indices.data() + end, isLeft);
+		middle = static_cast<uint32_t>(middleIt - indices.data());
+	} else {
+		// All centroids coincide, SAH cannot tell primitives apart; split in half to keep leaves small
+		middle = begin + (end - begin) / 2;
+	}
+
+	uint32_t rightChildIdx = 0;
+	if (depth < input.maxParallelDepth && end - begin >= PARALLEL_BUILD_MIN_PRIMITIVES) {
+		// Subtrees cover disjoint ranges of primitiveIndices, so they can be built concurrently into separate vectors
+		std::vector<Node> leftNodes;
+		auto leftBuilt = std::async(std::launch::async, [&]() { buildSubtree(input, leftNodes, begin, middle, depth + 1); });
+		std::vector<Node> rightNodes;
+		buildSubtree(input, rightNodes, middle, end, depth + 1);
+		leftBuilt.get();
+
+		auto appendSubtree = [&](const std::vector<Node>& nodesToAppend) {
+			const auto offset = static_cast<uint32_t>(subtreeNodes.size());
+			for (Node node : nodesToAppend) {
+				if (!node.isLeaf()) {
+					node.rightChildOrFirstPrimitive += offset;
+				}
+				subtreeNodes.push_back(node);
+			}
+		};
+		appendSubtree(leftNodes);
+		rightChildIdx = static_cast<uint32_t>(subtreeNodes.size());
+		appendSubtree(rightNodes);
+	} else {
+		buildSubtree(input, subtreeNodes, begin, middle, depth + 1);
+		rightChildIdx = static_cast<uint32_t>(subtreeNodes.size());
+		buildSubtree(input, subtreeNodes, middle, end, depth + 1);
+	}
+	subtreeNodes[nodeIdx].rightChildOrFirstPrimitive = rightChildIdx;
+	subtreeNodes[nodeIdx].primitiveCount = 0;
+}
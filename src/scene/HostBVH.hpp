@@ -0,0 +1,175 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <math/Aabb.h>
+#include <math/Vector.hpp>
+
+/**
+ * Bounding volume hierarchy over arbitrary primitives (given by their bounds), built and traversed on the host.
+ * Used by the host traversal backend both over triangles of a mesh (BLAS) and over entities of the scene (TLAS).
+ * The hierarchy is built top-down, splitting nodes with binned surface area heuristic (SAH);
+ * subtrees of large nodes are built in parallel. Once built, it can be refitted to moved primitives in O(n),
+ * similarly to the update of optix acceleration structures (see GASBuilder::updateGAS).
+ * Nodes are flattened in depth-first order: the left child of an inner node directly follows its parent,
+ * so only the index of the right child is stored. Refitted copies share the order of primitives, which never changes.
+ * This class does not depend on CUDA.
+ */
+struct HostBVH
+{
+	struct Node
+	{
+		Vec3f boundsMin;
+		uint32_t rightChildOrFirstPrimitive; // Right child for inner nodes, index to primitiveIndices for leaves
+		Vec3f boundsMax;
+		uint32_t primitiveCount; // Zero for inner nodes
+
+		bool isLeaf() const { return primitiveCount > 0; }
+	};
+	static_assert(sizeof(Node) == 32);
+
+	static constexpr int SAH_BIN_COUNT = 16;
+	static constexpr uint32_t MAX_LEAF_PRIMITIVES = 4;
+	static constexpr int MAX_DEPTH = 64;
+	// Smaller subtrees are not worth a separate thread
+	static constexpr uint32_t PARALLEL_BUILD_MIN_PRIMITIVES = 16 * 1024;
+
+	HostBVH() = default;
+
+	/**
+	 * Builds the hierarchy over primitives with the given bounds. Primitives are identified by their index.
+	 * The result does not depend on whether it was built in parallel.
+	 */
+	explicit HostBVH(const std::vector<Aabb3Df>& primitiveBounds, bool allowParallelBuild = true);
+
+	/**
+	 * Updates bounds of nodes to the moved primitives, keeping the topology of the hierarchy.
+	 * Traversal gets slower if primitives move far from their positions at the build time.
+	 * Primitive count must be the same as at the build time.
+	 */
+	void refit(const std::vector<Aabb3Df>& primitiveBounds);
+
+	/**
+	 * Returns bounds of triangles, ready to build BVH over them.
+	 */
+	static std::vector<Aabb3Df> getTriangleBounds(const std::vector<Vec3f>& vertices, const std::vector<Vec3i>& indices);
+
+	/**
+	 * Finds the closest intersection along the ray, visiting leaves in front-to-back order (approximately).
+	 * For each primitive in a visited leaf, intersectPrimitive(primitiveIdx, tMax) is called;
+	 * it should shorten tMax if the primitive is hit closer. Direction does not need to be normalized.
+	 */
+	template<typename IntersectPrimitive>
+	void intersect(const Vec3f& origin, const Vec3f& dir, float& tMax, IntersectPrimitive&& intersectPrimitive) const;
+
+	bool isEmpty() const { return nodes.empty(); }
+	const std::vector<Node>& getNodes() const { return nodes; }
+	const std::vector<uint32_t>& getPrimitiveIndices() const { return *primitiveIndices; }
+
+private:
+	struct BuildInput
+	{
+		const std::vector<Aabb3Df>& primitiveBounds;
+		const std::vector<Vec3f>& centroids;
+		std::vector<uint32_t>& primitiveIndices; // Reordered during the build
+		int maxParallelDepth; // Subtrees below this depth are built serially
+	};
+
+	/**
+	 * Builds subtree over primitiveIndices[begin, end), appending its nodes to subtreeNodes.
+	 * Indices of nodes are relative to the beginning of subtreeNodes.
+	 */
+	void buildSubtree(const BuildInput& input, std::vector<Node>& subtreeNodes, uint32_t begin, uint32_t end, int depth);
+
+	/**
+	 * Returns distance to the entry point of the ray into the node bounds, or infinity if the ray misses them.
+	 * Written without branches, so that the compiler vectorizes it.
+	 */
+	static float intersectBounds(const Node& node, const Vec3f& origin, const Vec3f& invDir, float tMax)
+	{
+		const Vec3f t0 = (node.boundsMin - origin) * invDir;
+		const Vec3f t1 = (node.boundsMax - origin) * invDir;
+		const float tNear = std::max(std::max(std::min(t0.x(), t1.x()), std::min(t0.y(), t1.y())),
+		                             std::max(std::min(t0.z(), t1.z()), 0.0f));
+		const float tFar = std::min(std::min(std::max(t0.x(), t1.x()), std::max(t0.y(), t1.y())),
+		                            std::min(std::max(t0.z(), t1.z()), tMax));
+		return tNear <= tFar ? tNear : std::numeric_limits<float>::infinity();
+	}
+
+	std::vector<Node> nodes;
+	std::shared_ptr<const std::vector<uint32_t>> primitiveIndices = std::make_shared<const std::vector<uint32_t>>();
+};
+
+template<typename IntersectPrimitive>
+void HostBVH::intersect(const Vec3f& origin, const Vec3f& dir, float& tMax, IntersectPrimitive&& intersectPrimitive) const
+{
+	constexpr float miss = std::numeric_limits<float>::infinity();
+	const Vec3f invDir = Vec3f{1.0f} / dir;
+	if (nodes.empty() || intersectBounds(nodes[0], origin, invDir, tMax) == miss) {
+		return;
+	}
+
+	// Postponed far children with their entry distances, skipped if a closer hit is found meanwhile.
+	struct StackEntry
+	{
+		uint32_t nodeIdx;
+		float tEntry;
+	};
+	StackEntry stack[MAX_DEPTH];
+	int stackSize = 0;
+	const uint32_t* leafPrimitives = primitiveIndices->data();
+
+	uint32_t nodeIdx = 0;
+	while (true) {
+		const Node& node = nodes[nodeIdx];
+		if (node.isLeaf()) {
+			const uint32_t end = node.rightChildOrFirstPrimitive + node.primitiveCount;
+			for (uint32_t i = node.rightChildOrFirstPrimitive; i < end; ++i) {
+				intersectPrimitive(leafPrimitives[i], tMax);
+			}
+		} else {
+			uint32_t nearIdx = nodeIdx + 1;
+			uint32_t farIdx = node.rightChildOrFirstPrimitive;
+			float tNear = intersectBounds(nodes[nearIdx], origin, invDir, tMax);
+			float tFar = intersectBounds(nodes[farIdx], origin, invDir, tMax);
+			if (tFar < tNear) {
+				std::swap(nearIdx, farIdx);
+				std::swap(tNear, tFar);
+			}
+			if (tNear != miss) {
+				if (tFar != miss) {
+					stack[stackSize++] = {farIdx, tFar};
+				}
+				nodeIdx = nearIdx;
+				continue;
+			}
+		}
+		// Pop the next node that may still contain a closer hit
+		do {
+			if (stackSize == 0) {
+				return;
+			}
+			--stackSize;
+		} while (stack[stackSize].tEntry > tMax);
+		nodeIdx = stack[stackSize].nodeIdx;
+	}
+}
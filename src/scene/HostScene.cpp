@@ -0,0 +1,147 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <spdlog/fmt/fmt.h>
+
+#include <scene/HostScene.hpp>
+
+HostGeometry::HostGeometry(std::vector<Vec3f> vertices, std::vector<Vec3i> indices, std::vector<Vec2f> textureCoords)
+  : HostGeometry(std::move(vertices), std::make_shared<const std::vector<Vec3i>>(std::move(indices)),
+                 std::make_shared<const std::vector<Vec2f>>(std::move(textureCoords)))
+{}
+
+HostGeometry::HostGeometry(std::vector<Vec3f> vertices, std::shared_ptr<const std::vector<Vec3i>> indices,
+                           std::shared_ptr<const std::vector<Vec2f>> textureCoords)
+  : vertices(std::move(vertices)), indices(std::move(indices)), textureCoords(std::move(textureCoords))
+{
+	const auto triangleBounds = HostBVH::getTriangleBounds(this->vertices, *this->indices);
+	for (auto&& triangle : triangleBounds) {
+		bounds += triangle;
+	}
+	bvh = HostBVH(triangleBounds);
+}
+
+HostGeometry::HostGeometry(const HostGeometry& previous, std::vector<Vec3f> vertices)
+  : vertices(std::move(vertices)),
+    indices(previous.indices),
+    textureCoords(previous.textureCoords),
+    bvh(previous.bvh),
+    consecutiveRefitCount(previous.consecutiveRefitCount + 1)
+{
+	if (this->vertices.size() != previous.vertices.size()) {
+		auto msg = fmt::format("cannot refit geometry with {} vertices to {} vertices", previous.vertices.size(),
+		                       this->vertices.size());
+		throw std::invalid_argument(msg);
+	}
+	const auto triangleBounds = HostBVH::getTriangleBounds(this->vertices, *indices);
+	for (auto&& triangle : triangleBounds) {
+		bounds += triangle;
+	}
+	bvh.refit(triangleBounds);
+}
+
+HostGeometry::Ptr HostGeometry::rebuilt(const HostGeometry& previous, std::vector<Vec3f> vertices)
+{
+	if (vertices.size() != previous.vertices.size()) {
+		auto msg = fmt::format("cannot rebuild geometry with {} vertices to {} vertices", previous.vertices.size(),
+		                       vertices.size());
+		throw std::invalid_argument(msg);
+	}
+	// Constructor is private, so std::make_shared cannot be used
+	return HostGeometry::Ptr(new HostGeometry(std::move(vertices), previous.indices, previous.textureCoords));
+}
+
+HostTexture::HostTexture(int width, int height, std::vector<TextureTexelFormat> texels)
+  : width(width), height(height), texels(std::move(texels))
+{}
+
+float HostTexture::sample(const Vec2f& uv) const
+{
+	auto texelIdx = [](float coord, int size) {
+		const float wrapped = coord - std::floor(coord);
+		return std::clamp(static_cast<int>(wrapped * static_cast<float>(size)), 0, size - 1);
+	};
+	return static_cast<float>(texels[texelIdx(uv[1], height) * width + texelIdx(uv[0], width)]);
+}
+
+HostScene::HostScene(std::vector<Instance> instances) : instances(std::move(instances))
+{
+	std::vector<Aabb3Df> instanceBounds;
+	instanceBounds.reserve(this->instances.size());
+	instanceTransforms.reserve(this->instances.size());
+	for (auto&& instance : this->instances) {
+		const Mat3x4f worldToObject = instance.objectToWorld.inverse();
+		instanceTransforms.push_back({worldToObject, worldToObject.rotation()});
+
+		const Vec3f& min = instance.geometry->bounds.minCorner();
+		const Vec3f& max = instance.geometry->bounds.maxCorner();
+		Aabb3Df worldBounds;
+		if (!instance.geometry->indices->empty()) {
+			for (int corner = 0; corner < 8; ++corner) {
+				const Vec3f local{corner & 1 ? max.x() : min.x(), corner & 2 ? max.y() : min.y(),
+				                  corner & 4 ? max.z() : min.z()};
+				worldBounds += instance.objectToWorld * local;
+			}
+		}
+		instanceBounds.push_back(worldBounds);
+	}
+	tlas = HostBVH(instanceBounds);
+}
+
+bool HostScene::intersect(const Vec3f& origin, const Vec3f& dir, float tMax, Hit& hit) const
+{
+	bool isHit = false;
+	tlas.intersect(origin, dir, tMax, [&](uint32_t instanceIdx, float& tMaxInstance) {
+		const HostGeometry& geometry = *instances[instanceIdx].geometry;
+		// Direction is transformed without normalization, so distances are the same in both spaces
+		const Vec3f objectOrigin = instanceTransforms[instanceIdx].worldToObject * origin;
+		const Vec3f objectDir = instanceTransforms[instanceIdx].worldToObjectLinear * dir;
+		geometry.bvh.intersect(objectOrigin, objectDir, tMaxInstance, [&](uint32_t triangleIdx, float& tMaxTriangle) {
+			// Moller-Trumbore, without culling
+			const Vec3i& triangle = (*geometry.indices)[triangleIdx];
+			const Vec3f& A = geometry.vertices[triangle.x()];
+			const Vec3f edgeAB = geometry.vertices[triangle.y()] - A;
+			const Vec3f edgeAC = geometry.vertices[triangle.z()] - A;
+			const Vec3f p = objectDir.cross(edgeAC);
+			const float det = edgeAB.dot(p);
+			if (det == 0.0f) {
+				return; // Ray parallel to the triangle
+			}
+			const float invDet = 1.0f / det;
+			const Vec3f s = objectOrigin - A;
+			const float u = s.dot(p) * invDet;
+			if (u < 0.0f || u > 1.0f) {
+				return;
+			}
+			const Vec3f q = s.cross(edgeAB);
+			const float v = objectDir.dot(q) * invDet;
+			if (v < 0.0f || u + v > 1.0f) {
+				return;
+			}
+			const float t = edgeAC.dot(q) * invDet;
+			if (t < 0.0f || t > tMaxTriangle) {
+				return;
+			}
+			tMaxTriangle = t;
+			hit = {t, u, v, triangleIdx, instanceIdx};
+			isHit = true;
+		});
+	});
+	return isHit;
+}
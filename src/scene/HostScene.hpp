@@ -0,0 +1,131 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <RGLFields.hpp>
+#include <math/Aabb.h>
+#include <math/Mat3x4f.hpp>
+#include <math/Vector.hpp>
+#include <scene/HostBVH.hpp>
+#include <gpu/ShaderBindingTableTypes.h>
+
+/**
+ * Host copy of mesh data (possibly animated), with BVH over its triangles.
+ */
+struct HostGeometry
+{
+	using Ptr = std::shared_ptr<const HostGeometry>;
+
+	// Like InstanceUpdateTracker::MAX_CONSECUTIVE_REFITS, refitted BVH is rebuilt from time to time to keep traversal fast
+	static constexpr size_t MAX_CONSECUTIVE_REFITS = 32;
+
+	HostGeometry(std::vector<Vec3f> vertices, std::vector<Vec3i> indices, std::vector<Vec2f> textureCoords);
+
+	/**
+	 * Creates geometry with the topology of the previous one and moved vertices.
+	 * BVH is refitted instead of rebuilt, which is much faster, but may degrade traversal if vertices move far.
+	 * Indices and texture coordinates are shared with the previous geometry.
+	 */
+	HostGeometry(const HostGeometry& previous, std::vector<Vec3f> vertices);
+
+	/**
+	 * Creates geometry with the topology of the previous one and moved vertices, with BVH rebuilt.
+	 */
+	static Ptr rebuilt(const HostGeometry& previous, std::vector<Vec3f> vertices);
+
+	std::vector<Vec3f> vertices;
+	std::shared_ptr<const std::vector<Vec3i>> indices;
+	std::shared_ptr<const std::vector<Vec2f>> textureCoords; // Empty if mesh has no texture coordinates
+	Aabb3Df bounds;
+	HostBVH bvh;
+	size_t consecutiveRefitCount{0};
+
+private:
+	HostGeometry(std::vector<Vec3f> vertices, std::shared_ptr<const std::vector<Vec3i>> indices,
+	             std::shared_ptr<const std::vector<Vec2f>> textureCoords);
+};
+
+/**
+ * Host copy of an intensity texture. Sampling mirrors the device texture object (see Texture):
+ * normalized coordinates, wrap addressing and point filtering.
+ */
+struct HostTexture
+{
+	using Ptr = std::shared_ptr<const HostTexture>;
+
+	HostTexture(int width, int height, std::vector<TextureTexelFormat> texels);
+
+	float sample(const Vec2f& uv) const;
+
+private:
+	int width;
+	int height;
+	std::vector<TextureTexelFormat> texels;
+};
+
+/**
+ * Immutable snapshot of the scene for the host traversal backend: instances of host geometries and BVH over them (TLAS).
+ * Snapshot is shared with graph threads, so it is never modified after construction; Scene builds a new one when needed.
+ */
+struct HostScene
+{
+	using Ptr = std::shared_ptr<const HostScene>;
+
+	struct Instance
+	{
+		int entityId;
+		Mat3x4f objectToWorld;
+		HostGeometry::Ptr geometry;
+		HostTexture::Ptr texture;                                     // May be nullptr
+		std::shared_ptr<const std::vector<Vec3f>> vertexDisplacement; // May be nullptr
+		// Same as the entity's SBT record, but pointing to the host data above (except for the texture object).
+		// It allows computing hits with the same code as optix programs.
+		EntitySBTData data;
+	};
+
+	struct Hit
+	{
+		float distance; // In units of the ray direction length
+		float u;        // Barycentrics, as in optix: hit = (1 - u - v) * A + u * B + v * C
+		float v;
+		uint32_t triangleIdx;
+		uint32_t instanceIdx;
+	};
+
+	explicit HostScene(std::vector<Instance> instances);
+
+	/**
+	 * Finds the closest hit of the ray within [0, tMax]. Triangles are double-sided, as in optix.
+	 * @return true if something was hit; in such case `hit` is filled.
+	 */
+	bool intersect(const Vec3f& origin, const Vec3f& dir, float tMax, Hit& hit) const;
+
+	const std::vector<Instance>& getInstances() const { return instances; }
+
+private:
+	struct InstanceTransforms
+	{
+		Mat3x4f worldToObject;
+		Mat3x4f worldToObjectLinear;
+	};
+
+	std::vector<Instance> instances;
+	std::vector<InstanceTransforms> instanceTransforms;
+	HostBVH tlas;
+};
@@ -0,0 +1,46 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <scene/InstanceUpdateTracker.hpp>
+
+void InstanceUpdateTracker::markDirty(size_t slot)
+{
+	if (slot >= slotCount) {
+		requestRebuild();
+		return;
+	}
+	dirtySlots.mark(slot);
+}
+
+InstanceUpdateTracker::Operation InstanceUpdateTracker::getOperation() const
+{
+	if (isRebuildRequested || consecutiveRefitCount >= MAX_CONSECUTIVE_REFITS) {
+		return Operation::Rebuild;
+	}
+	return dirtySlots.isEmpty() ? Operation::None : Operation::Refit;
+}
+
+void InstanceUpdateTracker::onRebuilt(size_t newSlotCount)
+{
+	slotCount = newSlotCount;
+	isRebuildRequested = false;
+	consecutiveRefitCount = 0;
+	dirtySlots.clear();
+}
+
+void InstanceUpdateTracker::onRefitted()
+{
+	consecutiveRefitCount += 1;
+	dirtySlots.clear();
+}
@@ -0,0 +1,65 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <scene/DirtySlotSet.hpp>
+
+/**
+ * Decides whether the instance acceleration structure (IAS) has to be rebuilt, or it is enough to refit it.
+ * Between rebuilds, instances occupy fixed slots. Changes of an existing instance (e.g. its transform) mark its slot dirty,
+ * so only dirty instances are patched and the IAS is refitted (OPTIX_BUILD_OPERATION_UPDATE), which is much faster.
+ * Adding or removing instances requires a rebuild. A rebuild is also forced after a number of consecutive refits,
+ * because refitting keeps the hierarchy built for the former positions, so trace performance degrades over time.
+ * This class does not depend on CUDA / OptiX.
+ */
+struct InstanceUpdateTracker
+{
+	enum class Operation
+	{
+		None,
+		Refit,
+		Rebuild,
+	};
+
+	using SlotRange = DirtySlotSet::SlotRange;
+
+	static constexpr size_t MAX_CONSECUTIVE_REFITS = 32;
+
+	void requestRebuild() { isRebuildRequested = true; }
+	void markDirty(size_t slot);
+
+	Operation getOperation() const;
+
+	/**
+	 * Returns sorted ranges of dirty slots. Ranges separated by at most maxGap clean slots are merged,
+	 * which trades copying some clean instances for issuing fewer copies.
+	 */
+	std::vector<SlotRange> getDirtyRanges(size_t maxGap = 0) const { return dirtySlots.getRanges(maxGap); }
+
+	void onRebuilt(size_t newSlotCount);
+	void onRefitted();
+
+	size_t getSlotCount() const { return slotCount; }
+	size_t getDirtySlotCount() const { return dirtySlots.getCount(); }
+
+private:
+	size_t slotCount{0};
+	bool isRebuildRequested{true};
+	size_t consecutiveRefitCount{0};
+	DirtySlotSet dirtySlots;
+};
@@ -37,7 +37,7 @@ void Mesh::setTexCoords(const Vec2f* texCoords, std::size_t texCoordCount)
 	}
 
 	dTextureCoords.value()->copyFromExternal(texCoords, texCoordCount);
-	Scene::instance().requestSBTRebuild();
+	Scene::instance().requestSBTUpdate(*this);
 }
 
 void Mesh::setBoneWeights(const rgl_bone_weights_t* boneWeights, int32_t boneWeightsCount)
@@ -0,0 +1,64 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <stdexcept>
+
+#include <spdlog/fmt/fmt.h>
+
+#include <scene/SBTSlotAllocator.hpp>
+
+size_t SBTSlotAllocator::acquire()
+{
+	size_t slot = isSlotUsed.size();
+	if (freeSlots.empty()) {
+		isSlotUsed.push_back(true);
+	} else {
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+		isSlotUsed[slot] = true;
+	}
+	dirtySlots.mark(slot);
+	return slot;
+}
+
+void SBTSlotAllocator::release(size_t slot)
+{
+	if (!isUsed(slot)) {
+		throw std::logic_error(fmt::format("attempted to release SBT slot {} which is not in use", slot));
+	}
+	isSlotUsed[slot] = false;
+	freeSlots.push_back(slot);
+}
+
+void SBTSlotAllocator::markDirty(size_t slot)
+{
+	if (isUsed(slot)) {
+		dirtySlots.mark(slot);
+	}
+}
+
+void SBTSlotAllocator::markAllDirty()
+{
+	for (size_t slot = 0; slot < isSlotUsed.size(); ++slot) {
+		markDirty(slot);
+	}
+}
+
+void SBTSlotAllocator::reset()
+{
+	isSlotUsed.clear();
+	freeSlots.clear();
+	dirtySlots.clear();
+}
@@ -0,0 +1,56 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <scene/DirtySlotSet.hpp>
+
+/**
+ * Assigns stable hitgroup record slots in the shader binding table (SBT) to entities.
+ * A slot is kept by the entity for its whole lifetime, so the records of other entities never move
+ * and only records of changed entities (dirty slots) need to be re-uploaded.
+ * Released slots leave holes in the table, which are reused by subsequently acquired slots instead of compacting the table.
+ * This class does not depend on CUDA / OptiX.
+ */
+struct SBTSlotAllocator
+{
+	using SlotRange = DirtySlotSet::SlotRange;
+
+	/**
+	 * Returns a free slot, preferring holes left by released slots. The returned slot is marked dirty.
+	 */
+	size_t acquire();
+	void release(size_t slot);
+
+	void markDirty(size_t slot);
+	void markAllDirty();
+	std::vector<SlotRange> getDirtyRanges(size_t maxGap = 0) const { return dirtySlots.getRanges(maxGap); }
+	void onUploaded() { dirtySlots.clear(); }
+
+	void reset();
+
+	bool isUsed(size_t slot) const { return slot < isSlotUsed.size() && isSlotUsed[slot]; }
+	size_t getSlotCount() const { return isSlotUsed.size(); } // Including holes
+	size_t getUsedSlotCount() const { return isSlotUsed.size() - freeSlots.size(); }
+	size_t getDirtySlotCount() const { return dirtySlots.getCount(); }
+
+private:
+	std::vector<bool> isSlotUsed;
+	std::vector<size_t> freeSlots;
+	DirtySlotSet dirtySlots;
+};
@@ -27,13 +27,40 @@ Scene::Scene() : stream(CudaStream::create(cudaStreamNonBlocking)) {}
 
 std::size_t Scene::getObjectCount() const { return entities.size(); }
 
+void Scene::setTime(Time time)
+{
+	prevTime = this->time;
+	this->time = time;
+
+	// Previous frame transforms and displacements in some records may become (in)valid
+	if (!timeDependentSBTSlots.empty()) {
+		for (auto&& slot : timeDependentSBTSlots) {
+			sbtSlots.markDirty(slot);
+		}
+		timeDependentSBTSlots.clear();
+		cachedSBT.reset();
+	}
+	if (isHostSceneTimeDependent) {
+		cachedHostScene.reset();
+	}
+}
+
 void Scene::clear()
 {
 	entities.clear();
+	instanceEntities.clear();
+	instanceSlots.clear();
+	sbtSlots.reset();
+	sbtEntities.clear();
+	entitySBTSlots.clear();
+	timeDependentSBTSlots.clear();
 	requestASRebuild();
 	requestSBTRebuild();
 	gasBuilderForEntities.clear();
 	gasBuilderForStaticMeshes.clear();
+	hostGeometryForStaticMeshes.clear();
+	hostGeometryForAnimatedEntities.clear();
+	hostTextures.clear();
 	time.reset();
 	prevTime.reset();
 }
@@ -41,8 +68,14 @@ void Scene::clear()
 void Scene::addEntity(std::shared_ptr<Entity> entity)
 {
 	entities.insert(entity);
+	size_t sbtSlot = sbtSlots.acquire();
+	if (sbtSlot >= sbtEntities.size()) {
+		sbtEntities.resize(sbtSlot + 1);
+	}
+	sbtEntities[sbtSlot] = entity;
+	entitySBTSlots[entity.get()] = sbtSlot;
 	requestASRebuild();
-	requestSBTRebuild();
+	cachedSBT.reset();
 }
 
 void Scene::removeEntity(std::shared_ptr<Entity> entity)
@@ -54,144 +87,393 @@ void Scene::removeEntity(std::shared_ptr<Entity> entity)
 		gasBuilderForStaticMeshes.erase(entity->mesh);
 	}
 	gasBuilderForEntities.erase(entity);
+	// Do not keep the entity alive until the next AS build
+	if (auto it = instanceSlots.find(entity.get()); it != instanceSlots.end()) {
+		instanceEntities[it->second].reset();
+		instanceSlots.erase(it);
+	}
+	// Leave a hole in SBT, it will be reused by the next added entity
+	if (auto it = entitySBTSlots.find(entity.get()); it != entitySBTSlots.end()) {
+		sbtSlots.release(it->second);
+		sbtEntities[it->second].reset();
+		timeDependentSBTSlots.erase(it->second);
+		entitySBTSlots.erase(it);
+	}
 	requestASRebuild();
-	requestSBTRebuild();
+	cachedSBT.reset();
 }
 
-OptixTraversableHandle Scene::getASLocked()
+std::pair<OptixTraversableHandle, OptixShaderBindingTable> Scene::getASAndSBTLocked()
 {
 	std::lock_guard optixStructsLock(optixStructsMutex);
 	if (!cachedAS.has_value()) {
 		cachedAS = buildAS();
 	}
-	return *cachedAS;
+	if (!cachedSBT.has_value()) {
+		cachedSBT = buildSBT();
+	}
+	return {*cachedAS, *cachedSBT};
 }
 
-OptixShaderBindingTable Scene::getSBTLocked()
+HostScene::Ptr Scene::getHostSceneLocked()
 {
-	std::lock_guard optixStructsLock(optixStructsMutex);
-	if (!cachedSBT.has_value()) {
-		cachedSBT = buildSBT();
+	std::lock_guard hostSceneLock(hostSceneMutex);
+	if (cachedHostScene == nullptr) {
+		cachedHostScene = buildHostScene();
 	}
-	return *cachedSBT;
+	return cachedHostScene;
 }
 
-OptixShaderBindingTable Scene::buildSBT()
+template<typename T>
+static std::vector<T> downloadToHost(const T* devicePtr, size_t count)
 {
-	static DeviceSyncArray<HitgroupRecord>::Ptr dHitgroupRecords = DeviceSyncArray<HitgroupRecord>::create();
-	static DeviceSyncArray<RaygenRecord>::Ptr dRaygenRecords = DeviceSyncArray<RaygenRecord>::create();
-	static DeviceSyncArray<MissRecord>::Ptr dMissRecords = DeviceSyncArray<MissRecord>::create();
-	static HostPinnedArray<HitgroupRecord>::Ptr hHitgroupRecords = HostPinnedArray<HitgroupRecord>::create();
+	std::vector<T> hostData(count);
+	if (count > 0) {
+		CHECK_CUDA(cudaMemcpy(hostData.data(), devicePtr, count * sizeof(T), cudaMemcpyDeviceToHost));
+	}
+	return hostData;
+}
+
+HostScene::Ptr Scene::buildHostScene()
+{
+	// Caches are rebuilt, so that data of meshes and textures no longer used are released
+	std::unordered_map<std::shared_ptr<Mesh>, HostGeometry::Ptr> usedStaticGeometries;
+	std::unordered_map<std::shared_ptr<Entity>, HostGeometry::Ptr> usedAnimatedGeometries;
+	std::unordered_map<std::shared_ptr<Texture>, HostTexture::Ptr> usedTextures;
+	std::vector<HostScene::Instance> instances;
+	instances.reserve(entities.size());
+	isHostSceneTimeDependent = false;
 
-	hHitgroupRecords->reserve(entities.size(), false);
-	hHitgroupRecords->clear(false);
 	for (auto&& entity : entities) {
-		auto& mesh = entity->mesh;
+		const auto& mesh = entity->mesh;
+		auto downloadGeometry = [&](const DeviceSyncArray<Vec3f>::Ptr& vertices) {
+			const auto& indices = mesh->dIndices;
+			std::vector<Vec2f> textureCoords;
+			if (const auto& uvs = mesh->dTextureCoords; uvs.has_value()) {
+				textureCoords = downloadToHost((*uvs)->getReadPtr(), (*uvs)->getCount());
+			}
+			return std::make_shared<const HostGeometry>(downloadToHost(vertices->getReadPtr(), vertices->getCount()),
+			                                            downloadToHost(indices->getReadPtr(), indices->getCount()),
+			                                            std::move(textureCoords));
+		};
+
+		HostGeometry::Ptr geometry;
+		if (entity->isAnimated()) {
+			// Animation moves vertices only, so BVH of the previous snapshot is refitted (like GAS in setupGASForEntities)
+			// Refitted BVH degrades as vertices move, so it is rebuilt after a number of consecutive refits
+			const auto& animatedVertices = entity->getAnimatedVertices().value();
+			auto prevIt = hostGeometryForAnimatedEntities.find(entity);
+			if (prevIt != hostGeometryForAnimatedEntities.end() &&
+			    prevIt->second->vertices.size() == animatedVertices->getCount()) {
+				auto vertices = downloadToHost(animatedVertices->getReadPtr(), animatedVertices->getCount());
+				geometry = prevIt->second->consecutiveRefitCount < HostGeometry::MAX_CONSECUTIVE_REFITS
+				             ? std::make_shared<const HostGeometry>(*prevIt->second, std::move(vertices))
+				             : HostGeometry::rebuilt(*prevIt->second, std::move(vertices));
+			} else {
+				geometry = downloadGeometry(animatedVertices);
+			}
+			usedAnimatedGeometries[entity] = geometry;
+		} else if (auto it = usedStaticGeometries.find(mesh); it != usedStaticGeometries.end()) {
+			geometry = it->second;
+		} else if (auto cachedIt = hostGeometryForStaticMeshes.find(mesh); cachedIt != hostGeometryForStaticMeshes.end()) {
+			geometry = usedStaticGeometries[mesh] = cachedIt->second;
+		} else {
+			geometry = usedStaticGeometries[mesh] = downloadGeometry(mesh->dVertices);
+		}
+
+		HostTexture::Ptr texture;
+		if (const auto& intensityTexture = entity->intensityTexture; intensityTexture != nullptr) {
+			if (auto it = hostTextures.find(intensityTexture); it != hostTextures.end()) {
+				texture = it->second;
+			} else {
+				texture = std::make_shared<const HostTexture>(static_cast<int>(intensityTexture->getWidth()),
+				                                              static_cast<int>(intensityTexture->getHeight()),
+				                                              intensityTexture->downloadTexels());
+			}
+			usedTextures[intensityTexture] = texture;
+		}
+
+		std::shared_ptr<const std::vector<Vec3f>> vertexDisplacement;
+		if (const Vec3f* dDisplacement = entity->getVertexDisplacementSincePrevFrame(); dDisplacement != nullptr) {
+			vertexDisplacement = std::make_shared<const std::vector<Vec3f>>(
+			    downloadToHost(dDisplacement, geometry->vertices.size()));
+		}
+
 		std::optional<Mat3x4f> prevFrameTransform = entity->getPreviousFrameLocalToWorldTransform();
-		hHitgroupRecords->append(HitgroupRecord{
-		    .data = {
-		             .vertex = entity->getAnimatedVertices().value_or(entity->mesh->dVertices)->getReadPtr(),
-		             .index = mesh->dIndices->getReadPtr(),
-		             // vertex count always the same (animated or not)
-		             .vertexCount = entity->mesh->dVertices->getCount(),
-		             .indexCount = mesh->dIndices->getCount(),
-		             .textureCoords = mesh->dTextureCoords.has_value() ? mesh->dTextureCoords.value()->getReadPtr() : nullptr,
-		             .textureCoordsCount = mesh->dTextureCoords.has_value() ? mesh->dTextureCoords.value()->getCount() : 0,
-		             .texture = entity->intensityTexture != nullptr ? entity->intensityTexture->getTextureObject() : 0,
-		             .laserRetro = entity->laserRetro,
-		             .prevFrameLocalToWorld = prevFrameTransform.value_or(Mat3x4f::identity()),
-		             .hasPrevFrameLocalToWorld = prevFrameTransform.has_value(),
-		             .vertexDisplacementSincePrevFrame = entity->getVertexDisplacementSincePrevFrame(),
-		             }
-        });
-		HitgroupRecord& last = hHitgroupRecords->at(hHitgroupRecords->getCount() - 1);
-		CHECK_OPTIX(optixSbtRecordPackHeader(Optix::getOrCreate().hitgroupPG, last.header));
-	}
-	dHitgroupRecords->copyFrom(hHitgroupRecords);
-
-	RaygenRecord hRaygenRecord = {};
-	CHECK_OPTIX(optixSbtRecordPackHeader(Optix::getOrCreate().raygenPG, &hRaygenRecord));
-	dRaygenRecords->copyFromExternal(&hRaygenRecord, 1);
-
-	MissRecord hMissRecord = {};
-	CHECK_OPTIX(optixSbtRecordPackHeader(Optix::getOrCreate().missPG, &hMissRecord));
-	dMissRecords->copyFromExternal(&hMissRecord, 1);
+		EntitySBTData data = {
+		    .vertex = geometry->vertices.data(),
+		    .index = geometry->indices->data(),
+		    .vertexCount = geometry->vertices.size(),
+		    .indexCount = geometry->indices->size(),
+		    .textureCoords = geometry->textureCoords->empty() ? nullptr : geometry->textureCoords->data(),
+		    .textureCoordsCount = geometry->textureCoords->size(),
+		    .texture = 0, // Sampled from the host texture instead
+		    .laserRetro = entity->laserRetro,
+		    .prevFrameLocalToWorld = prevFrameTransform.value_or(Mat3x4f::identity()),
+		    .hasPrevFrameLocalToWorld = prevFrameTransform.has_value(),
+		    .vertexDisplacementSincePrevFrame = vertexDisplacement != nullptr ? vertexDisplacement->data() : nullptr,
+		};
+		// The same condition as for time-dependent SBT records
+		if (entity->formerTransformInfo.time.has_value() || entity->formerAnimationTime.has_value()) {
+			isHostSceneTimeDependent = true;
+		}
+		instances.push_back({
+		    .entityId = entity->id,
+		    .objectToWorld = entity->transformInfo.matrix,
+		    .geometry = std::move(geometry),
+		    .texture = std::move(texture),
+		    .vertexDisplacement = std::move(vertexDisplacement),
+		    .data = data,
+		});
+	}
+	hostGeometryForStaticMeshes = std::move(usedStaticGeometries);
+	hostGeometryForAnimatedEntities = std::move(usedAnimatedGeometries);
+	hostTextures = std::move(usedTextures);
+	return std::make_shared<const HostScene>(std::move(instances));
+}
 
+OptixShaderBindingTable Scene::buildSBT()
+{
+	if (!emptyHitgroupRecord.has_value()) {
+		emptyHitgroupRecord = HitgroupRecord{};
+		CHECK_OPTIX(optixSbtRecordPackHeader(Optix::getOrCreate().hitgroupPG, emptyHitgroupRecord->header));
+
+		RaygenRecord hRaygenRecord = {};
+		CHECK_OPTIX(optixSbtRecordPackHeader(Optix::getOrCreate().raygenPG, &hRaygenRecord));
+		dRaygenRecords->copyFromExternal(&hRaygenRecord, 1);
+
+		MissRecord hMissRecord = {};
+		CHECK_OPTIX(optixSbtRecordPackHeader(Optix::getOrCreate().missPG, &hMissRecord));
+		dMissRecords->copyFromExternal(&hMissRecord, 1);
+	}
+
+	uploadDirtyHitgroupRecords();
+
+	const bool hasHitgroupRecords = getObjectCount() > 0;
 	return OptixShaderBindingTable{
 	    .raygenRecord = dRaygenRecords->getDeviceReadPtr(),
 	    .missRecordBase = dMissRecords->getDeviceReadPtr(),
 	    .missRecordStrideInBytes = sizeof(MissRecord),
 	    .missRecordCount = 1U,
-	    .hitgroupRecordBase = getObjectCount() > 0 ? dHitgroupRecords->getDeviceReadPtr() : static_cast<CUdeviceptr>(0),
+	    .hitgroupRecordBase = hasHitgroupRecords ? dHitgroupRecords->getDeviceReadPtr() : static_cast<CUdeviceptr>(0),
 	    .hitgroupRecordStrideInBytes = sizeof(HitgroupRecord),
-	    .hitgroupRecordCount = static_cast<unsigned>(dHitgroupRecords->getCount()),
+	    .hitgroupRecordCount = hasHitgroupRecords ? static_cast<unsigned>(dHitgroupRecords->getCount()) : 0U,
 	};
 }
 
+void Scene::uploadDirtyHitgroupRecords()
+{
+	// The table only grows (holes are reused), so existing records are preserved
+	if (hHitgroupRecords->getCount() != sbtSlots.getSlotCount()) {
+		hHitgroupRecords->resize(sbtSlots.getSlotCount(), false, true);
+		dHitgroupRecords->resize(sbtSlots.getSlotCount(), false, true);
+	}
+
+	auto ranges = sbtSlots.getDirtyRanges(SBT_MAX_CLEAN_GAP);
+	for (auto&& range : ranges) {
+		for (size_t slot = range.begin; slot < range.end; ++slot) {
+			if (sbtEntities[slot] == nullptr) {
+				continue; // Hole, not referenced by any instance
+			}
+			hHitgroupRecords->at(slot) = makeHitgroupRecord(sbtEntities[slot]);
+		}
+	}
+	for (auto&& range : ranges) {
+		CHECK_CUDA(cudaMemcpyAsync(dHitgroupRecords->getWritePtr() + range.begin, hHitgroupRecords->getReadPtr() + range.begin,
+		                           (range.end - range.begin) * sizeof(HitgroupRecord), cudaMemcpyHostToDevice,
+		                           getStream()->getHandle()));
+	}
+	if (!ranges.empty()) {
+		CHECK_CUDA(cudaStreamSynchronize(getStream()->getHandle()));
+	}
+	sbtSlots.onUploaded();
+}
+
+HitgroupRecord Scene::makeHitgroupRecord(const std::shared_ptr<Entity>& entity)
+{
+	auto& mesh = entity->mesh;
+	std::optional<Mat3x4f> prevFrameTransform = entity->getPreviousFrameLocalToWorldTransform();
+	HitgroupRecord record = *emptyHitgroupRecord;
+	record.data = {
+	    .vertex = entity->getAnimatedVertices().value_or(entity->mesh->dVertices)->getReadPtr(),
+	    .index = mesh->dIndices->getReadPtr(),
+	    // vertex count always the same (animated or not)
+	    .vertexCount = entity->mesh->dVertices->getCount(),
+	    .indexCount = mesh->dIndices->getCount(),
+	    .textureCoords = mesh->dTextureCoords.has_value() ? mesh->dTextureCoords.value()->getReadPtr() : nullptr,
+	    .textureCoordsCount = mesh->dTextureCoords.has_value() ? mesh->dTextureCoords.value()->getCount() : 0,
+	    .texture = entity->intensityTexture != nullptr ? entity->intensityTexture->getTextureObject() : 0,
+	    .laserRetro = entity->laserRetro,
+	    .prevFrameLocalToWorld = prevFrameTransform.value_or(Mat3x4f::identity()),
+	    .hasPrevFrameLocalToWorld = prevFrameTransform.has_value(),
+	    .vertexDisplacementSincePrevFrame = entity->getVertexDisplacementSincePrevFrame(),
+	};
+	// Validity of the above previous frame data depends on the scene time
+	if (entity->formerTransformInfo.time.has_value() || entity->formerAnimationTime.has_value()) {
+		timeDependentSBTSlots.insert(entitySBTSlots.at(entity.get()));
+	}
+	return record;
+}
+
 OptixTraversableHandle Scene::buildAS()
 {
 	if (getObjectCount() == 0) {
+		instanceEntities.clear();
+		instanceSlots.clear();
+		instanceTracker.requestRebuild();
 		return static_cast<OptixTraversableHandle>(0);
 	}
 
 	setupGASForEntities();
 
+	switch (instanceTracker.getOperation()) {
+		case InstanceUpdateTracker::Operation::None: return sceneHandle;
+		case InstanceUpdateTracker::Operation::Refit:
+			if (auto refittedHandle = refitAS(); refittedHandle.has_value()) {
+				return *refittedHandle;
+			}
+			break; // Refit not possible, rebuild
+		case InstanceUpdateTracker::Operation::Rebuild: break;
+	}
+
 	// Construct Instance Acceleration Structures based on Entities present on the scene
-	// TODO: this approach may be inefficient - most of the time only transform changes
-	auto instances = HostPinnedArray<OptixInstance>::create();
-	instances->reserve(entities.size(), false);
-	for (auto&& entity : entities) {
-		int idx = instances->getCount();
-		OptixInstance instance = {
-		    .instanceId = static_cast<unsigned int>(entity->id),
-		    .sbtOffset = static_cast<unsigned int>(idx), // NOTE: this assumes a single SBT record per GAS
-		    .visibilityMask = 255,
-		    .flags = OPTIX_INSTANCE_FLAG_DISABLE_ANYHIT,
-		    .traversableHandle = gasBuilderForEntities[entity]->getGAS(),
-		};
-		entity->transformInfo.matrix.toRaw(instance.transform);
-		instances->append(instance);
+	instanceEntities.assign(entities.begin(), entities.end());
+	instanceSlots.clear();
+	hInstances->reserve(instanceEntities.size(), false);
+	hInstances->clear(false);
+	for (size_t slot = 0; slot < instanceEntities.size(); ++slot) {
+		instanceSlots.emplace(instanceEntities[slot].get(), slot);
+		hInstances->append(makeInstance(instanceEntities[slot]));
+	}
+
+	dInstances->resize(hInstances->getCount(), false, false);
+	dInstances->copyFrom(hInstances);
+
+	runIASBuild(OPTIX_BUILD_OPERATION_BUILD);
+
+	// scratchpad.doCompaction(sceneHandle);
+
+	instanceTracker.onRebuilt(instanceEntities.size());
+	return sceneHandle;
+}
+
+std::optional<OptixTraversableHandle> Scene::refitAS()
+{
+	auto ranges = instanceTracker.getDirtyRanges(REFIT_MAX_CLEAN_GAP);
+	for (auto&& range : ranges) {
+		for (size_t slot = range.begin; slot < range.end; ++slot) {
+			OptixInstance instance = makeInstance(instanceEntities[slot]);
+			// Refit cannot handle replaced geometry (e.g. rebuilt GAS of an animated entity)
+			if (instance.traversableHandle != hInstances->at(slot).traversableHandle) {
+				return std::nullopt;
+			}
+			hInstances->at(slot) = instance;
+		}
 	}
+	// Patch only dirty instances
+	for (auto&& range : ranges) {
+		CHECK_CUDA(cudaMemcpyAsync(dInstances->getWritePtr() + range.begin, hInstances->getReadPtr() + range.begin,
+		                           (range.end - range.begin) * sizeof(OptixInstance), cudaMemcpyHostToDevice,
+		                           getStream()->getHandle()));
+	}
+	runIASBuild(OPTIX_BUILD_OPERATION_UPDATE);
+	instanceTracker.onRefitted();
+	return sceneHandle;
+}
 
-	dInstances->resize(instances->getCount(), false, false);
-	dInstances->copyFrom(instances);
+OptixInstance Scene::makeInstance(const std::shared_ptr<Entity>& entity)
+{
+	// NOTE: this assumes a single SBT record per GAS
+	OptixInstance instance = {
+	    .instanceId = static_cast<unsigned int>(entity->id),
+	    .sbtOffset = static_cast<unsigned int>(entitySBTSlots.at(entity.get())),
+	    .visibilityMask = 255,
+	    .flags = OPTIX_INSTANCE_FLAG_DISABLE_ANYHIT,
+	    .traversableHandle = gasBuilderForEntities[entity]->getGAS(),
+	};
+	entity->transformInfo.matrix.toRaw(instance.transform);
+	return instance;
+}
 
+void Scene::runIASBuild(OptixBuildOperation operation)
+{
 	OptixBuildInput instanceInput = {
 	    .type = OPTIX_BUILD_INPUT_TYPE_INSTANCES,
 	    .instanceArray = {.instances = dInstances->getDeviceReadPtr(),
 	                      .numInstances = static_cast<unsigned int>(dInstances->getCount())},
 	};
 
+	// Update (refit) requires the same build flags as the original build
 	OptixAccelBuildOptions accelBuildOptions = {
-	    .buildFlags =
-	        OPTIX_BUILD_FLAG_ALLOW_UPDATE // TODO(prybicki): figure out if there's a faster way to update than the current one
-	        | OPTIX_BUILD_FLAG_ALLOW_COMPACTION,
-	    .operation = OPTIX_BUILD_OPERATION_BUILD};
+	    .buildFlags = OPTIX_BUILD_FLAG_ALLOW_UPDATE | OPTIX_BUILD_FLAG_ALLOW_COMPACTION,
+	    .operation = operation,
+	};
 
 	scratchpad.resizeToFit(instanceInput, accelBuildOptions);
 
+	// Compacted size is not needed for update
+	const bool isBuild = operation == OPTIX_BUILD_OPERATION_BUILD;
 	OptixAccelEmitDesc emitDesc = {
 	    .result = scratchpad.dCompactedSize->getDeviceReadPtr(),
 	    .type = OPTIX_PROPERTY_TYPE_COMPACTED_SIZE,
 	};
 
-	OptixTraversableHandle sceneHandle;
 	CHECK_OPTIX(optixAccelBuild(Optix::getOrCreate().context, getStream()->getHandle(), &accelBuildOptions, &instanceInput, 1,
 	                            scratchpad.dTemp->getDeviceReadPtr(),
 	                            scratchpad.dTemp->getSizeOf() * scratchpad.dTemp->getCount(),
 	                            scratchpad.dFull->getDeviceReadPtr(),
-	                            scratchpad.dFull->getSizeOf() * scratchpad.dFull->getCount(), &sceneHandle, &emitDesc, 1));
+	                            scratchpad.dFull->getSizeOf() * scratchpad.dFull->getCount(), &sceneHandle,
+	                            isBuild ? &emitDesc : nullptr, isBuild ? 1 : 0));
 
 	CHECK_CUDA(cudaStreamSynchronize(getStream()->getHandle()));
+}
 
-	// scratchpad.doCompaction(sceneHandle);
+void Scene::requestASUpdate(const Entity& entity)
+{
+	if (auto it = instanceSlots.find(&entity); it != instanceSlots.end()) {
+		instanceTracker.markDirty(it->second);
+	} else {
+		instanceTracker.requestRebuild();
+	}
+	cachedAS.reset();
+	cachedHostScene.reset();
+}
 
-	return sceneHandle;
+void Scene::requestASRebuild()
+{
+	instanceTracker.requestRebuild();
+	cachedAS.reset();
+	cachedHostScene.reset();
 }
 
-void Scene::requestASRebuild() { cachedAS.reset(); }
+void Scene::requestSBTRebuild()
+{
+	sbtSlots.markAllDirty();
+	cachedSBT.reset();
+	cachedHostScene.reset();
+}
 
-void Scene::requestSBTRebuild() { cachedSBT.reset(); }
+void Scene::requestSBTUpdate(const Entity& entity)
+{
+	if (auto it = entitySBTSlots.find(&entity); it != entitySBTSlots.end()) {
+		sbtSlots.markDirty(it->second);
+	}
+	cachedSBT.reset();
+	cachedHostScene.reset();
+}
+
+void Scene::requestSBTUpdate(const Mesh& mesh)
+{
+	// Mesh data has changed (e.g. texture coordinates were set)
+	std::erase_if(hostGeometryForStaticMeshes, [&](const auto& meshGeometry) { return meshGeometry.first.get() == &mesh; });
+	std::erase_if(hostGeometryForAnimatedEntities,
+	              [&](const auto& entityGeometry) { return entityGeometry.first->mesh.get() == &mesh; });
+	for (auto&& entity : entities) {
+		if (entity->mesh.get() == &mesh) {
+			requestSBTUpdate(*entity);
+		}
+	}
+}
 
 CudaStream::Ptr Scene::getStream() const { return stream; }
 
@@ -17,10 +17,15 @@
 #include <set>
 #include <mutex>
 #include <string>
+#include <utility>
 #include <optional>
 #include <unordered_map>
+#include <unordered_set>
 #include <scene/ASBuildScratchpad.hpp>
 #include <scene/GASBuilder.hpp>
+#include <scene/InstanceUpdateTracker.hpp>
+#include <scene/SBTSlotAllocator.hpp>
+#include <scene/HostScene.hpp>
 #include <APIObject.hpp>
 
 #include <Time.hpp>
@@ -28,20 +33,21 @@
 #include <memory/Array.hpp>
 
 struct Entity;
+struct Mesh;
+struct Texture;
 
 /**
  * Class responsible for managing objects and meshes, building AS and SBT.
  * Ported from the PoC code which assumed 1:1 mesh:object relationship.
  * Because of that, when some objects share a mesh, SBT records will be duplicated.
- * This will still work, but it causes pointless CPU -> GPU copies.
- * TODO(prybicki): fix it
+ * Each entity owns a stable SBT slot, so only records of changed entities are copied to the GPU.
  *
  * This class may be accessed from different threads:
  * - client's thread doing API calls, modifying scene
  * - graph execution threads, requesting AS and SBT from RaytraceNode
  * As of now, Scene is not thread-safe, i.e. it is meant to be accessed only from the client's thread.
  * Calls that modify the scene waits until all current graph threads finish (done in API calls).
- * The only case when graph thread accesses scene is getAS() and getSBT(), which are locked.
+ * The only cases when graph thread accesses scene are getASAndSBTLocked() and getHostSceneLocked().
  *
  */
 struct Scene
@@ -57,11 +63,7 @@ struct Scene
 	void removeEntity(std::shared_ptr<Entity> entity);
 	void clear();
 
-	void setTime(Time time)
-	{
-		prevTime = this->time;
-		this->time = time;
-	}
+	void setTime(Time time);
 	std::optional<Time> getTime() const { return time; }
 	std::optional<Time> getPrevTime() const { return prevTime; }
 	std::optional<Time> getDeltaTime() const { return prevTime.has_value() ? std::optional(*time - *prevTime) : std::nullopt; }
@@ -70,17 +72,42 @@ struct Scene
 
 	CudaStream::Ptr getStream() const;
 
-	OptixTraversableHandle getASLocked();
-	OptixShaderBindingTable getSBTLocked();
+	/**
+	 * Returns AS and SBT of the current scene (building them if needed), under a single lock.
+	 */
+	std::pair<OptixTraversableHandle, OptixShaderBindingTable> getASAndSBTLocked();
+
+	/**
+	 * Returns host snapshot of the current scene for the host traversal backend (building it if needed), under a lock.
+	 * Geometries of static meshes are cached between snapshots, animated entities get their BVH refitted.
+	 */
+	HostScene::Ptr getHostSceneLocked();
 
 	void requestASRebuild();
 	void requestSBTRebuild();
+	/**
+	 * Requests refreshing SBT record of the given entity (or of all entities using the given mesh).
+	 * Only the changed records are copied to the GPU.
+	 */
+	void requestSBTUpdate(const Entity& entity);
+	void requestSBTUpdate(const Mesh& mesh);
+	/**
+	 * Requests refreshing AS after a change of the entity that does not affect the set of entities (e.g. its transform).
+	 * If possible, only the entity's instance is patched and AS is refitted instead of rebuilt.
+	 */
+	void requestASUpdate(const Entity& entity);
 
 private:
 	Scene();
 
 	OptixShaderBindingTable buildSBT();
 	OptixTraversableHandle buildAS();
+	std::optional<OptixTraversableHandle> refitAS();
+	OptixInstance makeInstance(const std::shared_ptr<Entity>& entity);
+	HitgroupRecord makeHitgroupRecord(const std::shared_ptr<Entity>& entity);
+	void uploadDirtyHitgroupRecords();
+	void runIASBuild(OptixBuildOperation operation);
+	HostScene::Ptr buildHostScene();
 
 	/**
 	 * The method process GASes for all entities to be up-to-date. It performs:
@@ -103,6 +130,36 @@ private:
 
 	// TODO: allow non-heap creation;
 	DeviceSyncArray<OptixInstance>::Ptr dInstances = DeviceSyncArray<OptixInstance>::create();
+	HostPinnedArray<OptixInstance>::Ptr hInstances = HostPinnedArray<OptixInstance>::create();
+
+	// Copying a few clean instances along is cheaper than issuing separate copies
+	static constexpr size_t REFIT_MAX_CLEAN_GAP = 16;
+
+	// State of the last IAS build, allowing to refit it
+	InstanceUpdateTracker instanceTracker;
+	std::vector<std::shared_ptr<Entity>> instanceEntities; // Indexed by instance slot
+	std::unordered_map<const Entity*, size_t> instanceSlots;
+	OptixTraversableHandle sceneHandle{0};
+
+	// Hitgroup records are kept at stable slots, see SBTSlotAllocator
+	static constexpr size_t SBT_MAX_CLEAN_GAP = 4;
+	SBTSlotAllocator sbtSlots;
+	std::vector<std::shared_ptr<Entity>> sbtEntities; // Indexed by SBT slot, nullptr for holes
+	std::unordered_map<const Entity*, size_t> entitySBTSlots;
+	std::unordered_set<size_t> timeDependentSBTSlots; // Records to be refreshed when the scene time changes
+	std::optional<HitgroupRecord> emptyHitgroupRecord; // With header packed once
+	DeviceSyncArray<HitgroupRecord>::Ptr dHitgroupRecords = DeviceSyncArray<HitgroupRecord>::create();
+	HostPinnedArray<HitgroupRecord>::Ptr hHitgroupRecords = HostPinnedArray<HitgroupRecord>::create();
+	DeviceSyncArray<RaygenRecord>::Ptr dRaygenRecords = DeviceSyncArray<RaygenRecord>::create();
+	DeviceSyncArray<MissRecord>::Ptr dMissRecords = DeviceSyncArray<MissRecord>::create();
+
+	// Host snapshot for the host traversal backend, reset whenever AS or SBT would need an update
+	std::mutex hostSceneMutex;
+	HostScene::Ptr cachedHostScene;
+	bool isHostSceneTimeDependent{false}; // Snapshot contains previous frame data, valid only for the current time
+	std::unordered_map<std::shared_ptr<Mesh>, HostGeometry::Ptr> hostGeometryForStaticMeshes;
+	std::unordered_map<std::shared_ptr<Entity>, HostGeometry::Ptr> hostGeometryForAnimatedEntities;
+	std::unordered_map<std::shared_ptr<Texture>, HostTexture::Ptr> hostTextures;
 
 	std::optional<Time> time;
 	std::optional<Time> prevTime;
@@ -63,6 +63,14 @@ void Texture::createTextureObject(const void* texels, int width, int height)
 	CHECK_CUDA(cudaCreateTextureObject(&dTextureObject, &res_desc, &tex_desc, nullptr));
 }
 
+std::vector<TextureTexelFormat> Texture::downloadTexels() const
+{
+	std::vector<TextureTexelFormat> texels(getWidth() * getHeight());
+	const size_t pitch = getWidth() * sizeof(TextureTexelFormat);
+	CHECK_CUDA(cudaMemcpy2DFromArray(texels.data(), pitch, dPixelArray, 0, 0, pitch, getHeight(), cudaMemcpyDeviceToHost));
+	return texels;
+}
+
 Texture::~Texture() { cleanup(); }
 
 void Texture::cleanup()
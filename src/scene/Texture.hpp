@@ -13,7 +13,10 @@
 // limitations under the License.
 #pragma once
 
+#include <vector>
+
 #include <APIObject.hpp>
+#include <RGLFields.hpp>
 #include <math/Vector.hpp>
 #include <rgl/api/core.h>
 
@@ -31,6 +34,11 @@ struct Texture : APIObject<Texture>
 
 	cudaTextureObject_t getTextureObject() const { return dTextureObject; }
 
+	/**
+	 * Copies texels (row-major) back from the device, e.g. to sample the texture on the host.
+	 */
+	std::vector<TextureTexelFormat> downloadTexels() const;
+
 
 private:
 	Texture(const void* texels, int width, int height);
@@ -0,0 +1,177 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include <Logger.hpp>
+#include <tape/AsyncTapeWriter.hpp>
+
+AsyncTapeWriter::AsyncTapeWriter(WriteFn write, size_t maxBufferedBytes, rgl_tape_overflow_policy_t overflowPolicy)
+  : write(std::move(write)),
+    overflowPolicy(overflowPolicy),
+    blockSize(std::clamp<size_t>(maxBufferedBytes / 4, 1, MAX_BLOCK_SIZE)),
+    maxBlockCount(std::max<size_t>(maxBufferedBytes / blockSize, 1)),
+    writerThread(&AsyncTapeWriter::writerLoop, this)
+{}
+
+AsyncTapeWriter::~AsyncTapeWriter()
+{
+	{
+		// Data of a dropped call is aborted by the client, anything else left pending must not be lost
+		std::unique_lock lock{mutex};
+		publishPending(lock);
+		isStopping = true;
+	}
+	blockPublished.notify_one();
+	writerThread.join();
+}
+
+bool AsyncTapeWriter::append(Target target, const void* data, size_t size, bool isDroppable)
+{
+	const auto* bytes = static_cast<const uint8_t*>(data);
+	while (size > 0) {
+		Block* block = pendingBlocks.empty() ? nullptr : pendingBlocks.back().get();
+		if (block == nullptr || block->target != target || block->size == blockSize) {
+			if (!acquireBlock(target, isDroppable)) {
+				return false;
+			}
+			block = pendingBlocks.back().get();
+		}
+		const size_t copySize = std::min(size, blockSize - block->size);
+		std::memcpy(block->data.get() + block->size, bytes, copySize);
+		block->size += copySize;
+		bytes += copySize;
+		size -= copySize;
+	}
+	return true;
+}
+
+bool AsyncTapeWriter::acquireBlock(Target target, bool isDroppable)
+{
+	std::unique_ptr<Block> block;
+	{
+		std::unique_lock lock{mutex};
+		if (freeBlocks.empty() && allocatedBlockCount == maxBlockCount) {
+			if (isDroppable && overflowPolicy == RGL_TAPE_OVERFLOW_DROP) {
+				return false;
+			}
+			// Pending blocks may hold the whole buffer; the writer thread must get them to make progress.
+			publishPending(lock);
+			const auto waitBegin = std::chrono::steady_clock::now();
+			blockReturned.wait(lock, [this] { return !freeBlocks.empty(); });
+			const auto waitTime = std::chrono::steady_clock::now() - waitBegin;
+			stats.blockedTimeNs += std::chrono::duration_cast<std::chrono::nanoseconds>(waitTime).count();
+		}
+		if (!freeBlocks.empty()) {
+			block = std::move(freeBlocks.back());
+			freeBlocks.pop_back();
+		}
+		else {
+			allocatedBlockCount += 1;
+		}
+	}
+	if (block == nullptr) {
+		block = std::make_unique<Block>(Block{.data = std::make_unique<uint8_t[]>(blockSize)});
+	}
+	block->target = target;
+	block->size = 0;
+	pendingBlocks.emplace_back(std::move(block));
+	return true;
+}
+
+void AsyncTapeWriter::commit()
+{
+	if (pendingBlocks.empty()) {
+		return;
+	}
+	std::unique_lock lock{mutex};
+	publishPending(lock);
+}
+
+void AsyncTapeWriter::abort()
+{
+	if (pendingBlocks.empty()) {
+		return;
+	}
+	std::lock_guard lock{mutex};
+	for (auto&& block : pendingBlocks) {
+		freeBlocks.emplace_back(std::move(block));
+	}
+	pendingBlocks.clear();
+}
+
+void AsyncTapeWriter::publishPending(std::unique_lock<std::mutex>& lock)
+{
+	if (pendingBlocks.empty()) {
+		return;
+	}
+	for (auto&& block : pendingBlocks) {
+		stats.bufferedBytes += block->size;
+		publishedBlocks.emplace_back(std::move(block));
+	}
+	pendingBlocks.clear();
+	stats.maxBufferedBytes = std::max(stats.maxBufferedBytes, stats.bufferedBytes);
+	lock.unlock();
+	blockPublished.notify_one();
+	lock.lock();
+}
+
+AsyncTapeWriter::Stats AsyncTapeWriter::getStats() const
+{
+	std::lock_guard lock{mutex};
+	return stats;
+}
+
+void AsyncTapeWriter::writerLoop()
+{
+	std::deque<std::unique_ptr<Block>> blocks;
+	bool hasFailed = false;
+	while (true) {
+		{
+			std::unique_lock lock{mutex};
+			blockPublished.wait(lock, [this] { return !publishedBlocks.empty() || isStopping; });
+			if (publishedBlocks.empty()) {
+				return;
+			}
+			blocks.swap(publishedBlocks);
+		}
+		uint64_t blocksBytes = 0;
+		for (auto&& block : blocks) {
+			blocksBytes += block->size;
+			if (hasFailed) {
+				continue;
+			}
+			try {
+				write(block->target, block->data.get(), block->size);
+			}
+			catch (std::exception& e) {
+				// Writing further data would produce a corrupted tape; the rest of recording is discarded.
+				RGL_ERROR("Asynchronous tape writer failed, the rest of recording is discarded: {}", e.what());
+				hasFailed = true;
+			}
+		}
+		{
+			std::lock_guard lock{mutex};
+			for (auto&& block : blocks) {
+				freeBlocks.emplace_back(std::move(block));
+			}
+			stats.bufferedBytes -= blocksBytes;
+			stats.writtenBytes += hasFailed ? 0 : blocksBytes;
+		}
+		blocks.clear();
+		blockReturned.notify_one();
+	}
+}
@@ -0,0 +1,102 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <rgl/api/extensions/tape.h>
+
+/**
+ * Writes tape files on a dedicated thread, so that recording does not stall API calls with file I/O.
+ * Data is copied into blocks taken from a pool; the total size of blocks is bounded.
+ * When the pool is exhausted, droppable data is rejected under RGL_TAPE_OVERFLOW_DROP policy,
+ * otherwise the client waits until the writer thread returns some blocks (back-pressure).
+ * Appended data is passed to the writer thread on commit() or on destruction,
+ * so the client can abort() data of a dropped call.
+ * Data is written in the order it was appended. Only one client thread is supported.
+ */
+struct AsyncTapeWriter
+{
+	enum class Target : uint8_t
+	{
+		Bin,
+		Calls,
+	};
+	using WriteFn = std::function<void(Target target, const uint8_t* data, size_t size)>;
+
+	static constexpr size_t MAX_BLOCK_SIZE = 256 * 1024;
+
+	struct Stats
+	{
+		uint64_t bufferedBytes{0};
+		uint64_t maxBufferedBytes{0};
+		uint64_t writtenBytes{0};
+		uint64_t blockedTimeNs{0};
+	};
+
+	AsyncTapeWriter(WriteFn write, size_t maxBufferedBytes, rgl_tape_overflow_policy_t overflowPolicy);
+	~AsyncTapeWriter(); // Writes all appended data, including data not committed yet
+
+	AsyncTapeWriter(const AsyncTapeWriter&) = delete;
+	AsyncTapeWriter& operator=(const AsyncTapeWriter&) = delete;
+
+	/**
+	 * Returns false if droppable data does not fit in the buffer under RGL_TAPE_OVERFLOW_DROP policy.
+	 * In such case, data appended since the last commit() should be aborted.
+	 */
+	bool append(Target target, const void* data, size_t size, bool isDroppable);
+	void commit();
+	void abort();
+
+	Stats getStats() const;
+
+private:
+	struct Block
+	{
+		Target target;
+		size_t size;
+		std::unique_ptr<uint8_t[]> data;
+	};
+
+	bool acquireBlock(Target target, bool isDroppable);
+	void publishPending(std::unique_lock<std::mutex>& lock);
+	void writerLoop();
+
+	WriteFn write;
+	rgl_tape_overflow_policy_t overflowPolicy;
+	size_t blockSize;
+	size_t maxBlockCount;
+
+	// Accessed only by the client thread
+	std::deque<std::unique_ptr<Block>> pendingBlocks;
+
+	mutable std::mutex mutex;
+	std::condition_variable blockReturned;
+	std::condition_variable blockPublished;
+	std::vector<std::unique_ptr<Block>> freeBlocks;
+	std::deque<std::unique_ptr<Block>> publishedBlocks;
+	size_t allocatedBlockCount{0};
+	bool isStopping{false};
+	Stats stats;
+
+	std::thread writerThread;
+};
@@ -0,0 +1,94 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bit>
+#include <cstring>
+
+#include <tape/BlobHash.hpp>
+
+static constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+static constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+static constexpr uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+static constexpr uint64_t PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+template<typename T>
+static T read(const uint8_t* ptr)
+{
+	T value;
+	std::memcpy(&value, ptr, sizeof(T)); // Unaligned read, assumes little-endian
+	return value;
+}
+
+static uint64_t hashRound(uint64_t acc, uint64_t input)
+{
+	acc += input * PRIME_2;
+	acc = std::rotl(acc, 31);
+	return acc * PRIME_1;
+}
+
+static uint64_t mergeRound(uint64_t acc, uint64_t value)
+{
+	acc ^= hashRound(0, value);
+	return acc * PRIME_1 + PRIME_4;
+}
+
+uint64_t hashBlob(const void* data, size_t size, uint64_t seed)
+{
+	const auto* ptr = static_cast<const uint8_t*>(data);
+	const uint8_t* const end = ptr + size;
+	uint64_t hash;
+
+	if (size >= 32) {
+		uint64_t v1 = seed + PRIME_1 + PRIME_2;
+		uint64_t v2 = seed + PRIME_2;
+		uint64_t v3 = seed;
+		uint64_t v4 = seed - PRIME_1;
+		for (const uint8_t* limit = end - 32; ptr <= limit; ptr += 32) {
+			v1 = hashRound(v1, read<uint64_t>(ptr));
+			v2 = hashRound(v2, read<uint64_t>(ptr + 8));
+			v3 = hashRound(v3, read<uint64_t>(ptr + 16));
+			v4 = hashRound(v4, read<uint64_t>(ptr + 24));
+		}
+		hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+		hash = mergeRound(hash, v1);
+		hash = mergeRound(hash, v2);
+		hash = mergeRound(hash, v3);
+		hash = mergeRound(hash, v4);
+	} else {
+		hash = seed + PRIME_5;
+	}
+	hash += static_cast<uint64_t>(size);
+
+	for (; ptr + 8 <= end; ptr += 8) {
+		hash ^= hashRound(0, read<uint64_t>(ptr));
+		hash = std::rotl(hash, 27) * PRIME_1 + PRIME_4;
+	}
+	if (ptr + 4 <= end) {
+		hash ^= static_cast<uint64_t>(read<uint32_t>(ptr)) * PRIME_1;
+		hash = std::rotl(hash, 23) * PRIME_2 + PRIME_3;
+		ptr += 4;
+	}
+	for (; ptr < end; ++ptr) {
+		hash ^= static_cast<uint64_t>(*ptr) * PRIME_5;
+		hash = std::rotl(hash, 11) * PRIME_1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= PRIME_2;
+	hash ^= hash >> 29;
+	hash *= PRIME_3;
+	hash ^= hash >> 32;
+	return hash;
+}
@@ -13,10 +13,12 @@
 // limitations under the License.
 
 #pragma once
-#include <cuda.h>
-#include <curand_kernel.h>
 
-#include <math/Vector.hpp>
+#include <cstddef>
+#include <cstdint>
 
-void gpuSetupRandomNumberGenerator(cudaStream_t stream, size_t elementsCount, unsigned int seed,
-                                   curandStatePhilox4_32_10_t* outPHILOXStates);
+/**
+ * 64-bit non-cryptographic hash of a byte range (XXH64 algorithm).
+ * Used to detect binary data that has already been recorded on a tape.
+ */
+uint64_t hashBlob(const void* data, size_t size, uint64_t seed = 0);
@@ -14,9 +14,13 @@
 
 #pragma once
 
+#include <list>
+#include <vector>
+
 #include <yaml-cpp/yaml.h>
 
 #include <Logger.hpp>
+#include <tape/MappedFile.hpp>
 
 // Type used as a key in TapePlayer object registry
 using TapeAPIObjectID = size_t;
@@ -35,27 +39,25 @@ struct PlaybackState
 			static_assert(std::is_trivially_copyable_v<T>);
 			sizeOfType = sizeof(T);
 		}
-		if (fileMmap == nullptr) {
+		if (binFile.getData() == nullptr) {
 			throw std::runtime_error("Trying to get tape binary data but it is empty");
 		}
 		auto offset = offsetYamlNode.as<size_t>();
-		if (offset + sizeOfType > mmapSize) {
+		if (offset + sizeOfType > binFile.getSize()) {
 			throw std::runtime_error(fmt::format("Tape binary offset with size of requested type ({}+{}) out of range ({})",
-			                                     offset, sizeOfType, mmapSize));
+			                                     offset, sizeOfType, binFile.getSize()));
 		}
-		return reinterpret_cast<T*>(fileMmap + offset);
+		return reinterpret_cast<T*>(binFile.getData() + offset);
 	}
 
-	~PlaybackState();
-
 	std::unordered_map<TapeAPIObjectID, rgl_mesh_t> meshes;
 	std::unordered_map<TapeAPIObjectID, rgl_entity_t> entities;
 	std::unordered_map<TapeAPIObjectID, rgl_texture_t> textures;
 	std::unordered_map<TapeAPIObjectID, rgl_node_t> nodes;
 
-private:
-	uint8_t* fileMmap{nullptr};
-	size_t mmapSize{0};
+	// Stand-ins for client's result buffers. Never released, because nodes may still refer to them after clear().
+	std::list<std::vector<char>> resultBuffers;
 
-	void mmapInit(const char* path);
+private:
+	MappedFile binFile;
 };
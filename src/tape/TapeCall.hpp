@@ -14,27 +14,44 @@
 
 #pragma once
 
+#include <chrono>
+
 #include <yaml-cpp/yaml.h>
 #include "Time.hpp"
 
 /**
- * Proxy structure for reading TapeCall fields.
- * Expects a node of the following format:
+ * Single call read from the tape: function name, timestamp and arguments.
+ * Arguments are exposed as a YAML sequence, regardless of the format the tape is stored in.
+ * Can be created from a node of the YAML format:
  * fnName: {t: <int64_t>, a: [<arg0>, <arg1>, ...]}
  */
 struct TapeCall
 {
-	std::string getFnName() const { return node.begin()->first.as<std::string>(); }
-	Time getTimestamp() const { return Time::nanoseconds(node.begin()->second["t"].as<std::chrono::nanoseconds::rep>()); }
-	YAML::Node getArgsNode() const { return node.begin()->second["a"]; }
+	std::string getFnName() const { return fnName; }
+	Time getTimestamp() const { return timestamp; }
+	YAML::Node getArgsNode() const { return argsNode; }
+
+	explicit TapeCall(const YAML::Node& node)
+	  : fnName(validateNode(node).begin()->first.as<std::string>()),
+	    timestamp(Time::nanoseconds(node.begin()->second["t"].as<std::chrono::nanoseconds::rep>())),
+	    argsNode(node.begin()->second["a"])
+	{}
+
+	TapeCall(std::string fnName, Time timestamp, YAML::Node argsNode)
+	  : fnName(std::move(fnName)), timestamp(timestamp), argsNode(std::move(argsNode))
+	{}
 
-	explicit TapeCall(const YAML::Node& node) : node(node)
+private: // METHODS
+	static const YAML::Node& validateNode(const YAML::Node& node)
 	{
 		if (!node.IsMap()) {
 			throw std::invalid_argument("TapeCall node is not a map");
 		}
+		return node;
 	}
 
 private: // FIELDS
-	YAML::Node node;
+	std::string fnName;
+	Time timestamp;
+	YAML::Node argsNode;
 };
@@ -0,0 +1,264 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cassert>
+#include <cstring>
+
+#include <tape/TapeCallStream.hpp>
+#include <RGLExceptions.hpp>
+#include <Logger.hpp>
+
+void TapeCallWriter::beginCall(std::string_view fnName, int64_t timestampNs)
+{
+	assert(!currentCallOffset.has_value());
+	if (chunk.empty()) {
+		chunk.resize(sizeof(TapeCallStream::ChunkHeader));
+		chunkBeginTimestampNs = timestampNs;
+	}
+	const uint16_t fnId = getFnId(fnName);
+	currentCallOffset = chunk.size();
+	currentArgCount = 0;
+	TapeCallStream::RecordHeader header{.fnId = fnId, .argCount = 0, .argsSize = 0, .timestampNs = timestampNs};
+	append(&header, sizeof(header));
+}
+
+void TapeCallWriter::endCall()
+{
+	assert(currentCallOffset.has_value());
+	TapeCallStream::RecordHeader header{};
+	std::memcpy(&header, chunk.data() + currentCallOffset.value(), sizeof(header));
+	const size_t argsSize = chunk.size() - currentCallOffset.value() - sizeof(header);
+	if (argsSize > UINT32_MAX) {
+		throw RecordError(fmt::format("Arguments of the recorded call are too large ({} bytes)", argsSize));
+	}
+	header.argCount = currentArgCount;
+	header.argsSize = static_cast<uint32_t>(argsSize);
+	std::memcpy(chunk.data() + currentCallOffset.value(), &header, sizeof(header));
+	currentCallOffset.reset();
+	++chunkRecordCount;
+
+	if (chunk.size() >= CHUNK_FLUSH_SIZE || header.timestampNs - chunkBeginTimestampNs.value() >= CHUNK_FLUSH_INTERVAL_NS) {
+		flush();
+	}
+}
+
+void TapeCallWriter::cancelCall()
+{
+	assert(currentCallOffset.has_value());
+	// Function definition written by beginCall() is kept, as the function id remains assigned
+	chunk.resize(currentCallOffset.value());
+	currentCallOffset.reset();
+}
+
+void TapeCallWriter::addArg(std::string_view value)
+{
+	if (value.size() > UINT32_MAX) {
+		throw RecordError(fmt::format("String argument of the recorded call is too long ({} bytes)", value.size()));
+	}
+	appendArg(TapeCallStream::ArgType::String, static_cast<uint32_t>(value.size()));
+	append(value.data(), value.size());
+}
+
+void TapeCallWriter::flush()
+{
+	assert(!currentCallOffset.has_value());
+	if (!isFileHeaderWritten) {
+		TapeCallStream::FileHeader fileHeader{.formatVersion = TapeCallStream::FORMAT_VERSION, .reserved = 0};
+		std::memcpy(fileHeader.magic, TapeCallStream::MAGIC, sizeof(fileHeader.magic));
+		sink(reinterpret_cast<const uint8_t*>(&fileHeader), sizeof(fileHeader));
+		isFileHeaderWritten = true;
+	}
+	if (chunkRecordCount == 0) {
+		return;
+	}
+	TapeCallStream::ChunkHeader chunkHeader{.magic = TapeCallStream::CHUNK_MAGIC,
+	                                        .payloadSize = static_cast<uint32_t>(chunk.size() - sizeof(chunkHeader)),
+	                                        .recordCount = chunkRecordCount};
+	std::memcpy(chunk.data(), &chunkHeader, sizeof(chunkHeader));
+	sink(chunk.data(), chunk.size());
+	chunk.clear();
+	chunkRecordCount = 0;
+	chunkBeginTimestampNs.reset();
+}
+
+uint16_t TapeCallWriter::getFnId(std::string_view fnName)
+{
+	if (auto it = fnIds.find(fnName); it != fnIds.end()) {
+		return it->second;
+	}
+	if (fnIds.size() >= TapeCallStream::FN_DEFINITION_ID) {
+		throw RecordError("Too many distinct functions recorded in the tape");
+	}
+	const auto fnId = static_cast<uint16_t>(fnIds.size());
+	fnIds.emplace(fnName, fnId);
+
+	// Definition record is placed in the same chunk as the first use, so it cannot be lost alone
+	TapeCallStream::RecordHeader header{.fnId = TapeCallStream::FN_DEFINITION_ID,
+	                                    .argCount = 0,
+	                                    .argsSize = static_cast<uint32_t>(sizeof(fnId) + fnName.size()),
+	                                    .timestampNs = 0};
+	append(&header, sizeof(header));
+	append(&fnId, sizeof(fnId));
+	append(fnName.data(), fnName.size());
+	++chunkRecordCount;
+	return fnId;
+}
+
+void TapeCallWriter::append(const void* data, size_t size)
+{
+	const auto* bytes = static_cast<const uint8_t*>(data);
+	chunk.insert(chunk.end(), bytes, bytes + size);
+}
+
+template<typename T>
+static void readValue(std::span<const uint8_t>& data, T& value)
+{
+	if (data.size() < sizeof(T)) {
+		throw RecordError("Invalid Tape: Corrupted call stream record");
+	}
+	std::memcpy(&value, data.data(), sizeof(T));
+	data = data.subspan(sizeof(T));
+}
+
+TapeCallReader::TapeCallReader(std::span<const uint8_t> data)
+{
+	TapeCallStream::FileHeader fileHeader{};
+	if (data.size() < sizeof(fileHeader)) {
+		throw RecordError("Invalid Tape: Missing call stream header");
+	}
+	readValue(data, fileHeader);
+	if (std::memcmp(fileHeader.magic, TapeCallStream::MAGIC, sizeof(fileHeader.magic)) != 0) {
+		throw RecordError("Invalid Tape: Unknown call stream format");
+	}
+	if (fileHeader.formatVersion != TapeCallStream::FORMAT_VERSION) {
+		throw RecordError(fmt::format("Unsupported Tape format: Call stream version {} (supported: {})",
+		                              fileHeader.formatVersion, TapeCallStream::FORMAT_VERSION));
+	}
+
+	while (!data.empty()) {
+		TapeCallStream::ChunkHeader chunkHeader{};
+		if (data.size() < sizeof(chunkHeader)) {
+			break;
+		}
+		std::memcpy(&chunkHeader, data.data(), sizeof(chunkHeader));
+		if (chunkHeader.magic != TapeCallStream::CHUNK_MAGIC) {
+			throw RecordError("Invalid Tape: Corrupted call stream chunk");
+		}
+		if (chunkHeader.payloadSize > data.size() - sizeof(chunkHeader)) {
+			break;
+		}
+		indexChunk(data.subspan(sizeof(chunkHeader), chunkHeader.payloadSize), chunkHeader.recordCount);
+		data = data.subspan(sizeof(chunkHeader) + chunkHeader.payloadSize);
+	}
+	if (!data.empty()) {
+		RGL_WARN("TAPE: skipping incomplete chunk at the end of the call stream ({} bytes), the recording was interrupted",
+		         data.size());
+	}
+}
+
+void TapeCallReader::indexChunk(std::span<const uint8_t> payload, uint32_t recordCount)
+{
+	for (uint32_t i = 0; i < recordCount; ++i) {
+		TapeCallStream::RecordHeader header{};
+		readValue(payload, header);
+		if (header.argsSize > payload.size()) {
+			throw RecordError("Invalid Tape: Corrupted call stream record");
+		}
+		auto args = payload.first(header.argsSize);
+		payload = payload.subspan(header.argsSize);
+
+		if (header.fnId == TapeCallStream::FN_DEFINITION_ID) {
+			uint16_t definedFnId = 0;
+			readValue(args, definedFnId);
+			if (definedFnId >= fnNames.size()) {
+				fnNames.resize(definedFnId + 1);
+			}
+			fnNames[definedFnId].assign(reinterpret_cast<const char*>(args.data()), args.size());
+			continue;
+		}
+		if (header.fnId >= fnNames.size() || fnNames[header.fnId].empty()) {
+			throw RecordError(fmt::format("Invalid Tape: Call of undefined function (id {})", header.fnId));
+		}
+		calls.push_back({.fnId = header.fnId,
+		                 .argCount = header.argCount,
+		                 .argsSize = header.argsSize,
+		                 .timestampNs = header.timestampNs,
+		                 .args = args.data()});
+	}
+	if (!payload.empty()) {
+		throw RecordError("Invalid Tape: Corrupted call stream chunk");
+	}
+}
+
+TapeCall TapeCallReader::getTapeCall(size_t idx) const
+{
+	const auto& call = calls.at(idx);
+	return TapeCall(fnNames[call.fnId], Time::nanoseconds(call.timestampNs), decodeArgs(call));
+}
+
+YAML::Node TapeCallReader::decodeArgs(const CallEntry& call) const
+{
+	YAML::Node args{YAML::NodeType::Sequence};
+	std::span<const uint8_t> data{call.args, call.argsSize};
+	for (int i = 0; i < call.argCount; ++i) {
+		TapeCallStream::ArgType type{};
+		readValue(data, type);
+		switch (type) {
+			case TapeCallStream::ArgType::Int64: {
+				int64_t value = 0;
+				readValue(data, value);
+				args.push_back(value);
+				break;
+			}
+			case TapeCallStream::ArgType::UInt64: {
+				uint64_t value = 0;
+				readValue(data, value);
+				args.push_back(value);
+				break;
+			}
+			case TapeCallStream::ArgType::Float: {
+				float value = 0.0f;
+				readValue(data, value);
+				args.push_back(value);
+				break;
+			}
+			case TapeCallStream::ArgType::Double: {
+				double value = 0.0;
+				readValue(data, value);
+				args.push_back(value);
+				break;
+			}
+			case TapeCallStream::ArgType::Bool: {
+				uint8_t value = 0;
+				readValue(data, value);
+				args.push_back(value != 0);
+				break;
+			}
+			case TapeCallStream::ArgType::String: {
+				uint32_t length = 0;
+				readValue(data, length);
+				if (length > data.size()) {
+					throw RecordError("Invalid Tape: Corrupted call stream record");
+				}
+				args.push_back(std::string(reinterpret_cast<const char*>(data.data()), length));
+				data = data.subspan(length);
+				break;
+			}
+			default:
+				throw RecordError(fmt::format("Invalid Tape: Unknown argument type ({}) in call of {}",
+				                              static_cast<int>(type), fnNames[call.fnId]));
+		}
+	}
+	return args;
+}
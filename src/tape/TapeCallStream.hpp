@@ -0,0 +1,177 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <tape/TapeCall.hpp>
+
+/**
+ * Binary, append-only stream of recorded API calls. Layout (native endianness, no alignment):
+ * - FileHeader,
+ * - chunks, each being a ChunkHeader followed by payloadSize bytes of records,
+ * - record: RecordHeader followed by argsSize bytes of arguments,
+ * - argument: ArgType (1 byte) followed by its value; strings are prefixed with uint32_t length.
+ * Function names are not repeated in every record - a definition record (fnId == FN_DEFINITION_ID, args being
+ * uint16_t id followed by the name) precedes the first use of every name.
+ * Arrays are not part of the stream - they are written to the binary file and records keep offsets into it.
+ * Chunks are written as a whole, so a crash may only leave the last chunk incomplete, which is skipped by the reader.
+ */
+struct TapeCallStream
+{
+	static constexpr char MAGIC[8] = {'R', 'G', 'L', 'C', 'A', 'L', 'L', 'S'};
+	static constexpr uint32_t FORMAT_VERSION = 1;
+	static constexpr uint32_t CHUNK_MAGIC = 0x4b4e4843; // "CHNK"
+	static constexpr uint16_t FN_DEFINITION_ID = UINT16_MAX;
+
+	enum class ArgType : uint8_t
+	{
+		Int64 = 0,
+		UInt64 = 1,
+		Float = 2,
+		Double = 3,
+		Bool = 4,
+		String = 5,
+	};
+
+	struct FileHeader
+	{
+		char magic[8];
+		uint32_t formatVersion;
+		uint32_t reserved;
+	};
+
+	struct ChunkHeader
+	{
+		uint32_t magic;
+		uint32_t payloadSize;
+		uint32_t recordCount;
+	};
+
+	struct RecordHeader
+	{
+		uint16_t fnId;
+		uint16_t argCount;
+		uint32_t argsSize;
+		int64_t timestampNs;
+	};
+
+	static_assert(sizeof(FileHeader) == 16);
+	static_assert(sizeof(ChunkHeader) == 12);
+	static_assert(sizeof(RecordHeader) == 16);
+};
+
+/**
+ * Encodes API calls into the binary call stream. Records are gathered in a chunk, which is passed to the sink
+ * when it grows too large or spans too long time, so the recording reaches the disk incrementally.
+ * The file header is passed to the sink with the first chunk.
+ */
+struct TapeCallWriter
+{
+	using ChunkSink = std::function<void(const uint8_t* data, size_t size)>;
+
+	static constexpr size_t CHUNK_FLUSH_SIZE = 64 * 1024;
+	static constexpr int64_t CHUNK_FLUSH_INTERVAL_NS = 1'000'000'000;
+
+	explicit TapeCallWriter(ChunkSink sink) : sink(std::move(sink)) {}
+
+	void beginCall(std::string_view fnName, int64_t timestampNs);
+	void endCall();
+	void cancelCall(); // Discards the call being written
+
+	template<typename T>
+	std::enable_if_t<std::is_integral_v<T>> addArg(T value)
+	{
+		if constexpr (std::is_same_v<T, bool>) {
+			appendArg(TapeCallStream::ArgType::Bool, static_cast<uint8_t>(value));
+		} else if constexpr (std::is_signed_v<T>) {
+			appendArg(TapeCallStream::ArgType::Int64, static_cast<int64_t>(value));
+		} else {
+			appendArg(TapeCallStream::ArgType::UInt64, static_cast<uint64_t>(value));
+		}
+	}
+	void addArg(float value) { appendArg(TapeCallStream::ArgType::Float, value); }
+	void addArg(double value) { appendArg(TapeCallStream::ArgType::Double, value); }
+	void addArg(const void* value) { addArg(reinterpret_cast<uintptr_t>(value)); }
+	void addArg(const char* value) { addArg(std::string_view(value != nullptr ? value : "")); }
+	void addArg(std::string_view value);
+
+	/**
+	 * Passes all complete records to the sink. Must not be called between beginCall() and endCall().
+	 */
+	void flush();
+
+private:
+	uint16_t getFnId(std::string_view fnName);
+	void append(const void* data, size_t size);
+
+	template<typename T>
+	void appendArg(TapeCallStream::ArgType type, T value)
+	{
+		append(&type, sizeof(type));
+		append(&value, sizeof(value));
+		++currentArgCount;
+	}
+
+	ChunkSink sink;
+	bool isFileHeaderWritten{false};
+	std::map<std::string, uint16_t, std::less<>> fnIds;
+
+	std::vector<uint8_t> chunk; // Starts with space for ChunkHeader
+	uint32_t chunkRecordCount{0};
+	std::optional<int64_t> chunkBeginTimestampNs;
+
+	std::optional<size_t> currentCallOffset; // Offset of RecordHeader of the call being written
+	uint16_t currentArgCount{0};
+};
+
+/**
+ * Indexes calls in the binary call stream (e.g. memory-mapped file) without decoding their arguments.
+ * Arguments are decoded to YAML nodes only when a call is requested, so tape functions work with both formats.
+ * The data must outlive the reader.
+ */
+struct TapeCallReader
+{
+	explicit TapeCallReader(std::span<const uint8_t> data);
+
+	size_t getCallCount() const { return calls.size(); }
+	std::string_view getFnName(size_t idx) const { return fnNames.at(calls.at(idx).fnId); }
+	int64_t getTimestampNs(size_t idx) const { return calls.at(idx).timestampNs; }
+	TapeCall getTapeCall(size_t idx) const;
+
+private:
+	struct CallEntry
+	{
+		uint16_t fnId;
+		uint16_t argCount;
+		uint32_t argsSize;
+		int64_t timestampNs;
+		const uint8_t* args;
+	};
+
+	void indexChunk(std::span<const uint8_t> payload, uint32_t recordCount);
+	YAML::Node decodeArgs(const CallEntry& call) const;
+
+	std::vector<std::string> fnNames; // Indexed by function id
+	std::vector<CallEntry> calls;
+};
@@ -0,0 +1,119 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <charconv>
+#include <fstream>
+
+#include <tape/TapeConverter.hpp>
+#include <tape/MappedFile.hpp>
+#include <tape/tapeDefinitions.hpp>
+#include <RGLExceptions.hpp>
+
+namespace fs = std::filesystem;
+
+template<typename T>
+static bool parseWhole(const std::string& text, T& value)
+{
+	const auto* end = text.data() + text.size();
+	auto [ptr, ec] = std::from_chars(text.data(), end, value);
+	return ec == std::errc{} && ptr == end;
+}
+
+static void addYamlArg(const YAML::Node& arg, TapeCallWriter& writer)
+{
+	if (!arg.IsScalar()) {
+		throw RecordError("Unsupported Tape format: Call argument is not a scalar");
+	}
+	const auto& text = arg.Scalar();
+	int64_t signedValue = 0;
+	uint64_t unsignedValue = 0;
+	if (parseWhole(text, signedValue)) {
+		writer.addArg(signedValue);
+	} else if (parseWhole(text, unsignedValue)) {
+		writer.addArg(unsignedValue);
+	} else if (text == "true" || text == "false") {
+		writer.addArg(text == "true");
+	} else {
+		writer.addArg(std::string_view(text));
+	}
+}
+
+void TapeConverter::yamlToCalls(const YAML::Node& yamlRoot, TapeCallWriter& writer)
+{
+	for (const auto& yamlCall : yamlRoot) {
+		const TapeCall call{yamlCall};
+		writer.beginCall(call.getFnName(), static_cast<int64_t>(call.getTimestamp().asNanoseconds()));
+		for (const auto& arg : call.getArgsNode()) {
+			addYamlArg(arg, writer);
+		}
+		writer.endCall();
+	}
+	writer.flush();
+}
+
+void TapeConverter::callsToYaml(const TapeCallReader& reader, YAML::Emitter& emitter)
+{
+	emitter << YAML::BeginSeq;
+	for (size_t idx = 0; idx < reader.getCallCount(); ++idx) {
+		const auto call = reader.getTapeCall(idx);
+		// clang-format off
+		emitter << YAML::BeginMap << YAML::Key << call.getFnName() << YAML::Flow
+		            << YAML::BeginMap
+		                << YAML::Key << "t" << YAML::Value << call.getTimestamp().asNanoseconds()
+		                << YAML::Key << "a" << YAML::Value << call.getArgsNode()
+		            << YAML::EndMap
+		        << YAML::EndMap;
+		// clang-format on
+	}
+	emitter << YAML::EndSeq;
+}
+
+void TapeConverter::convertYamlTapeToCalls(const fs::path& tapePath)
+{
+	const auto yamlPath = fs::path(tapePath).concat(YAML_EXTENSION).string();
+	const auto callsPath = fs::path(tapePath).concat(CALLS_EXTENSION).string();
+
+	const auto yamlRoot = YAML::LoadFile(yamlPath);
+	std::ofstream callsFile(callsPath, std::ios::binary);
+	if (callsFile.fail()) {
+		throw InvalidFilePath(fmt::format("TAPE: could not open call stream file '{}' due to the error: {}", callsPath,
+		                                  std::strerror(errno)));
+	}
+	TapeCallWriter writer([&](const uint8_t* data, size_t size) {
+		callsFile.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+	});
+	yamlToCalls(yamlRoot, writer);
+	callsFile.close();
+	if (callsFile.fail()) {
+		throw RecordError(fmt::format("TAPE: failed to write call stream file '{}'", callsPath));
+	}
+}
+
+void TapeConverter::convertCallsTapeToYaml(const fs::path& tapePath)
+{
+	const auto callsPath = fs::path(tapePath).concat(CALLS_EXTENSION).string();
+	const auto yamlPath = fs::path(tapePath).concat(YAML_EXTENSION).string();
+
+	const MappedFile callsFile(callsPath.c_str());
+	const TapeCallReader reader({callsFile.getData(), callsFile.getSize()});
+	YAML::Emitter emitter;
+	callsToYaml(reader, emitter);
+
+	std::ofstream yamlFile(yamlPath);
+	yamlFile << emitter.c_str();
+	yamlFile.close();
+	if (yamlFile.fail()) {
+		throw RecordError(fmt::format("TAPE: failed to write yaml file '{}'", yamlPath));
+	}
+}
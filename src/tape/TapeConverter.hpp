@@ -0,0 +1,40 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <filesystem>
+
+#include <yaml-cpp/yaml.h>
+
+#include <tape/TapeCallStream.hpp>
+
+/**
+ * Converts calls between the YAML log (tape format used before the binary call stream) and the binary call stream.
+ * Binary data (.bin) is the same for both formats, only calls are converted.
+ */
+struct TapeConverter
+{
+	/**
+	 * Integer and boolean arguments are stored as such, remaining ones as strings, exactly as they were written in YAML.
+	 */
+	static void yamlToCalls(const YAML::Node& yamlRoot, TapeCallWriter& writer);
+	static void callsToYaml(const TapeCallReader& reader, YAML::Emitter& emitter);
+
+	/**
+	 * Expect a path to the tape without suffix. Existing output file is overwritten.
+	 */
+	static void convertYamlTapeToCalls(const std::filesystem::path& tapePath);
+	static void convertCallsTapeToYaml(const std::filesystem::path& tapePath);
+};
@@ -43,10 +43,18 @@ class TapeCore
 	static void tape_graph_destroy(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_graph_get_result_size(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_graph_get_result_data(const YAML::Node& yamlNode, PlaybackState& state);
+	static void tape_graph_set_result_buffer(const YAML::Node& yamlNode, PlaybackState& state);
+	static void tape_graph_query_result_buffer(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_graph_node_add_child(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_graph_node_remove_child(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_graph_node_set_priority(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_graph_node_get_priority(const YAML::Node& yamlNode, PlaybackState& state);
+	static void tape_graph_set_concurrent_branches(const YAML::Node& yamlNode, PlaybackState& state);
+	static void tape_graph_set_wait_strategy(const YAML::Node& yamlNode, PlaybackState& state);
+	static void tape_graph_get_latency(const YAML::Node& yamlNode, PlaybackState& state);
+	static void tape_graph_set_profiling(const YAML::Node& yamlNode, PlaybackState& state);
+	static void tape_graph_get_node_stats(const YAML::Node& yamlNode, PlaybackState& state);
+	static void tape_graph_write_profile(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_node_rays_from_mat3x4f(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_node_rays_set_range(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_node_rays_set_ring_ids(const YAML::Node& yamlNode, PlaybackState& state);
@@ -61,11 +69,14 @@ class TapeCore
 	static void tape_node_raytrace_configure_beam_divergence(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_node_raytrace_configure_default_intensity(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_node_raytrace_configure_return_mode(const YAML::Node& yamlNode, PlaybackState& state);
+	static void tape_node_raytrace_configure_batch(const YAML::Node& yamlNode, PlaybackState& state);
+	static void tape_node_raytrace_configure_backend(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_node_points_format(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_node_points_yield(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_node_points_compact_by_field(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_node_points_spatial_merge(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_node_points_temporal_merge(const YAML::Node& yamlNode, PlaybackState& state);
+	static void tape_node_points_temporal_merge_configure_window(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_node_points_from_array(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_node_points_filter_ground(const YAML::Node& yamlNode, PlaybackState& state);
 	static void tape_node_points_radar_postprocess(const YAML::Node& yamlNode, PlaybackState& state);
@@ -103,10 +114,18 @@ class TapeCore
 		    TAPE_CALL_MAPPING("rgl_graph_destroy", TapeCore::tape_graph_destroy),
 		    TAPE_CALL_MAPPING("rgl_graph_get_result_size", TapeCore::tape_graph_get_result_size),
 		    TAPE_CALL_MAPPING("rgl_graph_get_result_data", TapeCore::tape_graph_get_result_data),
+		    TAPE_CALL_MAPPING("rgl_graph_set_result_buffer", TapeCore::tape_graph_set_result_buffer),
+		    TAPE_CALL_MAPPING("rgl_graph_query_result_buffer", TapeCore::tape_graph_query_result_buffer),
 		    TAPE_CALL_MAPPING("rgl_graph_node_add_child", TapeCore::tape_graph_node_add_child),
 		    TAPE_CALL_MAPPING("rgl_graph_node_remove_child", TapeCore::tape_graph_node_remove_child),
 		    TAPE_CALL_MAPPING("rgl_graph_node_set_priority", TapeCore::tape_graph_node_set_priority),
 		    TAPE_CALL_MAPPING("rgl_graph_node_get_priority", TapeCore::tape_graph_node_get_priority),
+		    TAPE_CALL_MAPPING("rgl_graph_set_concurrent_branches", TapeCore::tape_graph_set_concurrent_branches),
+		    TAPE_CALL_MAPPING("rgl_graph_set_wait_strategy", TapeCore::tape_graph_set_wait_strategy),
+		    TAPE_CALL_MAPPING("rgl_graph_get_latency", TapeCore::tape_graph_get_latency),
+		    TAPE_CALL_MAPPING("rgl_graph_set_profiling", TapeCore::tape_graph_set_profiling),
+		    TAPE_CALL_MAPPING("rgl_graph_get_node_stats", TapeCore::tape_graph_get_node_stats),
+		    TAPE_CALL_MAPPING("rgl_graph_write_profile", TapeCore::tape_graph_write_profile),
 		    TAPE_CALL_MAPPING("rgl_node_rays_from_mat3x4f", TapeCore::tape_node_rays_from_mat3x4f),
 		    TAPE_CALL_MAPPING("rgl_node_rays_set_range", TapeCore::tape_node_rays_set_range),
 		    TAPE_CALL_MAPPING("rgl_node_rays_set_ring_ids", TapeCore::tape_node_rays_set_ring_ids),
@@ -124,11 +143,15 @@ class TapeCore
 		                      TapeCore::tape_node_raytrace_configure_default_intensity),
 		    TAPE_CALL_MAPPING("rgl_node_raytrace_configure_return_mode",
 		                      TapeCore::tape_node_raytrace_configure_return_mode),
+		    TAPE_CALL_MAPPING("rgl_node_raytrace_configure_batch", TapeCore::tape_node_raytrace_configure_batch),
+		    TAPE_CALL_MAPPING("rgl_node_raytrace_configure_backend", TapeCore::tape_node_raytrace_configure_backend),
 		    TAPE_CALL_MAPPING("rgl_node_points_format", TapeCore::tape_node_points_format),
 		    TAPE_CALL_MAPPING("rgl_node_points_yield", TapeCore::tape_node_points_yield),
 		    TAPE_CALL_MAPPING("rgl_node_points_compact_by_field", TapeCore::tape_node_points_compact_by_field),
 		    TAPE_CALL_MAPPING("rgl_node_points_spatial_merge", TapeCore::tape_node_points_spatial_merge),
 		    TAPE_CALL_MAPPING("rgl_node_points_temporal_merge", TapeCore::tape_node_points_temporal_merge),
+		    TAPE_CALL_MAPPING("rgl_node_points_temporal_merge_configure_window",
+		                      TapeCore::tape_node_points_temporal_merge_configure_window),
 		    TAPE_CALL_MAPPING("rgl_node_points_from_array", TapeCore::tape_node_points_from_array),
 		    TAPE_CALL_MAPPING("rgl_node_points_filter_ground", TapeCore::tape_node_points_filter_ground),
 		    TAPE_CALL_MAPPING("rgl_node_points_radar_postprocess", TapeCore::tape_node_points_radar_postprocess),
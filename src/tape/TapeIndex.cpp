@@ -0,0 +1,338 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+
+#include <tape/PlaybackState.hpp>
+#include <tape/TapeIndex.hpp>
+
+namespace {
+
+enum class ObjectKind : uint8_t
+{
+	Mesh,
+	Entity,
+	Texture,
+	Scene,
+	Node,
+};
+
+enum class CallRole : uint8_t
+{
+	Keep,         // Always replayed (e.g. configuration of the library)
+	Skip,         // Never replayed: graph runs and result queries
+	Setter,       // Creates or updates the object given as the first argument; the creating and the last update win
+	Destroy,      // Destroys the object given as the first argument
+	DestroyGraph, // Destroys all nodes connected to the node given as the first argument
+	Link,         // Connects or disconnects nodes given as the first two arguments
+	Cleanup,      // Destroys all objects
+};
+
+struct CallRule
+{
+	CallRole role{CallRole::Keep};
+	ObjectKind kind{ObjectKind::Node};
+	std::optional<std::pair<int, ObjectKind>> reference; // Argument referring to another object, which must be kept alive
+	std::optional<int> setterKey; // Argument distinguishing independent setters of the same object (e.g. a field)
+};
+
+CallRule getCallRule(std::string_view fnName)
+{
+	static const std::set<std::string_view, std::less<>> skippedCalls = {
+	    TapeIndex::FRAME_CALL, "rgl_graph_get_result_size", "rgl_graph_get_result_data", "rgl_graph_node_get_priority",
+	    "rgl_graph_write_pcd_file", "rgl_graph_query_result_buffer", "rgl_graph_get_node_stats", "rgl_graph_write_profile",
+	    "rgl_graph_get_latency"};
+	static const std::vector<std::pair<std::string_view, ObjectKind>> objectPrefixes = {
+	    {"rgl_mesh_", ObjectKind::Mesh},   {"rgl_entity_", ObjectKind::Entity}, {"rgl_texture_", ObjectKind::Texture},
+	    {"rgl_scene_", ObjectKind::Scene}, {"rgl_node_", ObjectKind::Node},
+	};
+
+	if (skippedCalls.contains(fnName)) {
+		return {.role = CallRole::Skip};
+	}
+	if (fnName == "rgl_cleanup") {
+		return {.role = CallRole::Cleanup};
+	}
+	if (fnName == "rgl_graph_destroy") {
+		return {.role = CallRole::DestroyGraph, .kind = ObjectKind::Node};
+	}
+	if (fnName == "rgl_graph_node_add_child" || fnName == "rgl_graph_node_remove_child") {
+		return {.role = CallRole::Link, .kind = ObjectKind::Node};
+	}
+	if (fnName == "rgl_graph_set_result_buffer") {
+		return {.role = CallRole::Setter, .kind = ObjectKind::Node, .setterKey = 1};
+	}
+	if (fnName == "rgl_graph_node_set_priority" || fnName == "rgl_graph_set_concurrent_branches" ||
+	    fnName == "rgl_graph_set_wait_strategy" || fnName == "rgl_graph_set_profiling") {
+		return {.role = CallRole::Setter, .kind = ObjectKind::Node};
+	}
+	for (auto&& [prefix, kind] : objectPrefixes) {
+		if (!fnName.starts_with(prefix)) {
+			continue;
+		}
+		CallRule rule{.role = fnName.ends_with("_destroy") ? CallRole::Destroy : CallRole::Setter, .kind = kind};
+		if (fnName == "rgl_entity_create") {
+			rule.reference = {2, ObjectKind::Mesh};
+		}
+		if (fnName == "rgl_entity_set_intensity_texture") {
+			rule.reference = {1, ObjectKind::Texture};
+		}
+		return rule;
+	}
+	return {};
+}
+
+/**
+ * Tracks which calls are needed to recreate objects alive at the current point of the tape.
+ * Object handles may be reused after destruction, so each lifetime of a handle is a separate generation.
+ * A destroyed generation remains alive as long as calls of other objects refer to it (e.g. a mesh used by an entity).
+ */
+struct LivenessTracker
+{
+	using APICallIdx = TapeIndex::APICallIdx;
+	using GenerationId = uint32_t;
+	using ObjectKey = std::pair<ObjectKind, TapeAPIObjectID>;
+
+	void addCall(APICallIdx idx, std::string_view fnName, const TapeCallReader& reader)
+	{
+		const CallRule rule = getCallRule(fnName);
+		if (rule.role == CallRole::Skip) {
+			return;
+		}
+		if (rule.role == CallRole::Keep) {
+			liveCalls.insert(idx);
+			return;
+		}
+		if (rule.role == CallRole::Cleanup) {
+			while (!currentGenerations.empty()) {
+				endGeneration(currentGenerations.begin()->second, true);
+			}
+			return;
+		}
+
+		const YAML::Node args = reader.getTapeCall(idx).getArgsNode();
+		const GenerationId generation = getGeneration({rule.kind, args[0].as<TapeAPIObjectID>()});
+		liveCalls.insert(idx);
+		if (generations[generation].calls.empty()) {
+			generations[generation].creatingCall = idx;
+		}
+		generations[generation].calls.push_back(idx);
+
+		switch (rule.role) {
+			case CallRole::Setter: {
+				const int64_t key = rule.setterKey.has_value() ? args[*rule.setterKey].as<int64_t>() : 0;
+				auto [it, inserted] = setterCalls.try_emplace({generation, fnName, key}, idx);
+				if (!inserted) {
+					// The creating call is kept, since later calls (e.g. linking nodes) depend on the object's existence.
+					// It may have the same name as updates (e.g. rgl_node_* called again on an existing node).
+					if (it->second != generations[generation].creatingCall) {
+						killCall(it->second);
+					}
+					it->second = idx;
+				}
+				if (rule.reference.has_value()) {
+					auto [argIdx, kind] = rule.reference.value();
+					const GenerationId referenced = getGeneration({kind, args[argIdx].as<TapeAPIObjectID>()});
+					generations[referenced].referenceCount += 1;
+					callReferences[idx] = referenced;
+				}
+				break;
+			}
+			case CallRole::Destroy: endGeneration(generation, false); break;
+			case CallRole::DestroyGraph: destroyGraph(generation); break;
+			case CallRole::Link: {
+				const GenerationId child = getGeneration({rule.kind, args[1].as<TapeAPIObjectID>()});
+				generations[child].calls.push_back(idx);
+				if (fnName == "rgl_graph_node_add_child") {
+					links.insert({generation, child});
+					links.insert({child, generation});
+				} else {
+					eraseLink(generation, child);
+					eraseLink(child, generation);
+				}
+				break;
+			}
+			default: break;
+		}
+	}
+
+	std::vector<APICallIdx> getLiveCalls() const { return {liveCalls.begin(), liveCalls.end()}; }
+
+private:
+	struct Generation
+	{
+		ObjectKey key;
+		std::vector<APICallIdx> calls;
+		std::optional<APICallIdx> creatingCall;
+		int32_t referenceCount{0};
+		bool isDestroyed{false};
+		bool isDead{false};
+	};
+
+	GenerationId getGeneration(const ObjectKey& key)
+	{
+		auto [it, inserted] = currentGenerations.try_emplace(key, static_cast<GenerationId>(generations.size()));
+		if (inserted) {
+			generations.push_back({.key = key});
+		}
+		return it->second;
+	}
+
+	void endGeneration(GenerationId id, bool isForced)
+	{
+		Generation& generation = generations[id];
+		currentGenerations.erase(generation.key);
+		generation.isDestroyed = true;
+		if (isForced || generation.referenceCount == 0) {
+			killGeneration(id);
+		}
+	}
+
+	void killGeneration(GenerationId id)
+	{
+		if (generations[id].isDead) {
+			return;
+		}
+		generations[id].isDead = true;
+		// Killing calls may recursively kill other generations
+		auto calls = std::move(generations[id].calls);
+		for (auto&& idx : calls) {
+			killCall(idx);
+		}
+		auto [begin, end] = links.equal_range(id);
+		std::vector<GenerationId> neighbours;
+		for (auto it = begin; it != end; ++it) {
+			neighbours.push_back(it->second);
+		}
+		links.erase(id);
+		for (auto&& neighbour : neighbours) {
+			eraseLink(neighbour, id);
+		}
+	}
+
+	void killCall(APICallIdx idx)
+	{
+		if (liveCalls.erase(idx) == 0) {
+			return;
+		}
+		if (auto it = callReferences.find(idx); it != callReferences.end()) {
+			const GenerationId referenced = it->second;
+			callReferences.erase(it);
+			generations[referenced].referenceCount -= 1;
+			if (generations[referenced].isDestroyed && generations[referenced].referenceCount == 0) {
+				killGeneration(referenced);
+			}
+		}
+	}
+
+	void destroyGraph(GenerationId id)
+	{
+		std::vector<GenerationId> stack{id};
+		std::set<GenerationId> visited{id};
+		while (!stack.empty()) {
+			GenerationId current = stack.back();
+			stack.pop_back();
+			auto [begin, end] = links.equal_range(current);
+			for (auto it = begin; it != end; ++it) {
+				if (visited.insert(it->second).second) {
+					stack.push_back(it->second);
+				}
+			}
+		}
+		for (auto&& node : visited) {
+			endGeneration(node, true);
+		}
+	}
+
+	void eraseLink(GenerationId from, GenerationId to)
+	{
+		auto [begin, end] = links.equal_range(from);
+		for (auto it = begin; it != end; ++it) {
+			if (it->second == to) {
+				links.erase(it);
+				return;
+			}
+		}
+	}
+
+	std::map<ObjectKey, GenerationId> currentGenerations;
+	std::vector<Generation> generations;
+	std::set<APICallIdx> liveCalls;
+	std::map<std::tuple<GenerationId, std::string_view, int64_t>, APICallIdx> setterCalls;
+	std::unordered_map<APICallIdx, GenerationId> callReferences; // Generation referred to by the call
+	std::multimap<GenerationId, GenerationId> links;             // Both directions of parent-child connections
+};
+
+} // namespace
+
+TapeIndex::TapeIndex(const TapeCallReader& reader, size_t checkpointFrameInterval)
+{
+	timestamps.reserve(reader.getCallCount());
+	for (APICallIdx idx = 0; idx < reader.getCallCount(); ++idx) {
+		auto fnName = reader.getFnName(idx);
+		auto it = callsByFnName.find(fnName);
+		if (it == callsByFnName.end()) {
+			it = callsByFnName.emplace(std::string(fnName), std::vector<APICallIdx>{}).first;
+		}
+		it->second.push_back(idx);
+		timestamps.push_back(reader.getTimestampNs(idx));
+	}
+	buildCheckpoints(reader, checkpointFrameInterval);
+}
+
+void TapeIndex::buildCheckpoints(const TapeCallReader& reader, size_t checkpointFrameInterval)
+{
+	checkpoints.push_back({.callIdx = 0, .liveCalls = {}});
+	if (checkpointFrameInterval == 0) {
+		return;
+	}
+	LivenessTracker tracker;
+	size_t frameCount = 0;
+	for (APICallIdx idx = 0; idx < reader.getCallCount(); ++idx) {
+		auto fnName = reader.getFnName(idx);
+		if (fnName == FRAME_CALL) {
+			if (frameCount > 0 && frameCount % checkpointFrameInterval == 0) {
+				checkpoints.push_back({.callIdx = idx, .liveCalls = tracker.getLiveCalls()});
+			}
+			frameCount += 1;
+		}
+		tracker.addCall(idx, fnName, reader);
+	}
+}
+
+const std::vector<TapeIndex::APICallIdx>& TapeIndex::getCalls(std::string_view fnName) const
+{
+	static const std::vector<APICallIdx> noCalls;
+	auto it = callsByFnName.find(fnName);
+	return it != callsByFnName.end() ? it->second : noCalls;
+}
+
+std::optional<TapeIndex::APICallIdx> TapeIndex::findByTimestamp(int64_t timestampNs) const
+{
+	auto it = std::lower_bound(timestamps.begin(), timestamps.end(), timestampNs);
+	if (it == timestamps.end()) {
+		return std::nullopt;
+	}
+	return static_cast<APICallIdx>(it - timestamps.begin());
+}
+
+const TapeIndex::Checkpoint& TapeIndex::findCheckpoint(APICallIdx callIdx) const
+{
+	auto it = std::upper_bound(checkpoints.begin(), checkpoints.end(), callIdx,
+	                           [](APICallIdx idx, const Checkpoint& checkpoint) { return idx < checkpoint.callIdx; });
+	return *std::prev(it);
+}
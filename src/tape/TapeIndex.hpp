@@ -0,0 +1,74 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tape/TapeCallStream.hpp>
+
+/**
+ * Index of tape calls built once, when the tape is loaded:
+ * - calls of each function, in order,
+ * - call timestamps, for lookups by time,
+ * - checkpoints, allowing to restore the state of API objects without replaying all calls before them.
+ */
+struct TapeIndex
+{
+	using APICallIdx = int32_t;
+
+	/**
+	 * Calls which, played in order, recreate API objects (meshes, entities, textures, nodes) alive before callIdx.
+	 * Calls superseded later (e.g. an older transform of the same entity) and calls of destroyed objects are omitted,
+	 * as well as graph runs and result queries. Calls creating objects are kept even if updated later by a same-name call.
+	 */
+	struct Checkpoint
+	{
+		APICallIdx callIdx;
+		std::vector<APICallIdx> liveCalls;
+	};
+
+	static constexpr size_t DEFAULT_CHECKPOINT_FRAME_INTERVAL = 64;
+	static constexpr std::string_view FRAME_CALL = "rgl_graph_run";
+
+	/**
+	 * Checkpoints are taken before every checkpointFrameInterval-th graph run (frame).
+	 */
+	explicit TapeIndex(const TapeCallReader& reader, size_t checkpointFrameInterval = DEFAULT_CHECKPOINT_FRAME_INTERVAL);
+
+	const std::vector<APICallIdx>& getCalls(std::string_view fnName) const;
+	const std::vector<APICallIdx>& getFrames() const { return getCalls(FRAME_CALL); }
+
+	/**
+	 * Returns the first call recorded at or after the given time since the recording start.
+	 */
+	std::optional<APICallIdx> findByTimestamp(int64_t timestampNs) const;
+
+	/**
+	 * Returns the latest checkpoint at or before the given call. There is always one at the tape beginning.
+	 */
+	const Checkpoint& findCheckpoint(APICallIdx callIdx) const;
+
+private:
+	void buildCheckpoints(const TapeCallReader& reader, size_t checkpointFrameInterval);
+
+	std::map<std::string, std::vector<APICallIdx>, std::less<>> callsByFnName;
+	std::vector<int64_t> timestamps;
+	std::vector<Checkpoint> checkpoints;
+};
@@ -12,12 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <cassert>
 #include <thread>
 
 #include <tape/TapePlayer.hpp>
+#include <tape/TapeConverter.hpp>
 #include <tape/tapeDefinitions.hpp>
 #include <RGLExceptions.hpp>
 #include <tape/TapeCall.hpp>
@@ -28,7 +30,22 @@ TapePlayer::TapePlayer(const char* path) : path(path)
 {
 	playbackState = std::make_unique<PlaybackState>(getBinPath().c_str());
 
-	yamlRoot = YAML::LoadFile(getYamlPath());
+	if (fs::exists(getCallsPath())) {
+		callsFile = std::make_unique<MappedFile>(getCallsPath().c_str());
+		callReader = std::make_unique<TapeCallReader>(std::span<const uint8_t>{callsFile->getData(), callsFile->getSize()});
+	} else {
+		loadYamlTape();
+	}
+
+	index = std::make_unique<TapeIndex>(*callReader);
+	checkTapeVersion();
+
+	nextCallIdx = 0;
+}
+
+void TapePlayer::loadYamlTape()
+{
+	YAML::Node yamlRoot = YAML::LoadFile(getYamlPath());
 	if (yamlRoot.IsNull()) {
 		throw RecordError("Invalid Tape: Empty YAML file detected");
 	}
@@ -36,15 +53,19 @@ TapePlayer::TapePlayer(const char* path) : path(path)
 		throw RecordError("Unsupported Tape format: Detected outdated format");
 	}
 
-	checkTapeVersion();
-
-	nextCallIdx = 0;
+	// Calls are converted once, so playing does not depend on the format
+	TapeCallWriter writer(
+	    [this](const uint8_t* data, size_t size) { convertedCalls.insert(convertedCalls.end(), data, data + size); });
+	TapeConverter::yamlToCalls(yamlRoot, writer);
+	callReader = std::make_unique<TapeCallReader>(std::span<const uint8_t>{convertedCalls});
 }
 
 std::string TapePlayer::getBinPath() const { return fs::path(path).concat(BIN_EXTENSION).string(); }
 
 std::string TapePlayer::getYamlPath() const { return fs::path(path).concat(YAML_EXTENSION).string(); }
 
+std::string TapePlayer::getCallsPath() const { return fs::path(path).concat(CALLS_EXTENSION).string(); }
+
 void TapePlayer::checkTapeVersion()
 {
 	auto versionCallIdx = findFirst({RGL_VERSION});
@@ -64,39 +85,44 @@ void TapePlayer::checkTapeVersion()
 
 std::optional<TapePlayer::APICallIdx> TapePlayer::findFirst(std::set<std::string_view> fnNames)
 {
-	for (APICallIdx idx = 0; idx < yamlRoot.size(); ++idx) {
-		if (fnNames.contains(yamlRoot[idx].begin()->first.as<std::string>())) {
-			return idx;
+	std::optional<APICallIdx> result;
+	for (auto&& fnName : fnNames) {
+		const auto& calls = index->getCalls(fnName);
+		if (!calls.empty() && (!result.has_value() || calls.front() < result.value())) {
+			result = calls.front();
 		}
 	}
-	return std::nullopt;
+	return result;
 }
 
 std::optional<TapePlayer::APICallIdx> TapePlayer::findLast(std::set<std::string_view> fnNames)
 {
-	for (APICallIdx idx = 0; idx < yamlRoot.size(); ++idx) {
-		auto rIdx = yamlRoot.size() - 1 - idx;
-		if (fnNames.contains(yamlRoot[idx].begin()->first.as<std::string>())) {
-			return rIdx;
+	std::optional<APICallIdx> result;
+	for (auto&& fnName : fnNames) {
+		const auto& calls = index->getCalls(fnName);
+		if (!calls.empty() && (!result.has_value() || calls.back() > result.value())) {
+			result = calls.back();
 		}
 	}
-	return std::nullopt;
+	return result;
 }
 
 std::vector<TapePlayer::APICallIdx> TapePlayer::findAll(std::set<std::string_view> fnNames)
 {
 	std::vector<APICallIdx> result;
-	for (APICallIdx idx = 0; idx < yamlRoot.size(); ++idx) {
-		if (fnNames.contains((yamlRoot[idx].begin()->first.as<std::string>()))) {
-			result.push_back(idx);
-		}
+	for (auto&& fnName : fnNames) {
+		const auto& calls = index->getCalls(fnName);
+		result.insert(result.end(), calls.begin(), calls.end());
+	}
+	if (fnNames.size() > 1) {
+		std::sort(result.begin(), result.end());
 	}
 	return result;
 }
 
 void TapePlayer::playThrough(APICallIdx last)
 {
-	assert(last < yamlRoot.size());
+	assert(last < getCallCount());
 	for (; nextCallIdx <= last; ++nextCallIdx) {
 		playThis(nextCallIdx);
 	}
@@ -105,8 +131,8 @@ void TapePlayer::playThrough(APICallIdx last)
 void TapePlayer::playUntil(std::optional<APICallIdx> breakpoint)
 {
 	assert(!breakpoint.has_value() || nextCallIdx < breakpoint.value());
-	auto end = breakpoint.value_or(yamlRoot.size());
-	assert(end <= yamlRoot.size());
+	auto end = breakpoint.value_or(getCallCount());
+	assert(end <= getCallCount());
 	for (; nextCallIdx < end; ++nextCallIdx) {
 		playThis(nextCallIdx);
 	}
@@ -127,10 +153,11 @@ void TapePlayer::playApproximatelyRealtime()
 	// Approximation comes from the fact that we don't account for the time it takes to execute the function
 	// This could be fixed by moving TAPE_HOOK to the beginning of the API call
 	// It might be a good idea to do so, because it would record failed calls.
+	// Timestamps are relative to the first played call, playback may start after seeking
 	auto beginTimestamp = std::chrono::steady_clock::now();
-	for (; nextCallIdx < yamlRoot.size(); ++nextCallIdx) {
-		TapeCall nextCall = getTapeCall(nextCallIdx);
-		auto nextCallNs = std::chrono::nanoseconds(nextCall.getTimestamp().asNanoseconds());
+	auto beginCallNs = nextCallIdx < getCallCount() ? callReader->getTimestampNs(nextCallIdx) : 0;
+	for (; nextCallIdx < getCallCount(); ++nextCallIdx) {
+		auto nextCallNs = std::chrono::nanoseconds(callReader->getTimestampNs(nextCallIdx) - beginCallNs);
 		auto elapsed = std::chrono::steady_clock::now() - beginTimestamp;
 		std::this_thread::sleep_for(nextCallNs - elapsed);
 		playThis(nextCallIdx);
@@ -148,3 +175,30 @@ void TapePlayer::reset()
 	nextCallIdx = 0;
 	playbackState = std::make_unique<PlaybackState>(getBinPath().c_str());
 }
+
+void TapePlayer::seek(APICallIdx idx)
+{
+	if (idx < 0 || idx > getCallCount()) {
+		throw RecordError(fmt::format("Cannot seek to call {}, tape has {} calls", idx, getCallCount()));
+	}
+	const auto& checkpoint = index->findCheckpoint(idx);
+	if (idx < nextCallIdx || checkpoint.callIdx > nextCallIdx) {
+		reset();
+		for (auto&& call : checkpoint.liveCalls) {
+			playThis(call);
+		}
+		nextCallIdx = checkpoint.callIdx;
+	}
+	for (; nextCallIdx < idx; ++nextCallIdx) {
+		playThis(nextCallIdx);
+	}
+}
+
+void TapePlayer::seekFrame(size_t frame)
+{
+	const auto& frames = index->getFrames();
+	if (frame >= frames.size()) {
+		throw RecordError(fmt::format("Cannot seek to frame {}, tape has {} frames", frame, frames.size()));
+	}
+	seek(frames[frame]);
+}
@@ -17,8 +17,11 @@
 #include <optional>
 
 #include <rgl/api/core.h>
+#include <tape/MappedFile.hpp>
 #include <tape/PlaybackState.hpp>
 #include <tape/TapeCall.hpp>
+#include <tape/TapeCallStream.hpp>
+#include <tape/TapeIndex.hpp>
 
 // Helper macro to define tape function mapping entry
 #define TAPE_CALL_MAPPING(API_CALL_STRING, TAPE_CALL)                                                                          \
@@ -31,17 +34,19 @@ using TapeFunction = std::function<void(const YAML::Node&, PlaybackState&)>;
 
 struct TapePlayer
 {
-	using APICallIdx = int32_t;
+	using APICallIdx = TapeIndex::APICallIdx;
 	explicit TapePlayer(const char* path);
 	static void extendTapeFunctions(std::map<std::string, TapeFunction> map) { tapeFunctions.insert(map.begin(), map.end()); }
 
-	TapeCall getTapeCall(APICallIdx idx) const { return TapeCall(yamlRoot[idx]); }
+	TapeCall getTapeCall(APICallIdx idx) const { return callReader->getTapeCall(idx); }
 
 	void checkTapeVersion();
 
 	std::optional<APICallIdx> findFirst(std::set<std::string_view> fnNames);
 	std::optional<APICallIdx> findLast(std::set<std::string_view> fnNames);
 	std::vector<APICallIdx> findAll(std::set<std::string_view> fnNames);
+	std::optional<APICallIdx> findByTimestamp(int64_t timestampNs) const { return index->findByTimestamp(timestampNs); }
+	size_t getFrameCount() const { return index->getFrames().size(); }
 
 	void playThis(APICallIdx idx);
 	void playThrough(APICallIdx last);
@@ -49,10 +54,24 @@ struct TapePlayer
 	void playApproximatelyRealtime();
 	void reset();
 
+	/**
+	 * Makes idx the next call to play, with API objects in the state as if all calls before it were played.
+	 * Seeking back or far ahead restores the nearest checkpoint (see TapeIndex) and plays only calls after it.
+	 * Graph runs before the checkpoint are not replayed, so nodes accumulating data over runs start empty.
+	 */
+	void seek(APICallIdx idx);
+	void seekFrame(size_t frame); // Seeks to the frame-th graph run
+
 	rgl_node_t getNodeHandle(TapeAPIObjectID key) { return playbackState->nodes.at(key); }
 
 private:
-	YAML::Node yamlRoot{};
+	APICallIdx getCallCount() const { return static_cast<APICallIdx>(callReader->getCallCount()); }
+	void loadYamlTape();
+
+	std::unique_ptr<MappedFile> callsFile;       // Binary call stream, if the tape has one
+	std::vector<uint8_t> convertedCalls;         // Calls converted from YAML, for tapes recorded in the old format
+	std::unique_ptr<TapeCallReader> callReader;
+	std::unique_ptr<TapeIndex> index;
 	APICallIdx nextCallIdx{};
 	std::unique_ptr<PlaybackState> playbackState;
 	std::string path;
@@ -60,4 +79,5 @@ private:
 	static inline std::map<std::string, TapeFunction> tapeFunctions = {};
 	std::string getBinPath() const;
 	std::string getYamlPath() const;
+	std::string getCallsPath() const;
 };
@@ -14,6 +14,7 @@
 
 #include <filesystem>
 
+#include <tape/BlobHash.hpp>
 #include <tape/TapeRecorder.hpp>
 #include <tape/tapeDefinitions.hpp>
 #include <rgl/api/core.h>
@@ -24,7 +25,34 @@ std::optional<TapeRecorder> tapeRecorder;
 
 TapeRecorder::TapeRecorder(const fs::path& path)
 {
-	std::string pathYaml = fs::path(path).concat(YAML_EXTENSION).string();
+	openFiles(path);
+	beginTimestamp = std::chrono::steady_clock::now();
+	TapeRecorder::recordRGLVersion();
+	// Make the tape playable right away
+	callWriter.flush();
+}
+
+TapeRecorder::TapeRecorder(const fs::path& path, size_t maxBufferedBytes, rgl_tape_overflow_policy_t overflowPolicy)
+{
+	openFiles(path);
+	auto writeToFile = [this](AsyncTapeWriter::Target target, const uint8_t* data, size_t size) {
+		if (target == AsyncTapeWriter::Target::Bin) {
+			FWRITE(data, sizeof(uint8_t), size, fileBin);
+		}
+		else {
+			writeChunkToFile(data, size);
+		}
+	};
+	asyncWriter = std::make_unique<AsyncTapeWriter>(writeToFile, maxBufferedBytes, overflowPolicy);
+	beginTimestamp = std::chrono::steady_clock::now();
+	TapeRecorder::recordRGLVersion();
+	callWriter.flush();
+	asyncWriter->commit();
+}
+
+void TapeRecorder::openFiles(const fs::path& path)
+{
+	std::string pathCalls = fs::path(path).concat(CALLS_EXTENSION).string();
 	std::string pathBin = fs::path(path).concat(BIN_EXTENSION).string();
 
 	fileBin = fopen(pathBin.c_str(), "wb");
@@ -33,32 +61,156 @@ TapeRecorder::TapeRecorder(const fs::path& path)
 		                                  "due to the error: {}",
 		                                  pathBin, std::strerror(errno)));
 	}
-	fileYaml.open(pathYaml);
-	if (fileYaml.fail()) {
-		throw InvalidFilePath(fmt::format("rgl_tape_record_begin: could not open yaml file '{}' "
+	fileCalls = fopen(pathCalls.c_str(), "wb");
+	if (nullptr == fileCalls) {
+		fclose(fileBin);
+		throw InvalidFilePath(fmt::format("rgl_tape_record_begin: could not open call stream file '{}' "
 		                                  "due to the error: {}",
-		                                  pathYaml, std::strerror(errno)));
+		                                  pathCalls, std::strerror(errno)));
 	}
-
-	yamlEmitter << YAML::BeginSeq;
-	beginTimestamp = std::chrono::steady_clock::now();
-	TapeRecorder::recordRGLVersion();
 }
 
 TapeRecorder::~TapeRecorder()
 {
 	// TODO(prybicki): SIOF with Logger !!!
-	yamlEmitter << YAML::EndSeq;
-	fileYaml << yamlEmitter.c_str();
-	fileYaml.close();
-	if (fileYaml.fail()) {
-		RGL_WARN("rgl_tape_record_end: failed to close yaml file due to the error: {}", std::strerror(errno));
+	try {
+		callWriter.flush();
+		if (asyncWriter != nullptr) {
+			asyncWriter->commit();
+		}
+	}
+	catch (std::exception& e) {
+		RGL_WARN("rgl_tape_record_end: failed to write calls: {}", e.what());
+	}
+	// Waits until all buffered data is written
+	asyncWriter.reset();
+	if (fclose(fileCalls)) {
+		RGL_WARN("rgl_tape_record_end: failed to close call stream file due to the error: {}", std::strerror(errno));
 	}
 	if (fclose(fileBin)) {
 		RGL_WARN("rgl_tape_record_end: failed to close binary file due to the error: {}", std::strerror(errno));
 	}
 }
 
+rgl_tape_record_stats_t TapeRecorder::getStats() const
+{
+	rgl_tape_record_stats_t stats{
+	    .recorded_call_count = recordedCallCount,
+	    .dropped_call_count = droppedCallCount,
+	    .bin_data_bytes = binDataBytes,
+	    .deduplicated_bin_bytes = deduplicatedBinBytes,
+	};
+	if (asyncWriter != nullptr) {
+		auto writerStats = asyncWriter->getStats();
+		stats.buffered_bytes = writerStats.bufferedBytes;
+		stats.max_buffered_bytes = writerStats.maxBufferedBytes;
+		stats.written_bytes = writerStats.writtenBytes;
+		stats.blocked_time_ns = writerStats.blockedTimeNs;
+	}
+	return stats;
+}
+
+void TapeRecorder::beginCall(std::string_view fnName)
+{
+	auto timestamp =
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - beginTimestamp).count();
+	callBinOffset = currentBinOffset;
+	callBlobKeys.clear();
+	callBinDataBytes = 0;
+	callDeduplicatedBytes = 0;
+	callWriter.beginCall(fnName, timestamp);
+}
+
+void TapeRecorder::endCall()
+{
+	if (isCallDropped) {
+		dropCall();
+		return;
+	}
+	callWriter.endCall();
+	if (asyncWriter != nullptr) {
+		asyncWriter->commit();
+	}
+	recordedCallCount += 1;
+	binDataBytes += callBinDataBytes;
+	deduplicatedBinBytes += callDeduplicatedBytes;
+}
+
+void TapeRecorder::dropCall()
+{
+	callWriter.cancelCall();
+	asyncWriter->abort();
+	currentBinOffset = callBinOffset;
+	for (auto&& key : callBlobKeys) {
+		blobOffsets.erase(key);
+	}
+	isCallDropped = false;
+	droppedCallCount += 1;
+}
+
+size_t TapeRecorder::writeBlob(const void* data, size_t size)
+{
+	const size_t paddedSize = (size + 15) / 16 * 16;
+	callBinDataBytes += paddedSize;
+
+	std::optional<BlobKey> key;
+	if (size >= MIN_DEDUPLICATED_BLOB_SIZE) {
+		key = BlobKey{.hash = hashBlob(data, size), .size = size};
+		if (auto it = blobOffsets.find(key.value()); it != blobOffsets.end()) {
+			callDeduplicatedBytes += paddedSize;
+			return it->second;
+		}
+	}
+
+	writeBinData(data, size);
+	if (paddedSize != size) {
+		static constexpr uint8_t zeros[16]{};
+		writeBinData(zeros, paddedSize - size);
+	}
+
+	size_t outBinOffset = currentBinOffset;
+	currentBinOffset += paddedSize;
+	if (key.has_value()) {
+		blobOffsets.emplace(key.value(), outBinOffset);
+		callBlobKeys.emplace_back(key.value());
+	}
+	return outBinOffset;
+}
+
+void TapeRecorder::writeBinData(const void* data, size_t size)
+{
+	if (asyncWriter == nullptr) {
+		FWRITE(data, sizeof(uint8_t), size, fileBin);
+		return;
+	}
+	// Further arrays of a dropped call are skipped, but their offsets are still computed
+	if (!isCallDropped) {
+		isCallDropped = !asyncWriter->append(AsyncTapeWriter::Target::Bin, data, size, true);
+	}
+}
+
+void TapeRecorder::writeChunk(const uint8_t* data, size_t size)
+{
+	// Calls are never dropped once recorded
+	if (asyncWriter != nullptr) {
+		asyncWriter->append(AsyncTapeWriter::Target::Calls, data, size, false);
+		return;
+	}
+	writeChunkToFile(data, size);
+}
+
+void TapeRecorder::writeChunkToFile(const uint8_t* data, size_t size)
+{
+	// Binary data referenced by calls has to be written before them
+	if (fflush(fileBin) != 0) {
+		throw RecordError(fmt::format("Failed to flush binary file due to the error: {}", std::strerror(errno)));
+	}
+	FWRITE(data, sizeof(uint8_t), size, fileCalls);
+	if (fflush(fileCalls) != 0) {
+		throw RecordError(fmt::format("Failed to flush call stream file due to the error: {}", std::strerror(errno)));
+	}
+}
+
 void TapeRecorder::recordRGLVersion()
 {
 	int32_t major, minor, patch;
@@ -14,15 +14,21 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdio>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <optional>
-#include <fstream>
-
-#include <yaml-cpp/yaml.h>
+#include <filesystem>
 
 #include <rgl/api/core.h>
+#include <rgl/api/extensions/tape.h>
 #include <RGLExceptions.hpp>
 #include <Logger.hpp>
+#include <tape/AsyncTapeWriter.hpp>
+#include <tape/TapeCallStream.hpp>
 
 #ifdef _WIN32
 #define TAPE_HOOK(...)
@@ -47,105 +53,127 @@
 struct TapeRecorder
 {
 	explicit TapeRecorder(const std::filesystem::path& path);
+	/**
+	 * Records asynchronously: files are written by a background thread (see AsyncTapeWriter).
+	 */
+	TapeRecorder(const std::filesystem::path& path, size_t maxBufferedBytes, rgl_tape_overflow_policy_t overflowPolicy);
 	~TapeRecorder();
 
+	// Chunk sink captures this
+	TapeRecorder(const TapeRecorder&) = delete;
+	TapeRecorder& operator=(const TapeRecorder&) = delete;
+
 	/**
-	 * Emits lines like: "rgl_get_version_info: {t: 61323, a: [0, 16, 2]}"
+	 * Appends a record of the call to the binary call stream (see TapeCallStream).
+	 * Arrays are written to the binary file, the record keeps their offsets.
+	 * Arrays identical to ones already written are not written again, the record refers to the earlier copy.
+	 * When recording asynchronously, the call may be dropped if its arrays do not fit in the buffer.
 	 */
 	template<typename... Args>
-	void recordApiCall(std::string fnName, Args&&... args)
+	void recordApiCall(std::string_view fnName, Args&&... args)
 	{
-		auto timestamp =
-		    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - beginTimestamp).count();
-		// clang-format off
-		yamlEmitter << YAML::BeginMap << YAML::Key << fnName << YAML::Flow
-		                << YAML::BeginMap
-		                    << YAML::Key << "t" << YAML::Value << timestamp
-		                    << YAML::Key << "a" << YAML::Value << YAML::BeginSeq << emitArgs(args...) << YAML::EndSeq
-		                << YAML::EndMap
-		            << YAML::EndMap;
-		// clang-format on
+		beginCall(fnName);
+		(callWriter.addArg(toTapeValue(args)), ...);
+		endCall();
 	}
 
+	rgl_tape_record_stats_t getStats() const;
+
 	static void recordRGLVersion();
 
 private: // Methods
-	/**
-	 * Appends all arguments to the yaml file via template recursion.
-	 * Returns nil-potent YAML::EMITTER_MANIP to allow chaining << operator.
-	 */
-	template<typename T, typename... Args>
-	YAML::EMITTER_MANIP emitArgs(T&& head, Args&&... tail)
-	{
-		yamlEmitter << valueToYaml(head);
-		return emitArgs(tail...);
-	}
-	YAML::EMITTER_MANIP emitArgs() { return YAML::Auto; }
-
-	uintptr_t valueToYaml(void* value) { return (uintptr_t) value; }
-	uintptr_t valueToYaml(rgl_node_t* value) { return (uintptr_t) *value; }
-	uintptr_t valueToYaml(rgl_node_t value) { return (uintptr_t) value; }
-	uintptr_t valueToYaml(rgl_mesh_t* value) { return (uintptr_t) *value; }
-	uintptr_t valueToYaml(rgl_mesh_t value) { return (uintptr_t) value; }
-	uintptr_t valueToYaml(rgl_scene_t* value) { return (uintptr_t) *value; }
-	uintptr_t valueToYaml(rgl_scene_t value) { return (uintptr_t) value; }
-	uintptr_t valueToYaml(rgl_entity_t* value) { return (uintptr_t) *value; }
-	uintptr_t valueToYaml(rgl_entity_t value) { return (uintptr_t) value; }
-	uintptr_t valueToYaml(rgl_texture_t* value) { return (uintptr_t) *value; }
-	uintptr_t valueToYaml(rgl_texture_t value) { return (uintptr_t) value; }
-	size_t valueToYaml(const rgl_vec3f* value) { return writeToBin(value, 1); }
-	size_t valueToYaml(const rgl_mat3x4f* value) { return writeToBin(value, 1); }
+	void openFiles(const std::filesystem::path& path);
+	void beginCall(std::string_view fnName);
+	void endCall();
+	void dropCall();
+	size_t writeBlob(const void* data, size_t size);
+	void writeChunk(const uint8_t* data, size_t size);
+	void writeChunkToFile(const uint8_t* data, size_t size);
+	void writeBinData(const void* data, size_t size);
+
+	uintptr_t toTapeValue(void* value) { return (uintptr_t) value; }
+	uintptr_t toTapeValue(rgl_node_t* value) { return (uintptr_t) *value; }
+	uintptr_t toTapeValue(rgl_node_t value) { return (uintptr_t) value; }
+	uintptr_t toTapeValue(rgl_mesh_t* value) { return (uintptr_t) *value; }
+	uintptr_t toTapeValue(rgl_mesh_t value) { return (uintptr_t) value; }
+	uintptr_t toTapeValue(rgl_scene_t* value) { return (uintptr_t) *value; }
+	uintptr_t toTapeValue(rgl_scene_t value) { return (uintptr_t) value; }
+	uintptr_t toTapeValue(rgl_entity_t* value) { return (uintptr_t) *value; }
+	uintptr_t toTapeValue(rgl_entity_t value) { return (uintptr_t) value; }
+	uintptr_t toTapeValue(rgl_texture_t* value) { return (uintptr_t) *value; }
+	uintptr_t toTapeValue(rgl_texture_t value) { return (uintptr_t) value; }
+	size_t toTapeValue(const rgl_vec3f* value) { return writeToBin(value, 1); }
+	size_t toTapeValue(const rgl_mat3x4f* value) { return writeToBin(value, 1); }
 
 	template<typename T>
-	std::enable_if_t<!std::is_enum_v<T>, T> valueToYaml(T value)
+	std::enable_if_t<!std::is_enum_v<T>, T> toTapeValue(T value)
 	{
 		return value;
 	}
 
 	template<typename T, typename N>
-	size_t valueToYaml(std::pair<T, N> value)
+	size_t toTapeValue(std::pair<T, N> value)
 	{
 		return writeToBin(value.first, value.second);
 	}
 
 	template<typename N>
-	size_t valueToYaml(std::pair<const void*, N> value)
+	size_t toTapeValue(std::pair<const void*, N> value)
 	{
 		return writeToBin(static_cast<const char*>(value.first), value.second);
 	}
 
 	template<typename T>
-	std::enable_if_t<std::is_enum_v<T>, std::string> valueToYaml(T value)
+	std::enable_if_t<std::is_enum_v<T>, std::underlying_type_t<T>> toTapeValue(T value)
 	{
-		return std::to_string(static_cast<std::underlying_type_t<T>>(value));
+		return static_cast<std::underlying_type_t<T>>(value);
 	}
 
-	int valueToYaml(int32_t* value) { return *value; }
+	int toTapeValue(int32_t* value) { return *value; }
 
 	template<typename T>
 	size_t writeToBin(const T* source, size_t elemCount)
 	{
-		size_t elemSize = sizeof(T);
-		uint8_t remainder = (elemSize * elemCount) % 16;
-		uint8_t bytesToAdd = (16 - remainder) % 16;
-
-		FWRITE(source, elemSize, elemCount, fileBin);
-		if (remainder != 0) {
-			uint8_t zeros[16];
-			FWRITE(zeros, sizeof(uint8_t), bytesToAdd, fileBin);
-		}
-
-		size_t outBinOffset = currentBinOffset;
-		currentBinOffset += elemSize * elemCount + bytesToAdd;
-		return outBinOffset;
+		return writeBlob(source, sizeof(T) * elemCount);
 	}
 
+private: // Types
+	struct BlobKey
+	{
+		uint64_t hash;
+		size_t size;
+
+		bool operator==(const BlobKey& other) const = default;
+	};
+
+	struct BlobKeyHasher
+	{
+		size_t operator()(const BlobKey& key) const { return key.hash; }
+	};
+
+	// Hashing small blobs costs more than they take on the tape
+	static constexpr size_t MIN_DEDUPLICATED_BLOB_SIZE = 64;
+
 private: // Fields
-	std::ofstream fileYaml;
-	YAML::Emitter yamlEmitter;
+	FILE* fileCalls;
 	FILE* fileBin;
+	TapeCallWriter callWriter{[this](const uint8_t* data, size_t size) { writeChunk(data, size); }};
 	size_t currentBinOffset = 0;
 	std::chrono::time_point<std::chrono::steady_clock> beginTimestamp;
+
+	std::unique_ptr<AsyncTapeWriter> asyncWriter; // Null when recording synchronously
+	bool isCallDropped = false;
+	uint64_t recordedCallCount = 0;
+	uint64_t droppedCallCount = 0;
+
+	// Offsets of blobs already written, identified by content hash and size
+	std::unordered_map<BlobKey, size_t, BlobKeyHasher> blobOffsets;
+	std::vector<BlobKey> callBlobKeys; // Registered by the current call, forgotten if it is dropped
+	size_t callBinOffset = 0;
+	uint64_t callBinDataBytes = 0;
+	uint64_t callDeduplicatedBytes = 0;
+	uint64_t binDataBytes = 0;
+	uint64_t deduplicatedBinBytes = 0;
 };
 
 extern std::optional<TapeRecorder> tapeRecorder;
@@ -22,3 +22,4 @@
 #define RGL_VERSION "rgl_get_version_info"
 #define BIN_EXTENSION ".bin"
 #define YAML_EXTENSION ".yaml"
+#define CALLS_EXTENSION ".calls"
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <rgl/api/core.h>
+
+/**
+ * Aborts the benchmark (with RGL error message) if the API call fails.
+ * Returns from the enclosing function, so it can be used only in the benchmark body.
+ */
+#define BENCHMARK_RGL_CHECK(state, call)                                                                                       \
+	do {                                                                                                                       \
+		if ((call) != RGL_SUCCESS) {                                                                                           \
+			const char* errorString = nullptr;                                                                                 \
+			rgl_get_last_error_string(&errorString);                                                                           \
+			(state).SkipWithError(errorString);                                                                                \
+			return;                                                                                                            \
+		}                                                                                                                      \
+	} while (false)
+
+/**
+ * Releases all RGL objects created by the benchmark, so that benchmarks do not affect each other.
+ */
+struct ScopedRGLCleanup
+{
+	ScopedRGLCleanup() = default;
+	ScopedRGLCleanup(const ScopedRGLCleanup&) = delete;
+	ScopedRGLCleanup& operator=(const ScopedRGLCleanup&) = delete;
+	~ScopedRGLCleanup() { rgl_cleanup(); }
+};
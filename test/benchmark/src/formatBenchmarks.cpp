@@ -0,0 +1,131 @@
+#include <map>
+#include <vector>
+
+#include <benchmarkHelpers.hpp>
+
+#include <RGLFields.hpp>
+#include <GPUFieldDescBuilder.hpp>
+#include <HostFormat.hpp>
+#include <gpu/nodeKernels.hpp>
+#include <memory/Array.hpp>
+
+static constexpr size_t FORMAT_POINT_COUNT = 1'000'000;
+
+/**
+ * Layouts specialized in gpu/FormatLayout.hpp, keyed by their point size (which differs between them).
+ */
+static const std::vector<rgl_field_t>& getFormatLayout(int64_t pointSize)
+{
+	static const std::map<int64_t, std::vector<rgl_field_t>> layouts = []() {
+		std::map<int64_t, std::vector<rgl_field_t>> layouts;
+		for (auto&& fields : std::vector<std::vector<rgl_field_t>>{
+		         {XYZ_VEC3_F32, PADDING_32},
+		         {XYZ_VEC3_F32, PADDING_32, INTENSITY_F32, RING_ID_U16},
+		         {XYZ_VEC3_F32, INTENSITY_F32, RING_ID_U16, TIME_STAMP_F64},
+		         {XYZ_VEC3_F32, INTENSITY_U8, RETURN_TYPE_U8, RING_ID_U16, AZIMUTH_F32, ELEVATION_F32, DISTANCE_F32,
+		          TIME_STAMP_U32},
+		     }) {
+			layouts.emplace(static_cast<int64_t>(getPointSize(fields)), fields);
+		}
+		return layouts;
+	}();
+	return layouts.at(pointSize);
+}
+
+static void applyFormatPointSizes(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->ArgName("pointSize")->Arg(16)->Arg(22)->Arg(26)->Arg(32)->Unit(benchmark::kMicrosecond);
+}
+
+static CudaStream::Ptr getFormatStream()
+{
+	static CudaStream::Ptr stream = CudaStream::create(cudaStreamNonBlocking);
+	return stream;
+}
+
+/**
+ * Zero-initialized input fields and output buffer of formatting FORMAT_POINT_COUNT points of the given layout.
+ */
+template<template<typename> typename ArrayT>
+struct FormatData
+{
+	explicit FormatData(const std::vector<rgl_field_t>& fields)
+	{
+		for (auto&& field : fields) {
+			if (isDummy(field)) {
+				fieldData.push_back({field, nullptr});
+				continue;
+			}
+			fieldArrays.push_back(createArray());
+			fieldArrays.back()->resize(FORMAT_POINT_COUNT * getFieldSize(field), true, false);
+			fieldData.push_back({field, fieldArrays.back()->getReadPtr()});
+		}
+		output = createArray();
+		output->resize(FORMAT_POINT_COUNT * getPointSize(fields), false, false);
+	}
+
+	std::vector<typename ArrayT<char>::Ptr> fieldArrays;
+	std::vector<std::pair<rgl_field_t, const void*>> fieldData;
+	typename ArrayT<char>::Ptr output;
+
+private:
+	static typename ArrayT<char>::Ptr createArray()
+	{
+		if constexpr (std::is_same_v<ArrayT<char>, DeviceAsyncArray<char>>) {
+			return DeviceAsyncArray<char>::create(getFormatStream());
+		} else {
+			return ArrayT<char>::create();
+		}
+	}
+};
+
+/**
+ * Generic GPU formatting (SoA -> AoS) driven by the GPUFieldDesc table, used for layouts not specialized at compile time.
+ */
+static void FormatGenericGPU(benchmark::State& state)
+{
+	const auto& fields = getFormatLayout(state.range(0));
+	FormatData<DeviceAsyncArray> data{fields};
+	auto stream = getFormatStream();
+	GPUFieldDescBuilder gpuFieldDescBuilder;
+	for (auto _ : state) {
+		const GPUFieldDesc* gpuFields = gpuFieldDescBuilder.buildReadableAsync(stream, data.fieldData).getReadPtr();
+		gpuFormatSoaToAos(stream->getHandle(), FORMAT_POINT_COUNT, state.range(0), fields.size(), gpuFields,
+		                  data.output->getWritePtr());
+		CHECK_CUDA(cudaStreamSynchronize(stream->getHandle()));
+	}
+	state.SetItemsProcessed(state.iterations() * FORMAT_POINT_COUNT);
+}
+BENCHMARK(FormatGenericGPU)->Apply(applyFormatPointSizes);
+
+/**
+ * GPU formatting specialized for the layout at compile time (see gpu/FormatLayout.hpp).
+ */
+static void FormatSpecializedGPU(benchmark::State& state)
+{
+	FormatData<DeviceAsyncArray> data{getFormatLayout(state.range(0))};
+	auto stream = getFormatStream();
+	for (auto _ : state) {
+		if (!gpuFormatSoaToAosLayout(stream->getHandle(), FORMAT_POINT_COUNT, data.fieldData, data.output->getWritePtr())) {
+			state.SkipWithError("layout is not specialized");
+			return;
+		}
+		CHECK_CUDA(cudaStreamSynchronize(stream->getHandle()));
+	}
+	state.SetItemsProcessed(state.iterations() * FORMAT_POINT_COUNT);
+}
+BENCHMARK(FormatSpecializedGPU)->Apply(applyFormatPointSizes);
+
+/**
+ * Host formatting, used by FormatPointsNode when its inputs reside in host memory; shares the layout code with the GPU.
+ */
+static void FormatHost(benchmark::State& state)
+{
+	FormatData<HostPageableArray> data{getFormatLayout(state.range(0))};
+	for (auto _ : state) {
+		hostFormatSoaToAos(FORMAT_POINT_COUNT, data.fieldData, data.output->getWritePtr());
+		benchmark::DoNotOptimize(data.output->getRawReadPtr());
+	}
+	state.SetItemsProcessed(state.iterations() * FORMAT_POINT_COUNT);
+}
+BENCHMARK(FormatHost)->Apply(applyFormatPointSizes);
@@ -0,0 +1,174 @@
+#include <thread>
+#include <vector>
+
+#include <benchmarkHelpers.hpp>
+
+#include <RGLFields.hpp>
+#include <graph/GraphExecutor.hpp>
+#include <math/Mat3x4f.hpp>
+
+/**
+ * Places a cube with 2m edges at the given pose.
+ */
+static rgl_status_t spawnCube(const rgl_mat3x4f& pose)
+{
+	static const rgl_vec3f vertices[] = {
+	    {-1, -1, -1}, {1, -1, -1}, {1, 1, -1}, {-1, 1, -1}, {-1, -1, 1}, {1, -1, 1}, {1, 1, 1}, {-1, 1, 1},
+	};
+	static const rgl_vec3i indices[] = {
+	    {0, 3, 1}, {3, 2, 1}, {1, 2, 5}, {2, 6, 5}, {5, 6, 4}, {6, 7, 4},
+	    {4, 7, 0}, {7, 3, 0}, {3, 7, 2}, {7, 6, 2}, {4, 0, 5}, {0, 1, 5},
+	};
+	rgl_mesh_t mesh = nullptr;
+	rgl_entity_t entity = nullptr;
+	rgl_status_t status = rgl_mesh_create(&mesh, vertices, std::size(vertices), indices, std::size(indices));
+	if (status == RGL_SUCCESS) {
+		status = rgl_entity_create(&entity, nullptr, mesh);
+	}
+	if (status == RGL_SUCCESS) {
+		status = rgl_entity_set_transform(entity, &pose);
+	}
+	return status;
+}
+
+/**
+ * Rays in all directions, every 10 degrees horizontally and vertically.
+ */
+static std::vector<rgl_mat3x4f> makeSparseLidarRays()
+{
+	std::vector<rgl_mat3x4f> rays;
+	for (int horizontal = -180; horizontal <= 180; horizontal += 10) {
+		for (int vertical = -90; vertical <= 90; vertical += 10) {
+			rays.push_back(Mat3x4f::rotationDeg(horizontal, vertical, 0.0f).toRGL());
+		}
+	}
+	return rays;
+}
+
+/**
+ * Handing over a job to the graph thread and waiting for it, as done by the previous approach:
+ * spawning a new std::thread for every run and joining it. Baseline for GraphDispatchExecutor.
+ */
+static void GraphDispatchThreadPerRun(benchmark::State& state)
+{
+	for (auto _ : state) {
+		std::thread thread{[]() {}};
+		thread.join();
+	}
+}
+BENCHMARK(GraphDispatchThreadPerRun)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Handing over a job to a long-lived GraphExecutor worker and waiting for it.
+ */
+static void GraphDispatchExecutor(benchmark::State& state)
+{
+	auto executor = GraphExecutor::create();
+	for (auto _ : state) {
+		executor->submit([]() {});
+		executor->waitIdle();
+	}
+}
+BENCHMARK(GraphDispatchExecutor)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Run-to-run latency of a small raytracing graph (rgl_graph_run + waiting for results),
+ * dominated by fixed per-run costs, such as handing over the work to the graph thread.
+ */
+static void GraphRunToRunRaytrace(benchmark::State& state)
+{
+	ScopedRGLCleanup cleanup;
+	BENCHMARK_RGL_CHECK(state, spawnCube(Mat3x4f::TRS({0, 0, 5}).toRGL()));
+	const std::vector<rgl_mat3x4f> rays = makeSparseLidarRays();
+	rgl_node_t useRays = nullptr, raytrace = nullptr, compact = nullptr;
+	BENCHMARK_RGL_CHECK(state, rgl_node_rays_from_mat3x4f(&useRays, rays.data(), rays.size()));
+	BENCHMARK_RGL_CHECK(state, rgl_node_raytrace(&raytrace, nullptr));
+	BENCHMARK_RGL_CHECK(state, rgl_node_points_compact_by_field(&compact, RGL_FIELD_IS_HIT_I32));
+	BENCHMARK_RGL_CHECK(state, rgl_graph_node_add_child(useRays, raytrace));
+	BENCHMARK_RGL_CHECK(state, rgl_graph_node_add_child(raytrace, compact));
+
+	for (auto _ : state) {
+		BENCHMARK_RGL_CHECK(state, rgl_graph_run(useRays));
+		int32_t pointCount = 0, pointSize = 0;
+		BENCHMARK_RGL_CHECK(state, rgl_graph_get_result_size(compact, XYZ_VEC3_F32, &pointCount, &pointSize));
+		benchmark::DoNotOptimize(pointCount);
+	}
+}
+BENCHMARK(GraphRunToRunRaytrace)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Run-to-run overhead of GraphRunCtx: a chain of cheap nodes is run and its result is awaited.
+ * Args: count of transform nodes in the chain, point count.
+ * With few points, the time is dominated by fixed per-run and per-node costs (scheduling, synchronization).
+ */
+static void GraphRunOverhead(benchmark::State& state)
+{
+	ScopedRGLCleanup cleanup;
+	const auto transformNodeCount = state.range(0);
+	const std::vector<Vec3f> points(state.range(1), Vec3f{1.0f, 2.0f, 3.0f});
+	const rgl_field_t field = XYZ_VEC3_F32;
+	const rgl_mat3x4f transform = Mat3x4f::translation(0.0f, 0.0f, 1.0f).toRGL();
+
+	rgl_node_t fromArray = nullptr;
+	BENCHMARK_RGL_CHECK(state, rgl_node_points_from_array(&fromArray, points.data(), points.size(), &field, 1));
+	rgl_node_t last = fromArray;
+	for (int64_t i = 0; i < transformNodeCount; ++i) {
+		rgl_node_t transformNode = nullptr;
+		BENCHMARK_RGL_CHECK(state, rgl_node_points_transform(&transformNode, &transform));
+		BENCHMARK_RGL_CHECK(state, rgl_graph_node_add_child(last, transformNode));
+		last = transformNode;
+	}
+
+	for (auto _ : state) {
+		BENCHMARK_RGL_CHECK(state, rgl_graph_run(fromArray));
+		int32_t pointCount = 0, pointSize = 0;
+		BENCHMARK_RGL_CHECK(state, rgl_graph_get_result_size(last, XYZ_VEC3_F32, &pointCount, &pointSize));
+		benchmark::DoNotOptimize(pointCount);
+	}
+	state.SetItemsProcessed(state.iterations() * (transformNodeCount + 1));
+}
+BENCHMARK(GraphRunOverhead)
+    ->ArgsProduct({{1, 8, 32}, {1, 100'000}})
+    ->ArgNames({"transforms", "points"})
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Run-to-run latency of the graph from GraphRunToRunRaytrace with the given wait strategy (spin count, yield count).
+ * Latency counters of the graph (rgl_graph_get_latency) are reported as well.
+ */
+static void GraphRunWaitStrategy(benchmark::State& state)
+{
+	ScopedRGLCleanup cleanup;
+	BENCHMARK_RGL_CHECK(state, spawnCube(Mat3x4f::TRS({0, 0, 5}).toRGL()));
+	const std::vector<rgl_mat3x4f> rays = makeSparseLidarRays();
+	rgl_node_t useRays = nullptr, raytrace = nullptr, compact = nullptr;
+	BENCHMARK_RGL_CHECK(state, rgl_node_rays_from_mat3x4f(&useRays, rays.data(), rays.size()));
+	BENCHMARK_RGL_CHECK(state, rgl_node_raytrace(&raytrace, nullptr));
+	BENCHMARK_RGL_CHECK(state, rgl_node_points_compact_by_field(&compact, RGL_FIELD_IS_HIT_I32));
+	BENCHMARK_RGL_CHECK(state, rgl_graph_node_add_child(useRays, raytrace));
+	BENCHMARK_RGL_CHECK(state, rgl_graph_node_add_child(raytrace, compact));
+	const auto spinCount = static_cast<int32_t>(state.range(0));
+	const auto yieldCount = static_cast<int32_t>(state.range(1));
+	BENCHMARK_RGL_CHECK(state, rgl_graph_set_wait_strategy(useRays, spinCount, yieldCount));
+
+	for (auto _ : state) {
+		BENCHMARK_RGL_CHECK(state, rgl_graph_run(useRays));
+		int32_t pointCount = 0, pointSize = 0;
+		BENCHMARK_RGL_CHECK(state, rgl_graph_get_result_size(compact, XYZ_VEC3_F32, &pointCount, &pointSize));
+		benchmark::DoNotOptimize(pointCount);
+	}
+
+	// Setting the strategy synchronizes the graph, so that the last run is counted too
+	BENCHMARK_RGL_CHECK(state, rgl_graph_set_wait_strategy(useRays, spinCount, yieldCount));
+	rgl_graph_latency_t latency;
+	BENCHMARK_RGL_CHECK(state, rgl_graph_get_latency(useRays, &latency));
+	state.counters["run_mean_us"] = latency.run_mean_us;
+	state.counters["run_max_us"] = latency.run_max_us;
+	state.counters["wakeup_mean_us"] = latency.wakeup_mean_us;
+	state.counters["wakeup_max_us"] = latency.wakeup_max_us;
+}
+BENCHMARK(GraphRunWaitStrategy)
+    ->Args({0, 0})
+    ->Args({100'000, 100})
+    ->ArgNames({"spins", "yields"})
+    ->Unit(benchmark::kMicrosecond);
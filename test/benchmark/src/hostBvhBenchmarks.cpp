@@ -0,0 +1,95 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <benchmarkHelpers.hpp>
+
+#include <scene/HostBVH.hpp>
+
+/**
+ * Heightfield over the XY plane with gridSize x gridSize quads (two triangles each), as in HostBVHTest.
+ */
+static std::vector<Aabb3Df> makeGridTriangleBounds(int gridSize, float waveTime = 0.0f)
+{
+	std::vector<Vec3f> vertices;
+	std::vector<Vec3i> indices;
+	const int rowSize = gridSize + 1;
+	for (int y = 0; y < rowSize; ++y) {
+		for (int x = 0; x < rowSize; ++x) {
+			const float height = std::sin(0.1f * static_cast<float>(x) + waveTime) * std::cos(0.1f * static_cast<float>(y));
+			vertices.emplace_back(static_cast<float>(x), static_cast<float>(y), height);
+		}
+	}
+	for (int y = 0; y < gridSize; ++y) {
+		for (int x = 0; x < gridSize; ++x) {
+			const int corner = y * rowSize + x;
+			indices.emplace_back(corner, corner + 1, corner + rowSize);
+			indices.emplace_back(corner + 1, corner + rowSize + 1, corner + rowSize);
+		}
+	}
+	return HostBVH::getTriangleBounds(vertices, indices);
+}
+
+/**
+ * Building BVH of an animated entity, serially (0) or with parallel subtrees (1).
+ */
+static void HostBVHBuild(benchmark::State& state)
+{
+	const auto triangleBounds = makeGridTriangleBounds(static_cast<int>(state.range(0)));
+	const bool allowParallelBuild = state.range(1) != 0;
+	for (auto _ : state) {
+		HostBVH bvh{triangleBounds, allowParallelBuild};
+		benchmark::DoNotOptimize(bvh.getNodes().data());
+	}
+	state.SetItemsProcessed(state.iterations() * triangleBounds.size());
+}
+BENCHMARK(HostBVHBuild)->ArgsProduct({{100, 400}, {0, 1}})->Unit(benchmark::kMillisecond);
+
+/**
+ * Refitting BVH of an animated entity to moved vertices, done instead of the build for most frames.
+ */
+static void HostBVHRefit(benchmark::State& state)
+{
+	const auto triangleBounds = makeGridTriangleBounds(static_cast<int>(state.range(0)));
+	const auto movedTriangleBounds = makeGridTriangleBounds(static_cast<int>(state.range(0)), 1.5f);
+	HostBVH bvh{triangleBounds};
+	for (auto _ : state) {
+		bvh.refit(movedTriangleBounds);
+		benchmark::DoNotOptimize(bvh.getNodes().data());
+	}
+	state.SetItemsProcessed(state.iterations() * triangleBounds.size());
+}
+BENCHMARK(HostBVHRefit)->Arg(100)->Arg(400)->Unit(benchmark::kMillisecond);
+
+/**
+ * Traversal only: rays from above the center of the grid in all directions, primitives are intersected by their bounds.
+ */
+static void HostBVHTraversal(benchmark::State& state)
+{
+	const auto triangleBounds = makeGridTriangleBounds(static_cast<int>(state.range(0)));
+	const HostBVH bvh{triangleBounds};
+	Aabb3Df meshBounds;
+	for (auto&& bounds : triangleBounds) {
+		meshBounds += bounds;
+	}
+	const Vec3f origin = (meshBounds.minCorner() + meshBounds.maxCorner()) * 0.5f + Vec3f{0.0f, 0.0f, 0.5f};
+	std::mt19937 gen{42};
+	std::normal_distribution<float> normal{0.0f, 1.0f};
+	std::vector<Vec3f> directions(100'000);
+	for (auto&& dir : directions) {
+		dir = Vec3f{normal(gen), normal(gen), normal(gen)}.normalized();
+	}
+	for (auto _ : state) {
+		for (auto&& dir : directions) {
+			float tMax = std::numeric_limits<float>::infinity();
+			bvh.intersect(origin, dir, tMax, [&](uint32_t primitiveIdx, float& tMaxPrimitive) {
+				const Aabb3Df& bounds = triangleBounds[primitiveIdx];
+				const Vec3f center = (bounds.minCorner() + bounds.maxCorner()) * 0.5f;
+				tMaxPrimitive = std::min(tMaxPrimitive, std::max((center - origin).dot(dir), 0.0f));
+			});
+			benchmark::DoNotOptimize(tMax);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * directions.size());
+}
+BENCHMARK(HostBVHTraversal)->Arg(100)->Arg(400)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,37 @@
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <rgl/api/core.h>
+
+/**
+ * Runs all benchmarks, printing results as JSON by default, so that they can be compared between runs
+ * (e.g. with compare.py from Google Benchmark tools). Other formats may be requested with --benchmark_format.
+ */
+int main(int argc, char** argv)
+{
+	std::vector<char*> args{argv, argv + argc};
+	char defaultFormat[] = "--benchmark_format=json";
+	bool hasFormat = false;
+	for (auto&& arg : args) {
+		hasFormat |= std::string_view{arg}.starts_with("--benchmark_format");
+	}
+	if (!hasFormat) {
+		args.push_back(defaultFormat);
+	}
+
+	// Logs would mix with results on stdout (and API call logging would be measured as well)
+	if (rgl_configure_logging(RGL_LOG_LEVEL_OFF, nullptr, false) != RGL_SUCCESS) {
+		return 1;
+	}
+
+	int argCount = static_cast<int>(args.size());
+	benchmark::Initialize(&argCount, args.data());
+	if (benchmark::ReportUnrecognizedArguments(argCount, args.data())) {
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return rgl_cleanup() == RGL_SUCCESS ? 0 : 1;
+}
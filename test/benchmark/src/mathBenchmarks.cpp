@@ -0,0 +1,85 @@
+#include <random>
+#include <vector>
+
+#include <benchmarkHelpers.hpp>
+
+#include <math/Mat3x4f.hpp>
+
+static std::vector<Vec3f> generatePoints(size_t count)
+{
+	std::mt19937 gen{42};
+	std::uniform_real_distribution<float> coord{-100.0f, 100.0f};
+	std::vector<Vec3f> points(count);
+	for (auto&& point : points) {
+		point = {coord(gen), coord(gen), coord(gen)};
+	}
+	return points;
+}
+
+static std::vector<Mat3x4f> generateTransforms(size_t count)
+{
+	std::mt19937 gen{42};
+	std::uniform_real_distribution<float> translation{-100.0f, 100.0f};
+	std::uniform_real_distribution<float> angle{-180.0f, 180.0f};
+	std::vector<Mat3x4f> transforms(count);
+	for (auto&& transform : transforms) {
+		transform = Mat3x4f::TRS({translation(gen), translation(gen), translation(gen)}, {angle(gen), angle(gen), angle(gen)});
+	}
+	return transforms;
+}
+
+/**
+ * Transforming points on the host (e.g. host-side nodes, TransformPointsNode fallback).
+ */
+static void Mat3x4fTransformPoints(benchmark::State& state)
+{
+	const auto points = generatePoints(state.range(0));
+	std::vector<Vec3f> transformed(points.size());
+	const Mat3x4f transform = Mat3x4f::TRS({1, 2, 3}, {10, 20, 30}, {1, 2, 1});
+	for (auto _ : state) {
+		for (size_t i = 0; i < points.size(); ++i) {
+			transformed[i] = transform * points[i];
+		}
+		benchmark::DoNotOptimize(transformed.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Mat3x4fTransformPoints)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+
+/**
+ * Composing transforms on the host (e.g. rays transformed by the sensor pose).
+ */
+static void Mat3x4fComposeTransforms(benchmark::State& state)
+{
+	const auto transforms = generateTransforms(state.range(0));
+	std::vector<Mat3x4f> composed(transforms.size());
+	const Mat3x4f pose = Mat3x4f::TRS({1, 2, 3}, {10, 20, 30});
+	for (auto _ : state) {
+		for (size_t i = 0; i < transforms.size(); ++i) {
+			composed[i] = pose * transforms[i];
+		}
+		benchmark::DoNotOptimize(composed.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Mat3x4fComposeTransforms)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+
+/**
+ * Inverting transforms on the host (e.g. entity transforms when building the host traversal scene).
+ */
+static void Mat3x4fInverse(benchmark::State& state)
+{
+	const auto transforms = generateTransforms(state.range(0));
+	std::vector<Mat3x4f> inverted(transforms.size());
+	for (auto _ : state) {
+		for (size_t i = 0; i < transforms.size(); ++i) {
+			inverted[i] = transforms[i].inverse();
+		}
+		benchmark::DoNotOptimize(inverted.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Mat3x4fInverse)->RangeMultiplier(16)->Range(1 << 10, 1 << 16);
@@ -0,0 +1,137 @@
+#include <benchmarkHelpers.hpp>
+
+#include <CacheManager.hpp>
+#include <RGLFields.hpp>
+#include <macros/cuda.hpp>
+#include <memory/Array.hpp>
+
+/**
+ * Creates an empty array of the given kind; async device arrays share a single stream.
+ */
+template<template<typename> typename ArrayT>
+typename ArrayT<char>::Ptr createArray()
+{
+	if constexpr (std::is_same_v<ArrayT<char>, DeviceAsyncArray<char>>) {
+		static CudaStream::Ptr stream = CudaStream::create(cudaStreamNonBlocking);
+		return DeviceAsyncArray<char>::create(stream);
+	} else {
+		return ArrayT<char>::create();
+	}
+}
+
+/**
+ * Waits for operations enqueued on the array, so that their cost is included in the measured time.
+ */
+static void synchronize(const IAnyArray::ConstPtr& array)
+{
+	if (!isHost(array->getMemoryKind())) {
+		CHECK_CUDA(cudaDeviceSynchronize());
+	}
+}
+
+static void setBytesProcessed(benchmark::State& state, int64_t bytesPerIteration)
+{
+	state.SetBytesProcessed(state.iterations() * bytesPerIteration);
+}
+
+/**
+ * Allocation (and release) of a new array, as done by nodes creating arrays on each run.
+ */
+template<template<typename> typename ArrayT>
+static void ArrayCreateAndResize(benchmark::State& state)
+{
+	const auto byteCount = static_cast<size_t>(state.range(0));
+	for (auto _ : state) {
+		auto array = createArray<ArrayT>();
+		array->resize(byteCount, false, false);
+		synchronize(array);
+		benchmark::DoNotOptimize(array->getRawWritePtr());
+	}
+	setBytesProcessed(state, state.range(0));
+}
+
+/**
+ * Resizing within the capacity with zero-initialization, as done by nodes reusing their arrays between runs.
+ */
+template<template<typename> typename ArrayT>
+static void ArrayResizeZeroInit(benchmark::State& state)
+{
+	const auto byteCount = static_cast<size_t>(state.range(0));
+	auto array = createArray<ArrayT>();
+	array->reserve(byteCount, false);
+	for (auto _ : state) {
+		array->resize(byteCount / 2, true, false);
+		array->resize(byteCount, true, false);
+		synchronize(array);
+	}
+	setBytesProcessed(state, state.range(0) + state.range(0) / 2);
+}
+
+/**
+ * IAnyArray::copyFrom between arrays of (possibly) different kinds.
+ */
+template<template<typename> typename SrcArrayT, template<typename> typename DstArrayT>
+static void ArrayCopy(benchmark::State& state)
+{
+	const auto byteCount = static_cast<size_t>(state.range(0));
+	auto src = createArray<SrcArrayT>();
+	src->resize(byteCount, true, false);
+	synchronize(src);
+	IAnyArray::Ptr dst = createArray<DstArrayT>();
+	for (auto _ : state) {
+		dst->copyFrom(src);
+		synchronize(dst);
+	}
+	setBytesProcessed(state, state.range(0));
+}
+
+static void applyArraySizes(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->RangeMultiplier(16)->Range(1 << 10, 1 << 26); // 1 KiB - 64 MiB
+}
+
+BENCHMARK_TEMPLATE(ArrayCreateAndResize, HostPageableArray)->Apply(applyArraySizes);
+BENCHMARK_TEMPLATE(ArrayCreateAndResize, HostPinnedArray)->Apply(applyArraySizes);
+BENCHMARK_TEMPLATE(ArrayCreateAndResize, DeviceSyncArray)->Apply(applyArraySizes);
+BENCHMARK_TEMPLATE(ArrayCreateAndResize, DeviceAsyncArray)->Apply(applyArraySizes);
+
+BENCHMARK_TEMPLATE(ArrayResizeZeroInit, HostPageableArray)->Apply(applyArraySizes);
+BENCHMARK_TEMPLATE(ArrayResizeZeroInit, HostPinnedArray)->Apply(applyArraySizes);
+BENCHMARK_TEMPLATE(ArrayResizeZeroInit, DeviceAsyncArray)->Apply(applyArraySizes);
+
+BENCHMARK_TEMPLATE2(ArrayCopy, HostPageableArray, HostPageableArray)->Apply(applyArraySizes);
+BENCHMARK_TEMPLATE2(ArrayCopy, HostPageableArray, DeviceAsyncArray)->Apply(applyArraySizes);
+BENCHMARK_TEMPLATE2(ArrayCopy, HostPinnedArray, DeviceAsyncArray)->Apply(applyArraySizes);
+BENCHMARK_TEMPLATE2(ArrayCopy, DeviceAsyncArray, HostPinnedArray)->Apply(applyArraySizes);
+BENCHMARK_TEMPLATE2(ArrayCopy, DeviceAsyncArray, DeviceAsyncArray)->Apply(applyArraySizes);
+
+/**
+ * Per-run bookkeeping of a node caching output fields (e.g. CompactByFieldPointsNode):
+ * aging entries, then looking up (and marking as updated) each requested field.
+ */
+static void CacheManagerRun(benchmark::State& state)
+{
+	const auto fieldCount = static_cast<size_t>(state.range(0));
+	std::vector<rgl_field_t> fields;
+	for (auto&& field : getAllRealFields()) {
+		if (fields.size() < fieldCount) {
+			fields.push_back(field);
+		}
+	}
+	CacheManager<rgl_field_t, IAnyArray::Ptr> cacheManager;
+	for (auto _ : state) {
+		cacheManager.trigger();
+		for (auto&& field : fields) {
+			if (!cacheManager.contains(field)) {
+				IAnyArray::Ptr fieldData = HostPageableArray<char>::create();
+				cacheManager.insert(field, fieldData, true);
+			}
+			if (!cacheManager.isLatest(field)) {
+				benchmark::DoNotOptimize(cacheManager.getValue(field));
+				cacheManager.setUpdated(field);
+			}
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(CacheManagerRun)->Arg(4)->Arg(16)->Arg(static_cast<int64_t>(getAllRealFields().size()));
@@ -0,0 +1,142 @@
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include <benchmarkHelpers.hpp>
+#include <helpers/radarClusteringHelpers.hpp>
+
+#include <RGLFields.hpp>
+
+/**
+ * Clustering done by RadarPostprocessPointsNode on every run, with the grid-indexed RadarClusterBuilder.
+ */
+static void RadarClustering(benchmark::State& state)
+{
+	const auto input = RadarClusteringInput::generate(state.range(0), state.range(1), 42);
+	RadarClusterBuilder builder; // Reused between runs, like in the node
+	for (auto _ : state) {
+		const auto& clusters = input.buildClusters(builder);
+		benchmark::DoNotOptimize(clusters.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(RadarClustering)
+    ->Args({2'000, 100})
+    ->Args({5'000, 250})
+    ->Args({20'000, 1'000})
+    ->Args({50'000, 2'500})
+    ->ArgNames({"points", "objects"})
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Straightforward clustering that RadarClusterBuilder is tested against (every point against every cluster,
+ * merging restarted after every merge), for comparison with RadarClustering. It scales quadratically or worse,
+ * so it is measured on smaller sets only.
+ */
+static void RadarClusteringReference(benchmark::State& state)
+{
+	const auto input = RadarClusteringInput::generate(state.range(0), state.range(1), 42);
+	for (auto _ : state) {
+		const auto clusters = input.buildClustersReference();
+		benchmark::DoNotOptimize(clusters.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(RadarClusteringReference)
+    ->Args({2'000, 100})
+    ->Args({5'000, 250})
+    ->ArgNames({"points", "objects"})
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Input of RadarTrackObjectsNode (see its getRequiredFieldList()).
+ */
+struct RadarDetection
+{
+	Field<XYZ_VEC3_F32>::type xyz;
+	Field<DISTANCE_F32>::type distance;
+	Field<AZIMUTH_F32>::type azimuth;
+	Field<ELEVATION_F32>::type elevation;
+	Field<RADIAL_SPEED_F32>::type radialSpeed;
+	Field<ENTITY_ID_I32>::type entityId;
+	Field<RELATIVE_VELOCITY_VEC3_F32>::type relativeVelocity;
+	Field<ABSOLUTE_VELOCITY_VEC3_F32>::type absoluteVelocity;
+
+	static inline const std::vector<rgl_field_t> fields = {
+	    XYZ_VEC3_F32,
+	    DISTANCE_F32,
+	    AZIMUTH_F32,
+	    ELEVATION_F32,
+	    RADIAL_SPEED_F32,
+	    ENTITY_ID_I32,
+	    RELATIVE_VELOCITY_VEC3_F32,
+	    ABSOLUTE_VELOCITY_VEC3_F32,
+	};
+};
+static_assert(sizeof(RadarDetection) == 14 * sizeof(float)); // No padding between fields
+
+/**
+ * Tracking done by RadarTrackObjectsNode, run in a graph on consecutive frames of slowly moving objects.
+ * Args: object count, detections per object; 500 x 8 is the scale of RadarTrackObjectsNodeTest.many_objects_tracking_test.
+ */
+static void RadarTrackObjects(benchmark::State& state)
+{
+	ScopedRGLCleanup cleanup;
+	const auto objectCount = static_cast<size_t>(state.range(0));
+	const auto detectionsPerObject = static_cast<size_t>(state.range(1));
+	const uint64_t frameTimeNs = 50'000'000;
+
+	// Objects circle around their centers, so frames can be replayed in a loop
+	const int frameCount = 32;
+	std::mt19937 gen{42};
+	std::uniform_real_distribution<float> centerCoord{-40.0f, 40.0f};
+	std::normal_distribution<float> spread{0.0f, 0.3f};
+	std::vector<Vec3f> objectCenters(objectCount);
+	for (auto&& center : objectCenters) {
+		center = {std::abs(centerCoord(gen)) + 5.0f, centerCoord(gen), 0.0f};
+	}
+	std::vector<std::vector<RadarDetection>> frames(frameCount);
+	for (int frame = 0; frame < frameCount; ++frame) {
+		const float phase = 2.0f * std::numbers::pi_v<float> * static_cast<float>(frame) / frameCount;
+		for (size_t object = 0; object < objectCount; ++object) {
+			const Vec3f center = objectCenters[object] + Vec3f{std::cos(phase), std::sin(phase), 0.0f} * 0.5f;
+			for (size_t i = 0; i < detectionsPerObject; ++i) {
+				const Vec3f xyz = center + Vec3f{spread(gen), spread(gen), spread(gen)};
+				const Vec3f spherical = xyz.toSpherical();
+				frames[frame].push_back({
+				    .xyz = xyz,
+				    .distance = spherical[0],
+				    .azimuth = spherical[1],
+				    .elevation = spherical[2],
+				    .radialSpeed = 1.0f + 0.1f * spread(gen),
+				    .entityId = static_cast<int32_t>(object),
+				    .relativeVelocity = Vec3f{0.0f},
+				    .absoluteVelocity = Vec3f{0.0f},
+				});
+			}
+		}
+	}
+
+	rgl_node_t fromArray = nullptr, trackObjects = nullptr;
+	const auto& fields = RadarDetection::fields;
+	BENCHMARK_RGL_CHECK(state, rgl_node_points_from_array(&fromArray, frames[0].data(), frames[0].size(), fields.data(),
+	                                                      fields.size()));
+	BENCHMARK_RGL_CHECK(state, rgl_node_points_radar_track_objects(&trackObjects, 2.0f, 0.5f, 0.5f, 0.5f, 1.0f, 500.0f, 0.01f));
+	BENCHMARK_RGL_CHECK(state, rgl_graph_node_add_child(fromArray, trackObjects));
+
+	uint64_t timeNs = 0;
+	int64_t frame = 0;
+	for (auto _ : state) {
+		const auto& detections = frames[frame++ % frameCount];
+		BENCHMARK_RGL_CHECK(state, rgl_node_points_from_array(&fromArray, detections.data(), detections.size(),
+		                                                      fields.data(), fields.size()));
+		BENCHMARK_RGL_CHECK(state, rgl_scene_set_time(nullptr, timeNs += frameTimeNs));
+		BENCHMARK_RGL_CHECK(state, rgl_graph_run(fromArray));
+		int32_t trackedObjectCount = 0, pointSize = 0;
+		BENCHMARK_RGL_CHECK(state, rgl_graph_get_result_size(trackObjects, XYZ_VEC3_F32, &trackedObjectCount, &pointSize));
+		benchmark::DoNotOptimize(trackedObjectCount);
+	}
+	state.SetItemsProcessed(state.iterations() * objectCount * detectionsPerObject);
+}
+BENCHMARK(RadarTrackObjects)->Args({8, 16})->Args({64, 16})->Args({256, 8})->Args({500, 8})->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,106 @@
+#include <random>
+#include <vector>
+
+#include <benchmarkHelpers.hpp>
+
+#include <HostKernels.hpp>
+#include <math/Philox.hpp>
+
+/**
+ * Baseline: sequential generator with state, as used before noise nodes switched to Philox.
+ */
+static void NormalsMersenneTwister(benchmark::State& state)
+{
+	std::mt19937 gen{42};
+	std::normal_distribution<float> normal{0.0f, 1.0f};
+	std::vector<float> normals(state.range(0));
+	for (auto _ : state) {
+		for (auto&& sample : normals) {
+			sample = normal(gen);
+		}
+		benchmark::DoNotOptimize(normals.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(NormalsMersenneTwister)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+
+/**
+ * Philox4x32::normal called per element, the same code as in device kernels.
+ */
+static void NormalsPhiloxScalar(benchmark::State& state)
+{
+	std::vector<float> normals(state.range(0));
+	uint32_t frame = 0;
+	for (auto _ : state) {
+		for (size_t i = 0; i < normals.size(); ++i) {
+			normals[i] = Philox4x32::normal(42, frame, static_cast<uint32_t>(i));
+		}
+		++frame;
+		benchmark::DoNotOptimize(normals.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(NormalsPhiloxScalar)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+
+/**
+ * hostGenerateNormals, generating random bits for multiple elements at once with SIMD.
+ */
+static void NormalsPhiloxHost(benchmark::State& state)
+{
+	std::vector<float> normals(state.range(0));
+	uint32_t frame = 0;
+	for (auto _ : state) {
+		hostGenerateNormals(42, frame++, 0, normals.size(), normals.data());
+		benchmark::DoNotOptimize(normals.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(NormalsPhiloxHost)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+
+/**
+ * Random bits only, without transforming them to the normal distribution, which dominates the cost otherwise.
+ */
+static void BitsPhiloxScalar(benchmark::State& state)
+{
+	std::vector<uint32_t> bits(state.range(0));
+	uint32_t frame = 0;
+	for (auto _ : state) {
+		for (size_t i = 0; i < bits.size(); ++i) {
+			bits[i] = Philox4x32::generate(42, frame, static_cast<uint32_t>(i)).x[0];
+		}
+		++frame;
+		benchmark::DoNotOptimize(bits.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BitsPhiloxScalar)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+
+/**
+ * Host Gaussian noise node path (hostAddGaussianNoiseDistance), including the worker pool.
+ */
+static void GaussianNoiseDistanceHost(benchmark::State& state)
+{
+	std::mt19937 gen{42};
+	std::uniform_real_distribution<float> coord{-100.0f, 100.0f};
+	std::vector<Vec3f> points(state.range(0));
+	std::vector<float> distances(points.size());
+	for (size_t i = 0; i < points.size(); ++i) {
+		points[i] = {coord(gen), coord(gen), coord(gen)};
+		distances[i] = points[i].length();
+	}
+	std::vector<Vec3f> outPoints(points.size());
+	std::vector<float> outDistances(points.size());
+	uint32_t frame = 0;
+	for (auto _ : state) {
+		hostAddGaussianNoiseDistance(points.size(), 0.0f, 0.02f, 0.001f, Mat3x4f::identity(), 42, frame++, points.data(),
+		                             distances.data(), outPoints.data(), outDistances.data());
+		benchmark::DoNotOptimize(outPoints.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(GaussianNoiseDistanceHost)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
@@ -0,0 +1,113 @@
+#include <filesystem>
+#include <vector>
+
+#include <benchmarkHelpers.hpp>
+
+#include <rgl/api/extensions/tape.h>
+#include <math/Mat3x4f.hpp>
+#include <tape/tapeDefinitions.hpp>
+
+static const std::vector<rgl_vec3f> cubeVertices = {
+    {-1, -1, -1},
+    {1, -1, -1},
+    {1, 1, -1},
+    {-1, 1, -1},
+    {-1, -1, 1},
+    {1, -1, 1},
+    {1, 1, 1},
+    {-1, 1, 1},
+};
+static const std::vector<rgl_vec3i> cubeIndices = {
+    {0, 3, 1},
+    {3, 2, 1},
+    {1, 2, 5},
+    {2, 6, 5},
+    {5, 6, 4},
+    {6, 7, 4},
+    {4, 7, 0},
+    {7, 3, 0},
+    {3, 7, 2},
+    {7, 6, 2},
+    {4, 0, 5},
+    {0, 1, 5},
+};
+
+static std::string getTapePath() { return (std::filesystem::temp_directory_path() / "rglBenchmarkTape").string(); }
+
+static void removeTape(const std::string& path)
+{
+	std::filesystem::remove(path + YAML_EXTENSION);
+	std::filesystem::remove(path + BIN_EXTENSION);
+	std::filesystem::remove(path + CALLS_EXTENSION);
+}
+
+/**
+ * Throughput of recording a typical per-frame call (entity transform update).
+ * Args: recorded call count, whether the recording is asynchronous (see rgl_tape_record_begin_async).
+ */
+static void TapeRecord(benchmark::State& state)
+{
+	ScopedRGLCleanup cleanup;
+	const auto callCount = state.range(0);
+	const bool isAsync = state.range(1) != 0;
+	const std::string path = getTapePath();
+
+	rgl_mesh_t mesh = nullptr;
+	rgl_entity_t entity = nullptr;
+	BENCHMARK_RGL_CHECK(state, rgl_mesh_create(&mesh, cubeVertices.data(), cubeVertices.size(), cubeIndices.data(),
+	                                           cubeIndices.size()));
+	BENCHMARK_RGL_CHECK(state, rgl_entity_create(&entity, nullptr, mesh));
+
+	for (auto _ : state) {
+		if (isAsync) {
+			BENCHMARK_RGL_CHECK(state, rgl_tape_record_begin_async(path.c_str(), 64 * 1024 * 1024, RGL_TAPE_OVERFLOW_BLOCK));
+		} else {
+			BENCHMARK_RGL_CHECK(state, rgl_tape_record_begin(path.c_str()));
+		}
+		for (int64_t i = 0; i < callCount; ++i) {
+			const rgl_mat3x4f transform = Mat3x4f::translation(static_cast<float>(i), 0.0f, 0.0f).toRGL();
+			BENCHMARK_RGL_CHECK(state, rgl_entity_set_transform(entity, &transform));
+		}
+		BENCHMARK_RGL_CHECK(state, rgl_tape_record_end());
+	}
+	removeTape(path);
+	state.SetItemsProcessed(state.iterations() * callCount);
+}
+BENCHMARK(TapeRecord)
+    ->ArgsProduct({{1'000, 10'000}, {0, 1}})
+    ->ArgNames({"calls", "async"})
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * Throughput of replaying a tape with a scene setup followed by transform updates.
+ * Args: recorded transform update count.
+ */
+static void TapePlay(benchmark::State& state)
+{
+	ScopedRGLCleanup cleanup;
+	const auto callCount = state.range(0);
+	const std::string path = getTapePath();
+
+	BENCHMARK_RGL_CHECK(state, rgl_tape_record_begin(path.c_str()));
+	rgl_mesh_t mesh = nullptr;
+	rgl_entity_t entity = nullptr;
+	BENCHMARK_RGL_CHECK(state, rgl_mesh_create(&mesh, cubeVertices.data(), cubeVertices.size(), cubeIndices.data(),
+	                                           cubeIndices.size()));
+	BENCHMARK_RGL_CHECK(state, rgl_entity_create(&entity, nullptr, mesh));
+	for (int64_t i = 0; i < callCount; ++i) {
+		const rgl_mat3x4f transform = Mat3x4f::translation(static_cast<float>(i), 0.0f, 0.0f).toRGL();
+		BENCHMARK_RGL_CHECK(state, rgl_entity_set_transform(entity, &transform));
+	}
+	BENCHMARK_RGL_CHECK(state, rgl_tape_record_end());
+
+	for (auto _ : state) {
+		BENCHMARK_RGL_CHECK(state, rgl_tape_play(path.c_str()));
+		// Objects created by the playback are not a part of the measurement
+		state.PauseTiming();
+		BENCHMARK_RGL_CHECK(state, rgl_cleanup());
+		state.ResumeTiming();
+	}
+	removeTape(path);
+	state.SetItemsProcessed(state.iterations() * (callCount + 2));
+}
+BENCHMARK(TapePlay)->Arg(1'000)->Arg(10'000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include <graph/RadarClustering.hpp>
+
+/**
+ * Synthetic radar detections: points scattered around randomly placed objects.
+ */
+struct RadarClusteringInput
+{
+	std::vector<rgl_radar_scope_t> radarScopes;
+	std::vector<float> distances;
+	std::vector<float> azimuths;
+	std::vector<float> radialSpeeds;
+	std::vector<float> elevations;
+
+	static RadarClusteringInput generate(size_t pointCount, size_t objectCount, unsigned seed, bool hasRadialSpeed = true)
+	{
+		RadarClusteringInput input;
+		input.radarScopes = {
+		    rgl_radar_scope_t{ .begin_distance = 0.0f,
+		                      .end_distance = 40.0f,
+		                      .distance_separation_threshold = 0.5f,
+		                      .radial_speed_separation_threshold = 0.5f,
+		                      .azimuth_separation_threshold = 0.02f},
+		    rgl_radar_scope_t{.begin_distance = 40.0f,
+		                      .end_distance = 120.0f,
+		                      .distance_separation_threshold = 1.5f,
+		                      .radial_speed_separation_threshold = 1.0f,
+		                      .azimuth_separation_threshold = 0.01f},
+		};
+
+		std::mt19937 gen{seed};
+		std::uniform_real_distribution<float> objectDistance{0.5f, 125.0f}; // Some points are outside of scopes
+		std::uniform_real_distribution<float> objectAzimuth{-std::numbers::pi_v<float> / 3, std::numbers::pi_v<float> / 3};
+		std::uniform_real_distribution<float> objectRadialSpeed{-20.0f, 20.0f};
+		std::uniform_real_distribution<float> objectSize{0.3f, 5.0f};
+		std::uniform_int_distribution<size_t> objectIdx{0, objectCount - 1};
+		std::uniform_real_distribution<float> offset{-0.5f, 0.5f};
+
+		struct Object
+		{
+			float distance, azimuth, radialSpeed, size;
+		};
+		std::vector<Object> objects(objectCount);
+		for (auto&& object : objects) {
+			object = {objectDistance(gen), objectAzimuth(gen), objectRadialSpeed(gen), objectSize(gen)};
+		}
+		for (size_t i = 0; i < pointCount; ++i) {
+			const auto& object = objects[objectIdx(gen)];
+			input.distances.emplace_back(object.distance + object.size * offset(gen));
+			input.azimuths.emplace_back(object.azimuth + object.size / object.distance * offset(gen));
+			input.radialSpeeds.emplace_back(hasRadialSpeed ? object.radialSpeed + 0.2f * offset(gen) : NAN);
+			input.elevations.emplace_back(0.1f * offset(gen));
+		}
+		return input;
+	}
+
+	std::vector<RadarCluster>& buildClusters(RadarClusterBuilder& builder) const
+	{
+		return builder.build(radarScopes, distances.size(), distances.data(), azimuths.data(), radialSpeeds.data(),
+		                     elevations.data());
+	}
+
+	/**
+	 * Straightforward clustering: every point is tested against every cluster and the merging restarts after every merge.
+	 */
+	std::vector<RadarCluster> buildClustersReference() const
+	{
+		std::vector<RadarCluster> clusters;
+		for (int i = 0; i < distances.size(); ++i) {
+			const auto radarScope = getRadarScopeWithinDistance(radarScopes, distances[i]);
+			if (!radarScope.has_value()) {
+				continue;
+			}
+			bool isPointClustered = false;
+			for (auto&& cluster : clusters) {
+				if (cluster.isCandidate(distances[i], azimuths[i], radialSpeeds[i], radarScope.value())) {
+					cluster.addPoint(i, distances[i], azimuths[i], radialSpeeds[i], elevations[i]);
+					isPointClustered = true;
+					break;
+				}
+			}
+			if (!isPointClustered) {
+				clusters.emplace_back(i, distances[i], azimuths[i], radialSpeeds[i], elevations[i]);
+			}
+		}
+
+		bool allClustersGood = false;
+		while (clusters.size() > 1 && !allClustersGood) {
+			allClustersGood = true;
+			for (int i = 0; i < clusters.size(); ++i) {
+				for (int j = i + 1; j < clusters.size(); ++j) {
+					if (clusters[i].canMergeWith(clusters[j], radarScopes)) {
+						clusters[i].takeIndicesFrom(std::move(clusters[j]));
+						clusters.erase(clusters.begin() + j);
+						allClustersGood = false;
+						break;
+					}
+				}
+				if (!allClustersGood) {
+					break;
+				}
+			}
+		}
+		return clusters;
+	}
+};
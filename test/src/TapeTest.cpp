@@ -1,4 +1,5 @@
 #include <filesystem>
+#include <thread>
 
 #include "helpers/sceneHelpers.hpp"
 #include "helpers/commonHelpers.hpp"
@@ -6,9 +7,16 @@
 #include "helpers/textureHelpers.hpp"
 
 #include "RGLFields.hpp"
+#include "RGLExceptions.hpp"
 #include "rgl/api/extensions/tape.h"
 #include "math/Mat3x4f.hpp"
 #include "tape/tapeDefinitions.hpp"
+#include "tape/TapeCallStream.hpp"
+#include "tape/TapeConverter.hpp"
+#include "tape/AsyncTapeWriter.hpp"
+#include "tape/BlobHash.hpp"
+#include "tape/TapeIndex.hpp"
+#include "tape/TapePlayer.hpp"
 
 #if RGL_BUILD_PCL_EXTENSION
 #include "rgl/api/extensions/pcl.h"
@@ -255,6 +263,12 @@ TEST_F(TapeTest, RecordPlayAllCalls)
 	rgl_return_mode_t returnMode = RGL_RETURN_FIRST;
 	EXPECT_RGL_SUCCESS(rgl_node_raytrace_configure_return_mode(raytrace, returnMode));
 
+	int32_t batchId = 1;
+	EXPECT_RGL_SUCCESS(rgl_node_raytrace_configure_batch(raytrace, batchId));
+
+	rgl_raytrace_backend_t backend = RGL_RAYTRACE_BACKEND_OPTIX;
+	EXPECT_RGL_SUCCESS(rgl_node_raytrace_configure_backend(raytrace, backend));
+
 	rgl_node_t format = nullptr;
 	std::vector<rgl_field_t> fields = {RGL_FIELD_XYZ_VEC3_F32, RGL_FIELD_DISTANCE_F32};
 	EXPECT_RGL_SUCCESS(rgl_node_points_format(&format, fields.data(), fields.size()));
@@ -275,6 +289,7 @@ TEST_F(TapeTest, RecordPlayAllCalls)
 	rgl_node_t temporalMerge = nullptr;
 	std::vector<rgl_field_t> tMergeFields = {RGL_FIELD_XYZ_VEC3_F32, RGL_FIELD_DISTANCE_F32, RGL_FIELD_PADDING_32};
 	EXPECT_RGL_SUCCESS(rgl_node_points_temporal_merge(&temporalMerge, tMergeFields.data(), tMergeFields.size()));
+	EXPECT_RGL_SUCCESS(rgl_node_points_temporal_merge_configure_window(temporalMerge, 10, 1.0f));
 
 	rgl_node_t usePoints = nullptr;
 	std::vector<rgl_field_t> usePointsFields = {RGL_FIELD_XYZ_VEC3_F32};
@@ -338,7 +353,13 @@ TEST_F(TapeTest, RecordPlayAllCalls)
 	EXPECT_RGL_SUCCESS(rgl_graph_node_add_child(raytrace, filterGround));
 	EXPECT_RGL_SUCCESS(rgl_graph_node_add_child(filterGround, compactByFieldGround));
 
+	EXPECT_RGL_SUCCESS(rgl_graph_set_wait_strategy(raytrace, 1000, 10));
+	EXPECT_RGL_SUCCESS(rgl_graph_set_profiling(raytrace, true));
 	EXPECT_RGL_SUCCESS(rgl_graph_run(raytrace));
+	rgl_graph_latency_t latency;
+	EXPECT_RGL_SUCCESS(rgl_graph_get_latency(raytrace, &latency));
+	rgl_node_stats_t nodeStats;
+	EXPECT_RGL_SUCCESS(rgl_graph_get_node_stats(raytrace, &nodeStats));
 
 #if RGL_BUILD_PCL_EXTENSION
 	rgl_node_t downsample = nullptr;
@@ -411,6 +432,14 @@ void testCubeSceneOnGraph()
 	std::vector<FormatStruct> formatData{static_cast<long unsigned int>(outCount)};
 	EXPECT_RGL_SUCCESS(rgl_graph_get_result_data(format, RGL_FIELD_DYNAMIC_FORMAT, formatData.data()));
 
+	std::vector<FormatStruct> formatBuffer{static_cast<long unsigned int>(outCount)};
+	EXPECT_RGL_SUCCESS(rgl_graph_set_result_buffer(format, RGL_FIELD_DYNAMIC_FORMAT, formatBuffer.data(),
+	                                               formatBuffer.size() * sizeof(FormatStruct)));
+	EXPECT_RGL_SUCCESS(rgl_graph_run(raytrace));
+	int32_t ready = 0;
+	EXPECT_RGL_SUCCESS(rgl_graph_query_result_buffer(format, RGL_FIELD_DYNAMIC_FORMAT, &ready, nullptr));
+	EXPECT_RGL_SUCCESS(rgl_graph_set_result_buffer(format, RGL_FIELD_DYNAMIC_FORMAT, nullptr, 0));
+
 	for (int i = 0; i < formatData.size(); ++i) {
 		EXPECT_NEAR(formatData[i].xyz[0], rays[i].value[0][3], 1e-6);
 		EXPECT_NEAR(formatData[i].xyz[1], rays[i].value[1][3], 1e-6);
@@ -437,3 +466,445 @@ TEST_F(TapeTest, SceneReconstruction)
 
 	testCubeSceneOnGraph();
 }
+
+TEST_F(TapeTest, SceneReconstructionFromYAML)
+{
+	std::string cubeSceneRecordPath{
+	    (std::filesystem::temp_directory_path() / std::filesystem::path("cubeSceneYamlRecord")).string()};
+	ASSERT_RGL_SUCCESS(rgl_tape_record_begin(cubeSceneRecordPath.c_str()));
+	auto mesh = makeCubeMesh();
+	auto entity = makeEntity(mesh);
+	rgl_mat3x4f entityPoseTf = Mat3x4f::identity().toRGL();
+	ASSERT_RGL_SUCCESS(rgl_entity_set_transform(entity, &entityPoseTf));
+	ASSERT_RGL_SUCCESS(rgl_tape_record_end());
+
+	// Tapes recorded in the YAML format are still playable
+	TapeConverter::convertCallsTapeToYaml(cubeSceneRecordPath);
+	ASSERT_TRUE(std::filesystem::remove(createTempFilePath("cubeSceneYamlRecord", CALLS_EXTENSION)));
+
+	ASSERT_RGL_SUCCESS(rgl_cleanup());
+	ASSERT_RGL_SUCCESS(rgl_tape_play(cubeSceneRecordPath.c_str()));
+	testCubeSceneOnGraph();
+
+	// And can be converted back
+	TapeConverter::convertYamlTapeToCalls(cubeSceneRecordPath);
+	ASSERT_TRUE(std::filesystem::remove(createTempFilePath("cubeSceneYamlRecord", YAML_EXT)));
+
+	ASSERT_RGL_SUCCESS(rgl_cleanup());
+	ASSERT_RGL_SUCCESS(rgl_tape_play(cubeSceneRecordPath.c_str()));
+	testCubeSceneOnGraph();
+}
+
+TEST_F(TapeTest, CallStreamRoundTrip)
+{
+	std::vector<uint8_t> stream;
+	size_t chunkCount = 0;
+	TapeCallWriter writer([&](const uint8_t* data, size_t size) {
+		stream.insert(stream.end(), data, data + size);
+		++chunkCount;
+	});
+
+	// Enough calls to span multiple chunks
+	constexpr int callCount = 10'000;
+	for (int i = 0; i < callCount; ++i) {
+		writer.beginCall(i % 2 == 0 ? "rgl_even" : "rgl_odd", i);
+		writer.addArg(int32_t{-i});
+		writer.addArg(uint64_t{UINT64_MAX});
+		writer.addArg(0.1f * static_cast<float>(i));
+		writer.addArg(NAN);
+		writer.addArg(0.1 * i);
+		writer.addArg(i % 3 == 0);
+		writer.addArg(fmt::format("arg{}", i).c_str());
+		writer.endCall();
+	}
+	writer.flush();
+	EXPECT_GT(chunkCount, 2); // File header and at least two chunks
+
+	TapeCallReader reader({stream.data(), stream.size()});
+	ASSERT_EQ(reader.getCallCount(), callCount);
+	for (int i = 0; i < callCount; ++i) {
+		EXPECT_EQ(reader.getFnName(i), i % 2 == 0 ? "rgl_even" : "rgl_odd");
+		const auto call = reader.getTapeCall(i);
+		EXPECT_EQ(call.getFnName(), reader.getFnName(i));
+		EXPECT_EQ(call.getTimestamp().asNanoseconds(), i);
+		const auto args = call.getArgsNode();
+		ASSERT_EQ(args.size(), 7);
+		EXPECT_EQ(args[0].as<int32_t>(), -i);
+		EXPECT_EQ(args[1].as<uint64_t>(), UINT64_MAX);
+		EXPECT_EQ(args[2].as<float>(), 0.1f * static_cast<float>(i));
+		EXPECT_TRUE(std::isnan(args[3].as<float>()));
+		EXPECT_EQ(args[4].as<double>(), 0.1 * i);
+		EXPECT_EQ(args[5].as<bool>(), i % 3 == 0);
+		EXPECT_EQ(args[6].as<std::string>(), fmt::format("arg{}", i));
+	}
+}
+
+TEST_F(TapeTest, CallStreamInterruptedRecording)
+{
+	std::vector<uint8_t> stream;
+	std::vector<size_t> chunkEnds;
+	TapeCallWriter writer([&](const uint8_t* data, size_t size) {
+		stream.insert(stream.end(), data, data + size);
+		chunkEnds.push_back(stream.size());
+	});
+	writer.beginCall("rgl_first", 0);
+	writer.addArg(1);
+	writer.endCall();
+	writer.flush();
+	writer.beginCall("rgl_second", 1);
+	writer.addArg(2);
+	writer.endCall();
+	writer.flush();
+	ASSERT_EQ(chunkEnds.size(), 3); // File header and two chunks
+
+	// Calls from the chunk written partially are skipped
+	stream.resize(chunkEnds[2] - 1);
+	TapeCallReader reader({stream.data(), stream.size()});
+	ASSERT_EQ(reader.getCallCount(), 1);
+	EXPECT_EQ(reader.getFnName(0), "rgl_first");
+	EXPECT_EQ(reader.getTapeCall(0).getArgsNode()[0].as<int>(), 1);
+
+	// Stream without header is not a tape
+	stream.resize(sizeof(TapeCallStream::FileHeader) - 1);
+	EXPECT_THROW(TapeCallReader({stream.data(), stream.size()}), RecordError);
+}
+
+TEST_F(TapeTest, SceneReconstructionAsync)
+{
+	std::string cubeSceneRecordPath{
+	    (std::filesystem::temp_directory_path() / std::filesystem::path("cubeSceneAsyncRecord")).string()};
+	ASSERT_RGL_SUCCESS(rgl_tape_record_begin_async(cubeSceneRecordPath.c_str(), 1024 * 1024, RGL_TAPE_OVERFLOW_BLOCK));
+	auto mesh = makeCubeMesh();
+	auto entity = makeEntity(mesh);
+	rgl_mat3x4f entityPoseTf = Mat3x4f::identity().toRGL();
+	ASSERT_RGL_SUCCESS(rgl_entity_set_transform(entity, &entityPoseTf));
+
+	rgl_tape_record_stats_t stats;
+	ASSERT_RGL_SUCCESS(rgl_tape_record_get_stats(&stats));
+	EXPECT_GE(stats.recorded_call_count, 4); // Version, mesh, entity, transform
+	EXPECT_EQ(stats.dropped_call_count, 0);
+	EXPECT_LE(stats.max_buffered_bytes, 1024 * 1024);
+	ASSERT_RGL_SUCCESS(rgl_tape_record_end());
+
+	ASSERT_RGL_SUCCESS(rgl_cleanup());
+	ASSERT_RGL_SUCCESS(rgl_tape_play(cubeSceneRecordPath.c_str()));
+	testCubeSceneOnGraph();
+}
+
+TEST_F(TapeTest, AsyncRecordingEndedRightAway)
+{
+	std::string recordPath{(std::filesystem::temp_directory_path() / std::filesystem::path("asyncShortRecord")).string()};
+	// Calls are much smaller than the call stream flush threshold, they are written only at the end of recording
+	ASSERT_RGL_SUCCESS(rgl_tape_record_begin_async(recordPath.c_str(), 1024 * 1024, RGL_TAPE_OVERFLOW_BLOCK));
+	auto mesh = makeCubeMesh();
+	auto entity = makeEntity(mesh);
+	rgl_mat3x4f entityPoseTf = Mat3x4f::identity().toRGL();
+	ASSERT_RGL_SUCCESS(rgl_entity_set_transform(entity, &entityPoseTf));
+	ASSERT_RGL_SUCCESS(rgl_entity_set_transform(entity, &entityPoseTf));
+	ASSERT_RGL_SUCCESS(rgl_tape_record_end());
+
+	{
+		TapePlayer player{recordPath.c_str()};
+		EXPECT_EQ(player.findAll({"rgl_mesh_create"}).size(), 1);
+		EXPECT_EQ(player.findAll({"rgl_entity_create"}).size(), 1);
+		EXPECT_EQ(player.findAll({"rgl_entity_set_transform"}).size(), 2);
+	}
+
+	ASSERT_RGL_SUCCESS(rgl_cleanup());
+	ASSERT_RGL_SUCCESS(rgl_tape_play(recordPath.c_str()));
+	testCubeSceneOnGraph();
+}
+
+TEST_F(TapeTest, AsyncRecordingDropPolicy)
+{
+	std::string recordPath{(std::filesystem::temp_directory_path() / std::filesystem::path("asyncDropRecord")).string()};
+	rgl_tape_record_stats_t stats;
+	EXPECT_RGL_TAPE_ERROR(rgl_tape_record_get_stats(&stats), "no recording active");
+	EXPECT_RGL_INVALID_ARGUMENT(rgl_tape_record_begin_async(recordPath.c_str(), 0, RGL_TAPE_OVERFLOW_DROP),
+	                            "max_buffer_size > 0");
+
+	const size_t maxBufferSize = 1024;
+	ASSERT_RGL_SUCCESS(rgl_tape_record_begin_async(recordPath.c_str(), maxBufferSize, RGL_TAPE_OVERFLOW_DROP));
+	ASSERT_RGL_SUCCESS(rgl_tape_record_get_stats(&stats));
+	const uint64_t recordedCallCount = stats.recorded_call_count;
+
+	// Vertices do not fit in the buffer, but the call itself succeeds
+	std::vector<rgl_vec3f> vertices(maxBufferSize, rgl_vec3f{1.0f, 2.0f, 3.0f});
+	std::vector<rgl_vec3i> indices = {{0, 1, 2}};
+	rgl_mesh_t largeMesh = nullptr;
+	ASSERT_RGL_SUCCESS(rgl_mesh_create(&largeMesh, vertices.data(), vertices.size(), indices.data(), indices.size()));
+	EXPECT_NE(largeMesh, nullptr);
+
+	// Small calls are still recorded
+	rgl_mesh_t smallMesh = nullptr;
+	ASSERT_RGL_SUCCESS(rgl_mesh_create(&smallMesh, vertices.data(), 3, indices.data(), indices.size()));
+
+	ASSERT_RGL_SUCCESS(rgl_tape_record_get_stats(&stats));
+	EXPECT_EQ(stats.dropped_call_count, 1);
+	EXPECT_EQ(stats.recorded_call_count, recordedCallCount + 1);
+	EXPECT_LE(stats.max_buffered_bytes, maxBufferSize);
+	ASSERT_RGL_SUCCESS(rgl_tape_record_end());
+}
+
+TEST_F(TapeTest, AsyncTapeWriterBackPressure)
+{
+	std::vector<uint8_t> written;
+	auto slowWrite = [&](AsyncTapeWriter::Target target, const uint8_t* data, size_t size) {
+		EXPECT_EQ(target, AsyncTapeWriter::Target::Bin);
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+		written.insert(written.end(), data, data + size);
+	};
+	std::vector<uint8_t> expected;
+	AsyncTapeWriter::Stats stats;
+	{
+		AsyncTapeWriter writer(slowWrite, 64, RGL_TAPE_OVERFLOW_BLOCK);
+		for (int call = 0; call < 100; ++call) {
+			std::vector<uint8_t> data(call, static_cast<uint8_t>(call));
+			// Under blocking policy data is never dropped, even if it is larger than the buffer
+			ASSERT_TRUE(writer.append(AsyncTapeWriter::Target::Bin, data.data(), data.size(), true));
+			writer.commit();
+			expected.insert(expected.end(), data.begin(), data.end());
+		}
+		stats = writer.getStats();
+	}
+	EXPECT_EQ(written, expected);
+	EXPECT_LE(stats.maxBufferedBytes, 64);
+	EXPECT_GT(stats.blockedTimeNs, 0);
+}
+
+TEST_F(TapeTest, AsyncTapeWriterWritesUncommittedDataOnDestruction)
+{
+	std::vector<uint8_t> written;
+	auto writeCalls = [&](AsyncTapeWriter::Target target, const uint8_t* data, size_t size) {
+		EXPECT_EQ(target, AsyncTapeWriter::Target::Calls);
+		written.insert(written.end(), data, data + size);
+	};
+	std::vector<uint8_t> committed(100, 1), uncommitted(50, 2), aborted(10, 3);
+	{
+		AsyncTapeWriter writer(writeCalls, 1024, RGL_TAPE_OVERFLOW_BLOCK);
+		ASSERT_TRUE(writer.append(AsyncTapeWriter::Target::Calls, committed.data(), committed.size(), false));
+		writer.commit();
+		ASSERT_TRUE(writer.append(AsyncTapeWriter::Target::Calls, aborted.data(), aborted.size(), true));
+		writer.abort();
+		ASSERT_TRUE(writer.append(AsyncTapeWriter::Target::Calls, uncommitted.data(), uncommitted.size(), false));
+	}
+	std::vector<uint8_t> expected = committed;
+	expected.insert(expected.end(), uncommitted.begin(), uncommitted.end());
+	EXPECT_EQ(written, expected);
+}
+
+TEST_F(TapeTest, BlobHashReferenceValues)
+{
+	// Reference values of XXH64 with seed 0
+	EXPECT_EQ(hashBlob("", 0), 0xEF46DB3751D8E999ULL);
+	EXPECT_EQ(hashBlob("a", 1), 0xD24EC4F1A98C6E5BULL);
+	EXPECT_EQ(hashBlob("abc", 3), 0x44BC2CF5AD770999ULL);
+	std::string longInput(100, 'x');
+	EXPECT_EQ(hashBlob(longInput.data(), longInput.size()), 0x92F0DE5A88A3C094ULL);
+}
+
+TEST_F(TapeTest, BinaryDataDeduplication)
+{
+	std::string recordPath{(std::filesystem::temp_directory_path() / std::filesystem::path("dedupRecord")).string()};
+	std::vector<rgl_mat3x4f> rays(1000, Mat3x4f::identity().toRGL());
+	const size_t raysSize = rays.size() * sizeof(rgl_mat3x4f);
+
+	ASSERT_RGL_SUCCESS(rgl_tape_record_begin(recordPath.c_str()));
+	rgl_node_t raysNode = nullptr;
+	for (int frame = 0; frame < 10; ++frame) {
+		ASSERT_RGL_SUCCESS(rgl_node_rays_from_mat3x4f(&raysNode, rays.data(), rays.size()));
+	}
+	rays[0] = Mat3x4f::translation(1.0f, 2.0f, 3.0f).toRGL();
+	ASSERT_RGL_SUCCESS(rgl_node_rays_from_mat3x4f(&raysNode, rays.data(), rays.size()));
+	// Scene recreated from identical data
+	auto mesh = makeCubeMesh();
+	ASSERT_RGL_SUCCESS(rgl_mesh_destroy(mesh));
+	mesh = makeCubeMesh();
+	auto entity = makeEntity(mesh);
+	rgl_mat3x4f entityPoseTf = Mat3x4f::identity().toRGL();
+	ASSERT_RGL_SUCCESS(rgl_entity_set_transform(entity, &entityPoseTf));
+
+	rgl_tape_record_stats_t stats;
+	ASSERT_RGL_SUCCESS(rgl_tape_record_get_stats(&stats));
+	EXPECT_GE(stats.deduplicated_bin_bytes, 9 * raysSize);
+	ASSERT_RGL_SUCCESS(rgl_tape_record_end());
+
+	// Only two distinct ray arrays are written
+	EXPECT_LT(std::filesystem::file_size(createTempFilePath("dedupRecord", BIN_EXT)), 3 * raysSize);
+
+	ASSERT_RGL_SUCCESS(rgl_cleanup());
+	ASSERT_RGL_SUCCESS(rgl_tape_play(recordPath.c_str()));
+	testCubeSceneOnGraph();
+}
+
+TEST_F(TapeTest, TapeIndexCheckpoints)
+{
+	std::vector<uint8_t> stream;
+	TapeCallWriter writer([&](const uint8_t* data, size_t size) { stream.insert(stream.end(), data, data + size); });
+	int64_t timestamp = 0;
+	auto addCall = [&](std::string_view fnName, std::vector<uint64_t> args) {
+		writer.beginCall(fnName, timestamp);
+		for (auto&& arg : args) {
+			writer.addArg(arg);
+		}
+		writer.endCall();
+		timestamp += 10;
+	};
+	const uint64_t mesh = 1, entity = 2, tempMesh = 3, node = 4, child = 5;
+	addCall("rgl_get_version_info", {0, 0, 0});          // 0
+	addCall("rgl_mesh_create", {mesh, 0, 0, 0, 0});      // 1
+	addCall("rgl_entity_create", {entity, 0, mesh});     // 2
+	addCall("rgl_entity_set_transform", {entity, 0});    // 3, superseded by 11
+	addCall("rgl_mesh_destroy", {mesh});                 // 4, mesh is still used by the entity
+	addCall("rgl_mesh_create", {tempMesh, 0, 0, 0, 0});  // 5
+	addCall("rgl_mesh_destroy", {tempMesh});             // 6
+	addCall("rgl_node_rays_from_mat3x4f", {node, 0, 1}); // 7, creates the node, kept though updated by 12
+	addCall("rgl_node_raytrace", {child, 0});            // 8
+	addCall("rgl_graph_node_add_child", {node, child});  // 9
+	addCall("rgl_graph_run", {node});                    // 10
+	addCall("rgl_entity_set_transform", {entity, 16});   // 11
+	addCall("rgl_node_rays_from_mat3x4f", {node, 0, 1}); // 12
+	addCall("rgl_graph_run", {node});                    // 13
+	addCall("rgl_graph_destroy", {child});               // 14
+	addCall("rgl_entity_destroy", {entity});             // 15, releases the mesh
+	addCall("rgl_graph_run", {node});                    // 16
+	writer.flush();
+
+	TapeCallReader reader({stream.data(), stream.size()});
+	TapeIndex index(reader, 1);
+	EXPECT_EQ(index.getFrames(), (std::vector<TapeIndex::APICallIdx>{10, 13, 16}));
+	EXPECT_EQ(index.getCalls("rgl_mesh_create"), (std::vector<TapeIndex::APICallIdx>{1, 5}));
+	EXPECT_TRUE(index.getCalls("rgl_texture_create").empty());
+
+	EXPECT_EQ(index.findByTimestamp(35), 4);
+	EXPECT_EQ(index.findByTimestamp(40), 4);
+	EXPECT_EQ(index.findByTimestamp(1000), std::nullopt);
+
+	EXPECT_EQ(index.findCheckpoint(12).callIdx, 0);
+	EXPECT_TRUE(index.findCheckpoint(12).liveCalls.empty());
+	EXPECT_EQ(index.findCheckpoint(13).callIdx, 13);
+	EXPECT_EQ(index.findCheckpoint(15).liveCalls, (std::vector<TapeIndex::APICallIdx>{0, 1, 2, 4, 7, 8, 9, 11, 12}));
+	EXPECT_EQ(index.findCheckpoint(16).callIdx, 16);
+	EXPECT_EQ(index.findCheckpoint(16).liveCalls, (std::vector<TapeIndex::APICallIdx>{0}));
+}
+
+TEST_F(TapeTest, TapeIndexResultBufferSetters)
+{
+	std::vector<uint8_t> stream;
+	TapeCallWriter writer([&](const uint8_t* data, size_t size) { stream.insert(stream.end(), data, data + size); });
+	auto addCall = [&](std::string_view fnName, std::vector<uint64_t> args) {
+		writer.beginCall(fnName, 0);
+		for (auto&& arg : args) {
+			writer.addArg(arg);
+		}
+		writer.endCall();
+	};
+	const uint64_t node = 1, xyz = XYZ_VEC3_F32, distance = DISTANCE_F32;
+	addCall("rgl_node_points_yield", {node, 0, 0});                 // 0
+	addCall("rgl_graph_set_result_buffer", {node, xyz, 0, 0});      // 1, superseded by 3
+	addCall("rgl_graph_set_result_buffer", {node, distance, 0, 0}); // 2, other field, kept
+	addCall("rgl_graph_set_result_buffer", {node, xyz, 0, 0});      // 3
+	addCall("rgl_graph_run", {node});                               // 4
+	addCall("rgl_graph_run", {node});                               // 5
+	writer.flush();
+
+	TapeCallReader reader({stream.data(), stream.size()});
+	TapeIndex index(reader, 1);
+	EXPECT_EQ(index.findCheckpoint(5).callIdx, 5);
+	EXPECT_EQ(index.findCheckpoint(5).liveCalls, (std::vector<TapeIndex::APICallIdx>{0, 2, 3}));
+}
+
+TEST_F(TapeTest, SeekToFrame)
+{
+	std::string recordPath{(std::filesystem::temp_directory_path() / std::filesystem::path("seekRecord")).string()};
+	const size_t frameCount = 2 * TapeIndex::DEFAULT_CHECKPOINT_FRAME_INTERVAL + 10;
+
+	ASSERT_RGL_SUCCESS(rgl_tape_record_begin(recordPath.c_str()));
+	auto mesh = makeCubeMesh();
+	auto entity = makeEntity(mesh);
+	rgl_node_t useRays = nullptr, raytrace = nullptr, yield = nullptr;
+	rgl_mat3x4f ray = Mat3x4f::identity().toRGL();
+	rgl_field_t field = XYZ_VEC3_F32;
+	ASSERT_RGL_SUCCESS(rgl_node_rays_from_mat3x4f(&useRays, &ray, 1));
+	ASSERT_RGL_SUCCESS(rgl_node_raytrace(&raytrace, nullptr));
+	ASSERT_RGL_SUCCESS(rgl_node_points_yield(&yield, &field, 1));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(useRays, raytrace));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(raytrace, yield));
+	for (size_t frame = 0; frame < frameCount; ++frame) {
+		rgl_mat3x4f entityPoseTf = Mat3x4f::translation(0.0f, 0.0f, 10.0f + static_cast<float>(frame)).toRGL();
+		ASSERT_RGL_SUCCESS(rgl_entity_set_transform(entity, &entityPoseTf));
+		ASSERT_RGL_SUCCESS(rgl_graph_run(raytrace));
+	}
+	ASSERT_RGL_SUCCESS(rgl_tape_record_end());
+	ASSERT_RGL_SUCCESS(rgl_cleanup());
+
+	TapePlayer player{recordPath.c_str()};
+	ASSERT_EQ(player.getFrameCount(), frameCount);
+	const auto frames = player.findAll({"rgl_graph_run"});
+	auto expectFrameResult = [&](size_t frame) {
+		player.seekFrame(frame);
+		player.playThrough(frames[frame]);
+		rgl_node_t playedYield = player.getNodeHandle(reinterpret_cast<TapeAPIObjectID>(yield));
+		int32_t count = 0, sizeOf = 0;
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_size(playedYield, XYZ_VEC3_F32, &count, &sizeOf));
+		ASSERT_EQ(count, 1);
+		rgl_vec3f hitPoint;
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(playedYield, XYZ_VEC3_F32, &hitPoint));
+		// Cube faces are 1 unit away from its center
+		EXPECT_NEAR(hitPoint.value[2], 9.0f + static_cast<float>(frame), 1e-4f) << "frame " << frame;
+	};
+	// Forward, backward, across checkpoints and within a checkpoint interval
+	for (size_t frame : {size_t{5}, frameCount - 1, size_t{0}, TapeIndex::DEFAULT_CHECKPOINT_FRAME_INTERVAL + 3, size_t{70},
+	                     TapeIndex::DEFAULT_CHECKPOINT_FRAME_INTERVAL}) {
+		expectFrameResult(frame);
+	}
+}
+
+TEST_F(TapeTest, SeekPastNodeUpdate)
+{
+	std::string recordPath{(std::filesystem::temp_directory_path() / std::filesystem::path("seekNodeUpdate")).string()};
+	const size_t frameCount = TapeIndex::DEFAULT_CHECKPOINT_FRAME_INTERVAL + 10;
+	const size_t firstUpdateFrame = 5, secondUpdateFrame = 10;
+
+	ASSERT_RGL_SUCCESS(rgl_tape_record_begin(recordPath.c_str()));
+	auto mesh = makeCubeMesh();
+	auto entity = makeEntity(mesh);
+	rgl_mat3x4f entityPoseTf = Mat3x4f::translation(0.0f, 0.0f, 10.0f).toRGL();
+	ASSERT_RGL_SUCCESS(rgl_entity_set_transform(entity, &entityPoseTf));
+	rgl_node_t useRays = nullptr, raytrace = nullptr, yield = nullptr;
+	std::vector<rgl_mat3x4f> rays(3, Mat3x4f::identity().toRGL());
+	rgl_field_t field = XYZ_VEC3_F32;
+	ASSERT_RGL_SUCCESS(rgl_node_rays_from_mat3x4f(&useRays, rays.data(), 1));
+	ASSERT_RGL_SUCCESS(rgl_node_raytrace(&raytrace, nullptr));
+	ASSERT_RGL_SUCCESS(rgl_node_points_yield(&yield, &field, 1));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(useRays, raytrace));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(raytrace, yield));
+	for (size_t frame = 0; frame < frameCount; ++frame) {
+		// Nodes are updated after being linked, the number of rays tells which update is in effect
+		if (frame == firstUpdateFrame) {
+			ASSERT_RGL_SUCCESS(rgl_node_rays_from_mat3x4f(&useRays, rays.data(), 2));
+		}
+		if (frame == secondUpdateFrame) {
+			ASSERT_RGL_SUCCESS(rgl_node_rays_from_mat3x4f(&useRays, rays.data(), 3));
+		}
+		ASSERT_RGL_SUCCESS(rgl_graph_run(raytrace));
+	}
+	ASSERT_RGL_SUCCESS(rgl_tape_record_end());
+	ASSERT_RGL_SUCCESS(rgl_cleanup());
+
+	TapePlayer player{recordPath.c_str()};
+	const auto frames = player.findAll({"rgl_graph_run"});
+	auto expectRayCount = [&](size_t frame, int32_t expectedCount) {
+		player.seekFrame(frame);
+		player.playThrough(frames[frame]);
+		rgl_node_t playedYield = player.getNodeHandle(reinterpret_cast<TapeAPIObjectID>(yield));
+		int32_t count = 0, sizeOf = 0;
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_size(playedYield, XYZ_VEC3_F32, &count, &sizeOf));
+		EXPECT_EQ(count, expectedCount) << "frame " << frame;
+	};
+	// Restored from the checkpoint, which follows both updates
+	expectRayCount(TapeIndex::DEFAULT_CHECKPOINT_FRAME_INTERVAL + 3, 3);
+	// Replayed from the tape beginning
+	expectRayCount(firstUpdateFrame + 1, 2);
+	expectRayCount(1, 1);
+}
@@ -0,0 +1,137 @@
+#include <helpers/commonHelpers.hpp>
+#include <helpers/testPointCloud.hpp>
+
+#include <random>
+
+#include <RGLFields.hpp>
+#include <HostFormat.hpp>
+#include <gpu/FormatLayout.hpp>
+
+/*
+ * TEST PURPOSE:
+ * Check that specialized (compile-time) formatting layouts produce the same results as the generic, field-by-field formatting,
+ * both on host and on GPU.
+ */
+
+static const std::vector<std::vector<rgl_field_t>> specializedLayouts = {
+    {XYZ_VEC3_F32},
+    {XYZ_VEC3_F32, PADDING_32},
+    {XYZ_VEC3_F32, PADDING_32, INTENSITY_F32, RING_ID_U16},
+    {XYZ_VEC3_F32, INTENSITY_F32, RING_ID_U16, TIME_STAMP_F64},
+    {XYZ_VEC3_F32, INTENSITY_U8, RETURN_TYPE_U8, RING_ID_U16, AZIMUTH_F32, ELEVATION_F32, DISTANCE_F32, TIME_STAMP_U32},
+};
+
+static const std::vector<std::vector<rgl_field_t>> genericLayouts = {
+    {XYZ_VEC3_F32, IS_HIT_I32},
+    {PADDING_8, RING_ID_U16, DISTANCE_F32},
+};
+
+struct HostSoa
+{
+	HostSoa(const std::vector<rgl_field_t>& fields, size_t pointCount, unsigned seed) : pointCount(pointCount)
+	{
+		std::mt19937 gen(seed);
+		std::uniform_int_distribution<int> byte(0, 255);
+		for (auto&& field : fields) {
+			data.emplace_back(isDummy(field) ? 0 : pointCount * getFieldSize(field));
+			std::generate(data.back().begin(), data.back().end(), [&]() { return static_cast<char>(byte(gen)); });
+			readMappings.push_back({field, isDummy(field) ? nullptr : data.back().data()});
+			writeMappings.push_back({field, isDummy(field) ? nullptr : data.back().data()});
+		}
+	}
+
+	// Reference: byte-by-byte packing, paddings are zero
+	std::vector<char> toAos() const
+	{
+		std::vector<char> aos;
+		for (size_t i = 0; i < pointCount; ++i) {
+			for (size_t f = 0; f < readMappings.size(); ++f) {
+				size_t fieldSize = getFieldSize(readMappings[f].first);
+				if (isDummy(readMappings[f].first)) {
+					aos.insert(aos.end(), fieldSize, 0);
+					continue;
+				}
+				aos.insert(aos.end(), data[f].begin() + i * fieldSize, data[f].begin() + (i + 1) * fieldSize);
+			}
+		}
+		return aos;
+	}
+
+	size_t pointCount;
+	std::vector<std::vector<char>> data;
+	std::vector<std::pair<rgl_field_t, const void*>> readMappings;
+	std::vector<std::pair<rgl_field_t, void*>> writeMappings;
+};
+
+TEST(FormatLayoutTest, SpecializedLayoutsAreRecognized)
+{
+	auto isSpecialized = [](const std::vector<rgl_field_t>& fields) {
+		std::vector<std::pair<rgl_field_t, const void*>> mappings;
+		for (auto&& field : fields) {
+			mappings.push_back({field, nullptr});
+		}
+		return visitFormatLayout(mappings, [&](auto layout) {
+			EXPECT_EQ(decltype(layout)::POINT_SIZE, getPointSize(fields));
+			return true;
+		});
+	};
+	for (auto&& fields : specializedLayouts) {
+		EXPECT_TRUE(isSpecialized(fields));
+	}
+	for (auto&& fields : genericLayouts) {
+		EXPECT_FALSE(isSpecialized(fields));
+	}
+}
+
+TEST(FormatLayoutTest, HostFormatMatchesReference)
+{
+	constexpr size_t POINT_COUNT = 1031;
+	auto allLayouts = specializedLayouts;
+	allLayouts.insert(allLayouts.end(), genericLayouts.begin(), genericLayouts.end());
+	for (auto&& fields : allLayouts) {
+		HostSoa soa(fields, POINT_COUNT, 42);
+		std::vector<char> expected = soa.toAos();
+
+		// Paddings are not written by the generic path
+		std::vector<char> aos(expected.size(), 0);
+		hostFormatSoaToAos(POINT_COUNT, soa.readMappings, aos.data());
+		EXPECT_EQ(aos, expected) << "layout point size " << getPointSize(fields);
+
+		HostSoa roundTrip(fields, POINT_COUNT, 7);
+		hostFormatAosToSoa(POINT_COUNT, aos.data(), roundTrip.writeMappings);
+		EXPECT_EQ(roundTrip.data, soa.data) << "layout point size " << getPointSize(fields);
+	}
+}
+
+TEST(FormatLayoutTest, HostFormatHandlesMisalignedOutput)
+{
+	constexpr size_t POINT_COUNT = 17;
+	auto& fields = specializedLayouts[1];
+	HostSoa soa(fields, POINT_COUNT, 42);
+	std::vector<char> expected = soa.toAos();
+	std::vector<char> buffer(expected.size() + 1, 0);
+	hostFormatSoaToAos(POINT_COUNT, soa.readMappings, buffer.data() + 1);
+	EXPECT_TRUE(std::equal(expected.begin(), expected.end(), buffer.begin() + 1));
+}
+
+class FormatLayoutGPUTest : public RGLTestWithParam<std::vector<rgl_field_t>>
+{};
+
+INSTANTIATE_TEST_SUITE_P(FormatLayoutGPUTests, FormatLayoutGPUTest, testing::ValuesIn(specializedLayouts),
+                         [](const auto& info) { return "layout_" + std::to_string(info.index); });
+
+TEST_P(FormatLayoutGPUTest, FromArrayAndFormatRoundTrip)
+{
+	const std::vector<rgl_field_t>& fields = GetParam();
+	TestPointCloud pointCloud(fields, maxGPUCoresTestCount);
+
+	rgl_node_t usePoints = nullptr, format = nullptr;
+	ASSERT_RGL_SUCCESS(rgl_node_points_from_array(&usePoints, pointCloud.getData(), pointCloud.getPointCount(),
+	                                              fields.data(), fields.size()));
+	ASSERT_RGL_SUCCESS(rgl_node_points_format(&format, fields.data(), fields.size()));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(usePoints, format));
+	ASSERT_RGL_SUCCESS(rgl_graph_run(usePoints));
+
+	TestPointCloud formatted = TestPointCloud::createFromFormatNode(format, fields);
+	EXPECT_EQ(formatted, pointCloud);
+}
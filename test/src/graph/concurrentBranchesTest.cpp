@@ -0,0 +1,135 @@
+#include <thread>
+
+#include <helpers/commonHelpers.hpp>
+#include <helpers/graphHelpers.hpp>
+
+#include <api/apiCommon.hpp>
+#include <RGLFields.hpp>
+
+using namespace ::testing;
+
+struct ConcurrentBranches : RGLTest
+{
+	static constexpr double SLEEP = 0.1;
+	static constexpr int CHECKS = 8;
+	Vec3f data[2] = {
+	    {1, 2, 3},
+        {4, 5, 6}
+    };
+	rgl_field_t fields[1] = {XYZ_VEC3_F32};
+
+	void SetUp() override
+	{
+		if (std::thread::hardware_concurrency() < 2) {
+			GTEST_SKIP() << "Concurrent execution of branches requires at least two CPU cores";
+		}
+	}
+};
+
+TEST_F(ConcurrentBranches, SiblingBranchesOverlap)
+{
+	rgl_node_t fromArray = nullptr, sleepA = nullptr, nodeA = nullptr, sleepB = nullptr, nodeB = nullptr;
+	ASSERT_RGL_SUCCESS(rgl_node_points_from_array(&fromArray, data, 2, fields, 1));
+	createOrUpdateNode<SleepNode>(&sleepA, SLEEP);
+	createOrUpdateNode<RecordTimeNode>(&nodeA);
+	createOrUpdateNode<SleepNode>(&sleepB, SLEEP);
+	createOrUpdateNode<RecordTimeNode>(&nodeB);
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(fromArray, sleepA));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(sleepA, nodeA));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(fromArray, sleepB));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(sleepB, nodeB));
+
+	// Serial execution - second branch starts after the first one
+	ASSERT_RGL_SUCCESS(rgl_graph_run(fromArray));
+	double timestampA = dynamic_cast<RecordTimeNode*>(nodeA)->getMeasurement();
+	double timestampB = dynamic_cast<RecordTimeNode*>(nodeB)->getMeasurement();
+	EXPECT_GE(std::abs(timestampB - timestampA), SLEEP);
+
+	// Concurrent execution - branches sleep at the same time
+	ASSERT_RGL_SUCCESS(rgl_graph_set_concurrent_branches(fromArray, true));
+	for (int i = 0; i < CHECKS; ++i) {
+		ASSERT_RGL_SUCCESS(rgl_graph_run(fromArray));
+		timestampA = dynamic_cast<RecordTimeNode*>(nodeA)->getMeasurement();
+		timestampB = dynamic_cast<RecordTimeNode*>(nodeB)->getMeasurement();
+		EXPECT_LT(std::abs(timestampB - timestampA), SLEEP / 2);
+	}
+
+	// Disabling restores serial execution
+	ASSERT_RGL_SUCCESS(rgl_graph_set_concurrent_branches(sleepB, false));
+	ASSERT_RGL_SUCCESS(rgl_graph_run(fromArray));
+	timestampA = dynamic_cast<RecordTimeNode*>(nodeA)->getMeasurement();
+	timestampB = dynamic_cast<RecordTimeNode*>(nodeB)->getMeasurement();
+	EXPECT_GE(std::abs(timestampB - timestampA), SLEEP);
+}
+
+TEST_F(ConcurrentBranches, MergeWaitsForAllBranches)
+{
+	rgl_node_t fromArray = nullptr, sleep = nullptr, transformA = nullptr, transformB = nullptr, merge = nullptr;
+	rgl_mat3x4f translateA = Mat3x4f::translation(10, 0, 0).toRGL();
+	rgl_mat3x4f translateB = Mat3x4f::translation(0, 20, 0).toRGL();
+	ASSERT_RGL_SUCCESS(rgl_node_points_from_array(&fromArray, data, 2, fields, 1));
+	createOrUpdateNode<SleepNode>(&sleep, SLEEP);
+	ASSERT_RGL_SUCCESS(rgl_node_points_transform(&transformA, &translateA));
+	ASSERT_RGL_SUCCESS(rgl_node_points_transform(&transformB, &translateB));
+	ASSERT_RGL_SUCCESS(rgl_node_points_spatial_merge(&merge, fields, 1));
+
+	// Branch A is slowed down, so that merge would read stale data if it did not wait for it.
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(fromArray, sleep));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(sleep, transformA));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(fromArray, transformB));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(transformA, merge));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(transformB, merge));
+	ASSERT_RGL_SUCCESS(rgl_graph_set_concurrent_branches(merge, true));
+
+	for (int i = 0; i < CHECKS; ++i) {
+		ASSERT_RGL_SUCCESS(rgl_graph_run(fromArray));
+
+		int32_t outCount = 0, outSizeOf = 0;
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_size(merge, XYZ_VEC3_F32, &outCount, &outSizeOf));
+		ASSERT_EQ(outCount, 4);
+		ASSERT_EQ(outSizeOf, sizeof(Vec3f));
+
+		std::vector<Vec3f> merged(outCount);
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(merge, XYZ_VEC3_F32, merged.data()));
+		std::vector<Vec3f> expected = {
+		    data[0] + Vec3f{10, 0, 0},
+            data[1] + Vec3f{10, 0, 0},
+            data[0] + Vec3f{0, 20, 0},
+		    data[1] + Vec3f{0, 20, 0}
+        };
+		for (int p = 0; p < outCount; ++p) {
+			EXPECT_FLOAT_EQ(merged[p].x(), expected[p].x());
+			EXPECT_FLOAT_EQ(merged[p].y(), expected[p].y());
+			EXPECT_FLOAT_EQ(merged[p].z(), expected[p].z());
+		}
+	}
+}
+
+struct ThrowNode : IPointsNodeSingleInput
+{
+	void setParameters() {}
+
+protected:
+	void enqueueExecImpl() override { throw InvalidPipeline("ThrowNode"); }
+};
+
+TEST_F(ConcurrentBranches, ExceptionIsReportedToDependentNodes)
+{
+	rgl_node_t fromArray = nullptr, throwNode = nullptr, afterThrow = nullptr, sleep = nullptr, other = nullptr;
+	ASSERT_RGL_SUCCESS(rgl_node_points_from_array(&fromArray, data, 2, fields, 1));
+	createOrUpdateNode<ThrowNode>(&throwNode);
+	createOrUpdateNode<RecordTimeNode>(&afterThrow);
+	createOrUpdateNode<SleepNode>(&sleep, SLEEP);
+	createOrUpdateNode<RecordTimeNode>(&other);
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(fromArray, sleep));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(sleep, other));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(fromArray, throwNode));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(throwNode, afterThrow));
+	ASSERT_RGL_SUCCESS(rgl_graph_set_concurrent_branches(fromArray, true));
+
+	ASSERT_RGL_SUCCESS(rgl_graph_run(fromArray));
+	int32_t outCount = 0;
+	// Must not hang, even though afterThrow was never executed.
+	EXPECT_RGL_STATUS(rgl_graph_get_result_size(afterThrow, XYZ_VEC3_F32, &outCount, nullptr), RGL_INVALID_PIPELINE,
+	                  "ThrowNode");
+}
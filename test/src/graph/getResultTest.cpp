@@ -33,4 +33,76 @@ TEST_F(GraphGetResultTest, GetResultsSizeWithoutPriorRun)
 	// Test
 	int32_t count, size;
 	EXPECT_RGL_STATUS(rgl_graph_get_result_size(pointsFromArray, RGL_FIELD_XYZ_VEC3_F32, &count, &size), RGL_INVALID_PIPELINE);
-}
\ No newline at end of file
+}
+TEST_F(GraphGetResultTest, ResultBufferReceivesResultsOfEachRun)
+{
+	rgl_node_t pointsFromArray = nullptr, transform = nullptr;
+	rgl_field_t fields = RGL_FIELD_XYZ_VEC3_F32;
+	std::vector<rgl_vec3f> points = {
+	    {1, 2, 3},
+        {4, 5, 6},
+        {7, 8, 9}
+    };
+	rgl_mat3x4f translation = Mat3x4f::translation(10, 20, 30).toRGL();
+	ASSERT_RGL_SUCCESS(rgl_node_points_from_array(&pointsFromArray, points.data(), points.size(), &fields, 1));
+	ASSERT_RGL_SUCCESS(rgl_node_points_transform(&transform, &translation));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(pointsFromArray, transform));
+
+	std::vector<rgl_vec3f> buffer(points.size());
+	int32_t ready = 0, count = 0;
+	EXPECT_RGL_INVALID_ARGUMENT(rgl_graph_query_result_buffer(transform, RGL_FIELD_XYZ_VEC3_F32, &ready, &count),
+	                            "no result buffer");
+	ASSERT_RGL_SUCCESS(rgl_graph_set_result_buffer(transform, RGL_FIELD_XYZ_VEC3_F32, buffer.data(),
+	                                               buffer.size() * sizeof(rgl_vec3f)));
+
+	// Not ready before the first run
+	ASSERT_RGL_SUCCESS(rgl_graph_query_result_buffer(transform, RGL_FIELD_XYZ_VEC3_F32, &ready, &count));
+	EXPECT_EQ(ready, 0);
+
+	for (int run = 0; run < 3; ++run) {
+		translation = Mat3x4f::translation(run, 0, 0).toRGL();
+		ASSERT_RGL_SUCCESS(rgl_node_points_transform(&transform, &translation));
+		ASSERT_RGL_SUCCESS(rgl_graph_run(pointsFromArray));
+		do {
+			ASSERT_RGL_SUCCESS(rgl_graph_query_result_buffer(transform, RGL_FIELD_XYZ_VEC3_F32, &ready, &count));
+		} while (ready == 0);
+		ASSERT_EQ(count, points.size());
+		for (int i = 0; i < count; ++i) {
+			EXPECT_EQ(buffer[i].value[0], points[i].value[0] + run);
+			EXPECT_EQ(buffer[i].value[1], points[i].value[1]);
+			EXPECT_EQ(buffer[i].value[2], points[i].value[2]);
+		}
+	}
+
+	// Regular getter works with page-locked destination, too
+	std::vector<rgl_vec3f> copied(points.size());
+	ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(transform, RGL_FIELD_XYZ_VEC3_F32, buffer.data()));
+	ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(transform, RGL_FIELD_XYZ_VEC3_F32, copied.data()));
+	for (int i = 0; i < copied.size(); ++i) {
+		EXPECT_EQ(copied[i].value[0], buffer[i].value[0]);
+	}
+
+	ASSERT_RGL_SUCCESS(rgl_graph_set_result_buffer(transform, RGL_FIELD_XYZ_VEC3_F32, nullptr, 0));
+	EXPECT_RGL_INVALID_ARGUMENT(rgl_graph_query_result_buffer(transform, RGL_FIELD_XYZ_VEC3_F32, &ready, &count),
+	                            "no result buffer");
+}
+
+TEST_F(GraphGetResultTest, ResultBufferTooSmall)
+{
+	rgl_node_t pointsFromArray = nullptr;
+	rgl_field_t fields = RGL_FIELD_XYZ_VEC3_F32;
+	std::vector<rgl_vec3f> points(4);
+	ASSERT_RGL_SUCCESS(rgl_node_points_from_array(&pointsFromArray, points.data(), points.size(), &fields, 1));
+
+	std::vector<rgl_vec3f> buffer(points.size() - 1);
+	ASSERT_RGL_SUCCESS(rgl_graph_set_result_buffer(pointsFromArray, RGL_FIELD_XYZ_VEC3_F32, buffer.data(),
+	                                               buffer.size() * sizeof(rgl_vec3f)));
+	ASSERT_RGL_SUCCESS(rgl_graph_run(pointsFromArray));
+
+	int32_t ready = 0;
+	rgl_status_t status = RGL_SUCCESS;
+	do {
+		status = rgl_graph_query_result_buffer(pointsFromArray, RGL_FIELD_XYZ_VEC3_F32, &ready, nullptr);
+	} while (status == RGL_SUCCESS && ready == 0);
+	EXPECT_RGL_INVALID_PIPELINE(status, "result buffer is too small");
+}
@@ -0,0 +1,159 @@
+#include <chrono>
+#include <set>
+#include <thread>
+
+#include <helpers/commonHelpers.hpp>
+#include <helpers/lidarHelpers.hpp>
+#include <helpers/sceneHelpers.hpp>
+
+#include <graph/GraphExecutor.hpp>
+#include <graph/Node.hpp>
+#include <graph/WaitStrategy.hpp>
+#include <math/Mat3x4f.hpp>
+
+using namespace std::chrono_literals;
+
+TEST(GraphExecutor, ExecutesJobsInSubmissionOrder)
+{
+	auto executor = GraphExecutor::create();
+	std::vector<int> executed;
+	const int jobCount = 1000; // More than queue capacity
+	for (int i = 0; i < jobCount; ++i) {
+		executor->submit([&executed, i]() { executed.push_back(i); });
+	}
+	executor->waitIdle();
+
+	ASSERT_EQ(executed.size(), jobCount);
+	for (int i = 0; i < jobCount; ++i) {
+		EXPECT_EQ(executed.at(i), i);
+	}
+}
+
+TEST(GraphExecutor, UsesSingleLongLivedThread)
+{
+	auto executor = GraphExecutor::create();
+	EXPECT_FALSE(executor->isWorkerThread());
+
+	std::set<std::thread::id> workerIds;
+	bool allJobsOnWorker = true;
+	for (int i = 0; i < 16; ++i) {
+		executor->submit([&]() {
+			workerIds.insert(std::this_thread::get_id());
+			allJobsOnWorker &= executor->isWorkerThread();
+		});
+		executor->waitIdle();
+	}
+	EXPECT_EQ(workerIds.size(), 1);
+	EXPECT_TRUE(allJobsOnWorker);
+	EXPECT_FALSE(workerIds.contains(std::this_thread::get_id()));
+}
+
+TEST(GraphExecutor, WaitIdleWithoutJobsReturnsImmediately)
+{
+	auto executor = GraphExecutor::create();
+	executor->waitIdle();
+	executor->submit([]() { std::this_thread::sleep_for(10ms); });
+	executor->waitIdle();
+	executor->waitIdle();
+}
+
+TEST(WaitStrategy, ReturnsOnceValueChanges)
+{
+	for (auto&& strategy : {WaitStrategy{}, WaitStrategy{1000, 0}, WaitStrategy{0, 100}, WaitStrategy{100000, 1000}}) {
+		std::atomic<int> value{0};
+		std::thread setter{[&]() {
+			std::this_thread::sleep_for(5ms);
+			value.store(1);
+			value.notify_all();
+		}};
+		strategy.waitWhileEqual(value, 0);
+		EXPECT_EQ(value.load(), 1);
+		setter.join();
+
+		// Does not block if the value already differs
+		strategy.waitWhileEqual(value, 0);
+	}
+}
+
+TEST(WaitStrategy, StrongestTakesLargerThresholds)
+{
+	EXPECT_EQ(WaitStrategy::strongest({10, 0}, {0, 5}), (WaitStrategy{10, 5}));
+	EXPECT_EQ(WaitStrategy::strongest({}, {}), WaitStrategy{});
+}
+
+TEST(GraphExecutor, SpinningWorkersExecuteJobs)
+{
+	auto executor = GraphExecutor::create(2);
+	executor->setWaitStrategy({100000, 100});
+	std::atomic<int> executedCount{0};
+	const int jobCount = 100;
+	for (int i = 0; i < jobCount; ++i) {
+		executor->submit([&]() { executedCount.fetch_add(1); });
+		if (i % 10 == 0) {
+			std::this_thread::sleep_for(1ms); // Let the workers fall back to sleeping.
+		}
+	}
+	executor->waitIdle();
+	EXPECT_EQ(executedCount.load(), jobCount);
+}
+
+struct GraphRunLatency : public RGLTest
+{};
+
+/**
+ * Checks consistency of latency counters reported by RGL for the CPU-friendly (default) and the low-latency wait strategy.
+ * Values of the counters are compared by GraphRunWaitStrategy benchmark.
+ */
+TEST_F(GraphRunLatency, CountersPerWaitStrategy)
+{
+	const int runCount = 5;
+	spawnCubeOnScene(Mat3x4f::TRS({0, 0, 5}));
+
+	rgl_node_t useRays = nullptr, raytrace = nullptr, compact = nullptr;
+	std::vector<rgl_mat3x4f> rays = makeLidar3dRays(360, 180, 10, 10);
+	ASSERT_RGL_SUCCESS(rgl_node_rays_from_mat3x4f(&useRays, rays.data(), rays.size()));
+	ASSERT_RGL_SUCCESS(rgl_node_raytrace(&raytrace, nullptr));
+	ASSERT_RGL_SUCCESS(rgl_node_points_compact_by_field(&compact, RGL_FIELD_IS_HIT_I32));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(useRays, raytrace));
+
+	rgl_graph_latency_t latency;
+	EXPECT_RGL_INVALID_ARGUMENT(rgl_graph_get_latency(useRays, nullptr), "out_latency != nullptr");
+	EXPECT_RGL_INVALID_ARGUMENT(rgl_graph_set_wait_strategy(useRays, -1, 0), "spin_count >= 0");
+	EXPECT_RGL_INVALID_ARGUMENT(rgl_graph_set_wait_strategy(useRays, 0, -1), "yield_count >= 0");
+
+	// Graph has never been run
+	ASSERT_RGL_SUCCESS(rgl_graph_get_latency(useRays, &latency));
+	EXPECT_EQ(latency.run_count, 0);
+	EXPECT_EQ(latency.wakeup_count, 0);
+
+	// The setting is kept when the graph is modified (which also resets the counters)
+	ASSERT_RGL_SUCCESS(rgl_graph_set_wait_strategy(useRays, 1000, 10));
+	ASSERT_RGL_SUCCESS(rgl_graph_run(useRays));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(raytrace, compact));
+	EXPECT_EQ(useRays->getWaitStrategy(), (WaitStrategy{1000, 10}));
+	ASSERT_RGL_SUCCESS(rgl_graph_get_latency(useRays, &latency));
+	EXPECT_EQ(latency.run_count, 0);
+
+	for (auto&& [spinCount, yieldCount] : {std::pair{0, 0}, std::pair{100000, 100}}) {
+		ASSERT_RGL_SUCCESS(rgl_graph_set_wait_strategy(compact, spinCount, yieldCount));
+		auto expectedStrategy = WaitStrategy{static_cast<uint32_t>(spinCount), static_cast<uint32_t>(yieldCount)};
+		EXPECT_EQ(useRays->getWaitStrategy(), expectedStrategy);
+		ASSERT_RGL_SUCCESS(rgl_graph_get_latency(useRays, &latency));
+		const int initialRunCount = latency.run_count;
+
+		for (int i = 0; i < runCount; ++i) {
+			ASSERT_RGL_SUCCESS(rgl_graph_run(useRays));
+			int32_t outCount = 0, outSizeOf = 0;
+			ASSERT_RGL_SUCCESS(rgl_graph_get_result_size(compact, RGL_FIELD_XYZ_VEC3_F32, &outCount, &outSizeOf));
+		}
+		// Setting the strategy synchronizes the graph, so that the last run is measured too
+		ASSERT_RGL_SUCCESS(rgl_graph_set_wait_strategy(compact, spinCount, yieldCount));
+
+		ASSERT_RGL_SUCCESS(rgl_graph_get_latency(useRays, &latency));
+		EXPECT_EQ(latency.run_count - initialRunCount, runCount);
+		EXPECT_GE(latency.run_max_us, latency.run_mean_us);
+		EXPECT_GE(latency.run_mean_us, 0.0f);
+		EXPECT_GE(latency.wakeup_max_us, latency.wakeup_mean_us);
+		EXPECT_GE(latency.wakeup_mean_us, 0.0f);
+	}
+}
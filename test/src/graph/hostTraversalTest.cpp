@@ -0,0 +1,188 @@
+#include <random>
+
+#include <helpers/commonHelpers.hpp>
+#include <helpers/lidarHelpers.hpp>
+#include <helpers/sceneHelpers.hpp>
+#include <helpers/testPointCloud.hpp>
+
+#include <scene/HostScene.hpp>
+#include <math/Mat3x4f.hpp>
+
+class HostTraversalTest : public RGLTest
+{
+protected:
+	const std::vector<rgl_field_t> fields = {XYZ_VEC3_F32,    IS_HIT_I32,    DISTANCE_F32,       ENTITY_ID_I32,
+	                                         NORMAL_VEC3_F32, INTENSITY_F32, INCIDENT_ANGLE_F32, AZIMUTH_F32,
+	                                         ABSOLUTE_VELOCITY_VEC3_F32};
+
+	rgl_node_t rays = nullptr, raytrace = nullptr, yield = nullptr;
+
+	void createGraph(const std::vector<rgl_mat3x4f>& raysTf)
+	{
+		ASSERT_RGL_SUCCESS(rgl_node_rays_from_mat3x4f(&rays, raysTf.data(), raysTf.size()));
+		ASSERT_RGL_SUCCESS(rgl_node_raytrace(&raytrace, nullptr));
+		ASSERT_RGL_SUCCESS(rgl_node_points_yield(&yield, fields.data(), fields.size()));
+		ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(rays, raytrace));
+		ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(raytrace, yield));
+	}
+
+	TestPointCloud runWithBackend(rgl_raytrace_backend_t backend)
+	{
+		EXPECT_RGL_SUCCESS(rgl_node_raytrace_configure_backend(raytrace, backend));
+		EXPECT_RGL_SUCCESS(rgl_graph_run(rays));
+		return TestPointCloud::createFromNode(yield, fields);
+	}
+
+	// Rays grazing edges of triangles may be hit by one backend and missed by the other, such rays are counted and skipped.
+	static void expectSamePointClouds(const TestPointCloud& expected, const TestPointCloud& actual)
+	{
+		ASSERT_EQ(expected.getPointCount(), actual.getPointCount());
+		const auto expectedIsHit = expected.getFieldValues<IS_HIT_I32>();
+		const auto actualIsHit = actual.getFieldValues<IS_HIT_I32>();
+		const auto expectedEntityId = expected.getFieldValues<ENTITY_ID_I32>();
+		const auto actualEntityId = actual.getFieldValues<ENTITY_ID_I32>();
+		const auto expectedXyz = expected.getFieldValues<XYZ_VEC3_F32>();
+		const auto actualXyz = actual.getFieldValues<XYZ_VEC3_F32>();
+		const auto expectedDistance = expected.getFieldValues<DISTANCE_F32>();
+		const auto actualDistance = actual.getFieldValues<DISTANCE_F32>();
+		const auto expectedNormal = expected.getFieldValues<NORMAL_VEC3_F32>();
+		const auto actualNormal = actual.getFieldValues<NORMAL_VEC3_F32>();
+		const auto expectedIntensity = expected.getFieldValues<INTENSITY_F32>();
+		const auto actualIntensity = actual.getFieldValues<INTENSITY_F32>();
+		const auto expectedAzimuth = expected.getFieldValues<AZIMUTH_F32>();
+		const auto actualAzimuth = actual.getFieldValues<AZIMUTH_F32>();
+		const auto expectedIncidentAngle = expected.getFieldValues<INCIDENT_ANGLE_F32>();
+		const auto actualIncidentAngle = actual.getFieldValues<INCIDENT_ANGLE_F32>();
+		const auto expectedVelocity = expected.getFieldValues<ABSOLUTE_VELOCITY_VEC3_F32>();
+		const auto actualVelocity = actual.getFieldValues<ABSOLUTE_VELOCITY_VEC3_F32>();
+
+		size_t hitCount = 0, mismatchCount = 0;
+		for (size_t i = 0; i < expected.getPointCount(); ++i) {
+			EXPECT_FLOAT_EQ(expectedAzimuth[i], actualAzimuth[i]);
+			if (expectedIsHit[i] != actualIsHit[i] || expectedEntityId[i] != actualEntityId[i]) {
+				++mismatchCount;
+				continue;
+			}
+			if (!expectedIsHit[i]) {
+				EXPECT_EQ(expectedDistance[i], actualDistance[i]);
+				continue;
+			}
+			++hitCount;
+			EXPECT_NEAR(expectedDistance[i], actualDistance[i], 1e-4f);
+			for (int axis = 0; axis < 3; ++axis) {
+				EXPECT_NEAR(expectedXyz[i][axis], actualXyz[i][axis], 1e-4f);
+				EXPECT_NEAR(expectedNormal[i][axis], actualNormal[i][axis], 1e-4f);
+				EXPECT_NEAR(expectedVelocity[i][axis], actualVelocity[i][axis], 1e-3f);
+			}
+			EXPECT_NEAR(expectedIntensity[i], actualIntensity[i], 1e-3f);
+			EXPECT_NEAR(expectedIncidentAngle[i], actualIncidentAngle[i], 1e-3f);
+		}
+		EXPECT_GT(hitCount, 0);
+		EXPECT_LE(mismatchCount, expected.getPointCount() / 1000 + 1);
+	}
+};
+
+TEST_F(HostTraversalTest, host_scene_finds_closest_triangle)
+{
+	std::mt19937 gen{42};
+	std::uniform_real_distribution<float> coord{-10.0f, 10.0f};
+	std::uniform_real_distribution<float> offset{-1.0f, 1.0f};
+
+	std::vector<Vec3f> vertices;
+	std::vector<Vec3i> indices;
+	for (int i = 0; i < 1000; ++i) {
+		const Vec3f center{coord(gen), coord(gen), coord(gen)};
+		for (int vertex = 0; vertex < 3; ++vertex) {
+			vertices.push_back(center + Vec3f{offset(gen), offset(gen), offset(gen)});
+		}
+		indices.push_back({3 * i, 3 * i + 1, 3 * i + 2});
+	}
+	auto geometry = std::make_shared<const HostGeometry>(vertices, indices, std::vector<Vec2f>{});
+	const std::vector<Mat3x4f> transforms = {Mat3x4f::identity(), Mat3x4f::TRS({30, 0, 0}, {0, 45, 0}, {2, 1, 1})};
+	std::vector<HostScene::Instance> instances;
+	for (int i = 0; i < transforms.size(); ++i) {
+		instances.push_back({.entityId = i, .objectToWorld = transforms[i], .geometry = geometry});
+	}
+	HostScene scene{instances};
+
+	// Brute force reference, intersecting triangles in the world space
+	auto intersectAll = [&](const Vec3f& origin, const Vec3f& dir) {
+		float closest = std::numeric_limits<float>::infinity();
+		for (auto&& transform : transforms) {
+			for (auto&& triangle : indices) {
+				const Vec3f A = transform * vertices[triangle.x()];
+				const Vec3f AB = transform * vertices[triangle.y()] - A;
+				const Vec3f AC = transform * vertices[triangle.z()] - A;
+				const Vec3f p = dir.cross(AC);
+				const float invDet = 1.0f / AB.dot(p);
+				const Vec3f s = origin - A;
+				const float u = s.dot(p) * invDet;
+				const Vec3f q = s.cross(AB);
+				const float v = dir.dot(q) * invDet;
+				const float t = AC.dot(q) * invDet;
+				if (u >= 0 && v >= 0 && u + v <= 1 && t >= 0) {
+					closest = std::min(closest, t);
+				}
+			}
+		}
+		return closest;
+	};
+
+	int hitCount = 0;
+	for (int i = 0; i < 1000; ++i) {
+		const Vec3f origin{coord(gen) * 2, coord(gen) * 2, coord(gen) * 2};
+		const Vec3f dir = (Vec3f{coord(gen) + 15.0f, coord(gen), coord(gen)} - origin).normalized();
+		const float expected = intersectAll(origin, dir);
+
+		HostScene::Hit hit{};
+		const bool isHit = scene.intersect(origin, dir, std::numeric_limits<float>::infinity(), hit);
+		ASSERT_EQ(isHit, expected != std::numeric_limits<float>::infinity());
+		if (isHit) {
+			++hitCount;
+			EXPECT_NEAR(hit.distance, expected, 1e-3f);
+		}
+	}
+	EXPECT_GT(hitCount, 0);
+}
+
+TEST_F(HostTraversalTest, host_texture_sampling_wraps_coordinates)
+{
+	HostTexture texture{2, 2, {10, 20, 30, 40}};
+	EXPECT_EQ(texture.sample({0.25f, 0.25f}), 10.0f);
+	EXPECT_EQ(texture.sample({0.75f, 0.25f}), 20.0f);
+	EXPECT_EQ(texture.sample({0.25f, 0.75f}), 30.0f);
+	EXPECT_EQ(texture.sample({1.75f, -0.25f}), 40.0f);
+}
+
+TEST_F(HostTraversalTest, host_traversal_matches_optix)
+{
+	spawnCubeOnScene(Mat3x4f::TRS({0, 0, 10}, {0, 30, 0}, {2, 2, 2}), 1);
+	spawnCubeOnScene(Mat3x4f::TRS({5, 1, 8}, {10, 0, 45}), 2, 100);
+	spawnCubeOnScene(Mat3x4f::TRS({-6, -1, 12}, {0, 0, 0}, {1, 3, 1}), 3);
+	setupBoxesAlongAxes();
+
+	createGraph(makeLidar3dRays(360.0f, 180.0f, 0.72f, 0.72f));
+	ASSERT_RGL_SUCCESS(rgl_node_raytrace_configure_default_intensity(raytrace, 50.0f));
+
+	auto optixPointCloud = runWithBackend(RGL_RAYTRACE_BACKEND_OPTIX);
+	auto hostTraversalPointCloud = runWithBackend(RGL_RAYTRACE_BACKEND_HOST_TRAVERSAL);
+	expectSamePointClouds(optixPointCloud, hostTraversalPointCloud);
+}
+
+TEST_F(HostTraversalTest, host_traversal_computes_velocities)
+{
+	ASSERT_RGL_SUCCESS(rgl_scene_set_time(nullptr, 0));
+	const Mat3x4f initialPose = Mat3x4f::TRS({0, 0, 10}, {0, 20, 0});
+	rgl_entity_t entity = spawnCubeOnScene(initialPose, 1);
+	createGraph(makeLidar3dRays(90.0f, 90.0f, 0.5f, 0.5f));
+	ASSERT_RGL_SUCCESS(rgl_graph_run(rays));
+
+	// Entity is moved and rotated between frames
+	ASSERT_RGL_SUCCESS(rgl_scene_set_time(nullptr, 100 * 1000 * 1000));
+	const rgl_mat3x4f movedPose = (Mat3x4f::TRS({0.5f, 0, -0.2f}, {0, 5, 0}) * initialPose).toRGL();
+	ASSERT_RGL_SUCCESS(rgl_entity_set_transform(entity, &movedPose));
+
+	auto optixPointCloud = runWithBackend(RGL_RAYTRACE_BACKEND_OPTIX);
+	auto hostTraversalPointCloud = runWithBackend(RGL_RAYTRACE_BACKEND_HOST_TRAVERSAL);
+	expectSamePointClouds(optixPointCloud, hostTraversalPointCloud);
+}
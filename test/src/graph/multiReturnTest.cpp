@@ -405,3 +405,50 @@ TEST_F(GraphMultiReturn, horizontal_vertical_beam_divergence)
 	ASSERT_RGL_SUCCESS(rgl_graph_run(rays));
 }
 #endif
+
+/**
+ * Without beam divergence, only the primary ray is shot and returns are written directly by the raytracing programs.
+ * All returns of a beam come from the same ray.
+ */
+TEST_F(GraphMultiReturn, single_ray_beams_without_divergence)
+{
+	spawnCubeOnScene(Mat3x4f::identity());
+
+	const float rayOriginZ = -10.0f;
+	const std::vector<rgl_mat3x4f> raysTf = {Mat3x4f::translation(0.0f, 0.0f, rayOriginZ).toRGL(), // Hits the cube
+	                                         Mat3x4f::translation(5.0f, 0.0f, rayOriginZ).toRGL()}; // Misses the cube
+	const rgl_return_mode_t returnMode = RGL_RETURN_FIRST_LAST;
+	const int32_t returnCount = 2;
+
+	rgl_node_t yield = nullptr;
+	std::vector<rgl_field_t> outFields = {IS_HIT_I32, DISTANCE_F32, RETURN_TYPE_U8};
+	EXPECT_RGL_SUCCESS(rgl_node_rays_from_mat3x4f(&rays, raysTf.data(), raysTf.size()));
+	EXPECT_RGL_SUCCESS(rgl_node_raytrace(&raytrace, nullptr));
+	EXPECT_RGL_SUCCESS(rgl_node_raytrace_configure_beam_divergence(raytrace, 0.0f, 0.0f));
+	EXPECT_RGL_SUCCESS(rgl_node_raytrace_configure_return_mode(raytrace, returnMode));
+	EXPECT_RGL_SUCCESS(rgl_node_points_yield(&yield, outFields.data(), outFields.size()));
+	EXPECT_RGL_SUCCESS(rgl_graph_node_add_child(rays, raytrace));
+	EXPECT_RGL_SUCCESS(rgl_graph_node_add_child(raytrace, yield));
+	ASSERT_RGL_SUCCESS(rgl_graph_run(rays));
+
+	int32_t outCount = 0, outSize = 0;
+	ASSERT_RGL_SUCCESS(rgl_graph_get_result_size(yield, IS_HIT_I32, &outCount, &outSize));
+	ASSERT_EQ(outCount, raysTf.size() * returnCount);
+	std::vector<int32_t> isHit(outCount);
+	std::vector<float> distance(outCount);
+	std::vector<uint8_t> returnType(outCount);
+	ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(yield, IS_HIT_I32, isHit.data()));
+	ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(yield, DISTANCE_F32, distance.data()));
+	ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(yield, RETURN_TYPE_U8, returnType.data()));
+
+	for (int beamIdx = 0; beamIdx < raysTf.size(); ++beamIdx) {
+		for (int returnIdx = 0; returnIdx < returnCount; ++returnIdx) {
+			const int pointIdx = beamIdx * returnCount + returnIdx;
+			EXPECT_EQ(returnType[pointIdx], getReturnType(returnMode, returnIdx));
+			EXPECT_EQ(isHit[pointIdx], beamIdx == 0);
+		}
+	}
+	EXPECT_NEAR(distance[0], -rayOriginZ - CUBE_HALF_EDGE, 1e-4f);
+	EXPECT_EQ(distance[0], distance[1]);
+	EXPECT_EQ(distance[2], distance[3]);
+}
@@ -0,0 +1,115 @@
+#include <helpers/commonHelpers.hpp>
+#include <helpers/fileHelpers.hpp>
+
+#include <math/Mat3x4f.hpp>
+#include <memory/AllocationCounter.hpp>
+#include <memory/Array.hpp>
+#include <RGLFields.hpp>
+
+using namespace ::testing;
+
+struct NodeProfilerTest : RGLTest
+{
+	static constexpr int RUN_COUNT = 5;
+	Vec3f data[2] = {
+	    {1, 2, 3},
+        {4, 5, 6}
+    };
+	rgl_field_t fields[1] = {XYZ_VEC3_F32};
+	rgl_mat3x4f identity = Mat3x4f::identity().toRGL();
+
+	rgl_node_t fromArray = nullptr, transform = nullptr;
+
+	void SetUp() override
+	{
+		ASSERT_RGL_SUCCESS(rgl_node_points_from_array(&fromArray, data, 2, fields, 1));
+		ASSERT_RGL_SUCCESS(rgl_node_points_transform(&transform, &identity));
+		ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(fromArray, transform));
+	}
+};
+
+TEST(AllocationCounter, CountsArrayAllocationsOfCallingThread)
+{
+	auto before = AllocationCounter::getThreadAllocatedBytes();
+	auto array = HostPinnedArray<Vec3f>::create();
+	array->reserve(16, false);
+	EXPECT_EQ(AllocationCounter::getThreadAllocatedBytes() - before, 16 * sizeof(Vec3f));
+
+	// No allocation if capacity is sufficient
+	array->resize(8, false, false);
+	EXPECT_EQ(AllocationCounter::getThreadAllocatedBytes() - before, 16 * sizeof(Vec3f));
+}
+
+TEST_F(NodeProfilerTest, InvalidArguments)
+{
+	rgl_node_stats_t stats;
+	EXPECT_RGL_INVALID_ARGUMENT(rgl_graph_set_profiling(nullptr, true), "node != nullptr");
+	EXPECT_RGL_INVALID_ARGUMENT(rgl_graph_get_node_stats(transform, nullptr), "out_stats != nullptr");
+	EXPECT_RGL_INVALID_ARGUMENT(rgl_graph_write_profile(transform, nullptr, RGL_PROFILE_FORMAT_JSON), "file_path != nullptr");
+	EXPECT_RGL_INVALID_ARGUMENT(rgl_graph_write_profile(transform, "profile.json", static_cast<rgl_profile_format_t>(-1)),
+	                            "format");
+}
+
+TEST_F(NodeProfilerTest, CollectsStatsOnlyWhenEnabled)
+{
+	rgl_node_stats_t stats;
+	ASSERT_RGL_SUCCESS(rgl_graph_run(fromArray));
+	ASSERT_RGL_SUCCESS(rgl_graph_get_node_stats(transform, &stats));
+	EXPECT_EQ(stats.run_count, 0);
+
+	ASSERT_RGL_SUCCESS(rgl_graph_set_profiling(transform, true));
+	for (int i = 0; i < RUN_COUNT; ++i) {
+		ASSERT_RGL_SUCCESS(rgl_graph_run(fromArray));
+	}
+	ASSERT_RGL_SUCCESS(rgl_graph_get_node_stats(transform, &stats));
+	EXPECT_EQ(stats.run_count, RUN_COUNT);
+	EXPECT_GE(stats.cpu_time_mean_us, 0.0f);
+	EXPECT_EQ(stats.gpu_run_count, RUN_COUNT);
+	EXPECT_GE(stats.gpu_time_mean_us, 0.0f);
+	EXPECT_EQ(stats.points_in_last, 2);
+	EXPECT_EQ(stats.points_out_last, 2);
+	EXPECT_FLOAT_EQ(stats.points_out_mean, 2.0f);
+	// Output array is allocated once, later runs reuse it
+	EXPECT_GE(stats.allocated_bytes_total, static_cast<int64_t>(2 * sizeof(Vec3f)));
+	EXPECT_EQ(stats.allocated_bytes_last, 0);
+
+	// Profiling is enabled for the whole graph
+	ASSERT_RGL_SUCCESS(rgl_graph_get_node_stats(fromArray, &stats));
+	EXPECT_EQ(stats.run_count, RUN_COUNT);
+	EXPECT_EQ(stats.points_in_last, 0);
+	EXPECT_EQ(stats.points_out_last, 2);
+
+	// Disabling discards statistics
+	ASSERT_RGL_SUCCESS(rgl_graph_set_profiling(fromArray, false));
+	ASSERT_RGL_SUCCESS(rgl_graph_run(fromArray));
+	ASSERT_RGL_SUCCESS(rgl_graph_get_node_stats(transform, &stats));
+	EXPECT_EQ(stats.run_count, 0);
+}
+
+TEST_F(NodeProfilerTest, WritesJsonAndChromeTrace)
+{
+	const auto jsonPath = std::filesystem::temp_directory_path() / "NodeProfilerTest.json";
+	const auto tracePath = std::filesystem::temp_directory_path() / "NodeProfilerTest.trace.json";
+
+	ASSERT_RGL_SUCCESS(rgl_graph_set_profiling(fromArray, true));
+	for (int i = 0; i < RUN_COUNT; ++i) {
+		ASSERT_RGL_SUCCESS(rgl_graph_run(fromArray));
+	}
+	ASSERT_RGL_SUCCESS(rgl_graph_write_profile(fromArray, jsonPath.string().c_str(), RGL_PROFILE_FORMAT_JSON));
+	ASSERT_RGL_SUCCESS(rgl_graph_write_profile(fromArray, tracePath.string().c_str(), RGL_PROFILE_FORMAT_CHROME_TRACE));
+
+	auto json = readFileStr(jsonPath);
+	EXPECT_THAT(json, StartsWith("["));
+	EXPECT_THAT(json, HasSubstr("\"name\": \"TransformPointsNode\""));
+	EXPECT_THAT(json, HasSubstr("\"name\": \"FromArrayPointsNode\""));
+	EXPECT_THAT(json, HasSubstr(fmt::format("\"cpu_us\": {{\"count\": {}", RUN_COUNT)));
+
+	auto trace = readFileStr(tracePath);
+	EXPECT_THAT(trace, HasSubstr("\"traceEvents\""));
+	EXPECT_THAT(trace, HasSubstr("\"cat\": \"cpu\""));
+	EXPECT_THAT(trace, HasSubstr("\"cat\": \"gpu\""));
+	EXPECT_THAT(trace, HasSubstr("\"name\": \"TransformPointsNode\""));
+
+	std::filesystem::remove(jsonPath);
+	std::filesystem::remove(tracePath);
+}
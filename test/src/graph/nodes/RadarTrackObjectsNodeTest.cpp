@@ -277,6 +277,83 @@ TEST_F(RadarTrackObjectsNodeTest, tracking_kinematic_object_test)
 	}
 }
 
+TEST_F(RadarTrackObjectsNodeTest, many_objects_tracking_test)
+{
+	constexpr float distanceThreshold = 0.5f;
+	constexpr float azimuthThreshold = 0.05f;
+	constexpr float elevationThreshold = 0.05f;
+	constexpr float radialSpeedThreshold = 0.5f;
+
+	constexpr float maxMatchingDistance = 1.0f;
+	constexpr float maxPredictionTimeFrame = 500.0f;
+	constexpr float movementSensitivity = 0.01;
+
+	rgl_node_t trackObjectsNode = nullptr;
+	ASSERT_RGL_SUCCESS(rgl_node_points_radar_track_objects(&trackObjectsNode, distanceThreshold, azimuthThreshold,
+	                                                       elevationThreshold, radialSpeedThreshold, maxMatchingDistance,
+	                                                       maxPredictionTimeFrame, movementSensitivity));
+	auto trackObjectsNodePtr = Node::validatePtr<RadarTrackObjectsNode>(trackObjectsNode);
+
+	// Objects are placed on a spherical grid, separated much more than thresholds, so each one is detected separately.
+	constexpr int distanceSteps = 5, azimuthSteps = 20, elevationSteps = 5;
+	constexpr size_t objectsCount = distanceSteps * azimuthSteps * elevationSteps;
+	constexpr size_t detectionsCountPerObject = 8;
+	const Vec3f clusterSpread = {0.1f};
+
+	std::vector<Vec3f> xyz;
+	std::vector<float> distance, azimuth, elevation, radialSpeed;
+	std::vector<Field<ENTITY_ID_I32>::type> entityIds;
+	std::vector<Field<ABSOLUTE_VELOCITY_VEC3_F32>::type> absVelocities;
+	std::vector<Field<RELATIVE_VELOCITY_VEC3_F32>::type> relVelocities;
+	for (int d = 0; d < distanceSteps; ++d) {
+		for (int a = 0; a < azimuthSteps; ++a) {
+			for (int e = 0; e < elevationSteps; ++e) {
+				const float objectDistance = 20.0f + 5.0f * d;
+				const float objectAzimuth = -1.5f + 0.15f * a;
+				const float objectElevation = M_PI / 2 - 0.3f + 0.15f * e;
+				const auto clusterCenter = objectDistance * Vec3f{std::sin(objectElevation) * std::cos(objectAzimuth),
+				                                                  std::sin(objectElevation) * std::sin(objectAzimuth),
+				                                                  std::cos(objectElevation)};
+				const auto clusterId = static_cast<Field<ENTITY_ID_I32>::type>(entityIds.size());
+				generateDetectionFields(clusterCenter, clusterSpread, detectionsCountPerObject, clusterId, xyz, distance,
+				                        azimuth, elevation, radialSpeed, entityIds, absVelocities, relVelocities);
+			}
+		}
+	}
+
+	TestPointCloud inPointCloud(trackObjectsNodePtr->getRequiredFieldList(), objectsCount * detectionsCountPerObject);
+	inPointCloud.setFieldValues<XYZ_VEC3_F32>(xyz);
+	inPointCloud.setFieldValues<DISTANCE_F32>(distance);
+	inPointCloud.setFieldValues<AZIMUTH_F32>(azimuth);
+	inPointCloud.setFieldValues<ELEVATION_F32>(elevation);
+	inPointCloud.setFieldValues<RADIAL_SPEED_F32>(radialSpeed);
+	inPointCloud.setFieldValues<ENTITY_ID_I32>(entityIds);
+	inPointCloud.setFieldValues<ABSOLUTE_VELOCITY_VEC3_F32>(absVelocities);
+	inPointCloud.setFieldValues<RELATIVE_VELOCITY_VEC3_F32>(relVelocities);
+
+	const auto usePointsNode = inPointCloud.createUsePointsNode();
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(usePointsNode, trackObjectsNode));
+
+	const uint64_t frameTimeNs = 50 * 1e6; // ms
+	constexpr int numberOfIterations = 10;
+	for (int iterationCounter = 0; iterationCounter < numberOfIterations; ++iterationCounter) {
+		ASSERT_RGL_SUCCESS(rgl_scene_set_time(nullptr, iterationCounter * frameTimeNs));
+		ASSERT_RGL_SUCCESS(rgl_graph_run(trackObjectsNode));
+		int32_t detectedObjectsCount = 0, objectsSize = 0;
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_size(trackObjectsNode, XYZ_VEC3_F32, &detectedObjectsCount, &objectsSize));
+
+		// Objects do not move, so all of them should be matched with objects from previous frame.
+		ASSERT_EQ(detectedObjectsCount, objectsCount);
+		const auto& objectStates = trackObjectsNodePtr->getObjectStates();
+		ASSERT_EQ(objectStates.size(), objectsCount);
+		if (iterationCounter > 0) {
+			for (const auto& objectState : objectStates) {
+				ASSERT_EQ(objectState.objectStatus, RadarTrackObjectsNode::ObjectStatus::Measured);
+			}
+		}
+	}
+}
+
 #if RGL_BUILD_ROS2_EXTENSION
 #include <rgl/api/extensions/ros2.h>
 TEST_F(RadarTrackObjectsNodeTest, creating_random_objects_test)
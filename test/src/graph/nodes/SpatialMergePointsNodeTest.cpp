@@ -47,6 +47,59 @@ TEST_F(SpatialMergePointsNodeTest, valid_arguments)
 	EXPECT_RGL_SUCCESS(rgl_node_points_spatial_merge(&spatialMergePointsNode, fields.data(), fields.size()));
 }
 
+TEST_F(SpatialMergePointsNodeTest, merged_fields_follow_inputs)
+{
+	struct Point
+	{
+		Vec3f xyz;
+		float intensity;
+	};
+	std::vector<rgl_field_t> pointFields = {RGL_FIELD_XYZ_VEC3_F32, RGL_FIELD_INTENSITY_F32};
+	std::vector<Point> pointsA = {{{1, 2, 3}, 10}, {{4, 5, 6}, 20}};
+	std::vector<Point> pointsB = {{{7, 8, 9}, 30}};
+
+	rgl_node_t fromArrayA = nullptr, fromArrayB = nullptr;
+	ASSERT_RGL_SUCCESS(
+	    rgl_node_points_from_array(&fromArrayA, pointsA.data(), pointsA.size(), pointFields.data(), pointFields.size()));
+	ASSERT_RGL_SUCCESS(
+	    rgl_node_points_from_array(&fromArrayB, pointsB.data(), pointsB.size(), pointFields.data(), pointFields.size()));
+	ASSERT_RGL_SUCCESS(rgl_node_points_spatial_merge(&spatialMergePointsNode, pointFields.data(), pointFields.size()));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(fromArrayA, spatialMergePointsNode));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(fromArrayB, spatialMergePointsNode));
+
+	auto checkMergedData = [&]() {
+		std::vector<Point> expected = pointsA;
+		expected.insert(expected.end(), pointsB.begin(), pointsB.end());
+
+		int32_t outCount = 0, outSizeOf = 0;
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_size(spatialMergePointsNode, RGL_FIELD_INTENSITY_F32, &outCount, &outSizeOf));
+		ASSERT_EQ(outCount, expected.size());
+		std::vector<float> intensities(outCount);
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(spatialMergePointsNode, RGL_FIELD_INTENSITY_F32, intensities.data()));
+		std::vector<Vec3f> xyz(outCount);
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(spatialMergePointsNode, RGL_FIELD_XYZ_VEC3_F32, xyz.data()));
+		for (int i = 0; i < outCount; ++i) {
+			EXPECT_FLOAT_EQ(xyz[i].x(), expected[i].xyz.x());
+			EXPECT_FLOAT_EQ(xyz[i].y(), expected[i].xyz.y());
+			EXPECT_FLOAT_EQ(xyz[i].z(), expected[i].xyz.z());
+			EXPECT_FLOAT_EQ(intensities[i], expected[i].intensity);
+		}
+	};
+
+	ASSERT_RGL_SUCCESS(rgl_graph_run(spatialMergePointsNode));
+	checkMergedData();
+
+	// Fields are merged on demand, make sure they are not stale after inputs change
+	pointsB.push_back({{10, 11, 12}, 40});
+	pointsA[0].intensity = 50;
+	ASSERT_RGL_SUCCESS(
+	    rgl_node_points_from_array(&fromArrayA, pointsA.data(), pointsA.size(), pointFields.data(), pointFields.size()));
+	ASSERT_RGL_SUCCESS(
+	    rgl_node_points_from_array(&fromArrayB, pointsB.data(), pointsB.size(), pointFields.data(), pointFields.size()));
+	ASSERT_RGL_SUCCESS(rgl_graph_run(spatialMergePointsNode));
+	checkMergedData();
+}
+
 TEST_F(SpatialMergePointsNodeTest, spatial_merge_from_transforms)
 {
 	auto mesh = makeCubeMesh();
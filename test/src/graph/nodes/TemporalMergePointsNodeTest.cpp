@@ -4,6 +4,7 @@
 
 #include <math/Mat3x4f.hpp>
 #include <Logger.hpp>
+#include <RGLFields.hpp>
 
 #if RGL_BUILD_PCL_EXTENSION
 #include <rgl/api/extensions/pcl.h>
@@ -137,4 +138,128 @@ TEST_F(TemporalMergePointsNodeTest, temporal_merge_uses_host_memory)
 	if (allocatedBytes > allowedAllocatedBytes) {
 		FAIL() << fmt::format("TemporalMergeNode seems to allocate GPU memory (allocated {} b)", allocatedBytes);
 	}
-}
\ No newline at end of file
+}
+TEST_F(TemporalMergePointsNodeTest, invalid_argument_window)
+{
+	EXPECT_RGL_INVALID_ARGUMENT(rgl_node_points_temporal_merge_configure_window(nullptr, 1, 0.0f), "node != nullptr");
+
+	ASSERT_RGL_SUCCESS(rgl_node_points_temporal_merge(&temporalMergePointsNode, fields.data(), fields.size()));
+	EXPECT_RGL_INVALID_ARGUMENT(rgl_node_points_temporal_merge_configure_window(temporalMergePointsNode, -1, 0.0f),
+	                            "max_frame_count >= 0");
+	EXPECT_RGL_INVALID_ARGUMENT(rgl_node_points_temporal_merge_configure_window(temporalMergePointsNode, 1, -1.0f),
+	                            "max_duration >= 0.0f");
+	EXPECT_RGL_SUCCESS(rgl_node_points_temporal_merge_configure_window(temporalMergePointsNode, 0, 0.0f));
+}
+
+/**
+ * Frames have different sizes, so that the ring buffer wraps around, grows and evicts frames at different offsets.
+ * Each frame's points have values equal to the frame's index.
+ */
+class TemporalMergePointsNodeWindowTest : public TemporalMergePointsNodeTest
+{
+protected:
+	static constexpr int FRAMES = 12;
+	rgl_field_t windowFields[1] = {RGL_FIELD_INTENSITY_F32};
+	rgl_node_t usePoints = nullptr;
+
+	static int32_t getFrameSize(int frame) { return 1 + (frame * 7) % 5; }
+
+	void runFrame(int frame)
+	{
+		std::vector<float> points(getFrameSize(frame), static_cast<float>(frame));
+		ASSERT_RGL_SUCCESS(rgl_node_points_from_array(&usePoints, points.data(), points.size(), windowFields, 1));
+		if (temporalMergePointsNode == nullptr) {
+			ASSERT_RGL_SUCCESS(rgl_node_points_temporal_merge(&temporalMergePointsNode, windowFields, 1));
+			ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(usePoints, temporalMergePointsNode));
+		}
+		ASSERT_RGL_SUCCESS(rgl_graph_run(usePoints));
+	}
+
+	void expectMergedFrames(int firstFrame, int lastFrame)
+	{
+		std::vector<float> expected;
+		for (int frame = firstFrame; frame <= lastFrame; ++frame) {
+			expected.insert(expected.end(), getFrameSize(frame), static_cast<float>(frame));
+		}
+
+		int32_t outCount = 0, outSizeOf = 0;
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_size(temporalMergePointsNode, RGL_FIELD_INTENSITY_F32, &outCount, &outSizeOf));
+		ASSERT_EQ(outCount, expected.size());
+		std::vector<float> merged(outCount);
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(temporalMergePointsNode, RGL_FIELD_INTENSITY_F32, merged.data()));
+		EXPECT_EQ(merged, expected);
+	}
+};
+
+TEST_F(TemporalMergePointsNodeWindowTest, frame_count_window)
+{
+	constexpr int WINDOW = 3;
+	runFrame(0);
+	ASSERT_RGL_SUCCESS(rgl_node_points_temporal_merge_configure_window(temporalMergePointsNode, WINDOW, 0.0f));
+	for (int frame = 0; frame < FRAMES; ++frame) {
+		runFrame(frame);
+		expectMergedFrames(std::max(0, frame - WINDOW + 1), frame);
+	}
+}
+
+TEST_F(TemporalMergePointsNodeWindowTest, duration_window)
+{
+	constexpr uint64_t FRAME_PERIOD_NS = 100'000'000;
+	constexpr float WINDOW = 0.25f; // Fits the current frame and two previous ones
+	runFrame(0);
+	ASSERT_RGL_SUCCESS(rgl_node_points_temporal_merge_configure_window(temporalMergePointsNode, 0, WINDOW));
+	for (int frame = 0; frame < FRAMES; ++frame) {
+		ASSERT_RGL_SUCCESS(rgl_scene_set_time(nullptr, frame * FRAME_PERIOD_NS));
+		runFrame(frame);
+		expectMergedFrames(std::max(0, frame - 2), frame);
+	}
+}
+
+/**
+ * Nodes following TemporalMergePointsNode receive host-resident point clouds, which they process on the host.
+ */
+TEST_F(TemporalMergePointsNodeTest, host_resident_points_are_compacted_and_transformed)
+{
+	struct Point
+	{
+		Field<XYZ_VEC3_F32>::type xyz;
+		Field<IS_HIT_I32>::type isHit;
+		Field<IS_GROUND_I32>::type isGround;
+	};
+	rgl_field_t pointFields[] = {RGL_FIELD_XYZ_VEC3_F32, RGL_FIELD_IS_HIT_I32, RGL_FIELD_IS_GROUND_I32};
+	const int32_t pointCount = 100'000; // Enough to be processed in multiple chunks
+	std::vector<Point> points(pointCount);
+	for (int32_t i = 0; i < pointCount; ++i) {
+		points[i] = {Vec3f(static_cast<float>(i), 1.0f, 2.0f), i % 3 == 0, 0};
+	}
+	const Mat3x4f transform = Mat3x4f::TRS({1, 2, 3}, {0, 0, 90});
+	rgl_mat3x4f transformRgl = transform.toRGL();
+
+	rgl_node_t usePoints = nullptr, compact = nullptr, transformPts = nullptr;
+	ASSERT_RGL_SUCCESS(rgl_node_points_from_array(&usePoints, points.data(), pointCount, pointFields, ARRAY_SIZE(pointFields)));
+	ASSERT_RGL_SUCCESS(rgl_node_points_temporal_merge(&temporalMergePointsNode, pointFields, ARRAY_SIZE(pointFields)));
+	ASSERT_RGL_SUCCESS(rgl_node_points_compact_by_field(&compact, RGL_FIELD_IS_HIT_I32));
+	ASSERT_RGL_SUCCESS(rgl_node_points_transform(&transformPts, &transformRgl));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(usePoints, temporalMergePointsNode));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(temporalMergePointsNode, compact));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(compact, transformPts));
+	ASSERT_RGL_SUCCESS(rgl_graph_run(usePoints));
+
+	std::vector<Vec3f> expected;
+	for (auto&& point : points) {
+		if (point.isHit) {
+			expected.push_back(transform * point.xyz);
+		}
+	}
+
+	int32_t outCount = 0, outSizeOf = 0;
+	ASSERT_RGL_SUCCESS(rgl_graph_get_result_size(transformPts, RGL_FIELD_XYZ_VEC3_F32, &outCount, &outSizeOf));
+	ASSERT_EQ(outCount, expected.size());
+	std::vector<Vec3f> outPoints(outCount);
+	ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(transformPts, RGL_FIELD_XYZ_VEC3_F32, outPoints.data()));
+	for (int32_t i = 0; i < outCount; ++i) {
+		EXPECT_FLOAT_EQ(outPoints[i].x(), expected[i].x());
+		EXPECT_FLOAT_EQ(outPoints[i].y(), expected[i].y());
+		EXPECT_FLOAT_EQ(outPoints[i].z(), expected[i].z());
+	}
+}
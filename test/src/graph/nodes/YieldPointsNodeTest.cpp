@@ -37,3 +37,43 @@ TEST_F(YieldPointsNodeTest, valid_arguments)
 	// If (*yieldNode) != nullptr
 	EXPECT_RGL_SUCCESS(rgl_node_points_yield(&yieldNode, fields.data(), fields.size()));
 }
+
+TEST_F(YieldPointsNodeTest, yields_every_field_of_each_run)
+{
+	struct Point
+	{
+		rgl_vec3f xyz;
+		float intensity;
+		float azimuth;
+	};
+	std::vector<rgl_field_t> inFields = {RGL_FIELD_XYZ_VEC3_F32, RGL_FIELD_INTENSITY_F32, RGL_FIELD_AZIMUTH_F32};
+	fields.push_back(RGL_FIELD_XYZ_VEC3_F32);
+	rgl_node_t fromArrayNode = nullptr;
+	std::vector<Point> points(8);
+	ASSERT_RGL_SUCCESS(rgl_node_points_yield(&yieldNode, fields.data(), fields.size()));
+
+	for (int run = 0; run < 3; ++run) {
+		for (int i = 0; i < points.size(); ++i) {
+			points[i] = {{static_cast<float>(i), 0, static_cast<float>(run)}, static_cast<float>(run * 100 + i),
+			             static_cast<float>(-i)};
+		}
+		ASSERT_RGL_SUCCESS(
+		    rgl_node_points_from_array(&fromArrayNode, points.data(), points.size(), inFields.data(), inFields.size()));
+		if (run == 0) {
+			ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(fromArrayNode, yieldNode));
+		}
+		ASSERT_RGL_SUCCESS(rgl_graph_run(fromArrayNode));
+
+		std::vector<float> intensity(points.size()), azimuth(points.size());
+		std::vector<rgl_vec3f> xyz(points.size());
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(yieldNode, RGL_FIELD_INTENSITY_F32, intensity.data()));
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(yieldNode, RGL_FIELD_AZIMUTH_F32, azimuth.data()));
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(yieldNode, RGL_FIELD_XYZ_VEC3_F32, xyz.data()));
+		for (int i = 0; i < points.size(); ++i) {
+			EXPECT_EQ(intensity[i], points[i].intensity);
+			EXPECT_EQ(azimuth[i], points[i].azimuth);
+			EXPECT_EQ(xyz[i].value[0], points[i].xyz.value[0]);
+			EXPECT_EQ(xyz[i].value[2], points[i].xyz.value[2]);
+		}
+	}
+}
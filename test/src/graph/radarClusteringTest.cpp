@@ -0,0 +1,77 @@
+#include <helpers/commonHelpers.hpp>
+#include <helpers/radarClusteringHelpers.hpp>
+
+static void expectSameClusters(const std::vector<RadarCluster>& actual, const std::vector<RadarCluster>& expected)
+{
+	auto isSame = [](float a, float b) { return a == b || (std::isnan(a) && std::isnan(b)); };
+	ASSERT_EQ(actual.size(), expected.size());
+	for (int i = 0; i < actual.size(); ++i) {
+		// Order of indices matters - it affects choosing the directional center
+		ASSERT_EQ(actual[i].indices, expected[i].indices) << "cluster " << i;
+		for (int limit = 0; limit < 2; ++limit) {
+			EXPECT_TRUE(isSame(actual[i].minMaxDistance[limit], expected[i].minMaxDistance[limit]));
+			EXPECT_TRUE(isSame(actual[i].minMaxAzimuth[limit], expected[i].minMaxAzimuth[limit]));
+			EXPECT_TRUE(isSame(actual[i].minMaxRadialSpeed[limit], expected[i].minMaxRadialSpeed[limit]));
+			EXPECT_TRUE(isSame(actual[i].minMaxElevation[limit], expected[i].minMaxElevation[limit]));
+		}
+	}
+}
+
+TEST(RadarClustering, MatchesReferenceImplementation)
+{
+	RadarClusterBuilder builder; // Reused on purpose, buffers must not leak between calls
+	for (unsigned seed = 0; seed < 10; ++seed) {
+		for (auto&& [pointCount, objectCount] : {std::pair{200, 5}, std::pair{1000, 50}, std::pair{2000, 200}}) {
+			auto input = RadarClusteringInput::generate(pointCount, objectCount, seed);
+			expectSameClusters(input.buildClusters(builder), input.buildClustersReference());
+		}
+	}
+}
+
+TEST(RadarClustering, MatchesReferenceImplementationWithoutRadialSpeed)
+{
+	RadarClusterBuilder builder;
+	for (unsigned seed = 0; seed < 10; ++seed) {
+		auto input = RadarClusteringInput::generate(2000, 50, seed, false);
+		expectSameClusters(input.buildClusters(builder), input.buildClustersReference());
+	}
+}
+
+TEST(RadarClustering, MatchesReferenceImplementationWithUnusualThresholds)
+{
+	RadarClusterBuilder builder;
+	auto input = RadarClusteringInput::generate(1000, 20, 42);
+
+	// Zero thresholds - only points with equal coordinates are clustered together
+	for (auto&& scope : input.radarScopes) {
+		scope.distance_separation_threshold = 0.0f;
+		scope.azimuth_separation_threshold = 0.0f;
+	}
+	for (int i = 0; i < input.distances.size(); i += 3) {
+		input.distances[i] = std::round(input.distances[i]);
+		input.azimuths[i] = std::round(input.azimuths[i] * 10.0f) / 10.0f;
+	}
+	expectSameClusters(input.buildClusters(builder), input.buildClustersReference());
+
+	// Infinite thresholds - grid is not usable
+	input.radarScopes[1].azimuth_separation_threshold = INFINITY;
+	expectSameClusters(input.buildClusters(builder), input.buildClustersReference());
+
+	// Very small thresholds compared to objects - clusters span too many cells to be indexed
+	input.radarScopes[0].azimuth_separation_threshold = 1e-4f;
+	input.radarScopes[1].azimuth_separation_threshold = 1e-4f;
+	input.radarScopes[0].distance_separation_threshold = 10.0f;
+	expectSameClusters(input.buildClusters(builder), input.buildClustersReference());
+
+	// Points with nan azimuth are never clustered with others
+	input.azimuths[7] = NAN;
+	input.azimuths[100] = NAN;
+	expectSameClusters(input.buildClusters(builder), input.buildClustersReference());
+}
+
+TEST(RadarClustering, EmptyInput)
+{
+	RadarClusterBuilder builder;
+	auto input = RadarClusteringInput::generate(0, 1, 0);
+	EXPECT_TRUE(input.buildClusters(builder).empty());
+}
@@ -0,0 +1,129 @@
+#include <helpers/commonHelpers.hpp>
+#include <helpers/sceneHelpers.hpp>
+
+#include <graph/RaytraceBatch.hpp>
+#include <math/Mat3x4f.hpp>
+#include <RGLExceptions.hpp>
+
+class RaytraceBatchTest : public RGLTest
+{
+protected:
+	static RaytraceRequestContext makeRequest(size_t rayCount)
+	{
+		RaytraceRequestContext request{};
+		request.rayCount = rayCount;
+		return request;
+	}
+
+	struct Sensor
+	{
+		rgl_node_t rays = nullptr, raytrace = nullptr, yield = nullptr;
+	};
+
+	// Sensor looking at the cube (spawned at the origin) from given distance, its rays spread along X axis.
+	Sensor makeSensor(float distance, int rayCount)
+	{
+		Sensor sensor;
+		std::vector<rgl_mat3x4f> raysTf;
+		for (int i = 0; i < rayCount; ++i) {
+			raysTf.push_back(Mat3x4f::translation(i * 0.1f, 0.0f, -distance).toRGL());
+		}
+		rgl_field_t field = RGL_FIELD_DISTANCE_F32;
+		EXPECT_RGL_SUCCESS(rgl_node_rays_from_mat3x4f(&sensor.rays, raysTf.data(), raysTf.size()));
+		EXPECT_RGL_SUCCESS(rgl_node_raytrace(&sensor.raytrace, nullptr));
+		EXPECT_RGL_SUCCESS(rgl_node_points_yield(&sensor.yield, &field, 1));
+		EXPECT_RGL_SUCCESS(rgl_graph_node_add_child(sensor.rays, sensor.raytrace));
+		EXPECT_RGL_SUCCESS(rgl_graph_node_add_child(sensor.raytrace, sensor.yield));
+		return sensor;
+	}
+
+	std::vector<float> getDistances(const Sensor& sensor)
+	{
+		int32_t count = 0, sizeOf = 0;
+		EXPECT_RGL_SUCCESS(rgl_graph_get_result_size(sensor.yield, RGL_FIELD_DISTANCE_F32, &count, &sizeOf));
+		std::vector<float> distances(count);
+		EXPECT_RGL_SUCCESS(rgl_graph_get_result_data(sensor.yield, RGL_FIELD_DISTANCE_F32, distances.data()));
+		return distances;
+	}
+};
+
+TEST_F(RaytraceBatchTest, launch_data_lays_out_requests_one_after_another)
+{
+	const std::vector<size_t> rayCounts = {3, 0, 5, 1};
+	std::vector<RaytraceRequestContext> requests;
+	for (auto&& rayCount : rayCounts) {
+		requests.push_back(makeRequest(rayCount));
+	}
+	const OptixTraversableHandle scene = 42;
+	const float sceneDeltaTime = 0.1f;
+
+	auto data = RaytraceLaunchData::create(requests, scene, sceneDeltaTime);
+
+	ASSERT_EQ(data.requests.size(), rayCounts.size());
+	EXPECT_EQ(data.requestRayOffsets, (std::vector<uint32_t>{0, 3, 3, 8, 9}));
+	EXPECT_EQ(data.rayCount, 9);
+	for (auto&& request : data.requests) {
+		EXPECT_EQ(request.scene, scene);
+		EXPECT_EQ(request.sceneDeltaTime, sceneDeltaTime);
+	}
+
+	// Every ray is assigned to the request it belongs to, requests without rays are skipped.
+	const int requestCount = static_cast<int>(data.requests.size());
+	for (uint32_t launchIdx = 0; launchIdx < data.rayCount; ++launchIdx) {
+		int requestIdx = findRaytraceRequest(data.requestRayOffsets.data(), requestCount, launchIdx);
+		EXPECT_GE(launchIdx, data.requestRayOffsets.at(requestIdx));
+		EXPECT_LT(launchIdx, data.requestRayOffsets.at(requestIdx + 1));
+	}
+}
+
+TEST_F(RaytraceBatchTest, launch_data_rejects_too_many_rays)
+{
+	std::vector<RaytraceRequestContext> requests = {makeRequest(RaytraceLaunchData::maxRayCount),
+	                                                makeRequest(RaytraceLaunchData::maxRayCount)};
+	EXPECT_THROW(RaytraceLaunchData::create(requests, 0, 0.0f), InvalidPipeline);
+}
+
+TEST_F(RaytraceBatchTest, batched_sensors_match_separate_ones)
+{
+	spawnCubeOnScene(Mat3x4f::identity());
+	const std::vector<float> sensorDistances = {5.0f, 10.0f, 20.0f};
+	const int rayCount = 8;
+
+	std::vector<Sensor> sensors;
+	for (auto&& distance : sensorDistances) {
+		sensors.push_back(makeSensor(distance, rayCount));
+	}
+
+	// Separate launches
+	std::vector<std::vector<float>> expected;
+	for (auto&& sensor : sensors) {
+		ASSERT_RGL_SUCCESS(rgl_graph_run(sensor.rays));
+		expected.push_back(getDistances(sensor));
+	}
+
+	// Batched launch, each sensor in its own graph
+	for (auto&& sensor : sensors) {
+		ASSERT_RGL_SUCCESS(rgl_node_raytrace_configure_batch(sensor.raytrace, 1));
+	}
+	for (int frame = 0; frame < 3; ++frame) {
+		for (auto&& sensor : sensors) {
+			ASSERT_RGL_SUCCESS(rgl_graph_run(sensor.rays));
+		}
+		for (int sensorIdx = 0; sensorIdx < sensors.size(); ++sensorIdx) {
+			auto distances = getDistances(sensors.at(sensorIdx));
+			EXPECT_EQ(distances, expected.at(sensorIdx));
+			EXPECT_FLOAT_EQ(distances.front(), sensorDistances.at(sensorIdx) - CUBE_HALF_EDGE);
+		}
+	}
+
+	// Member that is not run does not block the others
+	ASSERT_RGL_SUCCESS(rgl_graph_run(sensors.front().rays));
+	EXPECT_EQ(getDistances(sensors.front()), expected.front());
+
+	// Leaving the batch
+	for (auto&& sensor : sensors) {
+		ASSERT_RGL_SUCCESS(rgl_node_raytrace_configure_batch(sensor.raytrace, 0));
+		ASSERT_RGL_SUCCESS(rgl_graph_run(sensor.rays));
+	}
+	EXPECT_EQ(getDistances(sensors.back()), expected.back());
+}
@@ -0,0 +1,198 @@
+#include <helpers/commonHelpers.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+
+#include <HostKernels.hpp>
+
+/*
+ * TEST PURPOSE:
+ * Check that host counterparts of node kernels match straightforward serial implementations,
+ * also when the input is split into multiple chunks processed in parallel.
+ */
+
+class HostKernelsTest : public RGLTest, public testing::WithParamInterface<size_t>
+{
+protected:
+	std::mt19937 gen{42};
+
+	std::vector<int32_t> makeMask(size_t count)
+	{
+		std::bernoulli_distribution isSet(0.3);
+		std::vector<int32_t> mask(count);
+		std::generate(mask.begin(), mask.end(), [&]() { return isSet(gen) ? 1 : 0; });
+		return mask;
+	}
+
+	std::vector<Vec3f> makeVectors(size_t count)
+	{
+		std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+		std::vector<Vec3f> vectors(count);
+		std::generate(vectors.begin(), vectors.end(), [&]() { return Vec3f{value(gen), value(gen), value(gen)}; });
+		return vectors;
+	}
+};
+
+INSTANTIATE_TEST_SUITE_P(HostKernelsTests, HostKernelsTest,
+                         testing::Values(0, 1, HOST_KERNEL_CHUNK_SIZE - 1, HOST_KERNEL_CHUNK_SIZE,
+                                         5 * HOST_KERNEL_CHUNK_SIZE + 7));
+
+TEST_P(HostKernelsTest, parallel_for_covers_every_index_once)
+{
+	const size_t count = GetParam();
+	std::vector<std::atomic<int>> visits(count);
+	hostParallelFor(count, 1000, [&](size_t begin, size_t end) {
+		ASSERT_LT(begin, end);
+		ASSERT_LE(end - begin, 1000);
+		for (size_t i = begin; i < end; ++i) {
+			++visits[i];
+		}
+	});
+	EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](auto&& v) { return v == 1; }));
+}
+
+TEST_P(HostKernelsTest, compaction)
+{
+	const size_t count = GetParam();
+	const std::vector<int32_t> mask = makeMask(count);
+	std::vector<float> src(count);
+	std::iota(src.begin(), src.end(), 0.0f);
+
+	std::vector<CompactionIndexType> prefixSum(count);
+	const size_t hitCount = hostFindCompaction(count, mask.data(), prefixSum.data());
+
+	std::vector<CompactionIndexType> expectedPrefixSum(count);
+	std::inclusive_scan(mask.begin(), mask.end(), expectedPrefixSum.begin());
+	EXPECT_EQ(prefixSum, expectedPrefixSum);
+	EXPECT_EQ(hitCount, static_cast<size_t>(std::count(mask.begin(), mask.end(), 1)));
+
+	std::vector<float> dst(hitCount);
+	hostApplyCompaction(count, sizeof(float), mask.data(), prefixSum.data(), reinterpret_cast<char*>(dst.data()),
+	                    reinterpret_cast<const char*>(src.data()));
+	std::vector<float> expected;
+	for (size_t i = 0; i < count; ++i) {
+		if (mask[i]) {
+			expected.push_back(src[i]);
+		}
+	}
+	EXPECT_EQ(dst, expected);
+}
+
+TEST_P(HostKernelsTest, transform_points_and_rays)
+{
+	const size_t count = GetParam();
+	const Mat3x4f transform = Mat3x4f::TRS({1, -2, 3}, {10, 20, 30}, {1, 2, 1});
+	const std::vector<Vec3f> points = makeVectors(count);
+	std::vector<Mat3x4f> rays(count);
+	for (size_t i = 0; i < count; ++i) {
+		rays[i] = Mat3x4f::TRS(points[i], points[i]);
+	}
+
+	std::vector<Vec3f> outPoints(count);
+	std::vector<Mat3x4f> outRays(count);
+	hostTransformPoints(count, points.data(), outPoints.data(), transform);
+	hostTransformRays(count, rays.data(), outRays.data(), transform);
+	for (size_t i = 0; i < count; ++i) {
+		Vec3f expectedPoint = transform * points[i];
+		EXPECT_EQ(outPoints[i].x(), expectedPoint.x());
+		EXPECT_EQ(outPoints[i].y(), expectedPoint.y());
+		EXPECT_EQ(outPoints[i].z(), expectedPoint.z());
+		EXPECT_EQ(outRays[i], transform * rays[i]);
+	}
+}
+
+TEST_P(HostKernelsTest, filter)
+{
+	const size_t count = GetParam();
+	struct Point
+	{
+		float intensity;
+		Vec3f xyz;
+		uint16_t ringId;
+	};
+	std::vector<Point> aos(count);
+	const std::vector<Vec3f> xyz = makeVectors(count);
+	for (size_t i = 0; i < count; ++i) {
+		aos[i] = {static_cast<float>(i), xyz[i], static_cast<uint16_t>(i)};
+	}
+
+	// Indices in reverse order, with repetitions
+	std::vector<Field<RAY_IDX_U32>::type> indices(count);
+	for (size_t i = 0; i < count; ++i) {
+		indices[i] = static_cast<uint32_t>((count - 1 - i) / 2 * 2);
+	}
+	std::vector<Point> filtered(count);
+	hostFilter(count, indices.data(), reinterpret_cast<char*>(filtered.data()), reinterpret_cast<const char*>(aos.data()),
+	           sizeof(Point));
+	for (size_t i = 0; i < count; ++i) {
+		EXPECT_EQ(filtered[i].intensity, aos[indices[i]].intensity);
+		EXPECT_EQ(filtered[i].ringId, aos[indices[i]].ringId);
+	}
+}
+
+TEST_P(HostKernelsTest, filter_ground_points)
+{
+	const size_t count = GetParam();
+	const Vec3f up = {0, 0, 1};
+	const float threshold = 0.3f;
+	std::vector<Vec3f> normals = makeVectors(count);
+	for (auto&& normal : normals) {
+		normal = normal.normalized();
+	}
+
+	std::vector<Field<IS_GROUND_I32>::type> isNonGround(count);
+	hostFilterGroundPoints(count, up, threshold, normals.data(), isNonGround.data());
+	for (size_t i = 0; i < count; ++i) {
+		EXPECT_EQ(isNonGround[i], acosf(fabsf(normals[i].dot(up))) > threshold);
+	}
+}
+
+TEST_P(HostKernelsTest, generate_normals)
+{
+	const size_t count = GetParam();
+	const uint64_t seed = 0x0123456789abcdef;
+	const uint32_t frame = 7;
+	const size_t firstIndex = 3; // Unaligned to SIMD lanes
+	std::vector<float> normals(count);
+	hostGenerateNormals(seed, frame, firstIndex, count, normals.data());
+	for (size_t i = 0; i < count; ++i) {
+		EXPECT_EQ(normals[i], Philox4x32::normal(seed, frame, firstIndex + i));
+	}
+}
+
+TEST_P(HostKernelsTest, gaussian_noise)
+{
+	const size_t count = GetParam();
+	const uint64_t seed = 42;
+	const uint32_t frame = 3;
+	const Mat3x4f lookAtOrigin = Mat3x4f::TRS({1, 2, 3}, {0, 90, 0});
+	const std::vector<Vec3f> points = makeVectors(count);
+	std::vector<float> distances(count);
+	for (size_t i = 0; i < count; ++i) {
+		distances[i] = (lookAtOrigin * points[i]).length();
+	}
+
+	std::vector<Vec3f> outPoints(count);
+	std::vector<float> outDistances(count);
+	hostAddGaussianNoiseDistance(count, 0.1f, 0.01f, 0.001f, lookAtOrigin, seed, frame, points.data(), distances.data(),
+	                             outPoints.data(), outDistances.data());
+	for (size_t i = 0; i < count; ++i) {
+		float expectedError = 0.1f + Philox4x32::normal(seed, frame, i) * (distances[i] * 0.001f + 0.01f);
+		EXPECT_FLOAT_EQ(outDistances[i], distances[i] + expectedError);
+	}
+
+	hostAddGaussianNoiseAngularHitpoint(count, 0.0f, 0.01f, RGL_AXIS_Z, lookAtOrigin, seed, frame, points.data(),
+	                                    outPoints.data(), outDistances.data());
+	for (size_t i = 0; i < count; ++i) {
+		// Rotation around the origin of the look-at frame preserves distance
+		EXPECT_NEAR(outDistances[i], distances[i], 1e-3f * std::max(1.0f, distances[i]));
+		Vec3f expected = lookAtOrigin.inverse() *
+		                 (Mat3x4f::rotationRad(RGL_AXIS_Z, Philox4x32::normal(seed, frame, i) * 0.01f) *
+		                  (lookAtOrigin * points[i]));
+		EXPECT_NEAR(outPoints[i].x(), expected.x(), 1e-3f);
+		EXPECT_NEAR(outPoints[i].y(), expected.y(), 1e-3f);
+		EXPECT_NEAR(outPoints[i].z(), expected.z(), 1e-3f);
+	}
+}
@@ -51,6 +51,27 @@ TEST_F(ArrayOps, ResizeChangesCount)
 	EXPECT_LE(array->getCapacity(), END_SIZE);
 }
 
+TEST_F(ArrayOps, CopyFromSegmentsConcatenates)
+{
+	auto first = HostPageableArray<Type>::create();
+	auto empty = HostPageableArray<Type>::create();
+	auto second = DeviceAsyncArray<Type>::create(CudaStream::getNullStream());
+	std::vector<Type> firstData = {1, 2, 3};
+	std::vector<Type> secondData = {4, 5};
+	first->copyFromExternal(firstData.data(), firstData.size());
+	second->copyFromExternal(secondData.data(), secondData.size());
+
+	array->append(42);
+	array->copyFromSegments({first, empty, second});
+	ASSERT_EQ(array->getCount(), firstData.size() + secondData.size());
+	for (int i = 0; i < array->getCount(); ++i) {
+		EXPECT_EQ(array->at(i), i + 1);
+	}
+
+	EXPECT_THROW(array->copyFromSegments({first, array}), std::runtime_error);
+	EXPECT_THROW(array->copyFromSegments({HostPageableArray<char>::create()}), std::runtime_error);
+}
+
 // TODO(nebraszka): write more tests:
 // TODO: resizing test
 // TODO: copy test
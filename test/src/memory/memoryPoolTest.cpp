@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <memory/MemoryPool.hpp>
+#include <memory/Array.hpp>
+
+/*
+ * TEST PURPOSE:
+ * Check that MemoryPool reuses freed blocks, keeps its counters right and respects the high-water mark.
+ * Backing allocator is malloc / free, so these tests do not need a GPU.
+ */
+
+struct MemoryPoolTest : public ::testing::Test
+{
+protected:
+	static constexpr size_t MAX_CACHED_BYTES = 4096;
+
+	MemoryPoolTest()
+	  : pool(
+	        [this](size_t bytes) {
+		        backingAllocations += 1;
+		        return malloc(bytes);
+	        },
+	        [this](void* ptr) {
+		        backingDeallocations += 1;
+		        free(ptr);
+	        },
+	        MAX_CACHED_BYTES, MAX_CACHED_BYTES)
+	{}
+
+	size_t backingAllocations = 0;
+	size_t backingDeallocations = 0;
+	MemoryPool pool;
+};
+
+TEST_F(MemoryPoolTest, SizeClasses)
+{
+	EXPECT_EQ(MemoryPool::getSizeClass(0), MemoryPool::MIN_BLOCK_BYTES);
+	EXPECT_EQ(MemoryPool::getSizeClass(1), MemoryPool::MIN_BLOCK_BYTES);
+	EXPECT_EQ(MemoryPool::getSizeClass(256), 256);
+	EXPECT_EQ(MemoryPool::getSizeClass(257), 320);
+	EXPECT_EQ(MemoryPool::getSizeClass(512), 512);
+	EXPECT_EQ(MemoryPool::getSizeClass(513), 640);
+	EXPECT_EQ(MemoryPool::getSizeClass(1000), 1024);
+	for (size_t bytes = 1; bytes < (1 << 20); bytes = bytes * 3 / 2 + 1) {
+		size_t sizeClass = MemoryPool::getSizeClass(bytes);
+		EXPECT_GE(sizeClass, bytes);
+		EXPECT_LE(sizeClass, std::max(MemoryPool::MIN_BLOCK_BYTES, bytes + bytes / 4));
+	}
+}
+
+TEST_F(MemoryPoolTest, FreedBlocksAreReused)
+{
+	void* first = pool.allocate(300);
+	pool.deallocate(first);
+	EXPECT_EQ(pool.getStats().bytesCached, 320);
+
+	// Same size class
+	void* second = pool.allocate(310);
+	EXPECT_EQ(second, first);
+	EXPECT_EQ(backingAllocations, 1);
+
+	// Different size class
+	void* third = pool.allocate(100);
+	EXPECT_NE(third, first);
+	EXPECT_EQ(backingAllocations, 2);
+
+	MemoryPoolStats stats = pool.getStats();
+	EXPECT_EQ(stats.hitCount, 1);
+	EXPECT_EQ(stats.missCount, 2);
+	EXPECT_EQ(stats.bytesLive, 320 + 256);
+	EXPECT_EQ(stats.bytesPeak, 320 + 256);
+	EXPECT_EQ(stats.bytesCached, 0);
+
+	pool.deallocate(second);
+	pool.deallocate(third);
+	stats = pool.getStats();
+	EXPECT_EQ(stats.bytesLive, 0);
+	EXPECT_EQ(stats.bytesPeak, 320 + 256);
+	EXPECT_EQ(stats.bytesCached, 320 + 256);
+	EXPECT_EQ(backingDeallocations, 0);
+
+	pool.trim();
+	EXPECT_EQ(pool.getStats().bytesCached, 0);
+	EXPECT_EQ(backingDeallocations, 2);
+
+	EXPECT_THROW(pool.deallocate(third), std::invalid_argument);
+}
+
+TEST_F(MemoryPoolTest, HighWaterMarkIsRespected)
+{
+	std::vector<void*> blocks;
+	for (int i = 0; i < 8; ++i) {
+		blocks.push_back(pool.allocate(1024));
+	}
+	void* large = pool.allocate(2 * MAX_CACHED_BYTES);
+	for (auto&& block : blocks) {
+		pool.deallocate(block);
+	}
+	pool.deallocate(large); // Too large to be cached
+
+	MemoryPoolStats stats = pool.getStats();
+	EXPECT_EQ(stats.bytesCached, MAX_CACHED_BYTES);
+	EXPECT_EQ(stats.trimCount, 5);
+	EXPECT_EQ(backingDeallocations, 5);
+
+	pool.setMaxCachedBytes(1024);
+	EXPECT_EQ(pool.getStats().bytesCached, 1024);
+	EXPECT_EQ(backingDeallocations, 8);
+}
+
+TEST_F(MemoryPoolTest, LargestBlocksAreTrimmedFirst)
+{
+	void* small = pool.allocate(256);
+	void* large = pool.allocate(2048);
+	pool.deallocate(small);
+	pool.deallocate(large);
+
+	pool.trim(1024);
+	EXPECT_EQ(pool.getStats().bytesCached, 256);
+	void* reused = pool.allocate(200);
+	EXPECT_EQ(reused, small);
+	pool.deallocate(reused);
+}
+
+TEST(MemoryPool, ReusedBlocksAreSynchronized)
+{
+	size_t syncCount = 0;
+	MemoryPool pool(malloc, free, 4096, 4096, [&]() { syncCount += 1; });
+
+	void* first = pool.allocate(256);
+	void* second = pool.allocate(256);
+	void* fresh = pool.allocate(512);
+	EXPECT_EQ(syncCount, 0);
+
+	pool.deallocate(first);
+	pool.deallocate(second);
+	void* reused = pool.allocate(256);
+	EXPECT_EQ(syncCount, 1);
+
+	// Released before the last synchronization
+	void* reusedAgain = pool.allocate(256);
+	EXPECT_EQ(syncCount, 1);
+
+	pool.deallocate(reused);
+	reused = pool.allocate(256);
+	EXPECT_EQ(syncCount, 2);
+	EXPECT_EQ(pool.getStats().syncCount, 2);
+
+	pool.deallocate(reused);
+	pool.deallocate(reusedAgain);
+	pool.deallocate(fresh);
+}
+
+TEST(MemoryPools, HostPageableArraysReuseMemory)
+{
+	MemoryPool& pool = MemoryPools::getHostPool(MemoryKind::HostPageable);
+	size_t hitsBefore = pool.getStats().hitCount;
+	{
+		auto array = HostPageableArray<float>::create();
+		// Fluctuating point count
+		for (size_t count : {1000, 3000, 2000, 5000, 1000, 3000, 5000}) {
+			array->resize(count, true, false);
+			array->clear(false);
+		}
+	}
+	{
+		auto array = HostPageableArray<float>::create();
+		array->resize(5000, false, false);
+	}
+	EXPECT_GT(pool.getStats().hitCount, hitsBefore);
+}
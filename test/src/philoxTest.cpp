@@ -0,0 +1,63 @@
+#include <helpers/commonHelpers.hpp>
+
+#include <cmath>
+
+#include <math/Philox.hpp>
+
+class PhiloxTest : public RGLTest
+{};
+
+// Known-answer vectors of Philox4x32-10 published with Random123 (kat_vectors)
+TEST_F(PhiloxTest, matches_reference_vectors)
+{
+	struct Vector
+	{
+		Philox4x32::Bits counter;
+		uint32_t key0, key1;
+		Philox4x32::Bits expected;
+	};
+	const Vector vectors[] = {
+	    {{0, 0, 0, 0}, 0, 0, {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}},
+	    {{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+	     0xffffffff,
+	     0xffffffff,
+	     {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}},
+	    {{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+	     0xa4093822,
+	     0x299f31d0,
+	     {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}},
+	};
+	for (auto&& vector : vectors) {
+		Philox4x32::Bits bits = Philox4x32::generate(vector.counter, vector.key0, vector.key1);
+		for (int i = 0; i < 4; ++i) {
+			EXPECT_EQ(bits.x[i], vector.expected.x[i]);
+		}
+	}
+}
+
+TEST_F(PhiloxTest, normal_distribution_moments)
+{
+	constexpr uint32_t SAMPLES = 1'000'000;
+	double sum = 0.0, sumSquares = 0.0;
+	for (uint32_t i = 0; i < SAMPLES; ++i) {
+		double sample = Philox4x32::normal(1234, 5, i);
+		ASSERT_TRUE(std::isfinite(sample));
+		sum += sample;
+		sumSquares += sample * sample;
+	}
+	double mean = sum / SAMPLES;
+	double variance = sumSquares / SAMPLES - mean * mean;
+	EXPECT_NEAR(mean, 0.0, 0.005);
+	EXPECT_NEAR(variance, 1.0, 0.005);
+}
+
+TEST_F(PhiloxTest, streams_depend_on_seed_frame_and_index)
+{
+	const float sample = Philox4x32::normal(1, 1, 1);
+	EXPECT_EQ(sample, Philox4x32::normal(1, 1, 1));
+	EXPECT_NE(sample, Philox4x32::normal(2, 1, 1));
+	EXPECT_NE(sample, Philox4x32::normal(1, 2, 1));
+	EXPECT_NE(sample, Philox4x32::normal(1, 1, 2));
+	// Upper half of the seed is a part of the key as well
+	EXPECT_NE(sample, Philox4x32::normal(1 + (uint64_t{1} << 32), 1, 1));
+}
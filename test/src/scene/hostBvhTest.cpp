@@ -0,0 +1,166 @@
+#include <cmath>
+#include <random>
+
+#include <helpers/commonHelpers.hpp>
+#include <helpers/geometryData.hpp>
+
+#include <math/Mat3x4f.hpp>
+#include <scene/HostBVH.hpp>
+#include <scene/HostScene.hpp>
+
+class HostBVHTest : public RGLTest
+{
+protected:
+	struct TestMesh
+	{
+		std::vector<Vec3f> vertices;
+		std::vector<Vec3i> indices;
+	};
+
+	// Heightfield over the XY plane with gridSize x gridSize quads (two triangles each)
+	static TestMesh makeGridMesh(int gridSize, float waveTime = 0.0f)
+	{
+		TestMesh mesh;
+		const int rowSize = gridSize + 1;
+		for (int y = 0; y < rowSize; ++y) {
+			for (int x = 0; x < rowSize; ++x) {
+				const float height = std::sin(0.1f * static_cast<float>(x) + waveTime) * std::cos(0.1f * static_cast<float>(y));
+				mesh.vertices.emplace_back(static_cast<float>(x), static_cast<float>(y), height);
+			}
+		}
+		for (int y = 0; y < gridSize; ++y) {
+			for (int x = 0; x < gridSize; ++x) {
+				const int corner = y * rowSize + x;
+				mesh.indices.emplace_back(corner, corner + 1, corner + rowSize);
+				mesh.indices.emplace_back(corner + 1, corner + rowSize + 1, corner + rowSize);
+			}
+		}
+		return mesh;
+	}
+
+	static TestMesh makeCubeMesh()
+	{
+		TestMesh mesh;
+		for (auto&& vertex : cubeVertices) {
+			mesh.vertices.emplace_back(vertex.value[0], vertex.value[1], vertex.value[2]);
+		}
+		for (auto&& triangle : cubeIndices) {
+			mesh.indices.emplace_back(triangle.value[0], triangle.value[1], triangle.value[2]);
+		}
+		return mesh;
+	}
+
+	static bool isSame(const Vec3f& lhs, const Vec3f& rhs)
+	{
+		return lhs.x() == rhs.x() && lhs.y() == rhs.y() && lhs.z() == rhs.z();
+	}
+
+	// Checks that every node bounds are exactly the union of bounds of its children (or primitives for leaves)
+	static void expectTightBounds(const HostBVH& bvh, const std::vector<Aabb3Df>& primitiveBounds)
+	{
+		const auto& nodes = bvh.getNodes();
+		const auto& primitiveIndices = bvh.getPrimitiveIndices();
+		for (size_t nodeIdx = 0; nodeIdx < nodes.size(); ++nodeIdx) {
+			const auto& node = nodes[nodeIdx];
+			Aabb3Df expected;
+			if (node.isLeaf()) {
+				for (uint32_t i = 0; i < node.primitiveCount; ++i) {
+					expected += primitiveBounds[primitiveIndices[node.rightChildOrFirstPrimitive + i]];
+				}
+			} else {
+				for (auto&& child : {nodes[nodeIdx + 1], nodes[node.rightChildOrFirstPrimitive]}) {
+					expected += Aabb3Df{} + child.boundsMin + child.boundsMax;
+				}
+			}
+			ASSERT_TRUE(isSame(node.boundsMin, expected.minCorner()));
+			ASSERT_TRUE(isSame(node.boundsMax, expected.maxCorner()));
+		}
+	}
+
+	static HostScene makeScene(const HostGeometry::Ptr& geometry)
+	{
+		return HostScene{{{.entityId = 0, .objectToWorld = Mat3x4f::identity(), .geometry = geometry}}};
+	}
+};
+
+TEST_F(HostBVHTest, parallel_build_matches_serial_build)
+{
+	// Large enough to build subtrees in parallel
+	const TestMesh mesh = makeGridMesh(200);
+	const auto triangleBounds = HostBVH::getTriangleBounds(mesh.vertices, mesh.indices);
+	ASSERT_GT(triangleBounds.size(), 2 * HostBVH::PARALLEL_BUILD_MIN_PRIMITIVES);
+
+	const HostBVH serial{triangleBounds, false};
+	const HostBVH parallel{triangleBounds, true};
+	ASSERT_EQ(serial.getNodes().size(), parallel.getNodes().size());
+	EXPECT_EQ(serial.getPrimitiveIndices(), parallel.getPrimitiveIndices());
+	for (size_t i = 0; i < serial.getNodes().size(); ++i) {
+		const auto& expected = serial.getNodes()[i];
+		const auto& actual = parallel.getNodes()[i];
+		ASSERT_EQ(expected.rightChildOrFirstPrimitive, actual.rightChildOrFirstPrimitive);
+		ASSERT_EQ(expected.primitiveCount, actual.primitiveCount);
+		ASSERT_TRUE(isSame(expected.boundsMin, actual.boundsMin));
+		ASSERT_TRUE(isSame(expected.boundsMax, actual.boundsMax));
+	}
+	expectTightBounds(parallel, triangleBounds);
+}
+
+TEST_F(HostBVHTest, refit_follows_moved_vertices)
+{
+	const TestMesh mesh = makeGridMesh(50);
+	const TestMesh movedMesh = makeGridMesh(50, 1.5f);
+	auto geometry = std::make_shared<const HostGeometry>(mesh.vertices, mesh.indices, std::vector<Vec2f>{});
+	auto refitted = std::make_shared<const HostGeometry>(*geometry, movedMesh.vertices);
+	auto rebuilt = std::make_shared<const HostGeometry>(movedMesh.vertices, movedMesh.indices, std::vector<Vec2f>{});
+	expectTightBounds(refitted->bvh, HostBVH::getTriangleBounds(movedMesh.vertices, movedMesh.indices));
+	EXPECT_TRUE(isSame(refitted->bounds.minCorner(), rebuilt->bounds.minCorner()));
+	EXPECT_TRUE(isSame(refitted->bounds.maxCorner(), rebuilt->bounds.maxCorner()));
+
+	// Rays from above, grazing the waves
+	const HostScene refittedScene = makeScene(refitted);
+	const HostScene rebuiltScene = makeScene(rebuilt);
+	std::mt19937 gen{42};
+	std::uniform_real_distribution<float> coord{0.0f, 50.0f};
+	for (int i = 0; i < 1000; ++i) {
+		const Vec3f origin{coord(gen), coord(gen), 5.0f};
+		const Vec3f dir = (Vec3f{coord(gen), coord(gen), 0.0f} - origin).normalized();
+		HostScene::Hit expected{}, actual{};
+		const bool isHit = rebuiltScene.intersect(origin, dir, std::numeric_limits<float>::infinity(), expected);
+		ASSERT_EQ(refittedScene.intersect(origin, dir, std::numeric_limits<float>::infinity(), actual), isHit);
+		if (isHit) {
+			EXPECT_FLOAT_EQ(actual.distance, expected.distance);
+			EXPECT_EQ(actual.triangleIdx, expected.triangleIdx);
+		}
+	}
+}
+
+TEST_F(HostBVHTest, refit_shares_topology)
+{
+	const TestMesh mesh = makeGridMesh(20);
+	const TestMesh movedMesh = makeGridMesh(20, 1.5f);
+	auto geometry = std::make_shared<const HostGeometry>(mesh.vertices, mesh.indices, std::vector<Vec2f>{});
+	auto refitted = std::make_shared<const HostGeometry>(*geometry, movedMesh.vertices);
+	EXPECT_EQ(refitted->indices, geometry->indices);
+	EXPECT_EQ(refitted->textureCoords, geometry->textureCoords);
+	EXPECT_EQ(&refitted->bvh.getPrimitiveIndices(), &geometry->bvh.getPrimitiveIndices());
+	EXPECT_EQ(geometry->consecutiveRefitCount, 0);
+	EXPECT_EQ(refitted->consecutiveRefitCount, 1);
+
+	auto rebuilt = HostGeometry::rebuilt(*refitted, movedMesh.vertices);
+	EXPECT_EQ(rebuilt->indices, geometry->indices);
+	EXPECT_EQ(rebuilt->consecutiveRefitCount, 0);
+	expectTightBounds(rebuilt->bvh, HostBVH::getTriangleBounds(movedMesh.vertices, movedMesh.indices));
+	EXPECT_THROW(HostGeometry::rebuilt(*geometry, {mesh.vertices.begin(), mesh.vertices.end() - 1}), std::invalid_argument);
+}
+
+TEST_F(HostBVHTest, refit_requires_the_same_primitive_count)
+{
+	const TestMesh mesh = makeCubeMesh();
+	auto bvh = HostBVH(HostBVH::getTriangleBounds(mesh.vertices, mesh.indices));
+	auto triangleBounds = HostBVH::getTriangleBounds(mesh.vertices, mesh.indices);
+	triangleBounds.pop_back();
+	EXPECT_THROW(bvh.refit(triangleBounds), std::invalid_argument);
+
+	const HostGeometry geometry{mesh.vertices, mesh.indices, {}};
+	EXPECT_THROW(HostGeometry(geometry, {mesh.vertices.begin(), mesh.vertices.end() - 1}), std::invalid_argument);
+}
@@ -0,0 +1,126 @@
+#include <helpers/sceneHelpers.hpp>
+#include <helpers/commonHelpers.hpp>
+
+#include <RGLFields.hpp>
+#include <scene/InstanceUpdateTracker.hpp>
+
+using Operation = InstanceUpdateTracker::Operation;
+
+class InstanceUpdateTrackerTest : public RGLTest
+{};
+
+TEST_F(InstanceUpdateTrackerTest, RefitOnlyAfterChangesOfExistingInstances)
+{
+	InstanceUpdateTracker tracker;
+	EXPECT_EQ(tracker.getOperation(), Operation::Rebuild); // Nothing built yet
+
+	tracker.onRebuilt(10);
+	EXPECT_EQ(tracker.getOperation(), Operation::None);
+
+	tracker.markDirty(3);
+	tracker.markDirty(3);
+	EXPECT_EQ(tracker.getOperation(), Operation::Refit);
+	EXPECT_EQ(tracker.getDirtySlotCount(), 1);
+
+	tracker.onRefitted();
+	EXPECT_EQ(tracker.getOperation(), Operation::None);
+	EXPECT_EQ(tracker.getDirtySlotCount(), 0);
+
+	// Instance added or removed
+	tracker.markDirty(1);
+	tracker.requestRebuild();
+	EXPECT_EQ(tracker.getOperation(), Operation::Rebuild);
+	tracker.onRebuilt(11);
+	EXPECT_EQ(tracker.getDirtySlotCount(), 0);
+
+	// Slot unknown to the last build
+	tracker.markDirty(11);
+	EXPECT_EQ(tracker.getOperation(), Operation::Rebuild);
+}
+
+TEST_F(InstanceUpdateTrackerTest, RebuildAfterTooManyRefits)
+{
+	InstanceUpdateTracker tracker;
+	tracker.onRebuilt(4);
+	for (size_t refit = 0; refit < InstanceUpdateTracker::MAX_CONSECUTIVE_REFITS; ++refit) {
+		tracker.markDirty(refit % 4);
+		ASSERT_EQ(tracker.getOperation(), Operation::Refit);
+		tracker.onRefitted();
+	}
+	tracker.markDirty(0);
+	EXPECT_EQ(tracker.getOperation(), Operation::Rebuild);
+	tracker.onRebuilt(4);
+	tracker.markDirty(0);
+	EXPECT_EQ(tracker.getOperation(), Operation::Refit);
+}
+
+TEST_F(InstanceUpdateTrackerTest, DirtyRanges)
+{
+	InstanceUpdateTracker tracker;
+	tracker.onRebuilt(100);
+	for (size_t slot : {50, 7, 8, 9, 12, 99, 0}) {
+		tracker.markDirty(slot);
+	}
+	auto toPairs = [](const std::vector<InstanceUpdateTracker::SlotRange>& ranges) {
+		std::vector<std::pair<size_t, size_t>> pairs;
+		for (auto&& range : ranges) {
+			pairs.emplace_back(range.begin, range.end);
+		}
+		return pairs;
+	};
+	using Pairs = std::vector<std::pair<size_t, size_t>>;
+	EXPECT_EQ(toPairs(tracker.getDirtyRanges()), (Pairs{{0, 1}, {7, 10}, {12, 13}, {50, 51}, {99, 100}}));
+	EXPECT_EQ(toPairs(tracker.getDirtyRanges(2)), (Pairs{{0, 1}, {7, 13}, {50, 51}, {99, 100}}));
+	EXPECT_EQ(toPairs(tracker.getDirtyRanges(100)), (Pairs{{0, 100}}));
+}
+
+/**
+ * Entities are moved and re-identified one by one, for more frames than the number of consecutive refits,
+ * so the scene goes through refits and periodic rebuilds. Every frame, each entity must be hit where it currently is.
+ */
+TEST_F(InstanceUpdateTrackerTest, RaytraceMovingEntities)
+{
+	constexpr int ENTITY_COUNT = 10;
+	constexpr float SPACING = 5.0f;
+	std::vector<rgl_entity_t> entities;
+	std::vector<float> entityDistances(ENTITY_COUNT, 10.0f);
+	std::vector<int32_t> entityIds(ENTITY_COUNT);
+	std::vector<rgl_mat3x4f> rays;
+	for (int i = 0; i < ENTITY_COUNT; ++i) {
+		entityIds[i] = i + 1;
+		entities.push_back(spawnCubeOnScene(Mat3x4f::translation(SPACING * i, 0.0f, entityDistances[i]), entityIds[i]));
+		rays.push_back(Mat3x4f::translation(SPACING * i, 0.0f, 0.0f).toRGL());
+	}
+
+	rgl_node_t useRays = nullptr, raytrace = nullptr, yield = nullptr;
+	std::vector<rgl_field_t> fields = {DISTANCE_F32, ENTITY_ID_I32};
+	ASSERT_RGL_SUCCESS(rgl_node_rays_from_mat3x4f(&useRays, rays.data(), rays.size()));
+	ASSERT_RGL_SUCCESS(rgl_node_raytrace(&raytrace, nullptr));
+	ASSERT_RGL_SUCCESS(rgl_node_points_yield(&yield, fields.data(), fields.size()));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(useRays, raytrace));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(raytrace, yield));
+
+	const int frameCount = 2 * InstanceUpdateTracker::MAX_CONSECUTIVE_REFITS + 5;
+	for (int frame = 0; frame < frameCount; ++frame) {
+		const int moved = frame % ENTITY_COUNT;
+		entityDistances[moved] = 5.0f + static_cast<float>(frame % 7);
+		rgl_mat3x4f transform = Mat3x4f::translation(SPACING * moved, 0.0f, entityDistances[moved]).toRGL();
+		ASSERT_RGL_SUCCESS(rgl_entity_set_transform(entities[moved], &transform));
+		if (frame % 3 == 0) {
+			entityIds[moved] += ENTITY_COUNT;
+			ASSERT_RGL_SUCCESS(rgl_entity_set_id(entities[moved], entityIds[moved]));
+		}
+
+		ASSERT_RGL_SUCCESS(rgl_graph_run(raytrace));
+
+		std::vector<Field<DISTANCE_F32>::type> distances(ENTITY_COUNT);
+		std::vector<Field<ENTITY_ID_I32>::type> ids(ENTITY_COUNT);
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(yield, DISTANCE_F32, distances.data()));
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(yield, ENTITY_ID_I32, ids.data()));
+		for (int i = 0; i < ENTITY_COUNT; ++i) {
+			// Cube faces are 1 unit away from its center
+			EXPECT_NEAR(distances[i], entityDistances[i] - 1.0f, 1e-4f) << "frame " << frame << ", entity " << i;
+			EXPECT_EQ(ids[i], entityIds[i]) << "frame " << frame << ", entity " << i;
+		}
+	}
+}
@@ -0,0 +1,115 @@
+#include <helpers/sceneHelpers.hpp>
+#include <helpers/commonHelpers.hpp>
+
+#include <RGLFields.hpp>
+#include <scene/SBTSlotAllocator.hpp>
+
+class SBTSlotAllocatorTest : public RGLTest
+{};
+
+TEST_F(SBTSlotAllocatorTest, ReleasedSlotsAreReused)
+{
+	SBTSlotAllocator slots;
+	EXPECT_EQ(slots.acquire(), 0);
+	EXPECT_EQ(slots.acquire(), 1);
+	EXPECT_EQ(slots.acquire(), 2);
+	EXPECT_EQ(slots.getDirtySlotCount(), 3); // New slots must be uploaded
+	slots.onUploaded();
+
+	slots.release(1);
+	EXPECT_EQ(slots.getSlotCount(), 3); // Hole, no compaction
+	EXPECT_EQ(slots.getUsedSlotCount(), 2);
+	EXPECT_FALSE(slots.isUsed(1));
+	EXPECT_EQ(slots.getDirtySlotCount(), 0);
+	EXPECT_THROW(slots.release(1), std::logic_error);
+
+	EXPECT_EQ(slots.acquire(), 1);
+	EXPECT_EQ(slots.acquire(), 3);
+	EXPECT_EQ(slots.getSlotCount(), 4);
+	EXPECT_EQ(slots.getDirtySlotCount(), 2);
+
+	slots.reset();
+	EXPECT_EQ(slots.getSlotCount(), 0);
+	EXPECT_EQ(slots.acquire(), 0);
+}
+
+TEST_F(SBTSlotAllocatorTest, OnlyUsedSlotsAreMarkedDirty)
+{
+	SBTSlotAllocator slots;
+	for (int i = 0; i < 6; ++i) {
+		slots.acquire();
+	}
+	slots.release(2);
+	slots.onUploaded();
+
+	slots.markDirty(4);
+	slots.markDirty(2);  // Hole
+	slots.markDirty(10); // Out of range
+	EXPECT_EQ(slots.getDirtySlotCount(), 1);
+
+	slots.markAllDirty();
+	EXPECT_EQ(slots.getDirtySlotCount(), 5);
+	auto ranges = slots.getDirtyRanges(1);
+	ASSERT_EQ(ranges.size(), 1);
+	EXPECT_EQ(ranges[0].begin, 0);
+	EXPECT_EQ(ranges[0].end, 6);
+	EXPECT_EQ(slots.getDirtyRanges().size(), 2);
+}
+
+/**
+ * Entities are removed and added between frames, so the new entities reuse SBT slots of the removed ones.
+ * Every frame, each ray must hit the entity in front of it and get attributes from that entity's SBT record.
+ */
+TEST_F(SBTSlotAllocatorTest, RaytraceWithReusedSlots)
+{
+	constexpr int ENTITY_COUNT = 8;
+	constexpr float SPACING = 5.0f;
+	std::vector<rgl_entity_t> entities(ENTITY_COUNT);
+	std::vector<float> laserRetros(ENTITY_COUNT);
+	std::vector<rgl_mat3x4f> rays;
+	auto spawn = [&](int i, float laserRetro) {
+		entities[i] = spawnCubeOnScene(Mat3x4f::translation(SPACING * i, 0.0f, 10.0f), i + 1);
+		laserRetros[i] = laserRetro;
+		EXPECT_RGL_SUCCESS(rgl_entity_set_laser_retro(entities[i], laserRetro));
+	};
+	for (int i = 0; i < ENTITY_COUNT; ++i) {
+		spawn(i, static_cast<float>(i));
+		rays.push_back(Mat3x4f::translation(SPACING * i, 0.0f, 0.0f).toRGL());
+	}
+
+	rgl_node_t useRays = nullptr, raytrace = nullptr, yield = nullptr;
+	std::vector<rgl_field_t> fields = {IS_HIT_I32, ENTITY_ID_I32, LASER_RETRO_F32};
+	ASSERT_RGL_SUCCESS(rgl_node_rays_from_mat3x4f(&useRays, rays.data(), rays.size()));
+	ASSERT_RGL_SUCCESS(rgl_node_raytrace(&raytrace, nullptr));
+	ASSERT_RGL_SUCCESS(rgl_node_points_yield(&yield, fields.data(), fields.size()));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(useRays, raytrace));
+	ASSERT_RGL_SUCCESS(rgl_graph_node_add_child(raytrace, yield));
+
+	for (int frame = 0; frame < 10; ++frame) {
+		// Replace two entities, released slots are reused in the reverse order
+		for (int i : {frame % ENTITY_COUNT, (frame + 3) % ENTITY_COUNT}) {
+			ASSERT_RGL_SUCCESS(rgl_entity_destroy(entities[i]));
+		}
+		for (int i : {frame % ENTITY_COUNT, (frame + 3) % ENTITY_COUNT}) {
+			spawn(i, 100.0f * static_cast<float>(frame) + static_cast<float>(i));
+		}
+		// Update a record of an entity that was not replaced
+		const int updated = (frame + 1) % ENTITY_COUNT;
+		laserRetros[updated] += 0.5f;
+		ASSERT_RGL_SUCCESS(rgl_entity_set_laser_retro(entities[updated], laserRetros[updated]));
+
+		ASSERT_RGL_SUCCESS(rgl_graph_run(raytrace));
+
+		std::vector<Field<IS_HIT_I32>::type> isHit(ENTITY_COUNT);
+		std::vector<Field<ENTITY_ID_I32>::type> ids(ENTITY_COUNT);
+		std::vector<Field<LASER_RETRO_F32>::type> retros(ENTITY_COUNT);
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(yield, IS_HIT_I32, isHit.data()));
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(yield, ENTITY_ID_I32, ids.data()));
+		ASSERT_RGL_SUCCESS(rgl_graph_get_result_data(yield, LASER_RETRO_F32, retros.data()));
+		for (int i = 0; i < ENTITY_COUNT; ++i) {
+			EXPECT_EQ(isHit[i], 1) << "frame " << frame << ", entity " << i;
+			EXPECT_EQ(ids[i], i + 1) << "frame " << frame << ", entity " << i;
+			EXPECT_EQ(retros[i], laserRetros[i]) << "frame " << frame << ", entity " << i;
+		}
+	}
+}
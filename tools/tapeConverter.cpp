@@ -0,0 +1,42 @@
+// Copyright 2023 Robotec.AI
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string_view>
+
+#include "spdlog/fmt/fmt.h"
+#include "tape/TapeConverter.hpp"
+
+int main(int argc, char** argv)
+{
+	if (argc != 3) {
+		fmt::print(stderr, "USAGE: {} <to-yaml|to-binary> <path-to-tape-without-suffix>\n", argv[0]);
+		return 1;
+	}
+	const std::string_view direction{argv[1]};
+	try {
+		if (direction == "to-yaml") {
+			TapeConverter::convertCallsTapeToYaml(argv[2]);
+		} else if (direction == "to-binary") {
+			TapeConverter::convertYamlTapeToCalls(argv[2]);
+		} else {
+			fmt::print(stderr, "Unknown conversion direction: {}\n", direction);
+			return 1;
+		}
+	}
+	catch (std::exception& e) {
+		fmt::print(stderr, "Conversion failed: {}\n", e.what());
+		return 1;
+	}
+	return 0;
+}
@@ -17,12 +17,16 @@
 
 int main(int argc, char** argv)
 {
-	if (argc != 2) {
-		fmt::print(stderr, "USAGE: {} <path-to-tape-without-suffix>\n", argv[0]);
+	if (argc != 2 && argc != 3) {
+		fmt::print(stderr, "USAGE: {} <path-to-tape-without-suffix> [first-frame]\n", argv[0]);
 		return 1;
 	}
 	TapePlayer player{argv[1]};
+	const size_t firstFrame = argc == 3 ? std::stoul(argv[2]) : 0;
 	while (true) {
+		if (firstFrame > 0) {
+			player.seekFrame(firstFrame);
+		}
 		player.playApproximatelyRealtime();
 		player.reset();
 	}
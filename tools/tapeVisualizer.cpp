@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <ranges>
+
 #include "rgl/api/extensions/tape.h"
 #include "rgl/api/extensions/pcl.h"
 #include "spdlog/fmt/fmt.h"
@@ -52,14 +54,21 @@ private:
 
 int main(int argc, char** argv)
 try {
-	if (argc != 2) {
-		fmt::print(stderr, "USAGE: {} <path-to-tape-without-suffix>\n", argv[0]);
+	if (argc != 2 && argc != 3) {
+		fmt::print(stderr, "USAGE: {} <path-to-tape-without-suffix> [first-frame]\n", argv[0]);
 		std::exit(EXIT_FAILURE);
 	}
 
 	fmt::print("Reading tape '{}' ...\n", argv[1]);
 	TapePlayer player{argv[1]};
 
+	// Frames are counted by rgl_graph_run calls; seeking restores the nearest checkpoint instead of replaying the whole tape
+	size_t firstFrame = argc == 3 ? std::stoul(argv[2]) : 0;
+	if (firstFrame > 0) {
+		fmt::print("Seeking to frame {} of {} ...\n", firstFrame, player.getFrameCount());
+		player.seekFrame(firstFrame);
+	}
+
 	std::vector<TapePlayer::APICallIdx> interceptedNodeCalls = player.findAll({INTERCEPTED_NODE_CALL});
 	if (interceptedNodeCalls.empty()) {
 		throw std::runtime_error("no nodes to intercept");
@@ -70,7 +79,7 @@ try {
 	// fix.push_back(interceptedNodeCalls[2]);
 	// interceptedNodeCalls = fix;
 
-	// Collect handles to intercepted nodes
+	// Collect handles to intercepted nodes (no-op if they were already created while seeking)
 	player.playThrough(interceptedNodeCalls.back());
 	std::vector<rgl_node_t> interceptedNodes;
 	for (auto&& call : interceptedNodeCalls) {
@@ -114,7 +123,7 @@ try {
 	}
 
 	// TODO: this will not work if LiDARS have different capture rate.
-	for (auto&& run : graphRuns) {
+	for (auto&& run : graphRuns | std::views::drop(firstFrame)) {
 		// Run till next run call
 		auto runNodeArg = player.getTapeCall(run).getArgsNode()[0].as<TapeAPIObjectID>();
 		player.playThrough(run);